@@ -11,6 +11,13 @@ outfile = 0
 EchoString = ""
 ParmPass = 0
 
+# Binary protocol field table, shared by every generated BinSocket file
+FieldList = []
+FieldId = {}
+SchemaHash = 0
+BinGuard = ""
+BinCaseIds = set()
+
 ########################################################################
 def WriteProlog():
 
@@ -352,6 +359,11 @@ def WriteCodeBlock(Indent,FmtPrefix,ArrayIdx,ArgPrefix,VarString,IdxLen,Ni,Nj,St
 
       global Prog, Verb, Pipe, outfile, EchoString
 
+      if Pipe == "BinSocket":
+         BinWriteCodeBlock(Indent,FmtPrefix,ArrayIdx,ArgPrefix,VarString,Ni,Nj,StructIdxString,FormatString)
+         return
+      #endif
+
       line = Indent+"   sprintf(line,\""
       line += FmtPrefix
       line += VarString
@@ -420,7 +432,12 @@ def WriteCodeBlock(Indent,FmtPrefix,ArrayIdx,ArgPrefix,VarString,IdxLen,Ni,Nj,St
 ########################################################################
 def ReadCodeBlock(Indent,FmtPrefix,ArrayIdx,ArgPrefix,ArgString,VarString,IdxLen,Ni,Nj,StructIdxString,Narg,FormatString):
 
-      global Prog, outfile
+      global Prog, Pipe, outfile
+
+      if Pipe == "BinSocket":
+         BinReadCodeBlock(Indent,FmtPrefix,ArrayIdx,ArgPrefix,ArgString,VarString,Ni,Nj,StructIdxString)
+         return
+      #endif
 
       line = Indent+"if (sscanf(line,\""
       line += FmtPrefix
@@ -637,18 +654,624 @@ def StripEmptyLoops(infile,outfile):
          line1 = infile.readline()
       #end while
             
+########################################################################
+# Binary socket protocol.  A frame is a 12-byte header (magic, schema
+# hash, payload length) followed by records.  Each record is a 2-byte
+# field ID from FieldList, one 4-byte index per [%ld] in the field's
+# text name, and the field's values as 8-byte doubles or integers.
+# Both ends are generated from the same 42.json, so the field IDs and
+# the schema hash agree exactly when the two programs were built from
+# the same database.
+########################################################################
+def CollectFields(StructList,Struct,FmtPrefix):
+
+      global FieldList, FieldId
+
+      Primitives = {"long","double"}
+
+      for Var in Struct["Table Data"]:
+         DataType = Var["Data Type"]
+         if DataType in Primitives:
+            IsIpc = Var["Sim Read/Write"] != "" or Var["App Read/Write"] != "" or Var["Packet Role"] == "PRM"
+            Name = FmtPrefix+Var["Variable Name"]
+            if IsIpc and Name not in FieldId:
+               Ni = 1
+               Nj = 1
+               if "Array Size" in Var:
+                  IdxList = Var["Array Size"].strip(r"[]").split(",")
+                  if len(IdxList) == 2:
+                     Ni = int(IdxList[0])
+                     Nj = int(IdxList[1])
+                  elif IdxList[0].isnumeric():
+                     Ni = int(IdxList[0])
+                  #endif
+               #endif
+               FieldId[Name] = len(FieldList)
+               FieldList.append((Name,Name.count("%ld"),Ni*Nj,DataType))
+            #endif
+         else:
+            for SubStruct in StructList:
+               if SubStruct["Table Name"] == DataType:
+                  LocalFmtPrefix = FmtPrefix+Var["Variable Name"]
+                  if "Array Size" in Var:
+                     if len(Var["Array Size"].strip(r"[]").split(",")) == 2:
+                        LocalFmtPrefix += "[%ld][%ld]."
+                     else:
+                        LocalFmtPrefix += "[%ld]."
+                     #endif
+                  else:
+                     LocalFmtPrefix += "."
+                  #endif
+                  CollectFields(StructList,SubStruct,LocalFmtPrefix)
+               #endif
+            #next SubStruct
+         #endif
+      #next Var
+
+########################################################################
+def BuildFieldTable(StructList):
+
+      global FieldList, FieldId, SchemaHash
+
+      FieldList = [("TIME",0,5,"double")]
+      FieldId = {"TIME":0}
+      Roots = [("SCType","SC[%ld]."),("OrbitType","Orb[%ld]."),
+               ("WorldType","World[%ld]."),("AcType","SC[%ld].AC.")]
+      for TableName,FmtPrefix in Roots:
+         for Struct in StructList:
+            if Struct["Table Name"] == TableName:
+               CollectFields(StructList,Struct,FmtPrefix)
+            #endif
+         #next Struct
+      #next Root
+
+      if len(FieldList) > 65535:
+         sys.exit("Too many IPC fields for a 16-bit field ID")
+      #endif
+      if max(F[1] for F in FieldList) > 3:
+         sys.exit("Binary IPC records carry at most three indices")
+      #endif
+
+      # FNV-1a over the field table, so mismatched peers are caught
+      SchemaHash = 0x811c9dc5
+      for Name,Nidx,Nval,DataType in FieldList:
+         for c in (Name+":"+str(Nval)+":"+DataType+";").encode():
+            SchemaHash = ((SchemaHash ^ c)*0x01000193) & 0xffffffff
+         #next c
+      #next Field
+
+########################################################################
+def WriteBinSupport():
+
+      global Prog, Verb, outfile
+
+      if Prog == "Sim":
+         Static = "static SIMLOCAL"
+      else:
+         Static = "static"
+      #endif
+
+      outfile.write("#include <stdint.h>\n\n")
+      outfile.write("#define IPC_NFIELD "+str(len(FieldList))+"\n")
+      outfile.write("#define IPC_MAGIC 0x34324950\n")
+      outfile.write("#define IPC_SCHEMA 0x%08x\n\n" % SchemaHash)
+      outfile.write("struct IpcFieldType {\n")
+      outfile.write("   const char *Name; /* As in the text protocol */\n")
+      outfile.write("   long Nidx;\n")
+      outfile.write("   long Nval;\n")
+      outfile.write("};\n")
+      outfile.write("static const struct IpcFieldType IpcField[IPC_NFIELD] = {\n")
+      for Name,Nidx,Nval,DataType in FieldList:
+         outfile.write("   {\""+Name+"\","+str(Nidx)+","+str(Nval)+"},\n")
+      #next Field
+      outfile.write("};\n\n")
+
+      outfile.write(Static+" char *IpcBuf = NULL;\n")
+      outfile.write(Static+" long IpcBufSize = 0;\n")
+      outfile.write(Static+" long IpcLen = 0;\n\n")
+
+      outfile.write("/**********************************************************************/\n")
+      outfile.write("static void IpcReserve(long N)\n")
+      outfile.write("{\n")
+      outfile.write("      if (IpcLen+N > IpcBufSize) {\n")
+      outfile.write("         IpcBufSize = 2*(IpcLen+N);\n")
+      outfile.write("         IpcBuf = (char *) realloc(IpcBuf,IpcBufSize);\n")
+      outfile.write("         if (IpcBuf == NULL) {\n")
+      outfile.write("            fprintf(stderr,\"IPC buffer realloc failed.  Bailing out!\\n\");\n")
+      outfile.write("            exit(EXIT_FAILURE);\n")
+      outfile.write("         }\n")
+      outfile.write("      }\n")
+      outfile.write("}\n")
+
+      if Verb == "WriteTo":
+         outfile.write("/**********************************************************************/\n")
+         outfile.write("static void IpcPutHdr(long Id, long I0, long I1, long I2)\n")
+         outfile.write("{\n")
+         outfile.write("      uint16_t Id16 = (uint16_t) Id;\n")
+         outfile.write("      int32_t Idx[3];\n")
+         outfile.write("      long Nidx = IpcField[Id].Nidx;\n\n")
+         outfile.write("      Idx[0] = (int32_t) I0;\n")
+         outfile.write("      Idx[1] = (int32_t) I1;\n")
+         outfile.write("      Idx[2] = (int32_t) I2;\n")
+         outfile.write("      IpcReserve(2+4*Nidx+8*IpcField[Id].Nval);\n")
+         outfile.write("      memcpy(&IpcBuf[IpcLen],&Id16,2);\n")
+         outfile.write("      memcpy(&IpcBuf[IpcLen+2],Idx,4*Nidx);\n")
+         outfile.write("      IpcLen += 2+4*Nidx;\n")
+         outfile.write("}\n")
+         outfile.write("/**********************************************************************/\n")
+         outfile.write("static void IpcPutDbl(const double *Val, long N)\n")
+         outfile.write("{\n")
+         outfile.write("      memcpy(&IpcBuf[IpcLen],Val,8*N);\n")
+         outfile.write("      IpcLen += 8*N;\n")
+         outfile.write("}\n")
+         outfile.write("/**********************************************************************/\n")
+         outfile.write("static void IpcPutLong(const long *Val, long N)\n")
+         outfile.write("{\n")
+         outfile.write("      int64_t Val64;\n")
+         outfile.write("      long k;\n\n")
+         outfile.write("      for(k=0;k<N;k++) {\n")
+         outfile.write("         Val64 = (int64_t) Val[k];\n")
+         outfile.write("         memcpy(&IpcBuf[IpcLen],&Val64,8);\n")
+         outfile.write("         IpcLen += 8;\n")
+         outfile.write("      }\n")
+         outfile.write("}\n")
+         if Prog == "Sim":
+            outfile.write("/**********************************************************************/\n")
+            outfile.write("/* Would Pfx match the text protocol line for field Id, as strncmp */\n")
+            outfile.write("/* does in WriteToSocket?  1 = yes, 0 = no, and with Idx NULL,     */\n")
+            outfile.write("/* 2 = depends on the indices.                                     */\n")
+            outfile.write("static long IpcPrefixMatch(const char *Pfx, const char *Name, const long *Idx)\n")
+            outfile.write("{\n")
+            outfile.write("      char Digits[24];\n")
+            outfile.write("      long Ip = 0, In = 0, Ix = 0, Nd, k;\n\n")
+            outfile.write("      while(Pfx[Ip] != '\\0') {\n")
+            outfile.write("         if (!strncmp(&Name[In],\"%ld\",3)) {\n")
+            outfile.write("            if (Idx == NULL) return(2);\n")
+            outfile.write("            Nd = sprintf(Digits,\"%ld\",Idx[Ix++]);\n")
+            outfile.write("            for(k=0;k<Nd && Pfx[Ip] != '\\0';k++,Ip++) {\n")
+            outfile.write("               if (Pfx[Ip] != Digits[k]) return(0);\n")
+            outfile.write("            }\n")
+            outfile.write("            In += 3;\n")
+            outfile.write("         }\n")
+            outfile.write("         else if (Name[In] == '\\0' || Pfx[Ip] != Name[In]) return(0);\n")
+            outfile.write("         else {\n")
+            outfile.write("            Ip++;\n")
+            outfile.write("            In++;\n")
+            outfile.write("         }\n")
+            outfile.write("      }\n")
+            outfile.write("      return(1);\n")
+            outfile.write("}\n")
+            outfile.write("/**********************************************************************/\n")
+            outfile.write("/* Per field, a summary (0 = never sent, 1 = always sent, 2 = check */\n")
+            outfile.write("/* indices) and the IpcPrefixMatch result for each prefix           */\n")
+            outfile.write("static void IpcBuildFieldSel(struct IpcType *I)\n")
+            outfile.write("{\n")
+            outfile.write("      long *Sel;\n")
+            outfile.write("      long Id,Ipfx;\n\n")
+            outfile.write("      I->FieldSel = (long *) calloc(IPC_NFIELD*(I->Nprefix+1),sizeof(long));\n")
+            outfile.write("      if (I->FieldSel == NULL) {\n")
+            outfile.write("         fprintf(stderr,\"IPC field selection calloc failed.  Bailing out!\\n\");\n")
+            outfile.write("         exit(EXIT_FAILURE);\n")
+            outfile.write("      }\n")
+            outfile.write("      for(Id=0;Id<IPC_NFIELD;Id++) {\n")
+            outfile.write("         Sel = &I->FieldSel[Id*(I->Nprefix+1)];\n")
+            outfile.write("         for(Ipfx=0;Ipfx<I->Nprefix;Ipfx++) {\n")
+            outfile.write("            Sel[1+Ipfx] = IpcPrefixMatch(I->Prefix[Ipfx],IpcField[Id].Name,NULL);\n")
+            outfile.write("            if (Sel[1+Ipfx] == 1) Sel[0] = 1;\n")
+            outfile.write("            else if (Sel[1+Ipfx] == 2 && Sel[0] == 0) Sel[0] = 2;\n")
+            outfile.write("         }\n")
+            outfile.write("      }\n")
+            outfile.write("}\n")
+            outfile.write("/**********************************************************************/\n")
+            outfile.write("static long IpcSelected(struct IpcType *I, long Id, long I0, long I1, long I2)\n")
+            outfile.write("{\n")
+            outfile.write("      long *Sel = &I->FieldSel[Id*(I->Nprefix+1)];\n")
+            outfile.write("      long Idx[3];\n")
+            outfile.write("      long Ipfx;\n\n")
+            outfile.write("      if (Sel[0] != 2) return(Sel[0]);\n")
+            outfile.write("      Idx[0] = I0;\n")
+            outfile.write("      Idx[1] = I1;\n")
+            outfile.write("      Idx[2] = I2;\n")
+            outfile.write("      for(Ipfx=0;Ipfx<I->Nprefix;Ipfx++) {\n")
+            outfile.write("         if (Sel[1+Ipfx] == 2 &&\n")
+            outfile.write("             IpcPrefixMatch(I->Prefix[Ipfx],IpcField[Id].Name,Idx)) return(1);\n")
+            outfile.write("      }\n")
+            outfile.write("      return(0);\n")
+            outfile.write("}\n")
+         #endif
+      else:
+         outfile.write("/**********************************************************************/\n")
+         outfile.write("/* Returns 0 only if nothing at all has arrived */\n")
+         outfile.write("static long IpcRecvAll(SOCKET Socket, char *Dst, long N, long Started)\n")
+         outfile.write("{\n")
+         outfile.write("      long Got = 0;\n")
+         outfile.write("      int NumBytes;\n\n")
+         outfile.write("      while(Got < N) {\n")
+         outfile.write("         NumBytes = recv(Socket,&Dst[Got],N-Got,0);\n")
+         outfile.write("         if (NumBytes == 0 || (NumBytes < 0 && Got == 0 && !Started)) return(0);\n")
+         outfile.write("         if (NumBytes > 0) Got += NumBytes;\n")
+         outfile.write("      }\n")
+         outfile.write("      return(1);\n")
+         outfile.write("}\n")
+         outfile.write("/**********************************************************************/\n")
+         outfile.write("static void IpcCheckHdr(const uint32_t *Hdr)\n")
+         outfile.write("{\n")
+         outfile.write("      if (Hdr[0] != IPC_MAGIC || Hdr[1] != IPC_SCHEMA) {\n")
+         outfile.write("         fprintf(stderr,\"Binary IPC frame has schema %08lx, expected %08lx.  Were both ends generated from the same 42.json?  Bailing out!\\n\",\n")
+         outfile.write("            (unsigned long) Hdr[1],(unsigned long) IPC_SCHEMA);\n")
+         outfile.write("         exit(EXIT_FAILURE);\n")
+         outfile.write("      }\n")
+         outfile.write("}\n")
+         outfile.write("/**********************************************************************/\n")
+         outfile.write("/* Reads one frame into IpcBuf and returns its total length, or 0 */\n")
+         outfile.write("static long IpcRecvFrame(SOCKET Socket)\n")
+         outfile.write("{\n")
+         outfile.write("      uint32_t Hdr[3];\n\n")
+         outfile.write("      if (!IpcRecvAll(Socket,(char *) Hdr,12,0)) return(0);\n")
+         outfile.write("      IpcCheckHdr(Hdr);\n")
+         outfile.write("      IpcLen = 0;\n")
+         outfile.write("      IpcReserve(12+Hdr[2]);\n")
+         outfile.write("      if (!IpcRecvAll(Socket,&IpcBuf[12],Hdr[2],1)) return(0);\n")
+         outfile.write("      return(12+Hdr[2]);\n")
+         outfile.write("}\n")
+         outfile.write("/**********************************************************************/\n")
+         outfile.write("static void IpcTruncated(void)\n")
+         outfile.write("{\n")
+         outfile.write("      fprintf(stderr,\"Truncated binary IPC frame.  Bailing out!\\n\");\n")
+         outfile.write("      exit(EXIT_FAILURE);\n")
+         outfile.write("}\n")
+         outfile.write("/**********************************************************************/\n")
+         outfile.write("static void IpcGetLong(long *Dst, const char *Src, long N)\n")
+         outfile.write("{\n")
+         outfile.write("      int64_t Val64;\n")
+         outfile.write("      long k;\n\n")
+         outfile.write("      for(k=0;k<N;k++) {\n")
+         outfile.write("         memcpy(&Val64,&Src[8*k],8);\n")
+         outfile.write("         Dst[k] = (long) Val64;\n")
+         outfile.write("      }\n")
+         outfile.write("}\n")
+      #endif
+
+########################################################################
+def BinWriteProlog():
+
+      global Prog, outfile, EchoString
+
+      outfile.write("/* Note:  This file was autogenerated by Database/JsonToIPC.py */\n")
+      outfile.write("/*        See Database/Readme.txt for details. */\n")
+      outfile.write("/*        If you are hand-modifying this file, keep in mind that */\n")
+      outfile.write("/*        your work will be lost if you run JsonToIPC.py again. */\n\n")
+
+      if Prog == "Sim":
+         outfile.write("#include \"42.h\"\n")
+      else:
+         outfile.write("#include \"Ac.h\"\n")
+      #endif
+      WriteBinSupport()
+
+      outfile.write("/**********************************************************************/\n")
+      outfile.write("/* Builds one frame in IpcBuf, for whichever transport sends it */\n")
+      if Prog == "Sim":
+         outfile.write("static void PackBinFrame(struct IpcType *I)\n")
+      else:
+         outfile.write("static void PackBinFrame(struct AcType *AC)\n")
+      #endif
+      outfile.write("{\n\n")
+      outfile.write("      long Isc,Iorb,Iw,i;\n")
+      outfile.write("      uint32_t Hdr[3];\n")
+      if Prog == "Sim":
+         outfile.write("      double TimeVal[5];\n")
+      #endif
+      outfile.write("\n")
+
+      outfile.write("      IpcLen = 0;\n")
+      outfile.write("      IpcReserve(12);\n")
+      outfile.write("      IpcLen = 12;\n\n")
+
+      if Prog == "Sim":
+         outfile.write("      if (I->FieldSel == NULL) IpcBuildFieldSel(I);\n\n")
+         outfile.write("      TimeVal[0] = UTC.Year;\n")
+         outfile.write("      TimeVal[1] = UTC.doy;\n")
+         outfile.write("      TimeVal[2] = UTC.Hour;\n")
+         outfile.write("      TimeVal[3] = UTC.Minute;\n")
+         outfile.write("      TimeVal[4] = UTC.Second;\n")
+         outfile.write("      IpcPutHdr(0,0,0,0);\n")
+         outfile.write("      IpcPutDbl(TimeVal,5);\n\n")
+      else:
+         outfile.write("      Isc = AC->ID;\n\n")
+      #endif
+
+########################################################################
+def BinWriteEpilog():
+
+      global Prog, outfile, EchoString
+
+      if Prog == "Sim":
+         Echo = "I->EchoEnabled"
+      else:
+         Echo = EchoString
+      #endif
+      outfile.write("      Hdr[0] = IPC_MAGIC;\n")
+      outfile.write("      Hdr[1] = IPC_SCHEMA;\n")
+      outfile.write("      Hdr[2] = (uint32_t) (IpcLen-12);\n")
+      outfile.write("      memcpy(IpcBuf,Hdr,12);\n")
+      outfile.write("      if ("+Echo+") printf(\"Binary IPC frame, %ld bytes\\n\",IpcLen);\n")
+      outfile.write("}\n")
+
+      outfile.write("/**********************************************************************/\n")
+      if Prog == "Sim":
+         outfile.write("void WriteToBinSocket(struct IpcType *I)\n")
+         Socket = "I->Socket"
+         Arg = "I"
+      else:
+         outfile.write("void WriteToBinSocket(SOCKET Socket, struct AcType *AC)\n")
+         Socket = "Socket"
+         Arg = "AC"
+      #endif
+      outfile.write("{\n")
+      outfile.write("      char AckMsg[5] = \"Ack\\n\";\n\n")
+      outfile.write("      PackBinFrame("+Arg+");\n")
+      outfile.write("      send("+Socket+",IpcBuf,IpcLen,0);\n\n")
+      outfile.write("      /* Wait for Ack */\n")
+      outfile.write("      recv("+Socket+",AckMsg,5,0);\n")
+      outfile.write("}\n")
+
+      outfile.write("/**********************************************************************/\n")
+      outfile.write("/* No Ack: ShmSend waits whenever the ring is full */\n")
+      if Prog == "Sim":
+         outfile.write("void WriteToShm(struct IpcType *I)\n")
+         Shm = "I->Shm"
+      else:
+         outfile.write("void WriteToShm(struct ShmLinkType *Shm, struct AcType *AC)\n")
+         Shm = "Shm"
+      #endif
+      outfile.write("{\n")
+      outfile.write("      PackBinFrame("+Arg+");\n")
+      outfile.write("      ShmSend("+Shm+",IpcBuf,IpcLen);\n")
+      outfile.write("}\n")
+
+########################################################################
+def BinReadProlog():
+
+      global Prog, outfile, EchoString, BinCaseIds
+
+      BinCaseIds = set()
+
+      outfile.write("/* Note:  This file was autogenerated by Database/JsonToIPC.py */\n")
+      outfile.write("/*        See Database/Readme.txt for details. */\n")
+      outfile.write("/*        If you are hand-modifying this file, keep in mind that */\n")
+      outfile.write("/*        your work will be lost if you run JsonToIPC.py again. */\n\n")
+
+      if Prog == "Sim":
+         outfile.write("#include \"42.h\"\n")
+      else:
+         outfile.write("#include \"Ac.h\"\n")
+      #endif
+      WriteBinSupport()
+
+      outfile.write("/**********************************************************************/\n")
+      outfile.write("/* Decodes one frame in place, wherever the transport left it */\n")
+      if Prog == "Sim":
+         outfile.write("static void UnpackBinFrame(const char *Frame, long Len, long EchoEnabled)\n")
+      else:
+         outfile.write("static void UnpackBinFrame(const char *Frame, long Len, struct AcType *AC)\n")
+      #endif
+      outfile.write("{\n\n")
+      if Prog == "Sim":
+         outfile.write("      struct SCType *S;\n")
+         outfile.write("      struct OrbitType *O;\n")
+         outfile.write("      struct DynType *D;\n")
+      #endif
+      outfile.write("      long Isc,Iorb,Iw,i;\n")
+      outfile.write("      long RequestTimeRefresh = 0;\n")
+      outfile.write("      uint16_t Id16;\n")
+      outfile.write("      int32_t Idx[3];\n")
+      outfile.write("      long Id,Ipos;\n")
+      outfile.write("      const char *Val;\n")
+      outfile.write("      double TimeVal[5];\n")
+      outfile.write("      long Year,doy,Hour,Minute;\n")
+      outfile.write("      double Second;\n")
+      if Prog == "App":
+         outfile.write("      long Month,Day;\n")
+      #endif
+      outfile.write("\n")
+      outfile.write("      if ("+EchoString+") printf(\"Binary IPC frame, %ld bytes\\n\",Len);\n\n")
+      outfile.write("      Ipos = 12;\n")
+      outfile.write("      while(Ipos < Len) {\n")
+      outfile.write("         if (Ipos+2 > Len) IpcTruncated();\n")
+      outfile.write("         memcpy(&Id16,&Frame[Ipos],2);\n")
+      outfile.write("         Id = Id16;\n")
+      outfile.write("         if (Id >= IPC_NFIELD) {\n")
+      outfile.write("            fprintf(stderr,\"Unknown field ID %ld in binary IPC frame.  Bailing out!\\n\",Id);\n")
+      outfile.write("            exit(EXIT_FAILURE);\n")
+      outfile.write("         }\n")
+      outfile.write("         /* Whole record present before any of it is read */\n")
+      outfile.write("         if (Ipos+2+4*IpcField[Id].Nidx+8*IpcField[Id].Nval > Len) IpcTruncated();\n")
+      outfile.write("         memcpy(Idx,&Frame[Ipos+2],4*IpcField[Id].Nidx);\n")
+      outfile.write("         Val = &Frame[Ipos+2+4*IpcField[Id].Nidx];\n")
+      outfile.write("         Ipos += 2+4*IpcField[Id].Nidx+8*IpcField[Id].Nval;\n\n")
+      outfile.write("         switch(Id) {\n")
+      outfile.write("            case 0:\n")
+      outfile.write("               memcpy(TimeVal,Val,sizeof(TimeVal));\n")
+      outfile.write("               Year = (long) TimeVal[0];\n")
+      outfile.write("               doy = (long) TimeVal[1];\n")
+      outfile.write("               Hour = (long) TimeVal[2];\n")
+      outfile.write("               Minute = (long) TimeVal[3];\n")
+      outfile.write("               Second = TimeVal[4];\n")
+      outfile.write("               RequestTimeRefresh = 1;\n")
+      outfile.write("               break;\n\n")
+
+########################################################################
+def BinReadEpilog():
+
+      global outfile
+
+      outfile.write("            default: /* Not read by this program */\n")
+      outfile.write("               break;\n")
+      outfile.write("         }\n")
+      outfile.write("      }\n\n")
+
+########################################################################
+def BinReadTransports():
+
+      global Prog, outfile
+
+      if Prog == "Sim":
+         Arg = "EchoEnabled"
+         Args = "long EchoEnabled"
+      else:
+         Arg = "AC"
+         Args = "struct AcType *AC"
+      #endif
+      outfile.write("/**********************************************************************/\n")
+      outfile.write("void ReadFromBinSocket(SOCKET Socket, "+Args+")\n")
+      outfile.write("{\n")
+      outfile.write("      char AckMsg[5] = \"Ack\\n\";\n")
+      outfile.write("      long Len;\n\n")
+      outfile.write("      Len = IpcRecvFrame(Socket);\n")
+      outfile.write("      if (Len == 0) return; /* Bail out if no message */\n")
+      outfile.write("      UnpackBinFrame(IpcBuf,Len,"+Arg+");\n\n")
+      outfile.write("      /* Acknowledge receipt, all five bytes the writer waits for */\n")
+      outfile.write("      send(Socket,AckMsg,5,0);\n")
+      outfile.write("}\n")
+      outfile.write("/**********************************************************************/\n")
+      outfile.write("/* The frame is decoded where it sits in the ring, then released */\n")
+      outfile.write("void ReadFromShm(struct ShmLinkType *Shm, "+Args+")\n")
+      outfile.write("{\n")
+      outfile.write("      const char *Frame;\n")
+      outfile.write("      uint32_t Hdr[3];\n")
+      outfile.write("      long Len;\n\n")
+      outfile.write("      Frame = ShmRecv(Shm,&Len);\n")
+      outfile.write("      if (Frame == NULL) return; /* Bail out if no message */\n")
+      outfile.write("      if (Len < 12) IpcTruncated();\n")
+      outfile.write("      memcpy(Hdr,Frame,12);\n")
+      outfile.write("      IpcCheckHdr(Hdr);\n")
+      outfile.write("      UnpackBinFrame(Frame,Len,"+Arg+");\n")
+      outfile.write("      ShmRelease(Shm);\n")
+      outfile.write("}\n")
+
+########################################################################
+def BinWriteCodeBlock(Indent,FmtPrefix,ArrayIdx,ArgPrefix,VarString,Ni,Nj,StructIdxString,FormatString):
+
+      global Prog, outfile
+
+      Id = str(FieldId[FmtPrefix+VarString])
+      IdxArgs = [ArrayIdx]+StructIdxString.split(",")[1:]
+      IdxArgs += ["0"]*(3-len(IdxArgs))
+      if Nj > 1:
+         Arg = "&"+ArgPrefix+VarString+"[0][0]"
+      elif Ni > 1:
+         Arg = ArgPrefix+VarString
+      else:
+         Arg = "&"+ArgPrefix+VarString
+      #endif
+      if FormatString == "%ld":
+         Put = "IpcPutLong"
+      else:
+         Put = "IpcPutDbl"
+      #endif
+
+      if Prog == "Sim":
+         outfile.write(Indent+"   if (IpcSelected(I,"+Id+","+",".join(IdxArgs)+")) {\n")
+         outfile.write(Indent+"      IpcPutHdr("+Id+","+",".join(IdxArgs)+");\n")
+         outfile.write(Indent+"      "+Put+"("+Arg+","+str(Ni*Nj)+");\n")
+         outfile.write(Indent+"   }\n")
+      else:
+         outfile.write(Indent+"   IpcPutHdr("+Id+","+",".join(IdxArgs)+");\n")
+         outfile.write(Indent+"   "+Put+"("+Arg+","+str(Ni*Nj)+");\n")
+      #endif
+
+########################################################################
+def BinReadCodeBlock(Indent,FmtPrefix,ArrayIdx,ArgPrefix,ArgString,VarString,Ni,Nj,StructIdxString):
+
+      global Prog, outfile, BinGuard, BinCaseIds
+
+      Id = FieldId[FmtPrefix+VarString]
+      if Id in BinCaseIds:
+         return
+      #endif
+      BinCaseIds.add(Id)
+
+      Indent = "               "
+      IdxNames = [ArrayIdx]+[x.lstrip("&") for x in StructIdxString.split(",")[1:]]
+      if Nj > 1:
+         Dst = "&"+ArgPrefix+VarString+"[0][0]"
+      elif Ni > 1:
+         Dst = ArgPrefix+VarString
+      else:
+         Dst = "&"+ArgPrefix+VarString
+      #endif
+
+      outfile.write("            case "+str(Id)+": /* "+FmtPrefix+VarString+" */\n")
+      for k in range(0,len(IdxNames)):
+         outfile.write(Indent+IdxNames[k]+" = Idx["+str(k)+"];\n")
+      #next k
+      Guard = []
+      if Prog == "App":
+         Guard.append("Isc == AC->ID")
+      #endif
+      if BinGuard != "":
+         Guard.append(BinGuard)
+      #endif
+      if len(Guard) > 0:
+         outfile.write(Indent+"if ("+" && ".join(Guard)+") {\n")
+         Indent += "   "
+      #endif
+      if ArgString == "LongVal":
+         outfile.write(Indent+"IpcGetLong("+Dst+",Val,"+str(Ni*Nj)+");\n")
+      else:
+         outfile.write(Indent+"memcpy("+Dst+",Val,"+str(8*Ni*Nj)+");\n")
+      #endif
+      if ArgPrefix.startswith("SC") and ArgPrefix.count("AC") == 0:
+         outfile.write(Indent+"SC[Isc].RequestStateRefresh = 1;\n")
+      #endif
+      if len(Guard) > 0:
+         Indent = Indent[0:-3]
+         outfile.write(Indent+"}\n")
+      #endif
+      outfile.write(Indent+"break;\n\n")
+
+########################################################################
+# The prologs declare every index the table might need.  Drop the ones a
+# generated function never uses, so the output compiles without warnings.
+def DropUnusedIndexLocals(FileName):
+
+      Decl = "      long Isc,Iorb,Iw,i;\n"
+      Sep = "/**********************************************************************/\n"
+      f = open(FileName)
+      Funcs = f.read().split(Sep)
+      f.close()
+      for k in range(0,len(Funcs)):
+         if Decl not in Funcs[k]:
+            continue
+         #endif
+         Body = Funcs[k].replace(Decl,"",1)
+         Code = re.sub(r'/\*.*?\*/|"(\\.|[^"\\])*"',"",Body,flags=re.S)
+         Used = [x for x in ["Isc","Iorb","Iw","i"] if re.search(r'\b'+x+r'\b',Code)]
+         if len(Used) > 0:
+            Funcs[k] = Funcs[k].replace(Decl,"      long "+",".join(Used)+";\n",1)
+         else:
+            Funcs[k] = Body
+         #endif
+      #next k
+      f = open(FileName,"w")
+      f.write(Sep.join(Funcs))
+      f.close()
+
 ########################################################################
 def main():
 
-      global Prog, Verb, Pipe, outfile, EchoString, ParmPass
+      global Prog, Verb, Pipe, outfile, EchoString, ParmPass, BinGuard
       
       ProgList = {"Sim","App"}
       VerbList = {"WriteTo","ReadFrom"}
-      PipeList = {"Socket","Gmsec","File","Cmd"}
+      PipeList = {"Socket","Gmsec","File","Cmd","BinSocket"}
       
       infile = open('42.json')
       StructDict = json.load(infile)
       infile.close()
+
+      BuildFieldTable(StructDict["Table Definition"])
       
       for Prog in ProgList:
       
@@ -665,7 +1288,13 @@ def main():
             
                   outfile = open("TempIpc.c","w")      
             
-                  if Verb == "WriteTo":
+                  if Pipe == "BinSocket":
+                     if Verb == "WriteTo":
+                        BinWriteProlog()
+                     else:
+                        BinReadProlog()
+                     #endif
+                  elif Verb == "WriteTo":
                      WriteProlog()
                   elif Verb == "ReadFrom":
                      ReadProlog()
@@ -727,6 +1356,8 @@ def main():
                                     outfile.write(Indent+"   if (SC[Isc].Exists) {\n")
                                     outfile.write(Indent+"      if (SC[Isc].AC.ParmLoadEnabled) {\n")
                                     #endif
+                                 elif Pipe == "BinSocket":
+                                    BinGuard = "SC[Isc].AC.ParmDumpEnabled"
                                  else:
                                     Indent = "         "
                                     outfile.write(Indent+"for(Isc=0;Isc<Nsc;Isc++) {\n")
@@ -735,7 +1366,9 @@ def main():
                                     Indent += "   "
                                  #endif
                                  ParseStruct(StructList,Struct,Indent+"      ","SC[%ld].AC.","Isc","SC[Isc].AC.","",1) 
-                                 if Verb == "WriteTo":
+                                 if Pipe == "BinSocket" and Verb == "ReadFrom":
+                                    BinGuard = ""
+                                 elif Verb == "WriteTo":
                                     outfile.write(Indent+"      }\n")
                                     outfile.write(Indent+"   }\n")
                                     outfile.write(Indent+"}\n\n")
@@ -754,12 +1387,16 @@ def main():
                                     Indent = "   "
                                     outfile.write(Indent+"   if (AC->ParmDumpEnabled) {\n")
                                     #endif
+                                 elif Pipe == "BinSocket":
+                                    BinGuard = "AC->ParmLoadEnabled"
                                  else:
                                     Indent = "         "
                                     outfile.write(Indent+"if (AC->ParmLoadEnabled) {\n")
                                  #endif
                                  ParseStruct(StructList,Struct,Indent+"   ","SC[%ld].AC.","Isc","AC->","",1) 
-                                 if Verb == "WriteTo":
+                                 if Pipe == "BinSocket" and Verb == "ReadFrom":
+                                    BinGuard = ""
+                                 elif Verb == "WriteTo":
                                     outfile.write(Indent+"   }\n\n")
                                  else:
                                     outfile.write(Indent+"}\n\n")
@@ -778,7 +1415,19 @@ def main():
                      #next Struct
                   #next ParmPass
                
-                  if Verb == "WriteTo":
+                  if Pipe == "BinSocket":
+                     if Verb == "WriteTo":
+                        BinWriteEpilog()
+                     else:
+                        BinReadEpilog()
+                        TimeRefreshCode()
+                        if Prog == "Sim":
+                           StateRefreshCode()
+                        #endif
+                        outfile.write("}\n")
+                        BinReadTransports()
+                     #endif
+                  elif Verb == "WriteTo":
                      WriteEpilog() 
                   elif Verb == "ReadFrom":
                      ReadEpilog()
@@ -796,6 +1445,9 @@ def main():
                   infile.close()
                   outfile.close()
                   os.remove("TempIpc.c")      
+                  if Pipe == "BinSocket":
+                     DropUnusedIndexLocals("../Source/IPC/"+Prog+Verb+Pipe+".c")
+                  #endif
                       
                #endif                
             #next Pipe
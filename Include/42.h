@@ -11,11 +11,12 @@
 
 /*    All Other Rights Reserved.                                      */
 
-/* Disable extern keyword to declare globals */
+/* Disable extern keyword to declare globals.  Sim globals are SIMLOCAL, */
+/* so a _REENTRANT_SIM_ build gives each case thread its own copy.       */
 #ifdef DECLARE_GLOBALS
-#define EXTERN
+#define EXTERN SIMLOCAL
 #else
-#define EXTERN extern
+#define EXTERN extern SIMLOCAL
 #endif
 
 #include <math.h>
@@ -76,6 +77,8 @@ EXTERN double Pi, TwoPi, HalfPi, SqrtTwo, SqrtHalf, A2R, R2A, GoldenRatio;
 EXTERN long TimeMode; /* FAST_TIME, REAL_TIME, EXTERNAL_SYNCH, NOS3_TIME */
 EXTERN double SimTime, STOPTIME, DTSIM, DTOUT, DTOUTGL;
 EXTERN long OutFlag, GLOutFlag, GLEnable, CleanUpFlag;
+EXTERN long Nthreads;     /* Threads for per-SC updates, polyhedron gravity */
+EXTERN long OutputFormat; /* OUTPUT_TEXT and/or OUTPUT_BINARY */
 
 /* Making global parameters for updated JPL EPHEM methods */
 EXTERN double EMRAT;  /* Earth/Moon Mass Ratio */
@@ -90,7 +93,11 @@ EXTERN long AeroShadowsActive;
 EXTERN long GGActive;
 EXTERN long SolPressActive;
 EXTERN long SolPressShadowsActive;
+EXTERN double ShadowTableStep; /* deg, 0 to clip shadows every step */
 EXTERN long GravPertActive;
+EXTERN long PolyGravDegree;     /* 0 to sum the polyhedron everywhere */
+EXTERN double PolyGravFarRatio; /* of Brillouin radius */
+EXTERN double PolyGravNearTol;  /* 0 to sum the polyhedron near the body */
 EXTERN long ThrusterPlumesActive;
 EXTERN long ResidualDipoleActive;
 EXTERN long ContactActive;
@@ -117,6 +124,7 @@ EXTERN double GpsSecond;
 /* Parameters for environmental models  */
 EXTERN long AtmoOption; /* TWOSIGMA_ATMO, NOMINAL_ATMO, USER_ATMO */
 EXTERN double Flux10p7, GeomagIndex;
+EXTERN struct AtmoTableType AtmoTable; /* Tabulated NRLMSISE00 density */
 EXTERN double
     SchattenTable[5][1009]; /* JD, +2sig F10.7, Nom F10.7, +2sig Kp, Nom Kp */
 
@@ -180,6 +188,9 @@ EXTERN double AssembleTime, LockTime, TriangleTime, SubstTime, SolveTime;
 
 EXTERN struct ConstellationType Constell[89];
 
+void GravPertStages(void);
+long GravStageIsTabled(double RKFdt, long OrbCenter);
+void ShutdownGravPertStages(void);
 void GravPertForceRK4(struct SCType *S, double u[6], double FrcN[3],
                       double RKFdt);
 void ThirdBodyGravForce(double p[3], double s[3], double mu, double mass,
@@ -191,18 +202,24 @@ void Rk4SpiceEphems(double JD, long trgtWORLD, double trgtPosN[3],
                     double trgtPosH[3], double *trgtPriMerAng,
                     double trgtCNH[3][3]);
 
-long SimStep(void);
+long SimStep(struct SimContextType *Ctx);
 void Ephemerides(void);
 void OrbitMotion(double Time);
+void SpaceWeather(void);
+void ShutdownAtmoTable(void);
 void Environment(struct SCType *S);
+void FindContactCandidates(void);
 void Perturbations(struct SCType *S);
 void Sensors(struct SCType *S);
 void SensorDriver(struct SCType *S);
 void FlightSoftWare(struct SCType *S);
 void ActuatorDriver(struct SCType *S);
 void Actuators(struct SCType *S);
-void CmdInterpreter(void);
+void CmdInterpreter(struct SimContextType *Ctx);
 void Report(void);
+void ShutdownReport(void);
+long ReportChannelIndex(const char *Name);
+const double *ReportChannelValues(void);
 void DrawScene(void);
 void ThreeBodyOrbitRK4(struct OrbitType *O);
 void MotionConstraints(struct SCType *S);
@@ -213,6 +230,7 @@ void MapStateVectorToBodyStates(double *u, double *x, double *h, double *a,
 void BodyStatesToNodeStates(struct SCType *S);
 void PartitionForces(struct SCType *S);
 void Dynamics(struct SCType *S);
+double NBodyOrbitStep(struct SCType *S);
 void Cleanup(void);
 void FindInterBodyDCMs(struct SCType *S);
 void FindPathVectors(struct SCType *S);
@@ -220,6 +238,9 @@ void FindTotalAngMom(struct SCType *S);
 double FindTotalKineticEnergy(struct SCType *S);
 void UpdateScBoundingBox(struct SCType *S);
 void FindUnshadedAreas(struct SCType *S, double DirVecN[3]);
+void InitShadowLut(struct SCType *S);
+void FreeSilArena(struct SilArenaType *A);
+void ShutdownShadowLut(void);
 void RadBelt(float RadiusKm, float MagLatDeg, int NumEnergies,
              float *ElectronEnergy, float *ProtonEnergy, double **Flux);
 void InitAlbedo(void);
@@ -242,10 +263,19 @@ void EchoEOM(double **COEF, double *State, double *RHS, long Ns);
 void EchoStates(int Nx, double *x, int Nu, double *u);
 void EchoRemAcc(struct SCType *S);
 
-void InitSim(int argc, char **argv);
+void InitSimContext(struct SimContextType *Ctx);
+void InitSim(struct SimContextType *Ctx, int argc, char **argv);
+/* Initialize and run one case to completion on the calling thread */
+int RunSimCase(struct SimContextType *Ctx, int argc, char **argv);
+/* Run the Monte Carlo campaign described in FileName */
+int RunMonteCarlo(int argc, char **argv, const char *FileName);
+void SampleMonteCarlo(void);
+void InitScThreads(void);
+void ShutdownScThreads(void);
 void InitOrbits(void);
 void InitSpacecraft(struct SCType *S);
 void LoadPlanets(void);
+void ShutdownMinorBodies(void);
 /* Load defined SPICE kernels from Model/spice_kernels/kernels.txt */
 long LoadSpiceKernels(char SpicePath[80]);
 /* Update celestial body locations at TT.JulDay using SPICE*/
@@ -265,6 +295,7 @@ long DecodeString(char *s);
 void InitFSW(struct SCType *S);
 void InitAC(struct SCType *S);
 void InitDSM(struct SCType *S);
+void ShutdownDSM(struct SCType *S);
 void InitLagrangePoints(void);
 /* Updates Lagrange System constants based on updated/variable orbit ephems */
 void UpdateLagrangePoints(void);
@@ -283,6 +314,9 @@ void NOS3Time(long *year, long *day_of_year, long *month, long *day, long *hour,
 
 void InterProcessComm(void);
 void InitInterProcessComm(void);
+void ShutdownInterProcessComm(void);
+void WriteToLink(struct IpcType *I);
+void ReadFromLink(struct IpcType *I);
 
 #undef EXTERN
 
@@ -19,4 +19,17 @@
 #define SQRTTWO        M_SQRT2
 #define SQRTHALF       M_SQRT1_2
 #define GOLDENRATIO    (1.6180339887498948482)
-#define SPEED_OF_LIGHT (299792458.0)
\ No newline at end of file
+#define SPEED_OF_LIGHT (299792458.0)
+
+/* Storage class for state owned by a single simulation case.  Building */
+/* with _REENTRANT_SIM_ gives each thread its own copy, so independent  */
+/* cases may run side by side in one process (see SimContextType).    */
+/* Per-call scratch that SC updated on different threads of one case   */
+/* would otherwise share is declared static _Thread_local instead.     */
+#ifndef SIMLOCAL
+#ifdef _REENTRANT_SIM_
+#define SIMLOCAL _Thread_local
+#else
+#define SIMLOCAL
+#endif
+#endif
@@ -129,6 +129,17 @@
 #define Y_AXIS 1
 #define Z_AXIS 2
 
+/* Random stream kinds, see InitRandomStream */
+#define RAND_ACCEL      1
+#define RAND_GYRO       2
+#define RAND_MAG        3
+#define RAND_FSS        4
+#define RAND_ST         5
+#define RAND_GPS        6
+#define RAND_FGS        7
+#define RAND_SHAKER     8
+#define RAND_DISPERSION 9
+
 #define POS_X 0
 #define POS_Y 1
 #define POS_Z 2
@@ -189,6 +200,13 @@
 #define ORBDOF_ENCKE      2
 #define ORBDOF_COWELL     3
 
+/* Orbit Integrators */
+#define ORBINT_RK4   0
+#define ORBINT_RKF78 1
+
+/* Values per direction in a self-shadowing table (see ShadowLutType) */
+#define SHADOW_LUT_NVAL 10
+
 #define EPH_MEAN    0
 #define EPH_DE430   1
 #define EPH_DE440   2
@@ -215,6 +233,10 @@
 #define EXTERNAL_TIME 2
 #define NOS3_TIME     3
 
+/* Report Output Formats, may be or'd */
+#define OUTPUT_TEXT   1
+#define OUTPUT_BINARY 2
+
 /* World Types */
 #define SUN      0
 #define PLANET   1
@@ -259,6 +281,7 @@
 #define IPC_SERVER       0
 #define IPC_CLIENT       1
 #define IPC_GMSEC_CLIENT 2
+#define IPC_SHM          3
 
 /* Secs from J2000 to the Unix epoch of 1 Jan 1970 */
 #define UNIX_EPOCH (-946728000.0)
@@ -30,6 +30,9 @@ EXTERN GLFWwindow *MapWindow;
 EXTERN GLFWwindow *OrreryWindow;
 EXTERN GLFWwindow *SphereWindow;
 
+/* Case stepped from the GUI event loop */
+EXTERN struct SimContextType *GuiSimCtx;
+
 /*
 ** #ifdef __cplusplus
 ** }
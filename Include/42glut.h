@@ -30,6 +30,9 @@ EXTERN GLuint MapWindow;
 EXTERN GLuint OrreryWindow;
 EXTERN GLuint SphereWindow;
 
+/* Case stepped from the GUI event loop */
+EXTERN struct SimContextType *GuiSimCtx;
+
 /*
 ** #ifdef __cplusplus
 ** }
@@ -51,6 +51,27 @@ struct SphereHarmType {
    double **C;
    double **S;
    double r_ref;
+   double EpochDT; /* IGRF coefficient cache interval, sec */
+   /* For SphereHarmGrav, indexed [m][n] so it walks memory in order */
+   double **HFa; /* Recursion coefficients, (M+2)x(N+1) */
+   double **HFb;
+   double **HFe;
+   double *HFs; /* Sectorial factors, M+2 */
+   double **HFC; /* C and S transposed, (M+1)x(N+1) */
+   double **HFS;
+};
+
+struct AtmoTableType {
+   /*~ Internal Variables ~*/
+   long Enabled;
+   double UpdateDT;         /* Time between grid epochs, sec */
+   double MinAlt, MaxAlt;   /* Altitude span of grid, m */
+   long Nlat, Nlst, Nalt;   /* Nodes in geodetic lat, local solar time, alt */
+   double DLat, DLst, DAlt; /* Node spacing: rad, hr, m */
+   double FluxTol, ApTol;   /* Rebuild when F10.7, Ap stray this far */
+   /* Lookup vs NRLMSISE00 at SC positions */
+   double MaxRelErr, RmsRelErr;
+   long Ncheck;
 };
 
 struct FormationType {
@@ -88,7 +109,7 @@ struct ShakerType {
    double *ToneAmp;   /* N or Nm */
    double *ToneFreq;  /* For tonic, rad/sec */
    double *TonePhase; /* For tonic, rad */
-   struct RandomProcessType *RandomProc;
+   struct RandomStreamType Rng;
    struct FilterType *Lowpass;
    struct FilterType *Highpass;
    double LowBandLimit;  /* rad/sec */
@@ -124,6 +145,7 @@ struct BodyType {
    char FlexFileName[40];
    float ModelMatrix[16]; /* For OpenGL */
    long GeomTag;
+   long RgnHitPoly; /* Warm start for Region contact search */
    /* For KaneNBody Dynamics */
    long Gin;         /* Joint that B is Bout of */
    double beta[3];   /* Vector from B ref pt to B[0] ref pt, expressed in N */
@@ -148,6 +170,11 @@ struct BodyType {
 
    double AccU[6];
 
+   /* Shadowing results for each poly of Geom[GeomTag], written by */
+   /* FindUnshadedAreas.  Kept per body since SC may share a Geom. */
+   double *UnshadedArea; /* Npoly */
+   double **UnshadedCtr; /* 3 x Npoly, expressed in B */
+
    /* For Flex Formulation */
    long Nf;                /* Number of flex modes superimposed on this body */
    double *xi;             /* Flex speed coordinate, Nf x 1 */
@@ -402,6 +429,7 @@ struct GyroType {
    double Bias;     /* rad/sec */
    double Angle;    /* rad */
    double MeasRate; /* rad/sec */
+   struct RandomStreamType Rng;
 };
 
 struct MagnetometerType {
@@ -418,6 +446,7 @@ struct MagnetometerType {
    /*~ Internal Variables ~*/
    long SampleCounter;
    double Field; /* Magfield Component, Tesla */
+   struct RandomStreamType Rng;
 };
 
 struct CssType {
@@ -464,6 +493,7 @@ struct FssType {
    double AlbB;
    double AlbC;
    double AlbD;
+   struct RandomStreamType Rng;
 };
 
 struct StarTrackerType {
@@ -490,6 +520,7 @@ struct StarTrackerType {
    long SampleCounter;
    long Valid;
    double qn[4];
+   struct RandomStreamType Rng;
 };
 
 struct GpsType {
@@ -513,6 +544,7 @@ struct GpsType {
    double VelW[3];
    double Lng, Lat, Alt;          /* Geocentric */
    double WgsLng, WgsLat, WgsAlt; /* Geodetic, WGS-84 */
+   struct RandomStreamType Rng;
 };
 
 struct AccelType {
@@ -539,6 +571,7 @@ struct AccelType {
    double MaxAcc;  /* m/s^2 max acceleration */
    double AccError;
    long Counts;
+   struct RandomStreamType Rng;
 
    /* Coef */
    double BiasStabCoef;
@@ -615,6 +648,7 @@ struct FgsType {
 
    struct PsfType PSF;
    struct GuideWindowType Gw;
+   struct RandomStreamType Rng;
 };
 
 struct JointPathTableType { /* tells if joint is in path of body*/
@@ -644,6 +678,7 @@ struct DynType {
    double *BodyFrc;                            /* 3*Nb x 1 */
    double **COEF;                              /* (Nu+Nf) x (Nu+Nf) */
    double *RHS;                                /* (Nu+Nf) x 1 */
+   double *LDLd;                               /* (Nu+Nf) x 1, D of COEF */
    long SomeJointsLocked;                      /* 1 if any DOFs are locked */
    long Ns;             /* Number of active states (joint + flex), <= (Nu+Nf) */
    double *ActiveState; /* u and uf concatenated, (Nu+Nf) x 1 */
@@ -659,6 +694,8 @@ struct DynType {
    double **PVelf;                 /* 3*Nb x Nf */
    double **mPVelf;                /* 3*Nb x Nf */
    double **Mf;                    /* Nf x Nf */
+   double **MfL;                   /* B[0].Mf = L*D*L^T, Nf x Nf */
+   double *MfD;                    /* B[0].Nf x 1 */
    double **PCPVelf;               /* Nf x Nf */
    double **HplusQetaPAngVelf;     /* Nf x Nf */
    double *uf, *uuf, *duf, *ufdot; /* Nf (Dynamic Flex States) */
@@ -675,6 +712,27 @@ struct DynType {
    double *GenConstraintFrc; /* Nc x 1 */
 };
 
+struct OrbIntType {
+   /*~ Internal Variables ~*/
+   long Method;  /* ORBINT_RK4, ORBINT_RKF78 */
+   double Tol;   /* Allowed error per step, relative */
+   long Active;  /* Step [t0,t1] is current */
+   double h;     /* Next trial step, sec */
+   double t0;    /* Step start, DynTime, sec */
+   double t1;    /* Step end, DynTime, sec */
+   double u0[6]; /* Translational state at t0 and t1 */
+   double u1[6];
+   double f0[6]; /* State derivatives at t0 and t1 */
+   double f1[6];
+   double j0[3]; /* Jerk at t0 and t1, m/s^3 */
+   double j1[3];
+   double Acc[3];  /* Perturbing accel held over the step, m/s^2 */
+   double DelV[3]; /* Held accel error, applied at next step, m/s */
+   double uOut[6]; /* Last sample handed back, to spot outside changes */
+   long Nstep;     /* Accepted steps */
+   long Nfev;      /* EOM evaluations */
+};
+
 struct EnvTrqType {
    /*~ Internal Variables ~*/
    long First;
@@ -682,6 +740,39 @@ struct EnvTrqType {
    double Hs[3];
 };
 
+/* Scratch for FindUnshadedAreas.  Buffers only grow, and each SC has */
+/* its own, so shadowing allocates nothing once warmed up and may run */
+/* on several SC at once.                                             */
+struct SilArenaType {
+   long EdgeCap;
+   long HashCap;
+   long VtxCap;
+   long ClipCap[2];
+   struct SilEdgeType *Edge;
+   long *Order; /* Sequence position -> Edge */
+   long *Pos;   /* Edge -> sequence position */
+   long *Next;  /* Hash chain */
+   long *Match;
+   long *Head; /* HashCap buckets, keyed on (Body, Iv1) */
+   struct SilVtxType *Vtx;
+   double *Pu; /* Vtx projected normal to DirVec */
+   double *Pv;
+   struct SilVtxType *Clip[2]; /* Ping-pong clipper output */
+};
+
+/* Self-shadowing of a single-body SC, tabulated over body-frame      */
+/* direction on an az/el grid.  Each node holds SHADOW_LUT_NVAL sums: */
+/* projected unshaded area, sum of area*centroid (3), and SRP force   */
+/* (3) and torque about the body origin (3) at unit solar pressure.   */
+struct ShadowLutType {
+   long GeomTag;
+   long Naz; /* Azimuth wraps at 2*pi */
+   long Nel; /* Elevation nodes include both poles */
+   double dAz;
+   double dEl;
+   double *Val; /* SHADOW_LUT_NVAL x Naz x Nel, azimuth fastest */
+};
+
 struct SCType {
    /*~ Internal Variables ~*/
    long ID; /* SC[x].ID = x */
@@ -694,6 +785,12 @@ struct SCType {
    double FswSampleTime;
    long FswMaxCounter;
    long FswSampleCounter;
+   double OrbSampleTime; /* Orbit step, multiple of DTSIM */
+   long OrbMaxCounter;
+   long OrbSampleCounter;
+   double EnvSampleTime; /* Mag field, density update, multiple of DTSIM */
+   long EnvMaxCounter;
+   long EnvSampleCounter;
    long InitAC;
    long InitDSM;
 
@@ -776,10 +873,15 @@ struct SCType {
    long WhlJitterActive;
    /* Workspace for KaneNBody */
    struct DynType Dyn;
+   /* Workspace for adaptive orbit integration */
+   struct OrbIntType OrbInt;
    /* Workspace for Actuator Sizing */
    struct EnvTrqType EnvTrq;
    /* Bounding Box used for shadowmap */
    struct BoundingBoxType BBox;
+   /* Tabulated self-shadowing, NULL if found every step */
+   struct ShadowLutType *ShadowLut;
+   struct SilArenaType Sil;
    /* See ReadStatesFromSocket */
    long RequestStateRefresh;
 
@@ -919,6 +1021,9 @@ struct WorldType {
    double RingInner, RingOuter;
    double Density; /* For minor bodies, polyhedron gravity */
    struct SphereHarmType GravModel;
+   struct SphereHarmType PolyGravModel; /* Exterior fit to polyhedron */
+   double PolyGravFarRad;               /* Use PolyGravModel beyond, m */
+   struct PolyGravGridType *PolyGravGrid; /* Near-field table, or NULL */
 
    /* Graphical Properties */
    long HasRing;
@@ -1080,16 +1185,46 @@ struct ConstellationType {
 struct IpcType {
    long Init;
    long Mode;       /* OFF, TX, RX, TXRX, ACS, WRITEFILE, READFILE */
-   long SocketRole; /* SERVER, CLIENT, GMSEC_CLIENT */
+   long SocketRole; /* SERVER, CLIENT, GMSEC_CLIENT, SHM */
    long AcsID;      /* AC.ID for ACS mode */
    char HostName[40];
    long Port;
    long AllowBlocking;
    long EchoEnabled;
+   long Binary; /* Sockets use WriteToBinSocket/ReadFromBinSocket */
    SOCKET Socket;
+   struct ShmLinkType *Shm; /* SHM role: binary frames in shared memory */
    FILE *File;
    long Nprefix;
    char **Prefix;
+   long *FieldSel; /* Binary format: per-field prefix matches */
+};
+
+/* Executive state for one simulation case.  Together with the SIMLOCAL */
+/* globals, this is everything a case needs to be stepped independently */
+struct SimContextType {
+   /*~ Internal Variables ~*/
+   long Initialized; /* First pass of SimStep done */
+   double TotalRunTime;
+   /* Progress reporting */
+   long ProgressPercent;
+   long ProgressCtr;
+   double ProgressTime;
+   /* Output flags */
+   long iout;
+   long GLiout;
+   /* Time stepping */
+   long itime;
+   long PrevTick;
+   long CurrTick;
+   /* SC bounding box refresh */
+   long BBoxCtr;
+   /* Command script */
+   long CmdInit;
+   long CmdFileActive;
+   FILE *CmdFile;
+   char CmdLine[512];
+   double CmdTime;
 };
 
 /*
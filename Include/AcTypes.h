@@ -287,6 +287,7 @@ struct AcSpinnerCtrlType {
 struct AcMomBiasCtrlType {
    /*~ Internal Variables ~*/
    long Init;
+   double bvbold[3]; /* For Bdot */
 };
 
 struct AcThreeAxisCtrlType {
@@ -323,6 +324,11 @@ struct AcCmgCtrlType {
    double therr[3], werr[3];
    double Tcmd[3];
    double AngRateCmd[4];
+   double DitherPhase; /* For CMGLaw4x1DOF */
+   double MoveTime;
+   double RPYCmd[3];
+   double qrl[4];
+   long Idx;
 };
 
 struct AcThrCtrlType {
@@ -334,6 +340,10 @@ struct AcThrCtrlType {
 
    /*~ Internal Variables ~*/
    long Init;
+   double MoveTime;
+   double CRL[3][3];
+   double PosRL[3];
+   long Idx;
 };
 
 struct AcCfsCtrlType {
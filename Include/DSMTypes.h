@@ -96,6 +96,11 @@ enum batchType {
    TIME_BATCH,
 };
 
+enum updateType {
+   QR_UPDATE = 0,     // square-root update of the whole batch through hqrd
+   SEQUENTIAL_UPDATE, // one scalar update per row, needs diagonal N
+};
+
 enum originType {  // Start at -2 so Nav->refOriType >= 0 is the SC[#]
    ORI_WORLD = -2, // reference origin is celestial body
    ORI_OP,         // reference origin is orbit point
@@ -263,9 +268,12 @@ struct DSMMeasType {
 
    /*~ Internal Variables ~*/
    long sensorNum;
-   double *(*measFun)(struct AcType *const, struct DSMType *const, const long);
-   double **(*measJacobianFun)(struct AcType *const, struct DSMType *const,
-                               const long);
+   // Write the estimated measurement and its errDim x navDim jacobian into
+   // caller storage, so a filter step allocates nothing
+   void (*measFun)(struct AcType *const, struct DSMType *const, const long,
+                   double *);
+   void (*measJacobianFun)(struct AcType *const, struct DSMType *const,
+                           const long, double **);
    enum SensorType type;
    int dim;
    int errDim;
@@ -277,12 +285,33 @@ struct DSMMeasType {
    struct DSMMeasType *nextMeas; // oh boy, a linked list
 };
 struct DSMMeasListType {
-   // TODO: add a tail maybe??
    struct DSMMeasType *head;
+   struct DSMMeasType *tail;
    long length;
    long measDim;
 };
 
+// Stacked measurement and update workspace for KalmanFilt. It grows to the
+// largest batch seen and is then reused, so steady-state steps allocate
+// nothing
+struct DSMKalmanWorkType {
+   long navDim;  // navDim the workspace is sized for
+   long measDim; // largest stacked measurement dimension it holds
+   double **H;   // measDim x navDim stacked jacobian
+   double **N;   // measDim x measDim stacked noise mapping
+   double *resid;
+   double *R;
+   double *est; // one sensor's estimated measurement
+   double **HS;
+   double **NR;
+   double **C;
+   double **Sz;
+   double **Uk;
+   double **K;
+   double **QR; // (navDim + measDim) x measDim
+   double **U;
+};
+
 struct DSMStateType {
    // TODO: A HASH TABLE WILL DO WHAT I WANT!!!!! to make this more configurable
    // if this were C++, this would be MUCH easier
@@ -322,6 +351,7 @@ struct DSMNavType {
 
    enum NavType type;
    enum batchType batching;
+   enum updateType update;
 
    // These need to be figured out still
    long refFrame;   // nav reference frame
@@ -392,6 +422,8 @@ struct DSMNavType {
    double **STMStep;  // STM for +1 CCSDS counts
    double **M;        // dynamics noise mapping matrix
    double *sqrQ;      // Diagonal elements of noise covariance
+   // EXPM_NWORK navDim x navDim work matrices for expmPade
+   double ***expmWork;
    void (*EOMJacobianFun)(struct AcType *const, struct DSMType *const,
                           const struct DateType *, double const[3][3],
                           double const[4], double const[3], double const[3],
@@ -415,6 +447,10 @@ struct DSMNavType {
 
    double **residuals[FIN_SENSOR + 1];
    long reportConfigured;
+
+   // Released measurements, kept by sensor type for CreateMeas to reuse
+   struct DSMMeasType *measPool[FIN_SENSOR + 1];
+   struct DSMKalmanWorkType kfWork;
 };
 
 struct DSMType {
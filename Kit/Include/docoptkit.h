@@ -12,6 +12,7 @@ typedef struct DocoptArgs {
    int help;
    int version;
    /* options with arguments */
+   char *campaign;
    char *defaultdir;
    char *graphics;
    char *indir;
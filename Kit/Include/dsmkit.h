@@ -34,20 +34,22 @@ extern "C" {
 void DSM_RelMotionToAngRate(double RelPosN[3], double RelVelN[3], double wn[3]);
 void DSM_WheelProcessing(struct AcType *AC);
 void DSM_MtbProcessing(struct AcType *AC);
-struct DSMMeasListType *DSM_GyroProcessing(struct AcType *const AC,
-                                           struct DSMType *const DSM);
-struct DSMMeasListType *DSM_MagnetometerProcessing(struct AcType *const AC,
-                                                   struct DSMType *const DSM);
-struct DSMMeasListType *DSM_CssProcessing(struct AcType *const AC,
-                                          struct DSMType *const DSM);
-struct DSMMeasListType *DSM_FssProcessing(struct AcType *const AC,
-                                          struct DSMType *const DSM);
-struct DSMMeasListType *DSM_StarTrackerProcessing(struct AcType *const AC,
-                                                  struct DSMType *const DSM);
-struct DSMMeasListType *DSM_GpsProcessing(struct AcType *const AC,
-                                          struct DSMType *const DSM);
-struct DSMMeasListType *DSM_AccelProcessing(struct AcType *const AC,
-                                            struct DSMType *const DSM);
+void DSM_GyroProcessing(struct AcType *const AC, struct DSMType *const DSM,
+                        struct DSMMeasListType *measList);
+void DSM_MagnetometerProcessing(struct AcType *const AC,
+                                struct DSMType *const DSM,
+                                struct DSMMeasListType *measList);
+void DSM_CssProcessing(struct AcType *const AC, struct DSMType *const DSM,
+                       struct DSMMeasListType *measList);
+void DSM_FssProcessing(struct AcType *const AC, struct DSMType *const DSM,
+                       struct DSMMeasListType *measList);
+void DSM_StarTrackerProcessing(struct AcType *const AC,
+                               struct DSMType *const DSM,
+                               struct DSMMeasListType *measList);
+void DSM_GpsProcessing(struct AcType *const AC, struct DSMType *const DSM,
+                       struct DSMMeasListType *measList);
+void DSM_AccelProcessing(struct AcType *const AC, struct DSMType *const DSM,
+                         struct DSMMeasListType *measList);
 void DSM_CommStateProcessing(struct DSMStateType *state,
                              struct DSMStateType *commState);
 
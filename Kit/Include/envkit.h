@@ -31,13 +31,23 @@
 ** #endif
 */
 
+void InitSphereHarmRecursion(struct SphereHarmType *SH);
+void DestroySphereHarmRecursion(struct SphereHarmType *SH);
+void SphereHarmGrav(const struct SphereHarmType *SH, const long N, const long M,
+                    const double r, const double trigs[4], const double Re,
+                    const double K, double gradV[3], double HV[3][3]);
 void SphericalHarmGravForce(const long N, const long M,
                             const struct WorldType *W, const double PriMerAng,
                             const double mass, const double pbn[3],
                             double FgeoN[3]);
 void IGRFMagField(const char *ModelPath, const struct DateType UTC,
-                  const long N, const long M, const double pbn[3],
-                  const double PriMerAng, double MagVecN[3]);
+                  const double EpochDT, const long N, const long M,
+                  const double pbn[3], const double PriMerAng,
+                  double MagVecN[3]);
+void IGRFMagFieldBatch(const char *ModelPath, const struct DateType UTC,
+                       const double EpochDT, const long N, const long M,
+                       const long Npos, double **PosN, const double PriMerAng,
+                       double **MagVecN);
 void DipoleMagField(double DipoleMoment, double DipoleAxis[3],
                     double DipoleOffset[3], double p[3], double PriMerAng,
                     double MagVecN[3]);
@@ -46,6 +56,9 @@ double JacchiaRoberts(double pbn[3], double svn[3], double F10p7, double Ap);
 double SimpleMSIS(double pbn[3], long Col);
 double NRLMSISE00(long Year, long DOY, long Hour, long Minute, double Second,
                   double PosW[3], double F10p7, double AP);
+void NRLMSISE00Batch(long Year, long DOY, long Hour, long Minute,
+                     double Second, long Npos, double **PosW, double F10p7,
+                     double AP, double *Density);
 double MarsAtmosphereModel(double r[3]);
 void SimpleEarthPrecNute(double JD, double C_TEME_TETE[3][3],
                          double C_TETE_J2000[3][3]);
@@ -53,10 +66,25 @@ void HiFiEarthPrecNute(double JD, double C_TEME_TETE[3][3],
                        double C_TETE_J2000[3][3]);
 void WGS84ToECEF(double glat, double glong, double alt, double p[3]);
 void ECEFToWGS84(double p[3], double *glat, double *glong, double *alt);
+void StartPolyhedronGravPool(long Nthread);
+void StopPolyhedronGravPool(void);
 long PolyhedronGravAcc(struct GeomType *G, double Density, double PosN[3],
                        double CWN[3][3], double GravAccN[3]);
 long PolyhedronGravGrad(struct GeomType *G, double Density, double PosN[3],
                         double CWN[3][3], double GravGradN[3][3]);
+double PolyhedronSphereHarm(struct GeomType *G, long N, double **C,
+                            double **S);
+void PolyhedronFarGravAcc(const struct SphereHarmType *SH, double mu,
+                          double PosN[3], double CWN[3][3],
+                          double GravAccN[3]);
+double PolyhedronFarFieldError(struct GeomType *G, double Density,
+                               const struct SphereHarmType *SH, double mu,
+                               double R);
+struct PolyGravGridType *CreatePolyGravGrid(struct GeomType *G, double Density,
+                                            double Tol, double Ratio);
+void DestroyPolyGravGrid(struct PolyGravGridType *Grid);
+void PolyGravGridAcc(struct PolyGravGridType *Grid, double PosN[3],
+                     double CWN[3][3], double GravAccN[3]);
 void GravGradTimesInertia(double g[3][3], double I[3][3], double GGxI[3]);
 
 /*
@@ -105,8 +105,9 @@ struct KalmanFilterType *CreateKalmanFilter(long Nx, long Nu, long Nw, long Nm);
 void PopulateKalmanFilterWorkspace(struct KalmanFilterType *KF);
 void KalmanFilterMeasUpdate(struct KalmanFilterType *KF, struct KFMeasType *M);
 void KalmanFilterTimeUpdate(struct KalmanFilterType *KF);
+/* DitherPhase is the caller's singularity-escape dither state */
 double CMGLaw4x1DOF(double Tcmd[3], double Axis[4][3], double Gim[4][3],
-                    double h[4], double AngRateCmd[4]);
+                    double h[4], double *DitherPhase, double AngRateCmd[4]);
 
 /*
 ** #ifdef __cplusplus
@@ -114,6 +114,23 @@ struct KDNodeType {
    struct KDNodeType *HighChild;
 };
 
+/* Surface force table, built once at load.  Structure-of-arrays over */
+/* all polys (same indexing as Poly[]) so the per-step aero and SRP    */
+/* sums stream through contiguous memory without touching PolyType.   */
+struct SurfTableType {
+   long N;     /* = Npoly */
+   double *Nx; /* Unit normal */
+   double *Ny;
+   double *Nz;
+   double *Area;
+   double *Cx; /* Centroid */
+   double *Cy;
+   double *Cz;
+   double *SpecFrac;
+   double *DiffFrac;
+   double *ForceMask; /* 1.0 if poly feels surface forces, 0.0 if SHADED */
+};
+
 struct GeomType {
    char ObjFileName[40];
    long Nmatl;
@@ -135,6 +152,7 @@ struct GeomType {
    int SeeThruListTag;
    struct OctreeType *Octree;
    struct KDNodeType *KDTree;
+   struct SurfTableType Surf;
 };
 
 /* Material Definitions used both in graphical output and for         */
@@ -172,6 +190,7 @@ struct MatlType *AddMtlLib(const char *PathName, const char *MtlLibName,
                            struct MatlType *OldMatl, long *Nmatl);
 void ScaleSpecDiffFrac(struct MatlType *Matl, long Nmatl);
 void SurfaceForceProps(struct GeomType *G);
+void BuildSurfTable(struct GeomType *G, const struct MatlType *Matl);
 void LoadKDTree(struct GeomType *G);
 long KDProjectRayOntoGeom(double Source[3], double DirVec[3],
                           struct GeomType *G, long *HitPoly,
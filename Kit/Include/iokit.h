@@ -34,6 +34,7 @@
 #ifdef _WIN32
 #include <winsock2.h>
 #else
+#include <sys/mman.h>
 #include <netdb.h>
 #include <netinet/in.h>
 #include <netinet/tcp.h>
@@ -64,16 +65,38 @@ long assignYAMLToBoolArray(const long n, struct fy_node *yamlSequence,
                            long dest[]);
 long getYAMLEulerAngles(struct fy_node *yamlEuler, double angles[3], long *seq);
 
+/* A scalar replaced as its YAML file is read.  Lets a Monte Carlo    */
+/* run disperse any input without rewriting files.                    */
+struct YamlOverrideType {
+   char File[64];  /* e.g. SC_Simple.yaml */
+   char Path[128]; /* e.g. /Attitude/Ang Vel/2 */
+   char Value[40];
+};
+void SetYamlOverrides(const struct YamlOverrideType *Ov, long Nov);
+
 FILE *FileOpen(const char *Path, const char *File, const char *CtrlCode);
 void ByteSwapDouble(double *A);
 int FileToString(const char *file_name, char **result_string,
                  size_t *string_len);
 double *PpmToPsf(const char *path, const char *filename, long *width,
                  long *height, long *BytesPerPixel);
+void *MapFile(const char *Path, const char *File, size_t *Size);
+void UnmapFile(void *Map, size_t Size);
+FILE *OpenTempFile(const char *Path, const char *File, char TmpName[1024]);
+long CommitTempFile(FILE *file, const char *TmpName, const char *Path,
+                    const char *File);
 
 SOCKET InitSocketServer(int Port, int AllowBlocking);
 SOCKET InitSocketClient(const char *hostname, int Port, int AllowBlocking);
 
+struct ShmLinkType;
+struct ShmLinkType *InitShmServer(int Port, int AllowBlocking);
+struct ShmLinkType *InitShmClient(int Port, int AllowBlocking);
+void ShmSend(struct ShmLinkType *L, const char *Msg, long Len);
+const char *ShmRecv(struct ShmLinkType *L, long *Len);
+void ShmRelease(struct ShmLinkType *L);
+void CloseShmLink(struct ShmLinkType *L);
+
 /*
 ** #ifdef __cplusplus
 ** }
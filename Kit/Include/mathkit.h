@@ -40,6 +40,9 @@
 #define MAX(x, y) ((x) < (y) ? (y) : (x))
 #endif
 
+/* Number of n x n work matrices taken by expmPade */
+#define EXPM_NWORK 7
+
 double signum(const double x);
 double sinc(const double x);
 void MxM(const double A[3][3], const double B[3][3], double C[3][3]);
@@ -79,6 +82,7 @@ void PerpBasis(const double A[3], double B[3], double C[3]);
 double fact(long const n);
 double oddfact(long const n);
 double factDfact(long const n, long const m);
+void LegendreNorm(const long N, const long M, double **Norm);
 void Legendre(const long N, const long M, const double x,
               double P[N + 1][M + 1], double sdP[N + 1][M + 1]);
 void SphericalHarmonics(const long N, const long M, const double r,
@@ -99,6 +103,8 @@ double **CreateMatrix(const long n, const long m);
 void DestroyMatrix(double **A);
 void LINSOLVE(double **A, double *x, double *b, const long n);
 void CholeskySolve(double **A, double *x, double *b, const long n);
+long LDLFactor(double **A, double *d, const long n);
+void LDLSolve(double **L, double *d, double *x, double *b, const long n);
 void ConjGradSolve(double **A, double *x, double *b, const long n,
                    const double errtol, const long maxiter);
 void Bairstow(long n, double *a, const double Tol, double *Real, double *Imag);
@@ -153,6 +159,7 @@ void hqrd(double **A, double **U, double **R, long const n, long const m);
 void bhqrd(double **A, double **U, double **R, long const n, long const m,
            long const bSize);
 
+void expmPade(double **A, double **e, long const n, double **W[EXPM_NWORK]);
 void expm(double **A, double **e, long const n);
 long isSignificant(int const m, int const n, double **A, double **B);
 void jacobiEValue(double **A, int const n, int const maxIter, double d[n]);
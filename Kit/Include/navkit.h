@@ -38,12 +38,12 @@ void DestroyMeas(struct DSMMeasType *meas);
 void push(struct DSMMeasListType *list, struct DSMMeasType *meas);
 struct DSMMeasType *pop_DSMMeas(struct DSMMeasListType *list);
 void DestroyMeasList(struct DSMMeasListType *list);
-struct DSMMeasType *swap_DSMMeas(struct DSMMeasType *ptr1,
-                                 struct DSMMeasType *ptr2);
-void bubbleSort(struct DSMMeasListType *list);
+void SortMeasList(struct DSMMeasListType *list);
 struct DSMMeasType *CreateMeas(struct DSMNavType *const Nav,
                                enum SensorType const type,
                                long const sensorNum);
+void ReleaseMeas(struct DSMNavType *const Nav, struct DSMMeasType *meas);
+void DestroyMeasPool(struct DSMNavType *const Nav);
 int comparator_DSMMeas(const void *v1, const void *v2);
 
 void updateNavCCSDS(ccsdsCoarse *sec, ccsdsFine *subsec, const double dSeconds);
@@ -61,43 +61,52 @@ void configureRefFrame(struct DSMNavType *const Nav,
                        const long reset);
 void getForceAndTorque(struct AcType *const AC, struct DSMNavType *const Nav,
                        double const CRB[3][3], double const *whlH);
+void StateTransitionMatrix(struct DSMNavType *const Nav, const double dt,
+                           double **STM);
 void PropagateNav(struct AcType *const AC, struct DSMType *const DSM,
                   const long dCCSDSSec, const long dCCSDSSubSec,
                   const long init);
+struct DSMKalmanWorkType *ReserveKalmanWork(struct DSMNavType *const Nav,
+                                            long const measDim);
+void DestroyKalmanWork(struct DSMNavType *const Nav);
+void QRMeasUpdate(struct DSMNavType *const Nav, const long measDim);
+long DiagonalMeasNoise(const struct DSMKalmanWorkType *W, const long measDim);
+void SequentialMeasUpdate(struct DSMNavType *const Nav, const long measDim);
+void MeasUpdate(struct DSMNavType *const Nav, const long measDim);
 void KalmanFilt(struct AcType *const AC, struct DSMType *const DSM);
 
 /*--------------------------------------------------------------------*/
 /*                       Measurement Jacobians                        */
 /*--------------------------------------------------------------------*/
-double **gyroJacobianFun(struct AcType *const AC, struct DSMType *const DSM,
-                         const long sensorNum);
-double **magJacobianFun(struct AcType *const AC, struct DSMType *const DSM,
-                        const long sensorNum);
-double **cssJacobianFun(struct AcType *const AC, struct DSMType *const DSM,
-                        const long sensorNum);
-double **fssJacobianFun(struct AcType *const AC, struct DSMType *const DSM,
-                        const long sensorNum);
-double **startrackJacobianFun(struct AcType *const AC,
-                              struct DSMType *const DSM, const long sensorNum);
-double **gpsJacobianFun(struct AcType *const AC, struct DSMType *const DSM,
-                        const long sensorNum);
-double **accelJacobianFun(struct AcType *const AC, struct DSMType *const DSM,
-                          const long sensorNum);
-
-double *gyroFun(struct AcType *const AC, struct DSMType *const DSM,
-                const long sensorNum);
-double *magFun(struct AcType *const AC, struct DSMType *const DSM,
-               const long sensorNum);
-double *cssFun(struct AcType *const AC, struct DSMType *const DSM,
-               const long sensorNum);
-double *fssFun(struct AcType *const AC, struct DSMType *const DSM,
-               const long sensorNum);
-double *startrackFun(struct AcType *const AC, struct DSMType *const DSM,
-                     const long sensorNum);
-double *gpsFun(struct AcType *const AC, struct DSMType *const DSM,
-               const long sensorNum);
-double *accelFun(struct AcType *const AC, struct DSMType *const DSM,
-                 const long sensorNum);
+void gyroJacobianFun(struct AcType *const AC, struct DSMType *const DSM,
+                     const long sensorNum, double **jacobian);
+void magJacobianFun(struct AcType *const AC, struct DSMType *const DSM,
+                    const long sensorNum, double **jacobian);
+void cssJacobianFun(struct AcType *const AC, struct DSMType *const DSM,
+                    const long sensorNum, double **jacobian);
+void fssJacobianFun(struct AcType *const AC, struct DSMType *const DSM,
+                    const long sensorNum, double **jacobian);
+void startrackJacobianFun(struct AcType *const AC, struct DSMType *const DSM,
+                          const long sensorNum, double **jacobian);
+void gpsJacobianFun(struct AcType *const AC, struct DSMType *const DSM,
+                    const long sensorNum, double **jacobian);
+void accelJacobianFun(struct AcType *const AC, struct DSMType *const DSM,
+                      const long sensorNum, double **jacobian);
+
+void gyroFun(struct AcType *const AC, struct DSMType *const DSM,
+             const long sensorNum, double *est);
+void magFun(struct AcType *const AC, struct DSMType *const DSM,
+            const long sensorNum, double *est);
+void cssFun(struct AcType *const AC, struct DSMType *const DSM,
+            const long sensorNum, double *est);
+void fssFun(struct AcType *const AC, struct DSMType *const DSM,
+            const long sensorNum, double *est);
+void startrackFun(struct AcType *const AC, struct DSMType *const DSM,
+                  const long sensorNum, double *est);
+void gpsFun(struct AcType *const AC, struct DSMType *const DSM,
+            const long sensorNum, double *est);
+void accelFun(struct AcType *const AC, struct DSMType *const DSM,
+              const long sensorNum, double *est);
 
 /*--------------------------------------------------------------------*/
 /*                          RIEKF functions                           */
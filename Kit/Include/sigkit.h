@@ -15,6 +15,7 @@
 #define __SIGKIT_H__
 
 #include <math.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -35,6 +36,18 @@ struct RandomProcessType {
    double SavedValue;
 };
 
+/* Counter-based stream.  Sample n depends only on Key, Id and n, so */
+/* streams are independent of each other and of the order in which   */
+/* they are drawn, and Count is all the state there is to save.      */
+struct RandomStreamType {
+   uint32_t Key[2]; /* Seed */
+   uint32_t Id[2];  /* Which stream */
+   uint64_t Count;  /* Samples drawn so far */
+   /* Second half of a Gaussian pair; a cache, not state */
+   long HaveNext;
+   double Next;
+};
+
 struct FilterType {
    long Ns;
    double *A, *B, *x, *y;
@@ -52,6 +65,12 @@ struct RandomProcessType *CreateRandomProcess(long Seed);
 void DestroyRandomProcess(struct RandomProcessType *RP);
 double UniformRandom(struct RandomProcessType *RP);
 double GaussianRandom(struct RandomProcessType *RP);
+void Philox4x32(const uint32_t Ctr[4], const uint32_t Key[2], uint32_t Out[4]);
+void InitRandomStream(struct RandomStreamType *RS, long Seed, long Id0,
+                      long Id1, long Id2, long Id3);
+double UniformStream(struct RandomStreamType *RS);
+double GaussianStream(struct RandomStreamType *RS);
+void GaussianStreamVec(struct RandomStreamType *RS, double *Out, long N);
 double PRN2D(long x, long y);
 double PRN3D(long x, long y, long z);
 double Step(double a, double x);
@@ -20,6 +20,8 @@ const char help_message[] =
     "overrides --defaultdir\n"
     "  -g BOOL --graphics=BOOLEAN    Force enable (TRUE, 1) or disable (FALSE, "
     "0) graphics regardless of what is in the input file.\n"
+    "  -c FILE --campaign=FILE       Run the Monte Carlo campaign described "
+    "in FILE instead of a single case.\n"
     "\n"
     "";
 
@@ -218,6 +220,10 @@ int elems_to_args(Elements *elements, DocoptArgs *args, bool help)
       else if (!strcmp(option->olong, "--help")) {
          args->help = option->value;
       }
+      else if (!strcmp(option->olong, "--campaign")) {
+         if (option->argument)
+            args->campaign = option->argument;
+      }
       else if (!strcmp(option->olong, "--defaultdir")) {
          if (option->argument)
             args->defaultdir = option->argument;
@@ -256,7 +262,7 @@ int elems_to_args(Elements *elements, DocoptArgs *args, bool help)
 
 DocoptArgs docopt(int argc, char *argv[], bool help)
 {
-   DocoptArgs args = {0,    0,    NULL,          NULL,        NULL,
+   DocoptArgs args = {0,    0,    NULL,          NULL,        NULL, NULL,
                       NULL, NULL, usage_pattern, help_message};
    Tokens ts;
    Command commands[]   = {};
@@ -264,8 +270,9 @@ DocoptArgs docopt(int argc, char *argv[], bool help)
    Option options[]     = {
        {"-h", "--help", 0, 0, NULL},     {"-d", "--defaultdir", 1, 0, NULL},
        {"-g", "--graphics", 1, 0, NULL}, {"-i", "--indir", 1, 0, NULL},
-       {"-m", "--modeldir", 1, 0, NULL}, {"-o", "--outdir", 1, 0, NULL}};
-   Elements elements = {0, 0, 6, commands, arguments, options};
+       {"-m", "--modeldir", 1, 0, NULL}, {"-o", "--outdir", 1, 0, NULL},
+       {"-c", "--campaign", 1, 0, NULL}};
+   Elements elements = {0, 0, 7, commands, arguments, options};
 
    ts = tokens_new(argc, argv);
    if (parse_args(&ts, &elements))
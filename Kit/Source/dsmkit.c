@@ -46,13 +46,12 @@ void DSM_RelMotionToAngRate(double RelPosN[3], double RelVelN[3], double wn[3])
 /*  corresponding to the Sensor Models in 42sensors.c                 */
 /*  Note!  These are simple, sometimes naive.  Use with care.         */
 /**********************************************************************/
-struct DSMMeasListType *DSM_GyroProcessing(struct AcType *const AC,
-                                           struct DSMType *const DSM)
+void DSM_GyroProcessing(struct AcType *const AC, struct DSMType *const DSM,
+                        struct DSMMeasListType *measList)
 {
    struct AcGyroType *G;
    struct DSMNavType *Nav;
-   struct DSMMeasType *meas         = NULL;
-   struct DSMMeasListType *measList = NULL;
+   struct DSMMeasType *meas = NULL;
    long Ig, i, j;
 
    Nav = &DSM->DsmNav;
@@ -62,10 +61,6 @@ struct DSMMeasListType *DSM_GyroProcessing(struct AcType *const AC,
       for (Ig = 0; Ig < AC->Ngyro; Ig++) {
          G = &AC->Gyro[Ig];
          if (G->Valid == TRUE) {
-            if (measList == NULL) {
-               measList = malloc(sizeof(struct DSMMeasListType));
-               InitMeasList(measList);
-            }
             meas                  = CreateMeas(Nav, GYRO_SENSOR, Ig);
             meas->ccsdsSeconds    = Nav->ccsdsSeconds;
             meas->ccsdsSubseconds = Nav->ccsdsSubseconds;
@@ -113,17 +108,16 @@ struct DSMMeasListType *DSM_GyroProcessing(struct AcType *const AC,
          MxV(AtAi, Atb, AC->wbn);
       }
    }
-   return (measList);
 }
 /**********************************************************************/
-struct DSMMeasListType *DSM_MagnetometerProcessing(struct AcType *const AC,
-                                                   struct DSMType *const DSM)
+void DSM_MagnetometerProcessing(struct AcType *const AC,
+                                struct DSMType *const DSM,
+                                struct DSMMeasListType *measList)
 {
    struct AcMagnetometerType *M;
    struct DSMNavType *Nav;
-   struct DSMMeasType *meas         = NULL;
-   struct DSMMeasListType *measList = NULL;
-   const double T2mG                = 1.0e7; // tesla to milligauss
+   struct DSMMeasType *meas = NULL;
+   const double T2mG        = 1.0e7; // tesla to milligauss
    long Im, i, j;
 
    Nav = &DSM->DsmNav;
@@ -132,10 +126,6 @@ struct DSMMeasListType *DSM_MagnetometerProcessing(struct AcType *const AC,
       for (Im = 0; Im < AC->Nmag; Im++) {
          M = &AC->MAG[Im];
          if (M->Valid == TRUE) {
-            if (measList == NULL) {
-               measList = malloc(sizeof(struct DSMMeasListType));
-               InitMeasList(measList);
-            }
             meas                  = CreateMeas(Nav, MAG_SENSOR, Im);
             meas->ccsdsSeconds    = Nav->ccsdsSeconds;
             meas->ccsdsSubseconds = Nav->ccsdsSubseconds;
@@ -183,16 +173,14 @@ struct DSMMeasListType *DSM_MagnetometerProcessing(struct AcType *const AC,
          MxV(AtAi, Atb, AC->bvb);
       }
    }
-   return (measList);
 }
 /**********************************************************************/
-struct DSMMeasListType *DSM_CssProcessing(struct AcType *const AC,
-                                          struct DSMType *const DSM)
+void DSM_CssProcessing(struct AcType *const AC, struct DSMType *const DSM,
+                       struct DSMMeasListType *measList)
 {
    struct AcCssType *Css;
    struct DSMNavType *Nav;
-   struct DSMMeasType *meas         = NULL;
-   struct DSMMeasListType *measList = NULL;
+   struct DSMMeasType *meas = NULL;
    long Ic, i, j;
 
    Nav = &DSM->DsmNav;
@@ -201,10 +189,6 @@ struct DSMMeasListType *DSM_CssProcessing(struct AcType *const AC,
       for (Ic = 0; Ic < AC->Ncss; Ic++) {
          Css = &AC->CSS[Ic];
          if (Css->Valid == TRUE) {
-            if (measList == NULL) {
-               measList = malloc(sizeof(struct DSMMeasListType));
-               InitMeasList(measList);
-            }
             meas                  = CreateMeas(Nav, CSS_SENSOR, Ic);
             meas->ccsdsSeconds    = Nav->ccsdsSeconds;
             meas->ccsdsSubseconds = Nav->ccsdsSubseconds;
@@ -266,17 +250,15 @@ struct DSMMeasListType *DSM_CssProcessing(struct AcType *const AC,
             AC->svb[i] = InvalidSVB[i];
       }
    }
-   return (measList);
 }
 /******************************************************************************/
 /* This function assumes FSS FOVs don't overlap, and FSS overwrites CSS */
-struct DSMMeasListType *DSM_FssProcessing(struct AcType *const AC,
-                                          struct DSMType *const DSM)
+void DSM_FssProcessing(struct AcType *const AC, struct DSMType *const DSM,
+                       struct DSMMeasListType *measList)
 {
    struct AcFssType *FSS;
    struct DSMNavType *Nav;
-   struct DSMMeasType *meas         = NULL;
-   struct DSMMeasListType *measList = NULL;
+   struct DSMMeasType *meas = NULL;
    long Ifss, i;
 
    Nav = &DSM->DsmNav;
@@ -285,10 +267,6 @@ struct DSMMeasListType *DSM_FssProcessing(struct AcType *const AC,
       for (Ifss = 0; Ifss < AC->Nfss; Ifss++) {
          FSS = &AC->FSS[Ifss];
          if (FSS->Valid == TRUE) {
-            if (measList == NULL) {
-               measList = malloc(sizeof(struct DSMMeasListType));
-               InitMeasList(measList);
-            }
             AC->SunValid          = 1;
             meas                  = CreateMeas(Nav, FSS_SENSOR, Ifss);
             meas->ccsdsSeconds    = Nav->ccsdsSeconds;
@@ -334,17 +312,16 @@ struct DSMMeasListType *DSM_FssProcessing(struct AcType *const AC,
          }
       }
    }
-   return (measList);
 }
 /**********************************************************************/
 /* TODO: Weight measurements to reduce impact of "weak" axis */
-struct DSMMeasListType *DSM_StarTrackerProcessing(struct AcType *const AC,
-                                                  struct DSMType *const DSM)
+void DSM_StarTrackerProcessing(struct AcType *const AC,
+                               struct DSMType *const DSM,
+                               struct DSMMeasListType *measList)
 {
    struct AcStarTrackerType *ST;
    struct DSMNavType *Nav;
-   struct DSMMeasType *meas         = NULL;
-   struct DSMMeasListType *measList = NULL;
+   struct DSMMeasType *meas = NULL;
    long Ist, i;
 
    Nav = &DSM->DsmNav;
@@ -354,10 +331,6 @@ struct DSMMeasListType *DSM_StarTrackerProcessing(struct AcType *const AC,
       for (Ist = 0; Ist < AC->Nst; Ist++) {
          ST = &AC->ST[Ist];
          if (ST->Valid == TRUE) {
-            if (measList == NULL) {
-               measList = malloc(sizeof(struct DSMMeasListType));
-               InitMeasList(measList);
-            }
             meas                  = CreateMeas(Nav, STARTRACK_SENSOR, Ist);
             meas->ccsdsSeconds    = Nav->ccsdsSeconds;
             meas->ccsdsSubseconds = Nav->ccsdsSubseconds;
@@ -392,16 +365,14 @@ struct DSMMeasListType *DSM_StarTrackerProcessing(struct AcType *const AC,
          AC->qbn[3]  = 1.0;
       }
    }
-   return (measList);
 }
 /**********************************************************************/
-struct DSMMeasListType *DSM_GpsProcessing(struct AcType *const AC,
-                                          struct DSMType *const DSM)
+void DSM_GpsProcessing(struct AcType *const AC, struct DSMType *const DSM,
+                       struct DSMMeasListType *measList)
 {
    struct AcGpsType *G;
    struct DSMNavType *Nav;
-   struct DSMMeasType *meas         = NULL;
-   struct DSMMeasListType *measList = NULL;
+   struct DSMMeasType *meas = NULL;
    long Igps, i;
 
    Nav = &DSM->DsmNav;
@@ -412,10 +383,6 @@ struct DSMMeasListType *DSM_GpsProcessing(struct AcType *const AC,
          G = &AC->GPS[Igps];
          // AC->Time = gpsTime2J2000Sec(G->Sec, G->Week, G->Rollover);
          if (G->Valid == TRUE) {
-            if (measList == NULL) {
-               measList = malloc(sizeof(struct DSMMeasListType));
-               InitMeasList(measList);
-            }
             meas                  = CreateMeas(Nav, GPS_SENSOR, Igps);
             meas->ccsdsSeconds    = Nav->ccsdsSeconds;
             meas->ccsdsSubseconds = Nav->ccsdsSubseconds;
@@ -441,16 +408,14 @@ struct DSMMeasListType *DSM_GpsProcessing(struct AcType *const AC,
          AC->VelN[i] = AC->GPS[0].VelN[i];
       }
    }
-   return (measList);
 }
 /**********************************************************************/
-struct DSMMeasListType *DSM_AccelProcessing(struct AcType *const AC,
-                                            struct DSMType *const DSM)
+void DSM_AccelProcessing(struct AcType *const AC, struct DSMType *const DSM,
+                         struct DSMMeasListType *measList)
 {
    struct AcAccelType *Acc;
    struct DSMNavType *Nav;
-   struct DSMMeasType *meas         = NULL;
-   struct DSMMeasListType *measList = NULL;
+   struct DSMMeasType *meas = NULL;
    long Iacc;
 
    Nav = &DSM->DsmNav;
@@ -460,10 +425,6 @@ struct DSMMeasListType *DSM_AccelProcessing(struct AcType *const AC,
       for (Iacc = 0; Iacc < AC->Nst; Iacc++) {
          Acc = &AC->Accel[Iacc];
          if (Acc->Valid == TRUE) {
-            if (measList == NULL) {
-               measList = malloc(sizeof(struct DSMMeasListType));
-               InitMeasList(measList);
-            }
             meas                  = CreateMeas(Nav, ACCEL_SENSOR, Iacc);
             meas->ccsdsSeconds    = Nav->ccsdsSeconds;
             meas->ccsdsSubseconds = Nav->ccsdsSubseconds;
@@ -472,7 +433,6 @@ struct DSMMeasListType *DSM_AccelProcessing(struct AcType *const AC,
          }
       }
    }
-   return (measList);
 }
 /**********************************************************************/
 /*  End Sensor Processing Functions                                   */
@@ -13,12 +13,194 @@
 /*    All Other Rights Reserved.                                      */
 
 #include "envkit.h"
+#include <pthread.h>
+#include <string.h>
 
 /* #ifdef __cplusplus
 ** namespace Kit {
 ** #endif
 */
 
+/**********************************************************************/
+/*  Recursion coefficients for fully normalized Legendre functions,   */
+/*  after Holmes and Featherstone (J. Geodesy, 2002).  With           */
+/*  t = cos(theta), u = sin(theta) and Pbar[n][m] = u^m*Q[n][m],      */
+/*    Q[m][m] = HFs[m]*Q[m-1][m-1]                                    */
+/*    Q[n][m] = HFa[m][n]*t*Q[n-1][m] - HFb[m][n]*Q[n-2][m]           */
+/*    dPbar[n][m]/dtheta = m*t*u^(m-1)*Q[n][m]                        */
+/*                         - HFe[m][n]*u^(m+1)*Q[n][m+1]              */
+/*  The derivative needs order M+1, so the tables run to M+1.         */
+/*  C and S are copied order-major alongside.                         */
+void InitSphereHarmRecursion(struct SphereHarmType *SH)
+{
+   const long N = SH->N;
+   const long M = SH->M;
+   long n, m;
+
+   SH->HFa = CreateMatrix(M + 2, N + 1);
+   SH->HFb = CreateMatrix(M + 2, N + 1);
+   SH->HFe = CreateMatrix(M + 2, N + 1);
+   SH->HFs = (double *)calloc(M + 2, sizeof(double));
+   SH->HFC = CreateMatrix(M + 1, N + 1);
+   SH->HFS = CreateMatrix(M + 1, N + 1);
+
+   SH->HFs[0] = 1.0;
+   SH->HFs[1] = sqrt(3.0);
+   for (m = 2; m <= M + 1; m++)
+      SH->HFs[m] = sqrt((2.0 * m + 1.0) / (2.0 * m));
+
+   for (m = 0; m <= M + 1; m++) {
+      for (n = m + 1; n <= N; n++) {
+         SH->HFa[m][n] =
+             sqrt((2.0 * n - 1.0) * (2.0 * n + 1.0) / ((n - m) * (n + m)));
+         if (n >= m + 2)
+            SH->HFb[m][n] =
+                sqrt((2.0 * n + 1.0) * (n + m - 1.0) * (n - m - 1.0) /
+                     ((n - m) * (n + m) * (2.0 * n - 3.0)));
+      }
+   }
+   for (m = 0; m <= M; m++) {
+      for (n = m; n <= N; n++) {
+         SH->HFe[m][n] =
+             sqrt((n - m) * (n + m + 1.0) / (m == 0 ? 2.0 : 1.0));
+         SH->HFC[m][n] = SH->C[n][m];
+         SH->HFS[m][n] = SH->S[n][m];
+      }
+   }
+}
+/**********************************************************************/
+void DestroySphereHarmRecursion(struct SphereHarmType *SH)
+{
+   DestroyMatrix(SH->HFa);
+   DestroyMatrix(SH->HFb);
+   DestroyMatrix(SH->HFe);
+   free(SH->HFs);
+   DestroyMatrix(SH->HFC);
+   DestroyMatrix(SH->HFS);
+   SH->HFa = NULL;
+   SH->HFb = NULL;
+   SH->HFe = NULL;
+   SH->HFs = NULL;
+   SH->HFC = NULL;
+   SH->HFS = NULL;
+}
+/**********************************************************************/
+/*  Gradient, and optionally Hessian, of a fully normalized potential */
+/*  in the frame of SphericalHarmonics (r, theta positive south, phi  */
+/*  positive east).  Walks one order at a time through the            */
+/*  recursions set up by InitSphereHarmRecursion, holding only the    */
+/*  current and next columns, so no tables are built or zeroed per    */
+/*  call and high degree stays cheap.  Q carries no u^m, so it        */
+/*  doesn't underflow near the poles.  HV may be NULL.                */
+void SphereHarmGrav(const struct SphereHarmType *SH, const long N, const long M,
+                    const double r, const double trigs[4], const double Re,
+                    const double K, double gradV[3], double HV[3][3])
+{
+   double ColA[N + 1], ColB[N + 1];
+   double *Q = ColA, *Q1 = ColB, *Swap;
+   double dVdr = 0.0, dVdtheta = 0.0, dVdphis = 0.0;
+   double d2Vdr2 = 0.0, d2Vdphi2 = 0.0, d2Vdtheta2 = 0.0, d2Vdrdphi = 0.0,
+          d2Vdrdtheta = 0.0, d2Vdphidtheta = 0.0;
+   long n, m;
+
+   /* .. Order can't be greater than Degree */
+   if (M > N) {
+      fprintf(stderr, "Order %ld can't be greater than Degree %ld\n", M, N);
+      exit(EXIT_FAILURE);
+   }
+
+   const double t   = trigs[0];
+   const double u   = trigs[1];
+   const double rho = Re / r;
+
+   double cm = 1.0, sm = 0.0;  /* cos(m*phi), sin(m*phi) */
+   double um = 1.0, um1 = 0.0; /* u^m, u^(m-1) (unused at m = 0) */
+   double rhom = rho;          /* rho^(m+1) */
+
+   Q[0] = 1.0;
+   if (N >= 1)
+      Q[1] = SH->HFa[0][1] * t;
+   for (n = 2; n <= N; n++)
+      Q[n] = SH->HFa[0][n] * t * Q[n - 1] - SH->HFb[0][n] * Q[n - 2];
+
+   for (m = 0; m <= M; m++) {
+      const double *a  = SH->HFa[m + 1];
+      const double *b  = SH->HFb[m + 1];
+      const double *e  = SH->HFe[m];
+      const double *Cm = SH->HFC[m];
+      const double *Sm = SH->HFS[m];
+
+      /* .. Order m+1 column, for the theta derivative and the next pass */
+      if (m + 1 <= N) {
+         Q1[m + 1] = SH->HFs[m + 1] * Q[m];
+         if (m + 2 <= N)
+            Q1[m + 2] = a[m + 2] * t * Q1[m + 1];
+         for (n = m + 3; n <= N; n++)
+            Q1[n] = a[n] * t * Q1[n - 1] - b[n] * Q1[n - 2];
+      }
+
+      const long n0 = (m == 0 ? 1 : m);
+      double rn     = (m == 0 ? rhom * rho : rhom); /* rho^(n+1) */
+      for (n = n0; n <= N; n++) {
+         const double Pbar  = um * Q[n];
+         const double dPbar = m * t * um1 * Q[n] -
+                              (n > m ? e[n] * um * u * Q1[n] : 0.0);
+         const double CcSs  = (Cm[n] * cm + Sm[n] * sm) * rn;
+         const double ScCs  = (Sm[n] * cm - Cm[n] * sm) * rn;
+
+         dVdr     -= CcSs * ((n + 1) * Pbar);
+         dVdtheta += CcSs * dPbar;
+         dVdphis  += ScCs * (m * um1 * Q[n]);
+         if (HV != NULL) {
+            double tmp = (double)(n * (n + 1));
+            if (m != 0 && u != 0.0)
+               tmp -= (m * m) / (u * u);
+            tmp *= Pbar;
+            if (u != 0.0)
+               tmp += dPbar * t / u;
+            d2Vdr2        += CcSs * (Pbar * ((n + 1) * (n + 2)));
+            d2Vdtheta2    -= CcSs * tmp;
+            d2Vdphi2      -= CcSs * (Pbar * (m * m));
+            d2Vdrdtheta   -= CcSs * (dPbar * (n + 1));
+            d2Vdrdphi     -= ScCs * (Pbar * ((n + 1) * m));
+            d2Vdphidtheta += ScCs * (dPbar * m);
+         }
+         rn *= rho;
+      }
+
+      Swap = Q;
+      Q    = Q1;
+      Q1   = Swap;
+
+      const double cm1  = cm * trigs[2] - sm * trigs[3];
+      sm                = sm * trigs[2] + cm * trigs[3];
+      cm                = cm1;
+      um1               = um;
+      um               *= u;
+      rhom             *= rho;
+   }
+
+   gradV[0] = dVdr * K / r;
+   gradV[1] = dVdtheta * K / r;
+   gradV[2] = dVdphis * K / r;
+
+   if (HV != NULL) {
+      const double r2    = r * r;
+      const double rsth  = r * u;
+      const double rsth2 = rsth * rsth;
+      const double Kr    = K / r;
+
+      HV[0][0] = d2Vdr2 * Kr / r;
+      HV[1][1] = d2Vdtheta2 * K / r2;
+      HV[2][2] = d2Vdphi2 * K / rsth2;
+      HV[0][1] = d2Vdrdtheta * Kr / r;
+      HV[0][2] = d2Vdrdphi * Kr / rsth;
+      HV[1][2] = d2Vdphidtheta * K / (r * rsth);
+      HV[1][0] = HV[0][1];
+      HV[2][0] = HV[0][2];
+      HV[2][1] = HV[1][2];
+   }
+}
 /**********************************************************************/
 void SphericalHarmGravForce(const long N, const long M,
                             const struct WorldType *W, const double PriMerAng,
@@ -32,10 +214,10 @@ void SphericalHarmGravForce(const long N, const long M,
 
 #ifdef _DEBUG_GRAV_
    // print out gravitational acceleration vector field to a file for debugging
-   static int first      = 0;
-   static int reporting  = 0;
-   static FILE *gravFile = NULL;
-   static double theta, phi;
+   static SIMLOCAL int first      = 0;
+   static SIMLOCAL int reporting  = 0;
+   static SIMLOCAL FILE *gravFile = NULL;
+   static SIMLOCAL double theta, phi;
    if (!first && !strcmp(W->Name, "Earth")) {
       first = 1;
       extern char OutPath[1000];
@@ -71,9 +253,8 @@ void SphericalHarmGravForce(const long N, const long M,
       getTrigSphericalCoords(pbe, &cth, &sth, &cph, &sph, &r);
       const double trigs[4] = {cth, sth, cph, sph};
 
-      SphericalHarmonics(N, M, r, trigs, GravModel->r_ref,
-                         W->mu / GravModel->r_ref, GravModel->C, GravModel->S,
-                         GravModel->Norm, gradV);
+      SphereHarmGrav(GravModel, N, M, r, trigs, GravModel->r_ref,
+                     W->mu / GravModel->r_ref, gradV, NULL);
       Fr  = mass * gradV[0];
       Fth = mass * gradV[1];
       Fph = mass * gradV[2];
@@ -96,124 +277,116 @@ void SphericalHarmGravForce(const long N, const long M,
 }
 /**********************************************************************/
 /*  IGRF Magnetic field model                                      *  */
-void IGRFMagField(const char *ModelPath, const struct DateType UTC,
-                  const long N, const long M, const double pbn[3],
-                  const double PriMerAng, double MagVecN[3])
-{
-   static double **C = NULL, **S = NULL, **Norm = NULL;
+/*  Cdat, Sdat, Norm are read once.  C, S hold the coefficients        */
+/*  interpolated to CoefYear, and are only rebuilt when the epoch      */
+/*  moves into a new EpochDT-long bucket.  They are per thread, so SC  */
+/*  updated in parallel share the loaded tables but not the cache.     */
 #define nYears 26
-
-   static double **Cdat[nYears + 1] = {NULL}, **Sdat[nYears + 1] = {NULL};
-   double t[nYears] = {1900.0, 1905.0, 1910.0, 1915.0, 1920.0, 1925.0, 1930.0,
-                       1935.0, 1940.0, 1945.0, 1950.0, 1955.0, 1960.0, 1965.0,
-                       1970.0, 1975.0, 1980.0, 1985.0, 1990.0, 1995.0, 2000.0,
-                       2005.0, 2010.0, 2015.0, 2020.0, 2025.0};
-   double cth, sth, cph, sph, pbe[3], gradV[3];
-   double r, Br, Bth, Bph, BVE[3];
-   const double AXIS[3] = {0.0, 0.0, 1.0};
-   double CEN[3][3];
-   const double Re    = 6371200.0;
-   static long First  = 1;
-   static long warned = 0;
-
+static const double IGRFYear[nYears] = {
+    1900.0, 1905.0, 1910.0, 1915.0, 1920.0, 1925.0, 1930.0,
+    1935.0, 1940.0, 1945.0, 1950.0, 1955.0, 1960.0, 1965.0,
+    1970.0, 1975.0, 1980.0, 1985.0, 1990.0, 1995.0, 2000.0,
+    2005.0, 2010.0, 2015.0, 2020.0, 2025.0};
+static SIMLOCAL double **IGRFCdat[nYears + 1] = {NULL},
+                       **IGRFSdat[nYears + 1] = {NULL};
+static SIMLOCAL double **IGRFNorm             = NULL;
+static SIMLOCAL long IGRFWarned               = 0;
+static _Thread_local double **IGRFC = NULL, **IGRFS = NULL;
+static _Thread_local double IGRFCoefYear = -1.0;
 #ifdef _DEBUG_MAG_
-   static FILE *magFile = NULL;
-   static int reporting = 0;
-   static double theta, phi;
+static SIMLOCAL FILE *magFile = NULL;
+static SIMLOCAL int reporting = 0;
+static SIMLOCAL double magTheta, magPhi;
 #endif
-   if (First) {
-      First = 0;
-      double dum[nYears + 1];
-      long k;
-      long n, m;
-      char gh;
-
-      C    = CreateMatrix(14, 14);
-      S    = CreateMatrix(14, 14);
-      Norm = CreateMatrix(14, 14);
-
-      for (k = 0; k < nYears + 1; k++) {
-         Cdat[k] = CreateMatrix(14, 14);
-         Sdat[k] = CreateMatrix(14, 14);
-      }
+/**********************************************************************/
+static void LoadIGRFCoefs(const char *ModelPath)
+{
+   double dum[nYears + 1];
+   long k;
+   long n, m;
+   char gh;
 
-      /* Get data from IGRF20.txt */
-      const char *file_name = "igrf14coeffs.txt";
-      FILE *IGRFfile        = FileOpen(ModelPath, file_name, "r");
-      // skip first 4 lines
-
-      char buffer[BUFSIZ] = {0};
-      for (int i = 0; i < 4; i++)
-         fgets(buffer, sizeof(buffer), IGRFfile);
-      while (fgets(buffer, sizeof(buffer), IGRFfile) != NULL) {
-         sscanf(buffer,
-                "%c %ld %ld %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf "
-                "%lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf",
-                &gh, &n, &m, &dum[0], &dum[1], &dum[2], &dum[3], &dum[4],
-                &dum[5], &dum[6], &dum[7], &dum[8], &dum[9], &dum[10], &dum[11],
-                &dum[12], &dum[13], &dum[14], &dum[15], &dum[16], &dum[17],
-                &dum[18], &dum[19], &dum[20], &dum[21], &dum[22], &dum[23],
-                &dum[24], &dum[25], &dum[26]);
-         switch (gh) {
-            case 'g':
-               for (k = 0; k < nYears + 1; k++)
-                  Cdat[k][n][m] = dum[k];
-               break;
-            case 'h':
-               for (k = 0; k < nYears + 1; k++)
-                  Sdat[k][n][m] = dum[k];
-               break;
-            default:
-               fprintf(
-                   stderr,
-                   "Invalid leading character in IGRF file %s. Exiting...\n",
-                   file_name);
-               exit(EXIT_FAILURE);
-               break;
-         }
-      }
-      fclose(IGRFfile);
-      /* Transform from Schmidt normalization to Neumann normalization */
-      for (n = 1; n <= 13; n++) {
-         for (m = 0; m <= n; m++) {
-            Norm[n][m] = 1.0;
-            if (m != 0)
-               Norm[n][m] = sqrt(2.0 / factDfact(n + m, n - m));
-         }
+   IGRFNorm = CreateMatrix(14, 14);
+
+   for (k = 0; k < nYears + 1; k++) {
+      IGRFCdat[k] = CreateMatrix(14, 14);
+      IGRFSdat[k] = CreateMatrix(14, 14);
+   }
+
+   /* Get data from IGRF20.txt */
+   const char *file_name = "igrf14coeffs.txt";
+   FILE *IGRFfile        = FileOpen(ModelPath, file_name, "r");
+   // skip first 4 lines
+
+   char buffer[BUFSIZ] = {0};
+   for (int i = 0; i < 4; i++)
+      fgets(buffer, sizeof(buffer), IGRFfile);
+   while (fgets(buffer, sizeof(buffer), IGRFfile) != NULL) {
+      sscanf(buffer,
+             "%c %ld %ld %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf "
+             "%lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf %lf",
+             &gh, &n, &m, &dum[0], &dum[1], &dum[2], &dum[3], &dum[4],
+             &dum[5], &dum[6], &dum[7], &dum[8], &dum[9], &dum[10], &dum[11],
+             &dum[12], &dum[13], &dum[14], &dum[15], &dum[16], &dum[17],
+             &dum[18], &dum[19], &dum[20], &dum[21], &dum[22], &dum[23],
+             &dum[24], &dum[25], &dum[26]);
+      switch (gh) {
+         case 'g':
+            for (k = 0; k < nYears + 1; k++)
+               IGRFCdat[k][n][m] = dum[k];
+            break;
+         case 'h':
+            for (k = 0; k < nYears + 1; k++)
+               IGRFSdat[k][n][m] = dum[k];
+            break;
+         default:
+            fprintf(stderr,
+                    "Invalid leading character in IGRF file %s. Exiting...\n",
+                    file_name);
+            exit(EXIT_FAILURE);
+            break;
       }
-#ifdef _DEBUG_MAG_
-      extern char OutPath[1000];
-      magFile   = FileOpen(OutPath, "/IGRFModelTest.42", "wt");
-      r         = MAGV(pbn);
-      reporting = 1;
-      fprintf(magFile, "%ld/%02ld/%02ld %02ld:%02ld:%.6lf\n", UTC.Year,
-              UTC.Month, UTC.Day, UTC.Hour, UTC.Minute, UTC.Second);
-      for (theta = 0.5; theta <= 179.5; theta += 0.5) {
-         for (phi = -180.0; phi < 180.0; phi += 0.5) {
-            cth            = cos(theta * D2R);
-            sth            = sin(theta * D2R);
-            cph            = cos(phi * D2R);
-            sph            = sin(phi * D2R);
-            double rvec[3] = {0.0};
-            rvec[0]        = r * sth * cph;
-            rvec[1]        = r * sth * sph;
-            rvec[2]        = r * cth;
-            double out[3]  = {0.0};
-            IGRFMagField(ModelPath, UTC, N, M, rvec, 0, out);
-         }
+   }
+   fclose(IGRFfile);
+   /* Transform from Schmidt normalization to Neumann normalization */
+   for (n = 1; n <= 13; n++) {
+      for (m = 0; m <= n; m++) {
+         IGRFNorm[n][m] = 1.0;
+         if (m != 0)
+            IGRFNorm[n][m] = sqrt(2.0 / factDfact(n + m, n - m));
       }
-      reporting = 0;
-      fclose(magFile);
+   }
+}
+/**********************************************************************/
+/*  Bring IGRFC, IGRFS up to date for UTC.  EpochDT [sec] is the       */
+/*  cache granularity; zero interpolates to UTC exactly.               */
+static void UpdateIGRFCoefs(const char *ModelPath, const struct DateType UTC,
+                            const double EpochDT)
+{
+   const double *t = IGRFYear;
 
-#endif
+   if (IGRFNorm == NULL)
+      LoadIGRFCoefs(ModelPath);
+   if (IGRFC == NULL) {
+      IGRFC = CreateMatrix(14, 14);
+      IGRFS = CreateMatrix(14, 14);
+   }
+
+   const double doy = (UTC.doy - 1) + (UTC.Hour - 1) / 24.0 +
+                      UTC.Minute / 1440.0 + UTC.Second / 86400.0;
+   double year      = UTC.Year + doy / (UTC.Year % 4 ? 365.0 : 366.0);
+   if (EpochDT > 0.0) {
+      /* .. Middle of the bucket holding year */
+      const double dYear = EpochDT / (365.25 * 86400.0);
+      year               = (floor(year / dYear) + 0.5) * dYear;
    }
+   if (year == IGRFCoefYear)
+      return;
+   IGRFCoefYear = year;
 
-   const double doy  = (UTC.doy - 1) + (UTC.Hour - 1) / 24.0 +
-                       UTC.Minute / 1440.0 + UTC.Second / 86400.0;
-   const double year = UTC.Year + doy / (UTC.Year % 4 ? 365.0 : 366.0);
    if (year > 2020) {
-      if (!warned && year > t[nYears - 1] + 5) {
-         warned = 1;
+      if (!IGRFWarned && year > t[nYears - 1] + 5) {
+         IGRFWarned = 1;
          printf("***** WARNING: IGRF model only well defined up to %ld; "
                 "IGRF values at %lf may be of reduced accuracy. *****\n",
                 (long)t[nYears - 1] + 5, year);
@@ -223,8 +396,10 @@ void IGRFMagField(const char *ModelPath, const struct DateType UTC,
           (year > t[nYears - 1] + 5.0 ? 5.0 : year - t[nYears - 1]);
       for (int n = 0; n <= 13; n++) {
          for (int m = 0; m <= n; m++) {
-            C[n][m] = Cdat[nYears - 1][n][m] + Cdat[nYears][n][m] * dt;
-            S[n][m] = Sdat[nYears - 1][n][m] + Sdat[nYears][n][m] * dt;
+            IGRFC[n][m] =
+                IGRFCdat[nYears - 1][n][m] + IGRFCdat[nYears][n][m] * dt;
+            IGRFS[n][m] =
+                IGRFSdat[nYears - 1][n][m] + IGRFSdat[nYears][n][m] * dt;
          }
       }
    }
@@ -233,16 +408,22 @@ void IGRFMagField(const char *ModelPath, const struct DateType UTC,
          for (int m = 0; m <= n; m++) {
             double Y[nYears] = {0.0};
             for (int k = 0; k < nYears; k++)
-               Y[k] = Cdat[k][n][m];
-            C[n][m] = LinInterp(t, Y, year, nYears);
+               Y[k] = IGRFCdat[k][n][m];
+            IGRFC[n][m] = LinInterp(t, Y, year, nYears);
             for (int k = 0; k < nYears; k++)
-               Y[k] = Sdat[k][n][m];
-            S[n][m] = LinInterp(t, Y, year, nYears);
+               Y[k] = IGRFSdat[k][n][m];
+            IGRFS[n][m] = LinInterp(t, Y, year, nYears);
          }
       }
    }
-
-   SimpRot(AXIS, PriMerAng, CEN);
+}
+/**********************************************************************/
+static void IGRFFieldAt(const long N, const long M, double CEN[3][3],
+                        const double pbn[3], double MagVecN[3])
+{
+   double cth, sth, cph, sph, pbe[3], gradV[3];
+   double r, Br, Bth, Bph, BVE[3];
+   const double Re = 6371200.0;
 
    /*    Transform p to spherical coords in Earth frame */
    MxV(CEN, pbn, pbe);
@@ -250,7 +431,7 @@ void IGRFMagField(const char *ModelPath, const struct DateType UTC,
    const double trigs[4] = {cth, sth, cph, sph};
 
    /*    Find Br, Bth, Bph */
-   SphericalHarmonics(N, M, r, trigs, Re, Re, C, S, Norm, gradV);
+   SphericalHarmonics(N, M, r, trigs, Re, Re, IGRFC, IGRFS, IGRFNorm, gradV);
    Br  = -gradV[0];
    Bth = -gradV[1];
    Bph = -gradV[2];
@@ -258,7 +439,7 @@ void IGRFMagField(const char *ModelPath, const struct DateType UTC,
 #ifdef _DEBUG_MAG_
    if (reporting) {
       fprintf(magFile, "%lf, %lf, %18.36le, %18.36le, %18.36le, %18.36le\n",
-              theta, phi - PriMerAng, r, Bph, -Bth, Br);
+              magTheta, magPhi, r, Bph, -Bth, Br);
    }
 #endif
 
@@ -274,9 +455,68 @@ void IGRFMagField(const char *ModelPath, const struct DateType UTC,
    **printf("Br,Bth,Bph: %lf %lf %lf\n",Br,Bth,Bph);
    **printf("BVE: %lf %lf %lf\n\n",BVE[0],BVE[1],BVE[2]);
    */
-#undef nYears
 }
+/**********************************************************************/
+void IGRFMagField(const char *ModelPath, const struct DateType UTC,
+                  const double EpochDT, const long N, const long M,
+                  const double pbn[3], const double PriMerAng,
+                  double MagVecN[3])
+{
+   const double AXIS[3] = {0.0, 0.0, 1.0};
+   double CEN[3][3];
+
+#ifdef _DEBUG_MAG_
+   static SIMLOCAL long First = 1;
+   if (First) {
+      First = 0;
+      extern char OutPath[1000];
+      double cth, sth, cph, sph;
+      double r  = MAGV(pbn);
+      magFile   = FileOpen(OutPath, "/IGRFModelTest.42", "wt");
+      reporting = 1;
+      fprintf(magFile, "%ld/%02ld/%02ld %02ld:%02ld:%.6lf\n", UTC.Year,
+              UTC.Month, UTC.Day, UTC.Hour, UTC.Minute, UTC.Second);
+      for (magTheta = 0.5; magTheta <= 179.5; magTheta += 0.5) {
+         for (magPhi = -180.0; magPhi < 180.0; magPhi += 0.5) {
+            cth            = cos(magTheta * D2R);
+            sth            = sin(magTheta * D2R);
+            cph            = cos(magPhi * D2R);
+            sph            = sin(magPhi * D2R);
+            double rvec[3] = {0.0};
+            rvec[0]        = r * sth * cph;
+            rvec[1]        = r * sth * sph;
+            rvec[2]        = r * cth;
+            double out[3]  = {0.0};
+            IGRFMagField(ModelPath, UTC, EpochDT, N, M, rvec, 0, out);
+         }
+      }
+      reporting = 0;
+      fclose(magFile);
+   }
+#endif
+
+   UpdateIGRFCoefs(ModelPath, UTC, EpochDT);
+   SimpRot(AXIS, PriMerAng, CEN);
+   IGRFFieldAt(N, M, CEN, pbn, MagVecN);
+}
+/**********************************************************************/
+/*  Field at Npos positions (PosN is Npos x 3) sharing one epoch and  */
+/*  one Earth orientation                                             */
+void IGRFMagFieldBatch(const char *ModelPath, const struct DateType UTC,
+                       const double EpochDT, const long N, const long M,
+                       const long Npos, double **PosN, const double PriMerAng,
+                       double **MagVecN)
+{
+   const double AXIS[3] = {0.0, 0.0, 1.0};
+   double CEN[3][3];
+   long Ip;
 
+   UpdateIGRFCoefs(ModelPath, UTC, EpochDT);
+   SimpRot(AXIS, PriMerAng, CEN);
+   for (Ip = 0; Ip < Npos; Ip++)
+      IGRFFieldAt(N, M, CEN, PosN[Ip], MagVecN[Ip]);
+}
+#undef nYears
 /**********************************************************************/
 /*  Computes planetary dipole magnetic field vector at S/C position.  */
 void DipoleMagField(double DipoleMoment, double DipoleAxis[3],
@@ -601,9 +841,9 @@ void HiFiEarthPrecNute(double JD, double C_TEME_TETE[3][3],
 {
 
    double P[3][3], N[3][3];
-   static long First = 1;
-   static double Al, Bl, Alp, Blp, AF, BF, AD, BD, AOm, BOm;
-   static double A2R;
+   static SIMLOCAL long First = 1;
+   static SIMLOCAL double Al, Bl, Alp, Blp, AF, BF, AD, BD, AOm, BOm;
+   static SIMLOCAL double A2R;
    long i;
    double T, zeta, z, theta;
    double cos_zeta, sin_zeta, cos_theta, sin_theta, cos_z, sin_z;
@@ -859,37 +1099,65 @@ void ECEFToWGS84(double p[3], double *glat, double *glong, double *alt)
    *glong = atan2(p[1], p[0]);
 }
 /**********************************************************************/
-/* Ref Werner and Scheeres, "Exterior Gravitation of a Polyhedron ..." */
-/* Returns 1 if PosN is outside polyhedron, 0 if inside */
-long PolyhedronGravAcc(struct GeomType *G, double Density, double PosN[3],
-                       double CWN[3][3], double GravAccN[3])
+/* Distance from PosW to every vertex, shared by the edge and face    */
+/* sums below so each vertex costs one sqrt instead of one per edge   */
+/* and face that touches it.  Per thread, since SC may be updated in  */
+/* parallel.                                                          */
+static _Thread_local double *PolyVtxDist = NULL;
+static _Thread_local long PolyVtxDistCap = 0;
+static double *PolyhedronVtxDist(const struct GeomType *G,
+                                 const double PosW[3])
+{
+   double *V;
+   double dx, dy, dz;
+   long Iv;
+
+   if (G->Nv > PolyVtxDistCap) {
+      free(PolyVtxDist);
+      PolyVtxDist = (double *)malloc(G->Nv * sizeof(double));
+      if (PolyVtxDist == NULL) {
+         fprintf(stderr, "PolyhedronVtxDist malloc returned null pointer.  "
+                         "Bailing out!\n");
+         exit(EXIT_FAILURE);
+      }
+      PolyVtxDistCap = G->Nv;
+   }
+   for (Iv = 0; Iv < G->Nv; Iv++) {
+      V               = G->V[Iv];
+      dx              = V[0] - PosW[0];
+      dy              = V[1] - PosW[1];
+      dz              = V[2] - PosW[2];
+      PolyVtxDist[Iv] = sqrt(dx * dx + dy * dy + dz * dz);
+   }
+   return (PolyVtxDist);
+}
+/**********************************************************************/
+/* Edge terms Ie0 <= Ie < Ie1 and face terms Ip0 <= Ip < Ip1 of the   */
+/* Werner-Scheeres sum, without the G*Density factor                  */
+static void PolyhedronGravAccSum(const struct GeomType *G, const double PosW[3],
+                                 const double *Dist, long Ie0, long Ie1,
+                                 long Ip0, long Ip1, double GravAccW[3],
+                                 double *SumWf)
 {
    struct EdgeType *E;
    struct PolyType *P;
    double *V1, *V2, *V3;
-   double PosW[3], GravAccW[3];
-   double re1[3], re2[3], rf1[3], rf2[3], rf3[3], r1, r2, r3, r2xr3[3];
-   double Num, Den, Er[3], Fr[3], Le, wf, SumWf, Gsig;
-   long PosIsOutside;
+   double re1[3], rf1[3], rf2[3], rf3[3], r1, r2, r3, r2xr3[3];
+   double Num, Den, Er[3], Fr[3], Le, wf;
    long Ie, Ip, i;
 
    for (i = 0; i < 3; i++) {
       GravAccW[i] = 0.0;
    }
-   SumWf = 0.0;
+   *SumWf = 0.0;
 
-   MxV(CWN, PosN, PosW);
-
-   for (Ie = 0; Ie < G->Nedge; Ie++) {
+   for (Ie = Ie0; Ie < Ie1; Ie++) {
       E  = &G->Edge[Ie];
       V1 = G->V[E->Vtx1];
-      V2 = G->V[E->Vtx2];
-      for (i = 0; i < 3; i++) {
+      for (i = 0; i < 3; i++)
          re1[i] = V1[i] - PosW[i];
-         re2[i] = V2[i] - PosW[i];
-      }
-      r1 = MAGV(re1);
-      r2 = MAGV(re2);
+      r1 = Dist[E->Vtx1];
+      r2 = Dist[E->Vtx2];
       Le = log((r1 + r2 + E->Length) / (r1 + r2 - E->Length));
       MxV(E->Dyad, re1, Er);
       for (i = 0; i < 3; i++) {
@@ -897,7 +1165,7 @@ long PolyhedronGravAcc(struct GeomType *G, double Density, double PosN[3],
       }
    }
 
-   for (Ip = 0; Ip < G->Npoly; Ip++) {
+   for (Ip = Ip0; Ip < Ip1; Ip++) {
       P  = &G->Poly[Ip];
       V1 = G->V[P->V[0]];
       V2 = G->V[P->V[1]];
@@ -907,9 +1175,9 @@ long PolyhedronGravAcc(struct GeomType *G, double Density, double PosN[3],
          rf2[i] = V2[i] - PosW[i];
          rf3[i] = V3[i] - PosW[i];
       }
-      r1 = MAGV(rf1);
-      r2 = MAGV(rf2);
-      r3 = MAGV(rf3);
+      r1 = Dist[P->V[0]];
+      r2 = Dist[P->V[1]];
+      r3 = Dist[P->V[2]];
       VxV(rf2, rf3, r2xr3);
       Num = VoV(rf1, r2xr3);
       Den = r1 * r2 * r3 + r1 * VoV(rf2, rf3) + r2 * VoV(rf3, rf1) +
@@ -919,7 +1187,253 @@ long PolyhedronGravAcc(struct GeomType *G, double Density, double PosN[3],
       for (i = 0; i < 3; i++) {
          GravAccW[i] += Fr[i] * wf;
       }
-      SumWf += wf;
+      *SumWf += wf;
+   }
+}
+/**********************************************************************/
+/* PolyhedronGravAcc splits its sums into POLYGRAV_NCHUNK fixed       */
+/* slices of the edge and face lists and adds the slices in order.    */
+/* The slices are the same whether they are summed by the pool or by  */
+/* the caller alone, so the result doesn't depend on the number of    */
+/* threads, or on whether the pool was free.  One caller at a time    */
+/* has the pool; others sum their slices themselves.                  */
+#define POLYGRAV_NCHUNK 16
+struct PolyGravPoolType {
+   long Nthread; /* Including the calling thread */
+   long Nuser;   /* Starts less stops */
+   pthread_t *Thread;
+   pthread_mutex_t Busy; /* Held by the caller whose sum is running */
+   pthread_mutex_t Mutex;
+   pthread_cond_t StartCond;
+   pthread_cond_t DoneCond;
+   long Generation; /* Bumped once per phase */
+   long Phase;      /* 0: vertex distances, 1: edge and face sums */
+   long NextChunk;  /* Next slice to be claimed */
+   long Ndone;      /* Slices finished in this phase */
+   long Shutdown;
+   const struct GeomType *G;
+   double PosW[3];
+   double *Dist;
+   long DistCap;
+   double Acc[POLYGRAV_NCHUNK][3];
+   double SumWf[POLYGRAV_NCHUNK];
+};
+static struct PolyGravPoolType PolyGravPool = {
+    .Nthread   = 1,
+    .Busy      = PTHREAD_MUTEX_INITIALIZER,
+    .Mutex     = PTHREAD_MUTEX_INITIALIZER,
+    .StartCond = PTHREAD_COND_INITIALIZER,
+    .DoneCond  = PTHREAD_COND_INITIALIZER};
+/**********************************************************************/
+static void PolyGravChunk(const struct GeomType *G, const double PosW[3],
+                          const double *Dist, long Ic, double Acc[3],
+                          double *SumWf)
+{
+   PolyhedronGravAccSum(G, PosW, Dist, Ic * G->Nedge / POLYGRAV_NCHUNK,
+                        (Ic + 1) * G->Nedge / POLYGRAV_NCHUNK,
+                        Ic * G->Npoly / POLYGRAV_NCHUNK,
+                        (Ic + 1) * G->Npoly / POLYGRAV_NCHUNK, Acc, SumWf);
+}
+/**********************************************************************/
+static void PolyGravClaimChunks(void)
+{
+   struct PolyGravPoolType *P = &PolyGravPool;
+   const struct GeomType *G;
+   double dx, dy, dz, *V;
+   long Ic, Phase, Iv;
+
+   while (1) {
+      pthread_mutex_lock(&P->Mutex);
+      Ic    = P->NextChunk++;
+      Phase = P->Phase;
+      G     = P->G;
+      pthread_mutex_unlock(&P->Mutex);
+      if (Ic >= POLYGRAV_NCHUNK)
+         break;
+      if (Phase == 0) {
+         for (Iv = Ic * G->Nv / POLYGRAV_NCHUNK;
+              Iv < (Ic + 1) * G->Nv / POLYGRAV_NCHUNK; Iv++) {
+            V           = G->V[Iv];
+            dx          = V[0] - P->PosW[0];
+            dy          = V[1] - P->PosW[1];
+            dz          = V[2] - P->PosW[2];
+            P->Dist[Iv] = sqrt(dx * dx + dy * dy + dz * dz);
+         }
+      }
+      else
+         PolyGravChunk(G, P->PosW, P->Dist, Ic, P->Acc[Ic], &P->SumWf[Ic]);
+      pthread_mutex_lock(&P->Mutex);
+      P->Ndone++;
+      if (P->Ndone == POLYGRAV_NCHUNK)
+         pthread_cond_signal(&P->DoneCond);
+      pthread_mutex_unlock(&P->Mutex);
+   }
+}
+/**********************************************************************/
+static void *PolyGravWorker(void *Arg)
+{
+   struct PolyGravPoolType *P = &PolyGravPool;
+   long Generation            = 0;
+
+   pthread_mutex_lock(&P->Mutex);
+   while (1) {
+      while (!P->Shutdown && P->Generation == Generation)
+         pthread_cond_wait(&P->StartCond, &P->Mutex);
+      if (P->Shutdown)
+         break;
+      Generation = P->Generation;
+      pthread_mutex_unlock(&P->Mutex);
+
+      PolyGravClaimChunks();
+
+      pthread_mutex_lock(&P->Mutex);
+   }
+   pthread_mutex_unlock(&P->Mutex);
+   return (NULL);
+}
+/**********************************************************************/
+static void PolyGravRunPhase(long Phase)
+{
+   struct PolyGravPoolType *P = &PolyGravPool;
+
+   pthread_mutex_lock(&P->Mutex);
+   P->Phase     = Phase;
+   P->NextChunk = 0;
+   P->Ndone     = 0;
+   P->Generation++;
+   pthread_cond_broadcast(&P->StartCond);
+   pthread_mutex_unlock(&P->Mutex);
+
+   PolyGravClaimChunks();
+
+   pthread_mutex_lock(&P->Mutex);
+   while (P->Ndone < POLYGRAV_NCHUNK)
+      pthread_cond_wait(&P->DoneCond, &P->Mutex);
+   pthread_mutex_unlock(&P->Mutex);
+}
+/**********************************************************************/
+/* Share the exact polyhedron sum over Nthread threads.  Calls nest:  */
+/* the pool is built by the first start (at its size) and torn down   */
+/* by the matching last stop, so concurrent sim cases may share it.   */
+void StartPolyhedronGravPool(long Nthread)
+{
+   struct PolyGravPoolType *P = &PolyGravPool;
+   long It;
+
+   if (Nthread > POLYGRAV_NCHUNK)
+      Nthread = POLYGRAV_NCHUNK;
+   pthread_mutex_lock(&P->Busy);
+   P->Nuser++;
+   if (P->Nuser > 1 || Nthread < 2) {
+      pthread_mutex_unlock(&P->Busy);
+      return;
+   }
+   P->Thread = (pthread_t *)calloc(Nthread - 1, sizeof(pthread_t));
+   if (P->Thread == NULL) {
+      fprintf(stderr, "PolyGravPool.Thread calloc returned null pointer.  "
+                      "Bailing out!\n");
+      exit(EXIT_FAILURE);
+   }
+   P->Shutdown   = 0;
+   P->Generation = 0;
+   for (It = 0; It < Nthread - 1; It++) {
+      if (pthread_create(&P->Thread[It], NULL, PolyGravWorker, NULL)) {
+         fprintf(stderr,
+                 "Could not start polyhedron gravity thread %ld.  Bailing "
+                 "out!\n",
+                 It);
+         exit(EXIT_FAILURE);
+      }
+   }
+   P->Nthread = Nthread;
+   pthread_mutex_unlock(&P->Busy);
+}
+/**********************************************************************/
+void StopPolyhedronGravPool(void)
+{
+   struct PolyGravPoolType *P = &PolyGravPool;
+   long It;
+
+   pthread_mutex_lock(&P->Busy);
+   if (P->Nuser > 0)
+      P->Nuser--;
+   if (P->Nuser > 0 || P->Nthread < 2) {
+      pthread_mutex_unlock(&P->Busy);
+      return;
+   }
+   pthread_mutex_lock(&P->Mutex);
+   P->Shutdown = 1;
+   pthread_cond_broadcast(&P->StartCond);
+   pthread_mutex_unlock(&P->Mutex);
+   for (It = 0; It < P->Nthread - 1; It++)
+      pthread_join(P->Thread[It], NULL);
+   free(P->Thread);
+   free(P->Dist);
+   P->Thread  = NULL;
+   P->Dist    = NULL;
+   P->DistCap = 0;
+   P->Nthread = 1;
+   pthread_mutex_unlock(&P->Busy);
+}
+/**********************************************************************/
+/* Ref Werner and Scheeres, "Exterior Gravitation of a Polyhedron ..." */
+/* Returns 1 if PosN is outside polyhedron, 0 if inside */
+long PolyhedronGravAcc(struct GeomType *G, double Density, double PosN[3],
+                       double CWN[3][3], double GravAccN[3])
+{
+   struct PolyGravPoolType *P = &PolyGravPool;
+   double PosW[3], GravAccW[3], Acc[POLYGRAV_NCHUNK][3];
+   double SumWf, Wf[POLYGRAV_NCHUNK], Gsig;
+   double *Dist;
+   long PosIsOutside;
+   long Ic, i;
+
+   MxV(CWN, PosN, PosW);
+
+   if (pthread_mutex_trylock(&P->Busy) == 0) {
+      if (P->Nthread > 1) {
+         if (G->Nv > P->DistCap) {
+            free(P->Dist);
+            P->Dist = (double *)malloc(G->Nv * sizeof(double));
+            if (P->Dist == NULL) {
+               fprintf(stderr, "PolyGravPool.Dist malloc returned null "
+                               "pointer.  Bailing out!\n");
+               exit(EXIT_FAILURE);
+            }
+            P->DistCap = G->Nv;
+         }
+         pthread_mutex_lock(&P->Mutex);
+         P->G = G;
+         for (i = 0; i < 3; i++)
+            P->PosW[i] = PosW[i];
+         pthread_mutex_unlock(&P->Mutex);
+         PolyGravRunPhase(0);
+         PolyGravRunPhase(1);
+         memcpy(Acc, P->Acc, sizeof(Acc));
+         memcpy(Wf, P->SumWf, sizeof(Wf));
+         pthread_mutex_unlock(&P->Busy);
+      }
+      else {
+         pthread_mutex_unlock(&P->Busy);
+         Dist = PolyhedronVtxDist(G, PosW);
+         for (Ic = 0; Ic < POLYGRAV_NCHUNK; Ic++)
+            PolyGravChunk(G, PosW, Dist, Ic, Acc[Ic], &Wf[Ic]);
+      }
+   }
+   else {
+      Dist = PolyhedronVtxDist(G, PosW);
+      for (Ic = 0; Ic < POLYGRAV_NCHUNK; Ic++)
+         PolyGravChunk(G, PosW, Dist, Ic, Acc[Ic], &Wf[Ic]);
+   }
+
+   for (i = 0; i < 3; i++) {
+      GravAccW[i] = 0.0;
+   }
+   SumWf = 0.0;
+   for (Ic = 0; Ic < POLYGRAV_NCHUNK; Ic++) {
+      for (i = 0; i < 3; i++)
+         GravAccW[i] += Acc[Ic][i];
+      SumWf += Wf[Ic];
    }
 
    Gsig = 6.67408E-11 * Density;
@@ -944,8 +1458,9 @@ long PolyhedronGravGrad(struct GeomType *G, double Density, double PosN[3],
    struct PolyType *P;
    double *V1, *V2, *V3;
    double PosW[3], GravGradW[3][3], GC[3][3];
-   double re1[3], re2[3], rf1[3], rf2[3], rf3[3], r1, r2, r3, r2xr3[3];
+   double rf1[3], rf2[3], rf3[3], r1, r2, r3, r2xr3[3];
    double Num, Den, Le, wf, SumWf, Gsig;
+   double *Dist;
    long PosIsOutside;
    long Ie, Ip, i, j;
 
@@ -956,17 +1471,12 @@ long PolyhedronGravGrad(struct GeomType *G, double Density, double PosN[3],
    SumWf = 0.0;
 
    MxV(CWN, PosN, PosW);
+   Dist = PolyhedronVtxDist(G, PosW);
 
    for (Ie = 0; Ie < G->Nedge; Ie++) {
       E  = &G->Edge[Ie];
-      V1 = G->V[E->Vtx1];
-      V2 = G->V[E->Vtx2];
-      for (i = 0; i < 3; i++) {
-         re1[i] = V1[i] - PosW[i];
-         re2[i] = V2[i] - PosW[i];
-      }
-      r1 = MAGV(re1);
-      r2 = MAGV(re2);
+      r1 = Dist[E->Vtx1];
+      r2 = Dist[E->Vtx2];
       Le = log((r1 + r2 + E->Length) / (r1 + r2 - E->Length));
       for (i = 0; i < 3; i++) {
          for (j = 0; j < 3; j++)
@@ -984,9 +1494,9 @@ long PolyhedronGravGrad(struct GeomType *G, double Density, double PosN[3],
          rf2[i] = V2[i] - PosW[i];
          rf3[i] = V3[i] - PosW[i];
       }
-      r1 = MAGV(rf1);
-      r2 = MAGV(rf2);
-      r3 = MAGV(rf3);
+      r1 = Dist[P->V[0]];
+      r2 = Dist[P->V[1]];
+      r3 = Dist[P->V[2]];
       VxV(rf2, rf3, r2xr3);
       Num = VoV(rf1, r2xr3);
       Den = r1 * r2 * r3 + r1 * VoV(rf2, rf3) + r2 * VoV(rf3, rf1) +
@@ -1014,6 +1524,548 @@ long PolyhedronGravGrad(struct GeomType *G, double Density, double PosN[3],
    return (PosIsOutside);
 }
 /**********************************************************************/
+/*  Gauss-Legendre nodes and weights on [0,1]                         */
+static void GaussLegendre01(long K, double *x, double *w)
+{
+   double z, z1, p0, p1, p2, dp;
+   long i, j;
+
+   for (i = 0; i < K; i++) {
+      z = cos(PI * (i + 0.75) / (K + 0.5));
+      do {
+         p1 = 1.0;
+         p2 = 0.0;
+         for (j = 1; j <= K; j++) {
+            p0 = p2;
+            p2 = p1;
+            p1 = ((2.0 * j - 1.0) * z * p2 - (j - 1.0) * p0) / j;
+         }
+         dp = K * (z * p1 - p2) / (z * z - 1.0);
+         z1 = z;
+         z  = z1 - p1 / dp;
+      } while (fabs(z - z1) > 1.0E-15);
+      x[i] = 0.5 * (1.0 - z);
+      w[i] = 1.0 / ((1.0 - z * z) * dp * dp);
+   }
+}
+/**********************************************************************/
+/*  Exterior spherical harmonic expansion of a uniform polyhedron,    */
+/*  in the unnormalized convention of SphericalHarmonics, to degree   */
+/*  and order N.  Each face is the base of a cone from the origin.    */
+/*  r^n*P[n][m]*cos(m*lng) is homogeneous of degree n, so its volume  */
+/*  integral over the cone is a face integral scaled by h/(n+3),      */
+/*  with h the distance from origin to face plane.  The face          */
+/*  integrals use a Gauss rule exact to degree N, so the coefficients */
+/*  are exact but for roundoff.  Returns the reference radius, that   */
+/*  of the Brillouin sphere about the origin.  The expansion only     */
+/*  converges outside that sphere.                                    */
+double PolyhedronSphereHarm(struct GeomType *G, long N, double **C,
+                            double **S)
+{
+   struct PolyType *Poly;
+   double P[N + 1][N + 1], sdP[N + 1][N + 1];
+   double cml[N + 1], sml[N + 1];
+   double x[N / 2 + 2], w[N / 2 + 2];
+   double *A, *B, *Cv, AB[3], AC[3], Nrm[3], y[3];
+   double hN, a, b, wt, r, rxy, cth, cph, sph, rn, Vol, Rref, Scale;
+   long K, Ip, Iv, ia, ib, n, m, i;
+
+   K = (N + 3) / 2;
+   GaussLegendre01(K, x, w);
+   for (n = 0; n <= N; n++) {
+      for (m = 0; m <= N; m++) {
+         C[n][m] = 0.0;
+         S[n][m] = 0.0;
+      }
+   }
+
+   Rref = 0.0;
+   for (Iv = 0; Iv < G->Nv; Iv++) {
+      r = MAGV(G->V[Iv]);
+      if (r > Rref)
+         Rref = r;
+   }
+
+   Vol = 0.0;
+   for (Ip = 0; Ip < G->Npoly; Ip++) {
+      Poly = &G->Poly[Ip];
+      A    = G->V[Poly->V[0]];
+      for (Iv = 1; Iv < Poly->Nv - 1; Iv++) {
+         B  = G->V[Poly->V[Iv]];
+         Cv = G->V[Poly->V[Iv + 1]];
+         for (i = 0; i < 3; i++) {
+            AB[i] = B[i] - A[i];
+            AC[i] = Cv[i] - A[i];
+         }
+         VxV(AB, AC, Nrm);
+         hN   = VoV(A, Nrm);
+         Vol += hN / 6.0;
+         for (ia = 0; ia < K; ia++) {
+            a = x[ia];
+            for (ib = 0; ib < K; ib++) {
+               b  = (1.0 - a) * x[ib];
+               wt = w[ia] * w[ib] * (1.0 - a) * hN;
+               for (i = 0; i < 3; i++)
+                  y[i] = A[i] + a * AB[i] + b * AC[i];
+               r = MAGV(y);
+               if (r == 0.0)
+                  continue;
+               rxy = sqrt(y[0] * y[0] + y[1] * y[1]);
+               cth = y[2] / r;
+               cph = (rxy > 0.0 ? y[0] / rxy : 1.0);
+               sph = (rxy > 0.0 ? y[1] / rxy : 0.0);
+               Legendre(N, N, cth, P, sdP);
+               cml[0] = 1.0;
+               sml[0] = 0.0;
+               for (m = 1; m <= N; m++) {
+                  cml[m] = cml[m - 1] * cph - sml[m - 1] * sph;
+                  sml[m] = sml[m - 1] * cph + cml[m - 1] * sph;
+               }
+               rn = wt;
+               for (n = 0; n <= N; n++) {
+                  for (m = 0; m <= n; m++) {
+                     C[n][m] += rn / (n + 3) * P[n][m] * cml[m];
+                     S[n][m] += rn / (n + 3) * P[n][m] * sml[m];
+                  }
+                  rn *= r;
+               }
+            }
+         }
+      }
+   }
+
+   /* Normalize by mass and Rref^n, and apply the addition theorem */
+   Scale = 1.0 / Vol;
+   for (n = 0; n <= N; n++) {
+      for (m = 0; m <= n; m++) {
+         C[n][m] *= (m == 0 ? 1.0 : 2.0) * Scale / factDfact(n + m, n - m);
+         S[n][m] *= (m == 0 ? 1.0 : 2.0) * Scale / factDfact(n + m, n - m);
+      }
+      Scale /= Rref;
+   }
+   return (Rref);
+}
+/**********************************************************************/
+/*  Acceleration from a polyhedron's exterior expansion.  Unlike      */
+/*  SphericalHarmGravForce, this includes the central term, so it     */
+/*  stands in for all of PolyhedronGravAcc.                           */
+void PolyhedronFarGravAcc(const struct SphereHarmType *SH, double mu,
+                          double PosN[3], double CWN[3][3],
+                          double GravAccN[3])
+{
+   double PosW[3], gradV[3], AccW[3];
+   double cth, sth, cph, sph, r, Fr;
+
+   MxV(CWN, PosN, PosW);
+   getTrigSphericalCoords(PosW, &cth, &sth, &cph, &sph, &r);
+   if (sth == 0.0) {
+      cph = 1.0;
+      sph = 0.0;
+   }
+   const double trigs[4] = {cth, sth, cph, sph};
+
+   SphereHarmGrav(SH, SH->N, SH->M, r, trigs, SH->r_ref, mu / SH->r_ref,
+                  gradV, NULL);
+   Fr = gradV[0] - mu / (r * r);
+
+   AccW[0] = (Fr * sth + gradV[1] * cth) * cph - gradV[2] * sph;
+   AccW[1] = (Fr * sth + gradV[1] * cth) * sph + gradV[2] * cph;
+   AccW[2] = Fr * cth - gradV[1] * sth;
+
+   MTxV(CWN, AccW, GravAccN);
+}
+/**********************************************************************/
+/*  Largest error of the exterior expansion, relative to the exact    */
+/*  polyhedron sum, over a Fibonacci lattice of directions at radius  */
+/*  R.  This bounds the jump in acceleration where the two switch.    */
+double PolyhedronFarFieldError(struct GeomType *G, double Density,
+                               const struct SphereHarmType *SH, double mu,
+                               double R)
+{
+   const long Npt       = 64;
+   double CWN[3][3]     = {{1.0, 0.0, 0.0}, {0.0, 1.0, 0.0}, {0.0, 0.0, 1.0}};
+   double p[3], Exact[3], Far[3], Diff[3];
+   double z, rho, Az, Err, MaxErr = 0.0;
+   long Ip, i;
+
+   for (Ip = 0; Ip < Npt; Ip++) {
+      z    = 1.0 - (2.0 * Ip + 1.0) / Npt;
+      rho  = sqrt(1.0 - z * z);
+      Az   = Ip * PI * (3.0 - sqrt(5.0));
+      p[0] = R * rho * cos(Az);
+      p[1] = R * rho * sin(Az);
+      p[2] = R * z;
+      PolyhedronGravAcc(G, Density, p, CWN, Exact);
+      PolyhedronFarGravAcc(SH, mu, p, CWN, Far);
+      for (i = 0; i < 3; i++)
+         Diff[i] = Far[i] - Exact[i];
+      Err = MAGV(Diff) / MAGV(Exact);
+      if (Err > MaxErr)
+         MaxErr = Err;
+   }
+   return (MaxErr);
+}
+/**********************************************************************/
+/*  Near-field grid.  An octree over a cube about the body, refined   */
+/*  lazily along the trajectories that visit it.  Each leaf holds the */
+/*  acceleration and its gradient at its eight corners (shared        */
+/*  between neighbours through a hash on their integer coordinates),  */
+/*  and interpolates                                                  */
+/*     a(x) = Sum w_k (a_k + 0.5 G_k (x - x_k))                       */
+/*  with trilinear weights w_k, which is exact for quadratic fields.  */
+/*  A cell is made a leaf once the interpolant matches the exact sum  */
+/*  at its center to within Tol.  Cells that might hold part of the   */
+/*  surface, or that are still too coarse at the deepest level, fall  */
+/*  back to the exact sum.                                            */
+#define POLYGRID_MIN_DEPTH 3
+#define POLYGRID_MAX_DEPTH 8
+#define POLYGRID_UNTESTED 0
+#define POLYGRID_SPLIT 1
+#define POLYGRID_LEAF 2
+#define POLYGRID_EXACT 3
+#define POLYGRID_NTEST 4
+/* Offsets from the cell center, in cell widths, of a tetrahedron of  */
+/* points at 0.21 and 0.79 of the way along each axis                 */
+static const double PolyGravGridTestPt[POLYGRID_NTEST][3] = {
+    {-0.29, -0.29, -0.29},
+    {-0.29, 0.29, 0.29},
+    {0.29, -0.29, 0.29},
+    {0.29, 0.29, -0.29}};
+struct PolyGravCornerType {
+   long Key;
+   double Acc[3];
+   double Grad[3][3];
+};
+struct PolyGravCellType {
+   long State;
+   long Child;     /* First of eight, if split */
+   long Corner[8]; /* If leaf */
+};
+struct PolyGravGridType {
+   struct GeomType *G;
+   double Density;
+   double Tol;
+   double HalfWidth;  /* Of the cube, m */
+   double SurfMargin; /* Longest edge of the shape model, m */
+   struct PolyGravCellType *Cell;
+   long Ncell, NcellAlloc;
+   struct PolyGravCornerType *Corner;
+   long Ncorner, NcornerAlloc;
+   long *Hash; /* Index into Corner, or -1 */
+   long HashMask;
+   pthread_mutex_t Mutex;
+};
+/**********************************************************************/
+static void *PolyGravGridRealloc(void *Ptr, size_t Size)
+{
+   Ptr = realloc(Ptr, Size);
+   if (Ptr == NULL) {
+      fprintf(stderr,
+              "PolyGravGrid realloc returned null pointer.  Bailing out!\n");
+      exit(EXIT_FAILURE);
+   }
+   return (Ptr);
+}
+/**********************************************************************/
+static long PolyGravGridNewCells(struct PolyGravGridType *Grid)
+{
+   long Ic, Ic0;
+
+   if (Grid->Ncell + 8 > Grid->NcellAlloc) {
+      Grid->NcellAlloc *= 2;
+      Grid->Cell        = (struct PolyGravCellType *)PolyGravGridRealloc(
+          Grid->Cell, Grid->NcellAlloc * sizeof(struct PolyGravCellType));
+   }
+   Ic0 = Grid->Ncell;
+   for (Ic = Ic0; Ic < Ic0 + 8; Ic++)
+      Grid->Cell[Ic].State = POLYGRID_UNTESTED;
+   Grid->Ncell += 8;
+   return (Ic0);
+}
+/**********************************************************************/
+static void PolyGravGridPos(const struct PolyGravGridType *Grid,
+                            const long Idx[3], double PosW[3])
+{
+   const double h = 2.0 * Grid->HalfWidth / (1L << POLYGRID_MAX_DEPTH);
+   long i;
+
+   for (i = 0; i < 3; i++)
+      PosW[i] = -Grid->HalfWidth + h * Idx[i];
+}
+/**********************************************************************/
+static long PolyGravGridHashSlot(const struct PolyGravGridType *Grid,
+                                 long Key)
+{
+   unsigned long long h = (unsigned long long)Key * 0x9E3779B97F4A7C15ULL;
+   long Slot            = (long)(h >> 20) & Grid->HashMask;
+
+   while (Grid->Hash[Slot] >= 0 && Grid->Corner[Grid->Hash[Slot]].Key != Key)
+      Slot = (Slot + 1) & Grid->HashMask;
+   return (Slot);
+}
+/**********************************************************************/
+/* Exact acceleration and gradient at an integer corner, computed     */
+/* once and shared by every cell that touches it                      */
+static long PolyGravGridCorner(struct PolyGravGridType *Grid,
+                               const long Idx[3])
+{
+   double CWN[3][3] = {{1.0, 0.0, 0.0}, {0.0, 1.0, 0.0}, {0.0, 0.0, 1.0}};
+   const long Nside = (1L << POLYGRID_MAX_DEPTH) + 1;
+   struct PolyGravCornerType *C;
+   double PosW[3];
+   long Key, Slot, Ihash, Icorner;
+
+   Key  = (Idx[0] * Nside + Idx[1]) * Nside + Idx[2];
+   Slot = PolyGravGridHashSlot(Grid, Key);
+   if (Grid->Hash[Slot] >= 0)
+      return (Grid->Hash[Slot]);
+
+   if (Grid->Ncorner == Grid->NcornerAlloc) {
+      Grid->NcornerAlloc *= 2;
+      Grid->Corner        = (struct PolyGravCornerType *)PolyGravGridRealloc(
+          Grid->Corner,
+          Grid->NcornerAlloc * sizeof(struct PolyGravCornerType));
+   }
+   Icorner = Grid->Ncorner++;
+   C       = &Grid->Corner[Icorner];
+   C->Key  = Key;
+   PolyGravGridPos(Grid, Idx, PosW);
+   PolyhedronGravAcc(Grid->G, Grid->Density, PosW, CWN, C->Acc);
+   PolyhedronGravGrad(Grid->G, Grid->Density, PosW, CWN, C->Grad);
+
+   /* .. Keep the table at most half full */
+   if (2 * Grid->Ncorner > Grid->HashMask + 1) {
+      Grid->HashMask = 2 * Grid->HashMask + 1;
+      Grid->Hash     = (long *)PolyGravGridRealloc(
+          Grid->Hash, (Grid->HashMask + 1) * sizeof(long));
+      for (Ihash = 0; Ihash <= Grid->HashMask; Ihash++)
+         Grid->Hash[Ihash] = -1;
+      for (Ihash = 0; Ihash < Grid->Ncorner; Ihash++)
+         Grid->Hash[PolyGravGridHashSlot(Grid, Grid->Corner[Ihash].Key)] =
+             Ihash;
+   }
+   else
+      Grid->Hash[Slot] = Icorner;
+   return (Icorner);
+}
+/**********************************************************************/
+/* Corner k of the cell with low corner Idx0 and edge Size (in finest */
+/* cells) is offset by bit 2 of k in x, bit 1 in y and bit 0 in z     */
+static void PolyGravGridCornerIdx(const long Idx0[3], long Size, long k,
+                                  long Idx[3])
+{
+   long i;
+
+   for (i = 0; i < 3; i++)
+      Idx[i] = Idx0[i] + ((k >> (2 - i)) & 1) * Size;
+}
+/**********************************************************************/
+static void PolyGravGridInterp(const struct PolyGravGridType *Grid,
+                               const long Corner[8], const long Idx0[3],
+                               long Size, const double PosW[3],
+                               double AccW[3])
+{
+   const struct PolyGravCornerType *C;
+   double x[3], x0[3], dx[3], Gdx[3], t[3], w, h;
+   long Idx[3], k, i;
+
+   h = 2.0 * Grid->HalfWidth / (1L << POLYGRID_MAX_DEPTH) * Size;
+   PolyGravGridPos(Grid, Idx0, x0);
+   for (i = 0; i < 3; i++) {
+      t[i]    = (PosW[i] - x0[i]) / h;
+      AccW[i] = 0.0;
+   }
+   for (k = 0; k < 8; k++) {
+      C = &Grid->Corner[Corner[k]];
+      PolyGravGridCornerIdx(Idx0, Size, k, Idx);
+      PolyGravGridPos(Grid, Idx, x);
+      w = 1.0;
+      for (i = 0; i < 3; i++) {
+         w    *= ((k >> (2 - i)) & 1) ? t[i] : 1.0 - t[i];
+         dx[i] = PosW[i] - x[i];
+      }
+      MxV((double(*)[3])C->Grad, dx, Gdx);
+      for (i = 0; i < 3; i++)
+         AccW[i] += w * (C->Acc[i] + 0.5 * Gdx[i]);
+   }
+}
+/**********************************************************************/
+/* Decide what an untested cell is: split it, make it a leaf, or      */
+/* leave it to the exact sum                                          */
+static void PolyGravGridTestCell(struct PolyGravGridType *Grid, long Ic,
+                                 const long Idx0[3], long Size, long Depth)
+{
+   double CWN[3][3] = {{1.0, 0.0, 0.0}, {0.0, 1.0, 0.0}, {0.0, 0.0, 1.0}};
+   struct PolyGravCellType *Cell;
+   struct GeomType *G = Grid->G;
+   double Mid[3], Pt[3], Exact[3], Interp[3], Diff[3], dx[3];
+   double h, HalfDiag, MinDist;
+   long Corner[8], Idx[3], Iv, Ip, k, i;
+
+   if (Depth < POLYGRID_MIN_DEPTH) {
+      k                    = PolyGravGridNewCells(Grid);
+      Grid->Cell[Ic].Child = k;
+      Grid->Cell[Ic].State = POLYGRID_SPLIT;
+      return;
+   }
+
+   /* .. A surface point is within the longest edge of some vertex, so */
+   /*    a cell with no vertex that near can't hold any of the surface */
+   h = 2.0 * Grid->HalfWidth / (1L << POLYGRID_MAX_DEPTH) * Size;
+   PolyGravGridPos(Grid, Idx0, Mid);
+   for (i = 0; i < 3; i++)
+      Mid[i] += 0.5 * h;
+   HalfDiag = 0.5 * sqrt(3.0) * h;
+   MinDist  = HalfDiag + Grid->SurfMargin + 1.0;
+   for (Iv = 0; Iv < G->Nv && MinDist > HalfDiag + Grid->SurfMargin; Iv++) {
+      for (i = 0; i < 3; i++)
+         dx[i] = G->V[Iv][i] - Mid[i];
+      if (MAGV(dx) < MinDist)
+         MinDist = MAGV(dx);
+   }
+
+   if (MinDist > HalfDiag + Grid->SurfMargin) {
+      for (k = 0; k < 8; k++) {
+         PolyGravGridCornerIdx(Idx0, Size, k, Idx);
+         Corner[k] = PolyGravGridCorner(Grid, Idx);
+      }
+      /* .. The interpolant's cubic error vanishes at the center, so   */
+      /*    test where it peaks along each edge instead               */
+      for (Ip = 0; Ip < POLYGRID_NTEST; Ip++) {
+         for (i = 0; i < 3; i++)
+            Pt[i] = Mid[i] + h * PolyGravGridTestPt[Ip][i];
+         PolyhedronGravAcc(G, Grid->Density, Pt, CWN, Exact);
+         PolyGravGridInterp(Grid, Corner, Idx0, Size, Pt, Interp);
+         for (i = 0; i < 3; i++)
+            Diff[i] = Interp[i] - Exact[i];
+         if (MAGV(Diff) > Grid->Tol * MAGV(Exact))
+            break;
+      }
+      if (Ip == POLYGRID_NTEST) {
+         Cell        = &Grid->Cell[Ic];
+         Cell->State = POLYGRID_LEAF;
+         for (k = 0; k < 8; k++)
+            Cell->Corner[k] = Corner[k];
+         return;
+      }
+   }
+
+   if (Depth < POLYGRID_MAX_DEPTH) {
+      k                    = PolyGravGridNewCells(Grid);
+      Grid->Cell[Ic].Child = k;
+      Grid->Cell[Ic].State = POLYGRID_SPLIT;
+   }
+   else
+      Grid->Cell[Ic].State = POLYGRID_EXACT;
+}
+/**********************************************************************/
+/* Grid over the cube of half-width Ratio Brillouin radii, for        */
+/* accelerations within relative error Tol of PolyhedronGravAcc       */
+struct PolyGravGridType *CreatePolyGravGrid(struct GeomType *G, double Density,
+                                            double Tol, double Ratio)
+{
+   struct PolyGravGridType *Grid;
+   double Rbril = 0.0;
+   long Iv, Ie, Ihash;
+
+   Grid = (struct PolyGravGridType *)calloc(1, sizeof(*Grid));
+   if (Grid == NULL) {
+      fprintf(stderr,
+              "PolyGravGrid calloc returned null pointer.  Bailing out!\n");
+      exit(EXIT_FAILURE);
+   }
+   for (Iv = 0; Iv < G->Nv; Iv++) {
+      if (MAGV(G->V[Iv]) > Rbril)
+         Rbril = MAGV(G->V[Iv]);
+   }
+   for (Ie = 0; Ie < G->Nedge; Ie++) {
+      if (G->Edge[Ie].Length > Grid->SurfMargin)
+         Grid->SurfMargin = G->Edge[Ie].Length;
+   }
+   Grid->G          = G;
+   Grid->Density    = Density;
+   Grid->Tol        = Tol;
+   Grid->HalfWidth  = Ratio * Rbril;
+   Grid->NcellAlloc = 64;
+   Grid->Cell       = (struct PolyGravCellType *)PolyGravGridRealloc(
+       NULL, Grid->NcellAlloc * sizeof(struct PolyGravCellType));
+   Grid->Ncell          = 1;
+   Grid->Cell[0].State  = POLYGRID_UNTESTED;
+   Grid->NcornerAlloc   = 64;
+   Grid->Corner         = (struct PolyGravCornerType *)PolyGravGridRealloc(
+       NULL, Grid->NcornerAlloc * sizeof(struct PolyGravCornerType));
+   Grid->HashMask = 127;
+   Grid->Hash     =
+       (long *)PolyGravGridRealloc(NULL, (Grid->HashMask + 1) * sizeof(long));
+   for (Ihash = 0; Ihash <= Grid->HashMask; Ihash++)
+      Grid->Hash[Ihash] = -1;
+   pthread_mutex_init(&Grid->Mutex, NULL);
+   return (Grid);
+}
+/**********************************************************************/
+void DestroyPolyGravGrid(struct PolyGravGridType *Grid)
+{
+   if (Grid == NULL)
+      return;
+   pthread_mutex_destroy(&Grid->Mutex);
+   free(Grid->Hash);
+   free(Grid->Corner);
+   free(Grid->Cell);
+   free(Grid);
+}
+/**********************************************************************/
+/* Stands in for PolyhedronGravAcc, refining the grid as needed       */
+void PolyGravGridAcc(struct PolyGravGridType *Grid, double PosN[3],
+                     double CWN[3][3], double GravAccN[3])
+{
+   struct PolyGravCellType *Cell;
+   double PosW[3], AccW[3], x0[3], h;
+   long Idx0[3], Size, Depth, Ic, Oct, i;
+
+   MxV(CWN, PosN, PosW);
+   for (i = 0; i < 3; i++) {
+      if (fabs(PosW[i]) >= Grid->HalfWidth) {
+         PolyhedronGravAcc(Grid->G, Grid->Density, PosN, CWN, GravAccN);
+         return;
+      }
+   }
+
+   pthread_mutex_lock(&Grid->Mutex);
+   Ic    = 0;
+   Size  = 1L << POLYGRID_MAX_DEPTH;
+   Depth = 0;
+   for (i = 0; i < 3; i++)
+      Idx0[i] = 0;
+   while (1) {
+      if (Grid->Cell[Ic].State == POLYGRID_UNTESTED)
+         PolyGravGridTestCell(Grid, Ic, Idx0, Size, Depth);
+      Cell = &Grid->Cell[Ic];
+      if (Cell->State != POLYGRID_SPLIT)
+         break;
+      Size /= 2;
+      Depth++;
+      PolyGravGridPos(Grid, Idx0, x0);
+      h   = 2.0 * Grid->HalfWidth / (1L << POLYGRID_MAX_DEPTH) * Size;
+      Oct = 0;
+      for (i = 0; i < 3; i++) {
+         if (PosW[i] >= x0[i] + h) {
+            Idx0[i] += Size;
+            Oct     |= 1L << (2 - i);
+         }
+      }
+      Ic = Cell->Child + Oct;
+   }
+   if (Cell->State == POLYGRID_LEAF) {
+      PolyGravGridInterp(Grid, Cell->Corner, Idx0, Size, PosW, AccW);
+      pthread_mutex_unlock(&Grid->Mutex);
+      MTxV(CWN, AccW, GravAccN);
+   }
+   else {
+      pthread_mutex_unlock(&Grid->Mutex);
+      PolyhedronGravAcc(Grid->G, Grid->Density, PosN, CWN, GravAccN);
+   }
+}
+/**********************************************************************/
 void GravGradTimesInertia(double g[3][3], double I[3][3], double GGxI[3])
 {
    GGxI[0] = (I[2][2] - I[1][1]) * g[1][2] + (g[1][1] - g[2][2]) * I[1][2] +
@@ -1447,7 +1447,7 @@ void KalmanFilterTimeUpdate(struct KalmanFilterType *KF)
 /*  Ref Wie, "Singularity Escape/Avoidance Steering Logic for         */
 /*  Control Moment Gyro Systems", JGCD, Sep-Oct 2005                  */
 double CMGLaw4x1DOF(double Tcmd[3], double Axis[4][3], double Gim[4][3],
-                    double h[4], double AngRateCmd[4])
+                    double h[4], double *DitherPhase, double AngRateCmd[4])
 {
    double eps0  = 0.1;
    double lam0  = 0.01;
@@ -1456,7 +1456,6 @@ double CMGLaw4x1DOF(double Tcmd[3], double Axis[4][3], double Gim[4][3],
    double dt    = 0.1;
    double TwoPi = 6.2831853072;
    double A[3][4], AAt[3][3], Asharp[4][3], Gain;
-   static double wt = 0.0;
    double lam, eps;
    double V[3][3], W[4][4], AW[3][4], Den[3][3], InvDen[3][3];
 
@@ -1482,10 +1481,10 @@ double CMGLaw4x1DOF(double Tcmd[3], double Axis[4][3], double Gim[4][3],
        AAt[0][1] * AAt[1][0] * AAt[2][2] - AAt[0][0] * AAt[1][2] * AAt[2][1];
 
    /* Singularity Avoidance */
-   lam  = lam0 * exp(-mu * Gain);
-   eps  = eps0 * sin(wt);
-   wt  += w * dt;
-   wt   = fmod(wt, TwoPi);
+   lam           = lam0 * exp(-mu * Gain);
+   eps           = eps0 * sin(*DitherPhase);
+   *DitherPhase += w * dt;
+   *DitherPhase  = fmod(*DitherPhase, TwoPi);
 
    /* V */
    for (i = 0; i < 3; i++) {
@@ -229,6 +229,48 @@ void SurfaceForceProps(struct GeomType *G)
    }
 }
 /*********************************************************************/
+void BuildSurfTable(struct GeomType *G, const struct MatlType *Matl)
+{
+   struct SurfTableType *T = &G->Surf;
+   struct PolyType *P;
+   double *Block;
+   long Ip;
+
+   T->N  = G->Npoly;
+   Block = (double *)calloc(11 * (G->Npoly > 0 ? G->Npoly : 1), sizeof(double));
+   if (Block == NULL) {
+      fprintf(stderr, "BuildSurfTable calloc returned null pointer.  Bailing "
+                      "out!\n");
+      exit(EXIT_FAILURE);
+   }
+   T->Nx        = Block;
+   T->Ny        = T->Nx + T->N;
+   T->Nz        = T->Ny + T->N;
+   T->Area      = T->Nz + T->N;
+   T->Cx        = T->Area + T->N;
+   T->Cy        = T->Cx + T->N;
+   T->Cz        = T->Cy + T->N;
+   T->SpecFrac  = T->Cz + T->N;
+   T->DiffFrac  = T->SpecFrac + T->N;
+   T->ForceMask = T->DiffFrac + T->N;
+
+   /* Aero and SRP don't see shaded polys */
+   for (Ip = 0; Ip < G->Npoly; Ip++) {
+      P                = &G->Poly[Ip];
+      T->Nx[Ip]        = P->Norm[0];
+      T->Ny[Ip]        = P->Norm[1];
+      T->Nz[Ip]        = P->Norm[2];
+      T->Area[Ip]      = P->Area;
+      T->Cx[Ip]        = P->Centroid[0];
+      T->Cy[Ip]        = P->Centroid[1];
+      T->Cz[Ip]        = P->Centroid[2];
+      T->SpecFrac[Ip]  = Matl[P->Matl].SpecFrac;
+      T->DiffFrac[Ip]  = Matl[P->Matl].DiffFrac;
+      T->ForceMask[Ip] =
+          strncmp(Matl[P->Matl].Label, "SHADED", 6) ? 1.0 : 0.0;
+   }
+}
+/*********************************************************************/
 /* Ref Werner and Scheeres, "Exterior Gravitation of a Polyhedron ..." */
 void EdgeAndPolyDyads(struct GeomType *G)
 {
@@ -853,10 +895,10 @@ long OCProjectRayOntoGeom(double Point[3], double DirVec[3], struct GeomType *G,
    struct OctreeCellType *OC;
    double Point2[3], Dist, Vec[3], dr[3];
    double MinDist, RoD;
-   static double **Vtx;
+   static _Thread_local double **Vtx;
    long Exhausted, Ip, Iv, InPoly, i;
    long FoundPoly;
-   static long First = 1;
+   static _Thread_local long First = 1;
 
    if (First) {
       First = 0;
@@ -931,6 +973,404 @@ long OCProjectRayOntoGeom(double Point[3], double DirVec[3], struct GeomType *G,
    return (FoundPoly);
 }
 /*********************************************************************/
+/* Binary cache of a parsed OBJ, written next to it as <name>.geom.  */
+/* It is keyed on a hash of the OBJ text, so editing the OBJ forces  */
+/* a fresh parse.  Materials are stored by label and the mtllibs by  */
+/* name, since Matl indices depend on what was loaded before.        */
+#define GEOM_CACHE_VERSION 1
+struct GeomCacheHdrType {
+   char Magic[8];
+   long Version;
+   long SizeofPoly;
+   long SizeofEdge;
+   unsigned long long ObjHash;
+   long EdgesEnabled;
+   long Nv, Nvt, Nvn, Npoly, Nedge;
+   long Nindex;  /* Sum of Poly[].Nv */
+   long Nlabel;  /* Distinct materials used */
+   long Nmtllib; /* mtllib lines, in order */
+   long Nmatl;   /* G->Nmatl */
+   struct BoundingBoxType BBox;
+};
+/*********************************************************************/
+static unsigned long long GeomCacheHash(const char *ModelPath,
+                                        const char *ObjFilename)
+{
+   FILE *infile;
+   char FileName[1024];
+   unsigned char buf[65536];
+   unsigned long long h = 14695981039346656037ULL;
+   size_t N, i;
+
+   snprintf(FileName, sizeof(FileName), "%s%s", ModelPath, ObjFilename);
+   infile = fopen(FileName, "rb");
+   if (infile == NULL)
+      return (0);
+   while ((N = fread(buf, 1, sizeof(buf), infile)) > 0) {
+      for (i = 0; i < N; i++) {
+         h ^= buf[i];
+         h *= 1099511628211ULL;
+      }
+   }
+   fclose(infile);
+   return (h);
+}
+/*********************************************************************/
+/* Cache name, relative to ModelPath */
+static void GeomCacheFileName(const char *ObjFilename, char *FileName,
+                              size_t Size)
+{
+   char *dot;
+
+   snprintf(FileName, Size, "%s", ObjFilename);
+   dot = strrchr(FileName, '.');
+   if (dot != NULL && strchr(dot, '/') == NULL)
+      *dot = 0;
+   strncat(FileName, ".geom", Size - strlen(FileName) - 1);
+}
+/*********************************************************************/
+static long FindMatlByLabel(const char *Label, const struct MatlType *Matl,
+                            long Nmatl)
+{
+   long Im;
+
+   for (Im = 0; Im < Nmatl; Im++) {
+      if (!strcmp(Label, Matl[Im].Label))
+         return (Im);
+   }
+   for (Im = 0; Im < Nmatl; Im++) {
+      if (!strcmp("default", Matl[Im].Label))
+         return (Im);
+   }
+   fprintf(stderr, "Material %s not found, and default material not found "
+                   "either\n",
+           Label);
+   exit(EXIT_FAILURE);
+}
+/*********************************************************************/
+static void WriteGeomCache(const char *ModelPath, const char *ObjFilename,
+                           unsigned long long ObjHash, long EdgesEnabled,
+                           struct GeomType *G, const struct MatlType *Matl,
+                           long Nmatl, const char *MtlLib, long Nmtllib)
+{
+   struct GeomCacheHdrType H;
+   struct PolyType Poly;
+   FILE *outfile;
+   char CacheName[1024], TmpName[1024];
+   long *Map, Lbl, Ip, Im;
+
+   if (ObjHash == 0)
+      return;
+   /* .. Written aside and renamed into place, so a reader never sees */
+   /*    a partial cache                                              */
+   GeomCacheFileName(ObjFilename, CacheName, sizeof(CacheName));
+   outfile = OpenTempFile(ModelPath, CacheName, TmpName);
+   if (outfile == NULL)
+      return; /* Read-only Model directory.  Parse again next time. */
+
+   /* Map global Matl indices onto a local label table */
+   Map = (long *)malloc((Nmatl > 0 ? Nmatl : 1) * sizeof(long));
+   if (Map == NULL) {
+      fprintf(stderr, "WriteGeomCache malloc returned null pointer.  Bailing "
+                      "out!\n");
+      exit(EXIT_FAILURE);
+   }
+   for (Im = 0; Im < Nmatl; Im++)
+      Map[Im] = -1;
+
+   memset(&H, 0, sizeof(H));
+   strcpy(H.Magic, "42GEOM");
+   H.Version      = GEOM_CACHE_VERSION;
+   H.SizeofPoly   = sizeof(struct PolyType);
+   H.SizeofEdge   = sizeof(struct EdgeType);
+   H.ObjHash      = ObjHash;
+   H.EdgesEnabled = EdgesEnabled;
+   H.Nv           = G->Nv;
+   H.Nvt          = G->Nvt;
+   H.Nvn          = G->Nvn;
+   H.Npoly        = G->Npoly;
+   H.Nedge        = G->Nedge;
+   H.Nmtllib      = Nmtllib;
+   H.Nmatl        = G->Nmatl;
+   H.BBox         = G->BBox;
+   for (Ip = 0; Ip < G->Npoly; Ip++) {
+      H.Nindex += G->Poly[Ip].Nv;
+      if (Map[G->Poly[Ip].Matl] < 0)
+         Map[G->Poly[Ip].Matl] = H.Nlabel++;
+   }
+   for (Im = 0; Im < G->Nmatl; Im++) {
+      if (Map[G->Matl[Im]] < 0)
+         Map[G->Matl[Im]] = H.Nlabel++;
+   }
+
+   fwrite(&H, sizeof(H), 1, outfile);
+   fwrite(MtlLib, 40, Nmtllib, outfile);
+   for (Lbl = 0; Lbl < H.Nlabel; Lbl++) {
+      for (Im = 0; Map[Im] != Lbl; Im++)
+         ;
+      fwrite(Matl[Im].Label, 40, 1, outfile);
+   }
+   for (Im = 0; Im < G->Nmatl; Im++)
+      fwrite(&Map[G->Matl[Im]], sizeof(long), 1, outfile);
+   if (G->Nv > 0)
+      fwrite(G->V[0], sizeof(double), 3 * G->Nv, outfile);
+   if (G->Nvt > 0)
+      fwrite(G->Vt[0], sizeof(double), 2 * G->Nvt, outfile);
+   if (G->Nvn > 0)
+      fwrite(G->Vn[0], sizeof(double), 3 * G->Nvn, outfile);
+   for (Ip = 0; Ip < G->Npoly; Ip++) {
+      Poly      = G->Poly[Ip];
+      Poly.V    = NULL;
+      Poly.Vt   = NULL;
+      Poly.Vn   = NULL;
+      Poly.E    = NULL;
+      Poly.Matl = Map[Poly.Matl];
+      fwrite(&Poly, sizeof(Poly), 1, outfile);
+   }
+   for (Ip = 0; Ip < G->Npoly; Ip++) {
+      fwrite(G->Poly[Ip].V, sizeof(long), G->Poly[Ip].Nv, outfile);
+      fwrite(G->Poly[Ip].Vt, sizeof(long), G->Poly[Ip].Nv, outfile);
+      fwrite(G->Poly[Ip].Vn, sizeof(long), G->Poly[Ip].Nv, outfile);
+      if (EdgesEnabled)
+         fwrite(G->Poly[Ip].E, sizeof(long), G->Poly[Ip].Nv, outfile);
+   }
+   fwrite(G->Edge, sizeof(struct EdgeType), G->Nedge, outfile);
+   free(Map);
+
+   if (ferror(outfile)) {
+      fclose(outfile);
+      remove(TmpName);
+      return;
+   }
+   CommitTempFile(outfile, TmpName, ModelPath, CacheName);
+}
+/*********************************************************************/
+/* Returns 1 if G was filled from a valid cache, 0 to parse the OBJ  */
+static long ReadGeomCache(const char *ModelPath, const char *ObjFilename,
+                          unsigned long long ObjHash, long EdgesEnabled,
+                          struct GeomType *G, struct MatlType **MatlPtr,
+                          long *Nmatl)
+{
+   struct GeomCacheHdrType H;
+   FILE *infile;
+   char CacheName[1024], FileName[2048];
+   char *MtlLib, (*Label)[40];
+   long *Index, *LblMatl, Nper, Ip, Im;
+   long Size, Ok;
+   struct MatlType *Matl;
+   struct PolyType *P;
+
+   if (ObjHash == 0)
+      return (0);
+   GeomCacheFileName(ObjFilename, CacheName, sizeof(CacheName));
+   snprintf(FileName, sizeof(FileName), "%s%s", ModelPath, CacheName);
+   infile = fopen(FileName, "rb");
+   if (infile == NULL)
+      return (0);
+   if (fread(&H, sizeof(H), 1, infile) != 1 || strcmp(H.Magic, "42GEOM") ||
+       H.Version != GEOM_CACHE_VERSION ||
+       H.SizeofPoly != (long)sizeof(struct PolyType) ||
+       H.SizeofEdge != (long)sizeof(struct EdgeType) ||
+       H.ObjHash != ObjHash || H.EdgesEnabled != EdgesEnabled) {
+      fclose(infile);
+      return (0);
+   }
+   Nper = (EdgesEnabled ? 4 : 3);
+   Size = sizeof(H) + 40 * (H.Nmtllib + H.Nlabel) + sizeof(long) * H.Nmatl +
+          sizeof(double) * (3 * H.Nv + 2 * H.Nvt + 3 * H.Nvn) +
+          sizeof(struct PolyType) * H.Npoly +
+          sizeof(long) * Nper * H.Nindex + sizeof(struct EdgeType) * H.Nedge;
+   fseek(infile, 0, SEEK_END);
+   if (ftell(infile) != Size || H.Nlabel < 1) {
+      fclose(infile);
+      return (0);
+   }
+   fseek(infile, sizeof(H), SEEK_SET);
+
+   MtlLib  = (char *)malloc(40 * H.Nmtllib + 1);
+   Label   = (char(*)[40])malloc(40 * H.Nlabel);
+   LblMatl = (long *)malloc(H.Nlabel * sizeof(long));
+   G->Matl = (long *)calloc(H.Nmatl > 2 ? H.Nmatl : 2, sizeof(long));
+   G->V    = CreateMatrix(H.Nv, 3);
+   G->Vt   = CreateMatrix(H.Nvt, 2);
+   G->Vn   = CreateMatrix(H.Nvn, 3);
+   G->Poly = (struct PolyType *)calloc(H.Npoly > 0 ? H.Npoly : 1,
+                                       sizeof(struct PolyType));
+   G->Edge = (struct EdgeType *)calloc(H.Nedge > 0 ? H.Nedge : 1,
+                                       sizeof(struct EdgeType));
+   Index   = (long *)calloc(Nper * H.Nindex + 1, sizeof(long));
+   if (MtlLib == NULL || Label == NULL || LblMatl == NULL || G->Matl == NULL ||
+       G->Poly == NULL || G->Edge == NULL || Index == NULL) {
+      fprintf(stderr, "ReadGeomCache alloc returned null pointer.  Bailing "
+                      "out!\n");
+      exit(EXIT_FAILURE);
+   }
+
+   Ok = fread(MtlLib, 40, H.Nmtllib, infile) == (size_t)H.Nmtllib &&
+        fread(Label, 40, H.Nlabel, infile) == (size_t)H.Nlabel &&
+        fread(G->Matl, sizeof(long), H.Nmatl, infile) == (size_t)H.Nmatl &&
+        (H.Nv == 0 ||
+         fread(G->V[0], sizeof(double), 3 * H.Nv, infile) ==
+             (size_t)(3 * H.Nv)) &&
+        (H.Nvt == 0 ||
+         fread(G->Vt[0], sizeof(double), 2 * H.Nvt, infile) ==
+             (size_t)(2 * H.Nvt)) &&
+        (H.Nvn == 0 ||
+         fread(G->Vn[0], sizeof(double), 3 * H.Nvn, infile) ==
+             (size_t)(3 * H.Nvn)) &&
+        fread(G->Poly, sizeof(struct PolyType), H.Npoly, infile) ==
+            (size_t)H.Npoly &&
+        fread(Index, sizeof(long), Nper * H.Nindex, infile) ==
+            (size_t)(Nper * H.Nindex) &&
+        fread(G->Edge, sizeof(struct EdgeType), H.Nedge, infile) ==
+            (size_t)H.Nedge;
+   fclose(infile);
+   for (Im = 0; Ok && Im < H.Nmatl; Im++)
+      Ok = (G->Matl[Im] >= 0 && G->Matl[Im] < H.Nlabel);
+   for (Ip = 0; Ok && Ip < H.Npoly; Ip++)
+      Ok = (G->Poly[Ip].Matl >= 0 && G->Poly[Ip].Matl < H.Nlabel);
+   if (!Ok) {
+      free(MtlLib);
+      free(Label);
+      free(LblMatl);
+      free(G->Matl);
+      DestroyMatrix(G->V);
+      DestroyMatrix(G->Vt);
+      DestroyMatrix(G->Vn);
+      free(G->Poly);
+      free(G->Edge);
+      free(Index);
+      return (0);
+   }
+
+   /* Load the same mtllibs the OBJ names, then resolve labels */
+   Matl = *MatlPtr;
+   for (Im = 0; Im < H.Nmtllib; Im++) {
+      Matl     = AddMtlLib(ModelPath, &MtlLib[40 * Im], Matl, Nmatl);
+      *MatlPtr = Matl;
+      ScaleSpecDiffFrac(Matl, *Nmatl);
+   }
+   for (Im = 0; Im < H.Nlabel; Im++)
+      LblMatl[Im] = FindMatlByLabel(Label[Im], Matl, *Nmatl);
+   for (Im = 0; Im < H.Nmatl; Im++)
+      G->Matl[Im] = LblMatl[G->Matl[Im]];
+
+   G->Nmatl = H.Nmatl;
+   G->Nv    = H.Nv;
+   G->Nvt   = H.Nvt;
+   G->Nvn   = H.Nvn;
+   G->Npoly = H.Npoly;
+   G->Nedge = H.Nedge;
+   G->BBox  = H.BBox;
+   for (Ip = 0; Ip < G->Npoly; Ip++) {
+      P       = &G->Poly[Ip];
+      P->Matl = LblMatl[P->Matl];
+      P->V    = Index;
+      P->Vt   = Index + P->Nv;
+      P->Vn   = Index + 2 * P->Nv;
+      P->E    = (EdgesEnabled ? Index + 3 * P->Nv : NULL);
+      Index  += Nper * P->Nv;
+   }
+   if (G->Nedge == 0) {
+      free(G->Edge);
+      G->Edge = NULL;
+   }
+   free(MtlLib);
+   free(Label);
+   free(LblMatl);
+
+   BuildSurfTable(G, Matl);
+   return (1);
+}
+/*********************************************************************/
+/* Open-addressed hash of directed edges (Vtx1,Vtx2).  Returns the   */
+/* slot holding that edge, or the empty slot where it would go.      */
+static long FindEdgeSlot(const long *Slot, long Mask,
+                         const struct EdgeType *Edge, long Vtx1, long Vtx2)
+{
+   unsigned long h;
+
+   h = ((unsigned long)Vtx1 * 2654435761UL) ^
+       ((unsigned long)Vtx2 * 40503UL + 0x9E3779B9UL);
+   h &= (unsigned long)Mask;
+   while (Slot[h] >= 0 &&
+          (Edge[Slot[h]].Vtx1 != Vtx1 || Edge[Slot[h]].Vtx2 != Vtx2))
+      h = (h + 1) & (unsigned long)Mask;
+   return ((long)h);
+}
+/*********************************************************************/
+/* Each poly edge V1->V2 is matched to an existing edge V2->V1, the  */
+/* first one made, if there is one.  Otherwise it starts a new edge. */
+static void BuildEdgeTable(struct GeomType *G)
+{
+   struct PolyType *P;
+   struct EdgeType *E;
+   double V[3];
+   long *Slot, *Eblock;
+   long MaxEdge, Nslot, Mask, Ip, Iv, Ie, V1, V2, h, i;
+
+   MaxEdge = 0;
+   for (Ip = 0; Ip < G->Npoly; Ip++)
+      MaxEdge += G->Poly[Ip].Nv;
+   Nslot = 16;
+   while (Nslot < 2 * MaxEdge)
+      Nslot *= 2;
+   Mask    = Nslot - 1;
+   Slot    = (long *)malloc(Nslot * sizeof(long));
+   Eblock  = (long *)calloc(MaxEdge > 0 ? MaxEdge : 1, sizeof(long));
+   G->Edge = (struct EdgeType *)calloc(MaxEdge > 0 ? MaxEdge : 1,
+                                       sizeof(struct EdgeType));
+   if (Slot == NULL || Eblock == NULL || G->Edge == NULL) {
+      fprintf(stderr, "BuildEdgeTable alloc returned null pointer.  Bailing "
+                      "out!\n");
+      exit(EXIT_FAILURE);
+   }
+   for (h = 0; h < Nslot; h++)
+      Slot[h] = -1;
+
+   G->Nedge = 0;
+   for (Ip = 0; Ip < G->Npoly; Ip++) {
+      P       = &G->Poly[Ip];
+      P->E    = Eblock;
+      Eblock += P->Nv;
+      for (Iv = 0; Iv < P->Nv; Iv++) {
+         V1 = P->V[Iv];
+         V2 = P->V[(Iv + 1) % P->Nv];
+         h  = FindEdgeSlot(Slot, Mask, G->Edge, V2, V1);
+         if (Slot[h] >= 0) {
+            Ie                = Slot[h];
+            G->Edge[Ie].Poly2 = Ip;
+            P->E[Iv]          = Ie;
+         }
+         else {
+            Ie       = G->Nedge++;
+            E        = &G->Edge[Ie];
+            E->Vtx1  = V1;
+            E->Vtx2  = V2;
+            E->Poly1 = Ip;
+            E->Poly2 = -1;
+            for (i = 0; i < 3; i++)
+               V[i] = G->V[V1][i] - G->V[V2][i];
+            E->Length = MAGV(V);
+            P->E[Iv]  = Ie;
+            /* Later duplicates of V1->V2 never shadow the first */
+            h = FindEdgeSlot(Slot, Mask, G->Edge, V1, V2);
+            if (Slot[h] < 0)
+               Slot[h] = Ie;
+         }
+      }
+   }
+   free(Slot);
+   if (G->Nedge > 0) {
+      G->Edge = (struct EdgeType *)realloc(G->Edge,
+                                           G->Nedge * sizeof(struct EdgeType));
+   }
+   else {
+      free(G->Edge);
+      G->Edge = NULL;
+   }
+}
+/*********************************************************************/
 struct GeomType *LoadWingsObjFile(const char *ModelPath,
                                   const char *ObjFilename,
                                   struct MatlType **MatlPtr, long *Nmatl,
@@ -942,16 +1382,12 @@ struct GeomType *LoadWingsObjFile(const char *ModelPath,
    char *txtptr;
    double V[3];
    double r[3], magr;
-   long V1, V2;
    long Ng, Ig, Iv, Im;
    long I, It, In, i, j, MatlIdx;
    long Ivtx, Ivt, Ivn, Ipoly;
-   long Ip, Ie;
    struct GeomType *G;
    struct PolyType *P;
-   void *Ptr;
    struct MatlType *Matl;
-   long BeenHereOnce;
    long NoArraySizesFound;
    double Value, Scale = 1.0;
    double Val1, Val2, Val3;
@@ -961,6 +1397,9 @@ struct GeomType *LoadWingsObjFile(const char *ModelPath,
    double TransVec[3] = {0.0, 0.0, 0.0};
    double Vr[3];
    long FirstUse;
+   unsigned long long ObjHash;
+   char *MtlLibList = NULL;
+   long Nmtllib     = 0;
 
    char line[512], vtxstring[512], *vtxtoken, MatlName[40];
    char MtlLibName[40];
@@ -989,6 +1428,7 @@ struct GeomType *LoadWingsObjFile(const char *ModelPath,
    G->Npoly           = 0;
    G->Nedge           = 0;
    MatlIdx            = 0;
+   memset(&G->Surf, 0, sizeof(struct SurfTableType));
 
    /* Allow a Null Geom entry */
    if (!strcmp(G->ObjFileName, "NONE")) {
@@ -997,6 +1437,15 @@ struct GeomType *LoadWingsObjFile(const char *ModelPath,
       return (Geom);
    }
 
+   /* A .geom left by an earlier run of this same OBJ skips the parse */
+   ObjHash = GeomCacheHash(ModelPath, ObjFilename);
+   if (ReadGeomCache(ModelPath, ObjFilename, ObjHash, EdgesEnabled, G,
+                     MatlPtr, Nmatl)) {
+      *Ngeom   = Ng;
+      *GeomTag = Ng - 1;
+      return (Geom);
+   }
+
    /* These will be expanded as needed */
    G->Matl = (long *)calloc(2, sizeof(long));
    if (G->Matl == NULL) {
@@ -1193,6 +1642,13 @@ struct GeomType *LoadWingsObjFile(const char *ModelPath,
          Matl     = AddMtlLib(ModelPath, MtlLibName, Matl, Nmatl);
          *MatlPtr = Matl;
          ScaleSpecDiffFrac(Matl, *Nmatl);
+         Nmtllib++;
+         MtlLibList = (char *)realloc(MtlLibList, 40 * Nmtllib);
+         if (MtlLibList == NULL) {
+            fprintf(stderr, "Realloc failed in LoadWingsObjFile\n");
+            exit(EXIT_FAILURE);
+         }
+         memcpy(&MtlLibList[40 * (Nmtllib - 1)], MtlLibName, 40);
       }
       else if (sscanf(line, "usemtl %s", MatlName) == 1) {
          MatlIdx = 0;
@@ -1262,58 +1718,12 @@ struct GeomType *LoadWingsObjFile(const char *ModelPath,
    for (i = 0; i < G->Nvn; i++)
       UNITV(G->Vn[i]);
 
-   if (EdgesEnabled) {
-      /* Build Edge Tables */
-      G->Nedge = 0;
-      for (Ip = 0; Ip < G->Npoly; Ip++) {
-         P    = &G->Poly[Ip];
-         P->E = (long *)calloc(P->Nv, sizeof(long));
-         for (Iv = 0; Iv < P->Nv; Iv++) {
-            V1           = P->V[Iv];
-            V2           = P->V[(Iv + 1) % P->Nv];
-            BeenHereOnce = 0;
-            for (Ie = 0; Ie < G->Nedge; Ie++) {
-               if (G->Edge[Ie].Vtx1 == V2) {
-                  if (G->Edge[Ie].Vtx2 == V1) {
-                     BeenHereOnce      = 1;
-                     G->Edge[Ie].Poly2 = Ip;
-                     P->E[Iv]          = Ie;
-                     break;
-                  }
-               }
-            }
-            if (!BeenHereOnce) {
-               G->Nedge++;
-               if (G->Nedge == 1) {
-                  Ptr = calloc(1, sizeof(struct EdgeType));
-                  if (Ptr == NULL) {
-                     fprintf(stderr, "Realloc failed in LoadWingsObjFile\n");
-                     exit(EXIT_FAILURE);
-                  }
-               }
-               else {
-                  Ptr = realloc(G->Edge, G->Nedge * sizeof(struct EdgeType));
-                  if (Ptr == NULL) {
-                     fprintf(stderr, "Realloc failed in LoadWingsObjFile\n");
-                     exit(EXIT_FAILURE);
-                  }
-               }
-               G->Edge                     = (struct EdgeType *)Ptr;
-               G->Edge[G->Nedge - 1].Vtx1  = V1;
-               G->Edge[G->Nedge - 1].Vtx2  = V2;
-               G->Edge[G->Nedge - 1].Poly1 = Ip;
-               G->Edge[G->Nedge - 1].Poly2 = -1;
-               for (i = 0; i < 3; i++)
-                  V[i] = G->V[V1][i] - G->V[V2][i];
-               G->Edge[G->Nedge - 1].Length = MAGV(V);
-               P->E[Iv]                     = G->Nedge - 1;
-            }
-         }
-      }
-   }
+   if (EdgesEnabled)
+      BuildEdgeTable(G);
 
    /* Find Normals, Areas, Centroids for use in surface force models */
    SurfaceForceProps(G);
+   BuildSurfTable(G, Matl);
 
    /* For polyhedron gravity */
    if (EdgesEnabled)
@@ -1333,6 +1743,13 @@ struct GeomType *LoadWingsObjFile(const char *ModelPath,
       }
    }
 
+   /* The "# Nv" line above may have changed the OBJ since it was hashed */
+   if (NoArraySizesFound)
+      ObjHash = GeomCacheHash(ModelPath, ObjFilename);
+   WriteGeomCache(ModelPath, ObjFilename, ObjHash, EdgesEnabled, G, Matl,
+                  *Nmatl, MtlLibList, Nmtllib);
+   free(MtlLibList);
+
    *Ngeom   = Ng;
    *GeomTag = Ng - 1;
    return (Geom);
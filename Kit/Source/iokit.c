@@ -12,11 +12,61 @@
 /*    All Other Rights Reserved.                                      */
 
 #include "iokit.h"
+#include "42constants.h"
+#if !defined(_WIN32)
+#include <limits.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <time.h>
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+#else
+#include <io.h>
+#endif
 
 /* #ifdef __cplusplus
 ** namespace Kit {
 ** #endif
 */
+/* Overrides for the YAML files read on this thread */
+static SIMLOCAL const struct YamlOverrideType *YamlOverride = NULL;
+static SIMLOCAL long NyamlOverride                         = 0;
+/**********************************************************************/
+/* The table is not copied; it must outlive the files it applies to.  */
+/* Pass NULL, 0 to clear.                                             */
+void SetYamlOverrides(const struct YamlOverrideType *Ov, long Nov)
+{
+   YamlOverride  = Ov;
+   NyamlOverride = Nov;
+}
+/**********************************************************************/
+static void ApplyYamlOverrides(struct fy_document *fyd, const char *fileName)
+{
+   const struct YamlOverrideType *O;
+   struct fy_node *Node, *Val;
+   long i;
+
+   for (i = 0; i < NyamlOverride; i++) {
+      O = &YamlOverride[i];
+      if (strcmp(O->File, fileName))
+         continue;
+      Node = fy_node_by_path_def(fy_document_root(fyd), O->Path);
+      if (Node == NULL) {
+         fprintf(stderr, "Override path %s not found in %s. Exiting...\n",
+                 O->Path, fileName);
+         exit(EXIT_FAILURE);
+      }
+      /* Inserting a scalar replaces the node in its parent */
+      Val = fy_node_create_scalar_copy(fyd, O->Value, strlen(O->Value));
+      if (Val == NULL || fy_node_insert(Node, Val)) {
+         fprintf(stderr, "Could not override %s in %s. Exiting...\n",
+                 O->Path, fileName);
+         exit(EXIT_FAILURE);
+      }
+   }
+}
 /**********************************************************************/
 struct fy_document *fy_document_build_and_check(const struct fy_parse_cfg *cfg,
                                                 const char *path,
@@ -37,6 +87,8 @@ struct fy_document *fy_document_build_and_check(const struct fy_parse_cfg *cfg,
       fy_document_destroy(fyd);
       exit(EXIT_FAILURE);
    }
+   if (NyamlOverride > 0)
+      ApplyYamlOverrides(fyd, fileName);
    return fyd;
 }
 /**********************************************************************/
@@ -257,6 +309,127 @@ double *PpmToPsf(const char *path, const char *filename, long *width,
    return (PSF);
 }
 /**********************************************************************/
+/* Read-only view of a whole file.  Returns NULL, without complaint,  */
+/* if the file can't be opened, so callers may fall back to another   */
+/* source.  Release with UnmapFile.                                   */
+void *MapFile(const char *Path, const char *File, size_t *Size)
+{
+   char FileName[1024];
+   void *Map;
+
+   strcpy(FileName, Path);
+   strcat(FileName, File);
+   *Size = 0;
+
+#if defined(_WIN32)
+   FILE *infile;
+   long Len;
+
+   infile = fopen(FileName, "rb");
+   if (infile == NULL)
+      return (NULL);
+   fseek(infile, 0, SEEK_END);
+   Len = ftell(infile);
+   rewind(infile);
+   Map = NULL;
+   if (Len > 0) {
+      Map = malloc(Len);
+      if (Map != NULL && fread(Map, 1, Len, infile) != (size_t)Len) {
+         free(Map);
+         Map = NULL;
+      }
+   }
+   fclose(infile);
+   if (Map != NULL)
+      *Size = (size_t)Len;
+#else
+   struct stat FileStatus;
+   int fd;
+
+   fd = open(FileName, O_RDONLY);
+   if (fd == -1)
+      return (NULL);
+   if (fstat(fd, &FileStatus) || FileStatus.st_size <= 0) {
+      close(fd);
+      return (NULL);
+   }
+   Map = mmap(NULL, FileStatus.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+   close(fd);
+   if (Map == MAP_FAILED)
+      return (NULL);
+   *Size = FileStatus.st_size;
+#endif
+   return (Map);
+}
+/**********************************************************************/
+void UnmapFile(void *Map, size_t Size)
+{
+   if (Map == NULL)
+      return;
+#if defined(_WIN32)
+   free(Map);
+#else
+   munmap(Map, Size);
+#endif
+}
+/**********************************************************************/
+/* Open a uniquely named scratch file beside Path/File for writing.   */
+/* CommitTempFile then renames it over Path/File, so another process  */
+/* reading or mapping the old file never sees it truncated or half    */
+/* written.  Returns NULL if the scratch file can't be created.       */
+FILE *OpenTempFile(const char *Path, const char *File, char TmpName[1024])
+{
+#if defined(_WIN32)
+   snprintf(TmpName, 1024, "%s%s.%lu.%lu", Path, File,
+            (unsigned long)GetCurrentProcessId(),
+            (unsigned long)GetCurrentThreadId());
+   return (fopen(TmpName, "wb"));
+#else
+   FILE *file;
+   int fd;
+
+   snprintf(TmpName, 1024, "%s%s.XXXXXX", Path, File);
+   fd = mkstemp(TmpName);
+   if (fd == -1)
+      return (NULL);
+   fchmod(fd, 0644);
+   file = fdopen(fd, "wb");
+   if (file == NULL) {
+      close(fd);
+      remove(TmpName);
+   }
+   return (file);
+#endif
+}
+/**********************************************************************/
+/* Flush the scratch file to disk and move it into place.  On failure */
+/* the scratch file is removed and nonzero is returned.               */
+long CommitTempFile(FILE *file, const char *TmpName, const char *Path,
+                    const char *File)
+{
+   char FileName[1024];
+   long Failed;
+
+   snprintf(FileName, 1024, "%s%s", Path, File);
+   Failed = (fflush(file) != 0);
+#if defined(_WIN32)
+   if (!Failed)
+      Failed = (_commit(_fileno(file)) != 0);
+   Failed |= (fclose(file) != 0);
+   if (!Failed)
+      Failed = !MoveFileExA(TmpName, FileName, MOVEFILE_REPLACE_EXISTING);
+#else
+   if (!Failed)
+      Failed = (fsync(fileno(file)) != 0);
+   Failed |= (fclose(file) != 0);
+   if (!Failed)
+      Failed = (rename(TmpName, FileName) != 0);
+#endif
+   if (Failed)
+      remove(TmpName);
+   return (Failed);
+}
+/**********************************************************************/
 SOCKET InitSocketServer(int Port, int AllowBlocking)
 {
 #if defined(_WIN32)
@@ -459,6 +632,370 @@ SOCKET InitSocketClient(const char *hostname, int Port, int AllowBlocking)
    return (sockfd);
 #endif /* _WIN32 */
 }
+/**********************************************************************/
+/*  Shared-memory link between two processes on one host.  The        */
+/*  segment holds one single-producer/single-consumer ring per        */
+/*  direction.  Each message is stored contiguously as an 8-byte      */
+/*  length and its payload, padded to 8 bytes; a length of -1 tells   */
+/*  the reader to wrap to the start of the ring.  Head and Tail are   */
+/*  running byte counts, so the ring is empty when they are equal.    */
+/*  A reader that has spun for a while sleeps on a futex (Linux) or   */
+/*  polls (elsewhere) until the writer bumps Seq.                     */
+#if !defined(_WIN32)
+
+#define SHM_MAGIC    0x34325348 /* "42SH" */
+#define SHM_VERSION  1
+#define SHM_RINGSIZE (1L << 20)
+#define SHM_NSPIN    2000
+
+struct ShmRingType {
+   _Alignas(64) atomic_llong Head; /* Bytes published by the writer */
+   _Alignas(64) atomic_llong Tail; /* Bytes released by the reader */
+   _Alignas(64) atomic_int Seq;    /* Bumped whenever Head or Tail moves */
+   atomic_int Sleepers;            /* Processes waiting for Seq to change */
+};
+
+struct ShmSegmentType {
+   atomic_int Magic;    /* Set last by the server */
+   atomic_int Attached; /* 0 = free, 1 = claimed, 2 = client ready */
+   long Version;
+   long RingSize;
+   long Pid[2]; /* Server, client */
+   struct ShmRingType Ring[2]; /* Server to client, client to server */
+   /* Ring[0] data, then Ring[1] data */
+};
+
+struct ShmLinkType {
+   struct ShmSegmentType *Seg;
+   size_t MapSize;
+   struct ShmRingType *Tx;
+   struct ShmRingType *Rx;
+   char *TxData;
+   char *RxData;
+   long long Mask;
+   long PeerPid;
+   long Nspin; /* No point spinning if the peer can't run meanwhile */
+   int AllowBlocking;
+   long long Pending; /* Rx Tail once the current message is released */
+};
+
+/**********************************************************************/
+static void ShmName(int Port, char *Name)
+{
+   sprintf(Name, "/42ipc_%d", Port);
+}
+/**********************************************************************/
+static long ShmPeerAlive(struct ShmLinkType *L)
+{
+   return (kill((pid_t)L->PeerPid, 0) == 0 || errno != ESRCH);
+}
+/**********************************************************************/
+static void ShmWake(struct ShmRingType *R)
+{
+   atomic_fetch_add(&R->Seq, 1);
+   if (atomic_load(&R->Sleepers) > 0) {
+#if defined(__linux__)
+      syscall(SYS_futex, (int *)&R->Seq, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+#endif
+   }
+}
+/**********************************************************************/
+/* Sleep until Seq moves away from OldSeq, or for at most a second    */
+static void ShmSleep(struct ShmRingType *R, int OldSeq)
+{
+#if defined(__linux__)
+   struct timespec Timeout = {1, 0};
+
+   syscall(SYS_futex, (int *)&R->Seq, FUTEX_WAIT, OldSeq, &Timeout, NULL, 0);
+#else
+   struct timespec Nap = {0, 20000};
+   long i;
+
+   for (i = 0; i < 50000 && atomic_load(&R->Seq) == OldSeq; i++)
+      nanosleep(&Nap, NULL);
+#endif
+}
+/**********************************************************************/
+static long long ShmAvail(struct ShmLinkType *L, struct ShmRingType *R)
+{
+   long long Used = atomic_load(&R->Head) - atomic_load(&R->Tail);
+
+   return (R == L->Tx ? L->Mask + 1 - Used : Used);
+}
+/**********************************************************************/
+/* Returns 1 once ring R has Need bytes free (Tx) or waiting (Rx), or */
+/* 0 if the peer has gone away                                        */
+static long ShmWait(struct ShmLinkType *L, struct ShmRingType *R,
+                    long long Need)
+{
+   long Ispin = 0;
+   int Seq;
+
+   while (ShmAvail(L, R) < Need) {
+      if (Ispin < L->Nspin) {
+         Ispin++;
+         continue;
+      }
+      /* Only ask after a sleep, to keep the kill() off the fast path */
+      if (Ispin > L->Nspin && !ShmPeerAlive(L))
+         return (0);
+      Ispin = L->Nspin + 1;
+      Seq   = atomic_load(&R->Seq);
+      atomic_fetch_add(&R->Sleepers, 1);
+      if (ShmAvail(L, R) < Need)
+         ShmSleep(R, Seq);
+      atomic_fetch_sub(&R->Sleepers, 1);
+   }
+   return (1);
+}
+/**********************************************************************/
+static struct ShmLinkType *ShmLink(struct ShmSegmentType *Seg,
+                                   size_t MapSize, long Side,
+                                   int AllowBlocking)
+{
+   struct ShmLinkType *L;
+
+   L = (struct ShmLinkType *)calloc(1, sizeof(struct ShmLinkType));
+   if (L == NULL) {
+      fprintf(stderr, "Shared memory link calloc failed.  Bailing out!\n");
+      exit(EXIT_FAILURE);
+   }
+   L->Seg           = Seg;
+   L->MapSize       = MapSize;
+   L->Tx            = &Seg->Ring[Side];
+   L->Rx            = &Seg->Ring[1 - Side];
+   L->TxData        = (char *)&Seg[1] + Side * Seg->RingSize;
+   L->RxData        = (char *)&Seg[1] + (1 - Side) * Seg->RingSize;
+   L->Mask          = Seg->RingSize - 1;
+   L->PeerPid       = Seg->Pid[1 - Side];
+   L->Nspin         = sysconf(_SC_NPROCESSORS_ONLN) > 1 ? SHM_NSPIN : 0;
+   L->AllowBlocking = AllowBlocking;
+   L->Pending       = atomic_load(&L->Rx->Tail);
+   return (L);
+}
+#endif
+/**********************************************************************/
+/* Creates the segment named after Port and waits for a client to     */
+/* attach, as InitSocketServer waits in accept.  The name is unlinked */
+/* once both ends hold the mapping, so nothing outlives the run.  An  */
+/* existing segment of that name is left alone: it may be another     */
+/* live 42's, still waiting for its client.                           */
+struct ShmLinkType *InitShmServer(int Port, int AllowBlocking)
+{
+#if defined(_WIN32)
+   fprintf(stderr, "Shared memory IPC is not supported on Windows.  "
+                   "Use a socket instead.\n");
+   exit(EXIT_FAILURE);
+   return (NULL);
+#else
+   struct ShmSegmentType *Seg;
+   struct timespec Nap = {0, 1000000};
+   char Name[40];
+   size_t MapSize;
+   long i;
+   int fd;
+
+   ShmName(Port, Name);
+   MapSize = sizeof(struct ShmSegmentType) + 2 * SHM_RINGSIZE;
+
+   fd = shm_open(Name, O_CREAT | O_EXCL | O_RDWR, 0600);
+   if (fd == -1 && errno == EEXIST) {
+      fprintf(stderr,
+              "Shared memory %s already exists.  Another 42 may be "
+              "serving port %d.  If not, a run that died before its "
+              "client attached left it behind; remove /dev/shm%s and "
+              "try again.\n",
+              Name, Port, Name);
+      exit(EXIT_FAILURE);
+   }
+   if (fd == -1) {
+      fprintf(stderr, "Error creating shared memory %s: %s.\n", Name,
+              strerror(errno));
+      exit(EXIT_FAILURE);
+   }
+   if (ftruncate(fd, MapSize) == -1) {
+      fprintf(stderr, "Error sizing shared memory %s: %s.\n", Name,
+              strerror(errno));
+      exit(EXIT_FAILURE);
+   }
+   Seg = (struct ShmSegmentType *)mmap(NULL, MapSize, PROT_READ | PROT_WRITE,
+                                       MAP_SHARED, fd, 0);
+   close(fd);
+   if (Seg == MAP_FAILED) {
+      fprintf(stderr, "Error mapping shared memory %s: %s.\n", Name,
+              strerror(errno));
+      exit(EXIT_FAILURE);
+   }
+
+   Seg->Version  = SHM_VERSION;
+   Seg->RingSize = SHM_RINGSIZE;
+   Seg->Pid[0]   = (long)getpid();
+   for (i = 0; i < 2; i++) {
+      atomic_init(&Seg->Ring[i].Head, 0);
+      atomic_init(&Seg->Ring[i].Tail, 0);
+      atomic_init(&Seg->Ring[i].Seq, 0);
+      atomic_init(&Seg->Ring[i].Sleepers, 0);
+   }
+   atomic_init(&Seg->Attached, 0);
+   atomic_store(&Seg->Magic, SHM_MAGIC);
+
+   printf("Server is waiting on shared memory %s\n", Name);
+   while (atomic_load(&Seg->Attached) != 2)
+      nanosleep(&Nap, NULL);
+   shm_unlink(Name);
+   printf("Server side of shared memory established.\n");
+
+   return (ShmLink(Seg, MapSize, 0, AllowBlocking));
+#endif
+}
+/**********************************************************************/
+/* Attaches to the segment InitShmServer made for Port, waiting for   */
+/* it to appear if the server hasn't started yet                      */
+struct ShmLinkType *InitShmClient(int Port, int AllowBlocking)
+{
+#if defined(_WIN32)
+   fprintf(stderr, "Shared memory IPC is not supported on Windows.  "
+                   "Use a socket instead.\n");
+   exit(EXIT_FAILURE);
+   return (NULL);
+#else
+   struct ShmSegmentType *Seg;
+   struct stat SegStatus;
+   struct timespec Nap = {0, 1000000};
+   char Name[40];
+   int Claim, fd;
+
+   ShmName(Port, Name);
+   printf("Client attaching to shared memory %s\n", Name);
+   while (1) {
+      fd = shm_open(Name, O_RDWR, 0);
+      if (fd == -1) {
+         if (errno != ENOENT) {
+            fprintf(stderr, "Error opening shared memory %s: %s.\n", Name,
+                    strerror(errno));
+            exit(EXIT_FAILURE);
+         }
+         nanosleep(&Nap, NULL);
+         continue;
+      }
+      if (fstat(fd, &SegStatus) ||
+          SegStatus.st_size < (off_t)sizeof(struct ShmSegmentType)) {
+         close(fd);
+         nanosleep(&Nap, NULL);
+         continue;
+      }
+      Seg = (struct ShmSegmentType *)mmap(NULL, SegStatus.st_size,
+                                          PROT_READ | PROT_WRITE, MAP_SHARED,
+                                          fd, 0);
+      close(fd);
+      if (Seg == MAP_FAILED) {
+         fprintf(stderr, "Error mapping shared memory %s: %s.\n", Name,
+                 strerror(errno));
+         exit(EXIT_FAILURE);
+      }
+      /* Not yet initialized, or already taken by another client */
+      Claim = 0;
+      if (atomic_load(&Seg->Magic) == SHM_MAGIC &&
+          atomic_compare_exchange_strong(&Seg->Attached, &Claim, 1))
+         break;
+      munmap(Seg, SegStatus.st_size);
+      nanosleep(&Nap, NULL);
+   }
+   if (Seg->Version != SHM_VERSION) {
+      fprintf(stderr, "Shared memory %s has version %ld, expected %d.\n",
+              Name, Seg->Version, SHM_VERSION);
+      exit(EXIT_FAILURE);
+   }
+   Seg->Pid[1] = (long)getpid();
+   atomic_store(&Seg->Attached, 2);
+   printf("Client side of shared memory established.\n");
+
+   return (ShmLink(Seg, SegStatus.st_size, 1, AllowBlocking));
+#endif
+}
+/**********************************************************************/
+/* Unmaps the segment.  The name is already gone, so the memory is    */
+/* freed once the peer lets go of it too.                             */
+void CloseShmLink(struct ShmLinkType *L)
+{
+#if !defined(_WIN32)
+   if (L == NULL)
+      return;
+   munmap(L->Seg, L->MapSize);
+   free(L);
+#endif
+}
+/**********************************************************************/
+/* Copies Msg into the outgoing ring, waiting while the ring is full. */
+/* The message is dropped if the peer has exited.                     */
+void ShmSend(struct ShmLinkType *L, const char *Msg, long Len)
+{
+#if !defined(_WIN32)
+   long long Head, Off, Skip, Need;
+   long long Len64 = Len, Wrap = -1;
+
+   Need = 8 + ((Len + 7) & ~7L);
+   if (Need > (L->Mask + 1) / 2) {
+      fprintf(stderr,
+              "Message of %ld bytes is too long for a shared memory ring "
+              "of %lld.  Bailing out!\n",
+              Len, L->Mask + 1);
+      exit(EXIT_FAILURE);
+   }
+   Head = atomic_load_explicit(&L->Tx->Head, memory_order_relaxed);
+   Off  = Head & L->Mask;
+   Skip = (L->Mask + 1 - Off < Need) ? L->Mask + 1 - Off : 0;
+   if (!ShmWait(L, L->Tx, Skip + Need))
+      return;
+   if (Skip > 0) {
+      memcpy(&L->TxData[Off], &Wrap, 8);
+      Off = 0;
+   }
+   memcpy(&L->TxData[Off], &Len64, 8);
+   memcpy(&L->TxData[Off + 8], Msg, Len);
+   atomic_store(&L->Tx->Head, Head + Skip + Need);
+   ShmWake(L->Tx);
+#endif
+}
+/**********************************************************************/
+/* Returns the next incoming message in place, or NULL if none has    */
+/* arrived (non-blocking link) or the peer has exited.  The message   */
+/* stays valid until ShmRelease.                                      */
+const char *ShmRecv(struct ShmLinkType *L, long *Len)
+{
+#if defined(_WIN32)
+   *Len = 0;
+   return (NULL);
+#else
+   long long Tail, Off, Len64;
+
+   *Len = 0;
+   Tail = atomic_load_explicit(&L->Rx->Tail, memory_order_relaxed);
+   if (atomic_load(&L->Rx->Head) == Tail && !L->AllowBlocking)
+      return (NULL);
+   if (!ShmWait(L, L->Rx, 1))
+      return (NULL);
+   Off = Tail & L->Mask;
+   memcpy(&Len64, &L->RxData[Off], 8);
+   if (Len64 < 0) {
+      Tail += L->Mask + 1 - Off;
+      Off   = 0;
+      memcpy(&Len64, L->RxData, 8);
+   }
+   L->Pending = Tail + 8 + ((Len64 + 7) & ~7LL);
+   *Len       = (long)Len64;
+   return (&L->RxData[Off + 8]);
+#endif
+}
+/**********************************************************************/
+/* Hands the space of the message from ShmRecv back to the writer     */
+void ShmRelease(struct ShmLinkType *L)
+{
+#if !defined(_WIN32)
+   atomic_store(&L->Rx->Tail, L->Pending);
+   ShmWake(L->Rx);
+#endif
+}
 
 /* #ifdef __cplusplus
 ** }
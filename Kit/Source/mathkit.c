@@ -637,6 +637,25 @@ double factDfact(long const n, long const m)
    return out;
 }
 
+/**********************************************************************/
+/*  Factors taking Neumann-normalized Legendre functions to full      */
+/*  normalization, up to Degree N and Order M:                        */
+/*     Norm[n][m] = sqrt((2-delta_m0)*(2n+1)*(n-m)!/(n+m)!)           */
+void LegendreNorm(const long N, const long M, double **Norm)
+{
+   double Nm;
+   long n, m;
+
+   for (n = 0; n <= N; n++) {
+      /* .. Orders m >= 1 carry the factor of 2 */
+      Nm         = sqrt(2.0 * (2 * n + 1));
+      Norm[n][0] = sqrt(2 * n + 1);
+      for (m = 1; m <= n && m <= M; m++) {
+         Nm         /= sqrt((double)(n + m) * (n - m + 1));
+         Norm[n][m]  = Nm;
+      }
+   }
+}
 /**********************************************************************/
 /*  Legendre Functions P(x) and sdP(x), up to Degree N and Order M    */
 /*  Neumann normalization (see Battin p.390+, Wertz App. G)           */
@@ -680,12 +699,13 @@ void Legendre(const long N, const long M, const double x,
 
    double powsm  = s;
    double powsm1 = 1.0;
+   double oddf   = 1.0; /* (2m-1)!! */
    /* .. Then there are the rest... */
    for (m = 1; m <= M; m++) {
-      double oddf = oddfact(2 * m - 1);
-      P[m][m]     = oddf * powsm;
-      Ps[m][m]    = oddf * powsm1;
-      sdP[m][m]   = m * (x * Ps[m][m] - 2.0 * P[m][m - 1]);
+      oddf      *= 2 * m - 1;
+      P[m][m]    = oddf * powsm;
+      Ps[m][m]   = oddf * powsm1;
+      sdP[m][m]  = m * (x * Ps[m][m] - 2.0 * P[m][m - 1]);
       if (m < N) {
          P[m + 1][m]  = x * (2 * m + 1) * P[m][m];
          Ps[m + 1][m] = x * (2 * m + 1) * Ps[m][m];
@@ -1049,18 +1069,18 @@ void DestroyMatrix(double **A)
 /**********************************************************************/
 /*   Solution of NxN system      A * x = b                            */
 /*   by Gaussian Elimination and Back Substitution, with pivoting     */
+/*   A and b are overwritten.  Rows are swapped in place, so no       */
+/*   scratch is allocated.                                            */
 void LINSOLVE(double **A, double *x, double *b, const long n)
 {
    long i, j, k, l, m;
-   double mm, *a1, b1;
+   double mm, a1, b1, piv;
 
    if (n == 1) {
       x[0] = b[0] / A[0][0];
       return;
    }
 
-   a1 = (double *)calloc(n, sizeof(double));
-
    for (j = 0; j < n - 1; j++) {
       mm = fabs(A[j][j]);
       l  = j;
@@ -1071,17 +1091,15 @@ void LINSOLVE(double **A, double *x, double *b, const long n)
          }
       }
       if (l != j) {
+         piv = A[l][j];
          for (i = 0; i < n; i++) {
-            a1[i] = A[j][i];
-         }
-         b1 = b[j];
-         for (i = j; i < n; i++) {
-            A[j][i] = A[l][i] / A[l][j];
-         }
-         b[j] = b[l] / A[l][j];
-         for (i = 0; i < n; i++) {
-            A[l][i] = a1[i];
+            a1 = A[j][i];
+            if (i >= j)
+               A[j][i] = A[l][i] / piv;
+            A[l][i] = a1;
          }
+         b1   = b[j];
+         b[j] = b[l] / piv;
          b[l] = b1;
       }
       else {
@@ -1106,8 +1124,54 @@ void LINSOLVE(double **A, double *x, double *b, const long n)
          x[i] -= A[i][k] * x[k];
       }
    }
+}
+/**********************************************************************/
+/*  In-place L*D*L^T factorization of symmetric positive-definite A.  */
+/*  Only the lower triangle of A is read.  On return the strict lower */
+/*  triangle holds unit lower-triangular L, and d holds the diagonal  */
+/*  of D.  The upper triangle is untouched.  Returns 1 on success, or */
+/*  0 (with A partly factored) if a pivot is not positive.            */
+long LDLFactor(double **A, double *d, const long n)
+{
+   double *Ai, *Aj, s;
+   long i, j, k;
 
-   free(a1);
+   for (j = 0; j < n; j++) {
+      Aj = A[j];
+      s  = Aj[j];
+      for (k = 0; k < j; k++)
+         s -= Aj[k] * Aj[k] * d[k];
+      if (!(s > 0.0))
+         return (0);
+      d[j] = s;
+      for (i = j + 1; i < n; i++) {
+         Ai = A[i];
+         s  = Ai[j];
+         for (k = 0; k < j; k++)
+            s -= Ai[k] * Aj[k] * d[k];
+         Ai[j] = s / d[j];
+      }
+   }
+   return (1);
+}
+/**********************************************************************/
+/*  Solve L*D*L^T * x = b using factors from LDLFactor.               */
+/*  x and b may be the same array.                                    */
+void LDLSolve(double **L, double *d, double *x, double *b, const long n)
+{
+   long i, k;
+
+   for (i = 0; i < n; i++) {
+      x[i] = b[i];
+      for (k = 0; k < i; k++)
+         x[i] -= L[i][k] * x[k];
+   }
+   for (i = 0; i < n; i++)
+      x[i] /= d[i];
+   for (i = n - 1; i >= 0; i--) {
+      for (k = i + 1; k < n; k++)
+         x[i] -= L[k][i] * x[k];
+   }
 }
 /**********************************************************************/
 /*  Solution of the linear equations A*x=b by Cholesky Decomposition  */
@@ -1632,10 +1696,10 @@ long ProjectPointOntoPoly(double Point[3], double DirVec[3], double **Vtx,
                           long Nvtx, double ProjPoint[3], double *Distance)
 {
    double Axis[3], a1[3], a2[3];
-   static double **COEF, *RHS, *x;
+   static _Thread_local double **COEF, *RHS, *x;
    double SumAng, s1[3], s2[3], S1xS2[3], Norm[3], SinAng, CosAng;
    long i, j, Iv, Nwrap;
-   static long First = 1;
+   static _Thread_local long First = 1;
    long OnEdge;
 
    if (First) {
@@ -2487,35 +2551,133 @@ void bhqrd(double **A, double **U, double **R, long const n, long const m,
    }
 }
 /******************************************************************************/
-// Taylor series method for Matrix Exponential, adapted from John Burkardt
-// https://people.sc.fsu.edu/~jburkardt
-void expm(double **A, double **e, long const n)
-{
-   int const maxIter = 25;
-   int k             = 1;
-   double **B, **C;
-   B = CreateMatrix(n, n);
-   C = CreateMatrix(n, n);
+// Matrix exponential by scaling and squaring of a diagonal Pade approximant,
+// after Higham, "The Scaling and Squaring Method for the Matrix Exponential
+// Revisited," SIAM J. Matrix Anal. Appl. 26(4), 2005.  The Pade degree is the
+// lowest that meets double precision for the 1-norm of A, so small steps cost a
+// handful of multiplies.  W holds EXPM_NWORK matrices of at least n x n, so
+// repeated calls allocate nothing.
+void expmPade(double **A, double **e, long const n, double **W[EXPM_NWORK])
+{
+   static const double Theta[4] = {1.495585217958292e-2, 2.539398330063230e-1,
+                                   9.504178996162932e-1, 2.097847961257068e0};
+   static const double Theta13  = 5.371920351148152e0;
+   static const double c[4][10] = {
+       {120.0, 60.0, 12.0, 1.0},
+       {30240.0, 15120.0, 3360.0, 420.0, 30.0, 1.0},
+       {17297280.0, 8648640.0, 1995840.0, 277200.0, 25200.0, 1512.0, 56.0,
+        1.0},
+       {17643225600.0, 8821612800.0, 2075673600.0, 302702400.0, 30270240.0,
+        2162160.0, 110880.0, 3960.0, 90.0, 1.0}};
+   static const double b[14] = {
+       64764752532480000.0, 32382376266240000.0, 7771770303897600.0,
+       1187353796428800.0,  129060195264000.0,   10559470521600.0,
+       670442572800.0,      33522128640.0,       1323241920.0,
+       40840800.0,          960960.0,            16380.0,
+       182.0,               1.0};
+   double **As = W[0], **A2 = W[1], **A4 = W[2], **A6 = W[3];
+   double **U = W[4], **V = W[5], **T = W[6];
+   double **Pw[4];
+   double Norm = 0.0, ColSum, Scl;
+   long i, j, k, p, Np, s = 0;
 
-   for (int i = 0; i < n; i++)
-      for (int j = 0; j < n; j++)
-         e[i][j] = 0.0;
+   for (j = 0; j < n; j++) {
+      ColSum = 0.0;
+      for (i = 0; i < n; i++)
+         ColSum += fabs(A[i][j]);
+      if (ColSum > Norm)
+         Norm = ColSum;
+   }
+
+   for (k = 0; k < 4 && Norm > Theta[k]; k++)
+      ;
+   if (k < 4) {
+      /* Degree 3, 5, 7 or 9, unscaled.  A^8 borrows U until U is formed */
+      Np    = k + 1;
+      Pw[0] = A2;
+      Pw[1] = A4;
+      Pw[2] = A6;
+      Pw[3] = U;
+      MxMG(A, A, A2, n, n, n);
+      for (p = 1; p < Np; p++)
+         MxMG(Pw[p - 1], A2, Pw[p], n, n, n);
+      for (i = 0; i < n; i++) {
+         for (j = 0; j < n; j++) {
+            V[i][j] = 0.0;
+            T[i][j] = 0.0;
+            for (p = 0; p < Np; p++) {
+               V[i][j] += c[k][2 * p + 2] * Pw[p][i][j];
+               T[i][j] += c[k][2 * p + 3] * Pw[p][i][j];
+            }
+         }
+         V[i][i] += c[k][0];
+         T[i][i] += c[k][1];
+      }
+      MxMG(A, T, U, n, n, n);
+   }
+   else {
+      /* Degree 13, with A scaled by 2^-s to bring its norm under Theta13 */
+      s = (long)ceil(log2(Norm / Theta13));
+      if (s < 0)
+         s = 0;
+      Scl = ldexp(1.0, -s);
+      for (i = 0; i < n; i++)
+         for (j = 0; j < n; j++)
+            As[i][j] = Scl * A[i][j];
+      MxMG(As, As, A2, n, n, n);
+      MxMG(A2, A2, A4, n, n, n);
+      MxMG(A4, A2, A6, n, n, n);
 
-   for (int i = 0; i < n; i++)
-      B[i][i] = 1.0;
+      for (i = 0; i < n; i++)
+         for (j = 0; j < n; j++)
+            T[i][j] = b[13] * A6[i][j] + b[11] * A4[i][j] + b[9] * A2[i][j];
+      MxMG(A6, T, V, n, n, n);
+      for (i = 0; i < n; i++) {
+         for (j = 0; j < n; j++)
+            V[i][j] += b[7] * A6[i][j] + b[5] * A4[i][j] + b[3] * A2[i][j];
+         V[i][i] += b[1];
+      }
+      MxMG(As, V, U, n, n, n);
 
-   while (k <= maxIter && isSignificant(n, n, e, B)) {
-      for (int i = 0; i < n; i++)
-         for (int j = 0; j < n; j++)
-            e[i][j] += B[i][j];
+      for (i = 0; i < n; i++)
+         for (j = 0; j < n; j++)
+            T[i][j] = b[12] * A6[i][j] + b[10] * A4[i][j] + b[8] * A2[i][j];
+      MxMG(A6, T, V, n, n, n);
+      for (i = 0; i < n; i++) {
+         for (j = 0; j < n; j++)
+            V[i][j] += b[6] * A6[i][j] + b[4] * A4[i][j] + b[2] * A2[i][j];
+         V[i][i] += b[0];
+      }
+   }
 
-      MxMG(B, A, C, n, n, n);
-      SxMG(1.0 / ((double)(k)), C, B, n, n);
-      k++;
+   /* Solve (V - U) e = (V + U) */
+   for (i = 0; i < n; i++) {
+      for (j = 0; j < n; j++) {
+         T[i][j]  = V[i][j] + U[i][j];
+         V[i][j] -= U[i][j];
+      }
    }
+   MINVxMG(V, T, e, n, n);
 
-   DestroyMatrix(B);
-   DestroyMatrix(C);
+   for (k = 0; k < s; k++) {
+      MxMG(e, e, T, n, n, n);
+      for (i = 0; i < n; i++)
+         for (j = 0; j < n; j++)
+            e[i][j] = T[i][j];
+   }
+}
+/******************************************************************************/
+// Allocating wrapper for expmPade, for callers outside any hot loop
+void expm(double **A, double **e, long const n)
+{
+   double **W[EXPM_NWORK];
+   long k;
+
+   for (k = 0; k < EXPM_NWORK; k++)
+      W[k] = CreateMatrix(n, n);
+   expmPade(A, e, n, W);
+   for (k = 0; k < EXPM_NWORK; k++)
+      DestroyMatrix(W[k]);
 }
 /******************************************************************************/
 // Test if matrix B is significant relative to matrix A, adapted from John
@@ -24,8 +24,6 @@
 */
 
 extern double EnckeFQ(double const r[3], double const delta[3]);
-extern void Legendre(long N, long M, double x, double P[N + 1][M + 1],
-                     double sdP[N + 1][M + 1]);
 #if REPORT_RESIDUALS == TRUE
 extern void DSM_NAV_ResidualsReport(double time,
                                     double **residuals[FIN_SENSOR + 1]);
@@ -34,25 +32,20 @@ extern void DSM_NAV_ResidualsReport(double time,
 void InitMeasList(struct DSMMeasListType *list)
 {
    list->head    = NULL;
+   list->tail    = NULL;
    list->length  = 0;
    list->measDim = 0;
 }
 
 void appendMeas(struct DSMMeasListType *list, struct DSMMeasType *newMeas)
 {
-   struct DSMMeasType *last = list->head;
-   if (newMeas == NULL) {
+   if (newMeas == NULL)
       return;
-   }
-   else if (last == NULL) {
+   if (list->head == NULL)
       list->head = newMeas;
-   }
-   else {
-      while (last->nextMeas != NULL) {
-         last = last->nextMeas;
-      }
-      last->nextMeas = newMeas;
-   }
+   else
+      list->tail->nextMeas = newMeas;
+   list->tail = newMeas;
 
    list->length  += 1;
    list->measDim += newMeas->errDim;
@@ -60,21 +53,13 @@ void appendMeas(struct DSMMeasListType *list, struct DSMMeasType *newMeas)
 
 void appendList(struct DSMMeasListType *list1, struct DSMMeasListType *list2)
 {
-   if (list2 == NULL)
-      return;
-   struct DSMMeasType *last = list1->head;
-   if (list2->head == NULL) {
+   if (list2 == NULL || list2->head == NULL)
       return;
-   }
-   else if (last == NULL) {
+   if (list1->head == NULL)
       list1->head = list2->head;
-   }
-   else {
-      while (last->nextMeas != NULL) {
-         last = last->nextMeas;
-      }
-      last->nextMeas = list2->head;
-   }
+   else
+      list1->tail->nextMeas = list2->head;
+   list1->tail = list2->tail;
 
    list1->length  += list2->length;
    list1->measDim += list2->measDim;
@@ -100,6 +85,8 @@ void push(struct DSMMeasListType *list, struct DSMMeasType *meas)
       measDim += last->errDim;
    }
 
+   if (list->head == NULL)
+      list->tail = last;
    last->nextMeas  = list->head;
    list->head      = meas;
    list->length   += length;
@@ -115,6 +102,8 @@ struct DSMMeasType *pop_DSMMeas(struct DSMMeasListType *list)
    meas->nextMeas            = NULL;
    list->length             -= 1;
    list->measDim            -= meas->errDim;
+   if (list->head == NULL)
+      list->tail = NULL;
    return meas;
 }
 
@@ -127,60 +116,86 @@ void DestroyMeasList(struct DSMMeasListType *list)
    }
 }
 
-struct DSMMeasType *swap_DSMMeas(struct DSMMeasType *ptr1,
-                                 struct DSMMeasType *ptr2)
+// Bottom-up merge sort on the links: O(n log n), stable, and no allocation
+void SortMeasList(struct DSMMeasListType *list)
 {
-   struct DSMMeasType *tmp = ptr2->nextMeas;
-   ptr2->nextMeas          = ptr1;
-   ptr1->nextMeas          = tmp;
-   return ptr2;
-}
+   struct DSMMeasType *head = list->head, *tail, *a, *b, *next;
+   struct DSMMeasType **link;
+   long width, na, nb, merges;
 
-// Measurements lists shouldn't be that long, maybe 20 or so per call, so bubble
-// sort should be fine Likely won't need to sort anything anyway do to how lists
-// are populated
-void bubbleSort(struct DSMMeasListType *list)
-{
-   const long count = list->length;
-   struct DSMMeasType **node;
-   long i, j, swapped;
-
-   for (i = 0; i <= count; i++) {
-      node    = &list->head;
-      swapped = 0;
-
-      for (j = 0; j < count - i - 1; j++) {
-         struct DSMMeasType *p1 = *node;
-         struct DSMMeasType *p2 = p1->nextMeas;
-
-         if (comparator_DSMMeas(&p1, &p2) == +1) {
-            /* update the link after swapping */
-            *node   = swap_DSMMeas(p1, p2);
-            swapped = 1;
+   if (head == NULL)
+      return;
+   for (width = 1;; width *= 2) {
+      a      = head;
+      head   = NULL;
+      tail   = NULL;
+      merges = 0;
+      while (a != NULL) {
+         merges++;
+         b = a;
+         for (na = 0; na < width && b != NULL; na++)
+            b = b->nextMeas;
+         nb = width;
+         while (na > 0 || (nb > 0 && b != NULL)) {
+            if (na == 0 ||
+                (nb > 0 && b != NULL && comparator_DSMMeas(&b, &a) < 0)) {
+               next = b;
+               b    = b->nextMeas;
+               nb--;
+            }
+            else {
+               next = a;
+               a    = a->nextMeas;
+               na--;
+            }
+            link  = (tail == NULL) ? &head : &tail->nextMeas;
+            *link = next;
+            tail  = next;
          }
-         node = &(*node)->nextMeas;
+         a = b;
       }
-
-      /* break if the loop ended without any swap */
-      if (swapped == 0)
+      tail->nextMeas = NULL;
+      if (merges <= 1)
          break;
    }
+   list->head = head;
+   list->tail = tail;
 }
 
+// Measurements come from a per-type free list when one has been released,
+// so after the first few steps no measurement is allocated
 struct DSMMeasType *CreateMeas(struct DSMNavType *const Nav,
                                enum SensorType const type, long const sensorNum)
 {
    struct DSMMeasType *meas, *sourceMeas = &Nav->measTypes[type][sensorNum];
-   meas                  = malloc(sizeof *meas);
+   if (Nav->measPool[type] != NULL) {
+      meas                = Nav->measPool[type];
+      Nav->measPool[type] = meas->nextMeas;
+      // sensors of one type need not share a size, so a pooled entry is
+      // resized when it last held a different sensor's measurement
+      if (meas->dim != sourceMeas->dim) {
+         free(meas->data);
+         meas->data = calloc(sourceMeas->dim, sizeof(double));
+      }
+      if (meas->errDim != sourceMeas->errDim) {
+         free(meas->R);
+         DestroyMatrix(meas->N);
+         meas->R = calloc(sourceMeas->errDim, sizeof(double));
+         meas->N = CreateMatrix(sourceMeas->errDim, sourceMeas->errDim);
+      }
+   }
+   else {
+      meas       = malloc(sizeof *meas);
+      meas->data = calloc(sourceMeas->dim, sizeof(double));
+      meas->R    = calloc(sourceMeas->errDim, sizeof(double));
+      meas->N    = CreateMatrix(sourceMeas->errDim, sourceMeas->errDim);
+   }
    meas->measFun         = sourceMeas->measFun;
    meas->measJacobianFun = sourceMeas->measJacobianFun;
    meas->type            = sourceMeas->type;
    meas->dim             = sourceMeas->dim;
    meas->errDim          = sourceMeas->errDim;
 
-   meas->data = calloc(meas->dim, sizeof(double));
-   meas->R    = calloc(meas->errDim, sizeof(double));
-   meas->N    = CreateMatrix(meas->errDim, meas->errDim);
    for (int i = 0; i < meas->errDim; i++) {
       meas->R[i] = sourceMeas->R[i];
       for (int j = 0; j < meas->errDim; j++)
@@ -191,6 +206,27 @@ struct DSMMeasType *CreateMeas(struct DSMNavType *const Nav,
    return (meas);
 }
 
+// Return a measurement to its type's free list for CreateMeas
+void ReleaseMeas(struct DSMNavType *const Nav, struct DSMMeasType *meas)
+{
+   meas->nextMeas            = Nav->measPool[meas->type];
+   Nav->measPool[meas->type] = meas;
+}
+
+void DestroyMeasPool(struct DSMNavType *const Nav)
+{
+   struct DSMMeasType *meas;
+
+   for (enum SensorType sensor = INIT_SENSOR; sensor <= FIN_SENSOR;
+        sensor++) {
+      while (Nav->measPool[sensor] != NULL) {
+         meas                  = Nav->measPool[sensor];
+         Nav->measPool[sensor] = meas->nextMeas;
+         DestroyMeas(meas);
+      }
+   }
+}
+
 //------------------------------------------------------------------------------
 // Used to order the array of measurements
 //------------------------------------------------------------------------------
@@ -297,90 +333,6 @@ double GetPriMerAng(const long orbCenter, const struct DateType *date)
 //------------------------------------------------------------------------------
 // Acceleration perturbation functions
 //------------------------------------------------------------------------------
-void SphericalHarmonicsJacobian(const long N, const long M, const double r,
-                                const double trigs[4], const double Re,
-                                const double K, double **C, double **S,
-                                double **Norm, double HV[3][3])
-{
-   double P[N + 1][M + 1], sdP[N + 1][M + 1];
-   long n, m;
-   double cphi[M + 1], sphi[M + 1];
-   double Rern1[N + 1], sth, cth;
-
-   /* .. Order can't be greater than Degree */
-   if (M > N) {
-      fprintf(stderr, "Order %ld can't be greater than Degree %ld\n", M, N);
-      exit(EXIT_FAILURE);
-   }
-
-   /* .. Find Legendre functions */
-   cth                = trigs[0];
-   sth                = trigs[1]; // sin(theta);
-   const double sth2  = sth * sth;
-   const double cotth = cth / sth;
-   const double r2 = r * r, rsth = r * sth;
-   const double rsth2 = rsth * rsth;
-   Legendre(N, M, cth, P, sdP);
-
-   /* .. Build cos(m*phi) and sin(m*phi) */
-   cphi[0] = 1.0;
-   sphi[0] = 0.0;
-   cphi[1] = trigs[2]; // cos(phi);
-   sphi[1] = trigs[3]; // sin(phi);
-   for (m = 2; m <= M; m++) {
-      cphi[m] = cphi[m - 1] * cphi[1] - sphi[m - 1] * sphi[1];
-      sphi[m] = sphi[m - 1] * cphi[1] + cphi[m - 1] * sphi[1];
-   }
-
-   double d2Vdr2 = 0.0, d2Vdphi2 = 0.0, d2Vdtheta2 = 0.0, d2Vdrdphi = 0.0,
-          d2Vdrdtheta = 0.0, d2Vdphidtheta = 0.0;
-   /* .. Find Jacobian of V */
-   /* .. Rern1[n] = (Re/r)^(n+1) */
-   Rern1[0] = Re / r;
-   for (n = 1; n <= N; n++)
-      Rern1[n] = Rern1[n - 1] * Rern1[0];
-   for (n = N; n >= 2; n--) {
-      for (m = MIN(n, M); m >= 0; m--) {
-         const double Pbar   = P[n][m] * Norm[n][m];
-         const double sdPbar = sdP[n][m] * Norm[n][m];
-         const double CcSsbar =
-             (C[n][m] * cphi[m] + S[n][m] * sphi[m]) * Rern1[n];
-         const double ScCsbar =
-             (S[n][m] * cphi[m] - C[n][m] * sphi[m]) * Rern1[n];
-
-         double tmp = (double)(n * (n + 1));
-         if (m != 0 && sth != 0.0)
-            tmp -= (m * m) / sth2;
-         tmp *= Pbar;
-         if (sth != 0.0)
-            tmp -= sdPbar * cotth;
-         d2Vdr2        += CcSsbar * (Pbar * ((n + 1) * (n + 2)));
-         d2Vdtheta2    -= CcSsbar * tmp;
-         d2Vdphi2      -= CcSsbar * (Pbar * (m * m));
-         d2Vdrdtheta   += CcSsbar * (sdPbar * (n + 1));
-         d2Vdrdphi     -= ScCsbar * (Pbar * ((n + 1) * m));
-         d2Vdphidtheta -= ScCsbar * (sdPbar * m);
-      }
-   }
-   const double Kr  = K / r;
-   d2Vdr2          *= Kr / r;
-   d2Vdphi2        *= K;
-   d2Vdtheta2      *= K;
-   d2Vdrdphi       *= Kr;
-   d2Vdrdtheta     *= Kr;
-   d2Vdphidtheta   *= K;
-
-   HV[0][0] = d2Vdr2;
-   HV[1][1] = d2Vdtheta2 / r2;
-   HV[2][2] = d2Vdphi2 / rsth2;
-   HV[0][1] = d2Vdrdtheta / r;
-   HV[0][2] = d2Vdrdphi / rsth;
-   HV[1][2] = d2Vdphidtheta / (r * rsth);
-   HV[1][0] = HV[0][1];
-   HV[2][0] = HV[0][2];
-   HV[2][1] = HV[1][2];
-}
-
 void SphericalHarmonicsHessian(long N, long M, struct WorldType *W,
                                double PriMerAng, double pbn[3],
                                double HgeoN[3][3])
@@ -408,9 +360,9 @@ void SphericalHarmonicsHessian(long N, long M, struct WorldType *W,
                              {cth * cph, cth * sph, -sth},
                              {-sph, cph, 0.0}};
 
-   /*    Find Jacobian */
-   SphericalHarmonicsJacobian(N, M, r, trigs, W->rad, W->mu / W->rad,
-                              GravModel->C, GravModel->S, GravModel->Norm, HV);
+   /*    Find gradient and Jacobian */
+   SphereHarmGrav(GravModel, N, M, r, trigs, W->rad, W->mu / W->rad, gradV,
+                  HV);
 
    /*   Calculate scaled Christoffel Symbols */
    /*     sCS^k_{ij} = CS^k_{ij} * sqrt(g_{kk}) / (sqrt(g_{ii})*sqrt(g_{jj})) */
@@ -428,8 +380,6 @@ void SphericalHarmonicsHessian(long N, long M, struct WorldType *W,
    sCS[2][2][0] = sCS[2][0][2];
    sCS[2][2][1] = sCS[2][1][2];
 
-   SphericalHarmonics(N, M, r, trigs, W->rad, W->mu / W->rad, GravModel->C,
-                      GravModel->S, GravModel->Norm, gradV);
    for (k = 0; k < 3; k++)
       for (i = 0; i < 3; i++)
          for (j = 0; j < 3; j++)
@@ -731,12 +681,13 @@ void getDAeroFrcAndTrqDVRel(struct DSMType *const DSM, double const CRB[3][3],
 //                               NAV FUNCTIONS
 //------------------------------------------------------------------------------
 
-double **gyroJacobianFun(struct AcType *const AC, struct DSMType *const DSM,
-                         const long Igyro)
+void gyroJacobianFun(struct AcType *const AC, struct DSMType *const DSM,
+                     const long Igyro, double **jacobian)
 {
    double tmp[3] = {0.0}, tmp2[3] = {0.0};
-   static double **B = NULL; // if its static, just need to allocate once,
-                             // instead of allocate/deallocate
+   static _Thread_local double **B = NULL; // if its static, just need to
+                                           // allocate once, instead of
+                                           // allocate/deallocate
    const struct DSMNavType *Nav  = &DSM->DsmNav;
    const struct AcGyroType *gyro = &AC->Gyro[Igyro];
    long i;
@@ -747,9 +698,6 @@ double **gyroJacobianFun(struct AcType *const AC, struct DSMType *const DSM,
    for (i = 0; i < 3; i++)
       B[0][i] = 0.0;
 
-   double **jacobian =
-       CreateMatrix(Nav->measTypes[GYRO_SENSOR][Igyro].dim, Nav->navDim);
-
    switch (Nav->type) {
       case LIEKF_NAV:
          MTxV(Nav->CRB, Nav->refOmega, tmp);
@@ -794,16 +742,15 @@ double **gyroJacobianFun(struct AcType *const AC, struct DSMType *const DSM,
          exit(EXIT_FAILURE);
          break;
    }
-
-   return (jacobian);
 }
 
-double **magJacobianFun(struct AcType *const AC, struct DSMType *const DSM,
-                        const long Imag)
+void magJacobianFun(struct AcType *const AC, struct DSMType *const DSM,
+                    const long Imag, double **jacobian)
 {
    double tmp[3] = {0.0}, tmp2[3] = {0.0};
-   static double **B = NULL; // if its static, just need to allocate once,
-                             // instead of allocate/deallocate
+   static _Thread_local double **B = NULL; // if its static, just need to
+                                           // allocate once, instead of
+                                           // allocate/deallocate
    const struct DSMNavType *Nav         = &DSM->DsmNav;
    const struct AcMagnetometerType *mag = &AC->MAG[Imag];
    const double T2mG                    = 1.0e7; // tesla to milligauss
@@ -815,9 +762,6 @@ double **magJacobianFun(struct AcType *const AC, struct DSMType *const DSM,
    for (i = 0; i < 3; i++)
       B[0][i] = 0.0;
 
-   double **jacobian =
-       CreateMatrix(Nav->measTypes[MAG_SENSOR][Imag].dim, Nav->navDim);
-
    switch (Nav->type) {
       case LIEKF_NAV:
          MxV(Nav->refCRN, AC->bvn, tmp);
@@ -849,16 +793,15 @@ double **magJacobianFun(struct AcType *const AC, struct DSMType *const DSM,
          exit(EXIT_FAILURE);
          break;
    }
-
-   return (jacobian);
 }
 
-double **cssJacobianFun(struct AcType *const AC, struct DSMType *const DSM,
-                        const long Icss)
+void cssJacobianFun(struct AcType *const AC, struct DSMType *const DSM,
+                    const long Icss, double **jacobian)
 {
    double tmp[3] = {0.0}, svb[3] = {0.0}, svr[3] = {0.0};
-   static double **B = NULL; // if its static, just need to allocate once,
-                             // instead of allocate/deallocate
+   static _Thread_local double **B = NULL; // if its static, just need to
+                                           // allocate once, instead of
+                                           // allocate/deallocate
    const struct DSMNavType *Nav = &DSM->DsmNav;
    const struct AcCssType *css  = &AC->CSS[Icss];
    long i;
@@ -871,9 +814,6 @@ double **cssJacobianFun(struct AcType *const AC, struct DSMType *const DSM,
 
    MxV(Nav->refCRN, AC->svn, svr);
 
-   double **jacobian =
-       CreateMatrix(Nav->measTypes[CSS_SENSOR][Icss].dim, Nav->navDim);
-
    switch (Nav->type) { // will need to figure something out with albedo if that
                         // is active
       case LIEKF_NAV:
@@ -902,17 +842,15 @@ double **cssJacobianFun(struct AcType *const AC, struct DSMType *const DSM,
          exit(EXIT_FAILURE);
          break;
    }
-
-   return (jacobian);
 }
 
-double **fssJacobianFun(struct AcType *const AC, struct DSMType *const DSM,
-                        const long Ifss)
+void fssJacobianFun(struct AcType *const AC, struct DSMType *const DSM,
+                    const long Ifss, double **jacobian)
 {
    double B[3][3] = {{0.0}}, tmp3x3[3][3] = {{0.0}};
-   const struct AcFssType *fss  = &AC->FSS[Ifss];
-   const struct DSMNavType *Nav = &DSM->DsmNav;
-   static double **tmpAssign    = NULL;
+   const struct AcFssType *fss             = &AC->FSS[Ifss];
+   const struct DSMNavType *Nav            = &DSM->DsmNav;
+   static _Thread_local double **tmpAssign = NULL;
    double svb[3], svs[3], CBN[3][3];
    double bhat[3] = {0.0}, hhat[3] = {0.0}, vhat[3] = {0.0};
    double bxsvs[3], hxsvs[3], vxsvs[3];
@@ -968,9 +906,6 @@ double **fssJacobianFun(struct AcType *const AC, struct DSMType *const DSM,
          exit(EXIT_FAILURE);
    }
 
-   double **jacobian =
-       CreateMatrix(Nav->measTypes[FSS_SENSOR][Ifss].dim, Nav->navDim);
-
    switch (Nav->type) {
       case LIEKF_NAV:
          MxM(B, fss->CB, tmp3x3);
@@ -999,17 +934,15 @@ double **fssJacobianFun(struct AcType *const AC, struct DSMType *const DSM,
          exit(EXIT_FAILURE);
          break;
    }
-
-   return (jacobian);
 }
 
-double **startrackJacobianFun(struct AcType *const AC,
-                              struct DSMType *const DSM, const long Ist)
+void startrackJacobianFun(struct AcType *const AC, struct DSMType *const DSM,
+                          const long Ist, double **jacobian)
 {
-   double tmpM[3][3]                  = {{0.0}}, CSB[3][3];
-   static double **tmpAssign          = NULL;
-   const struct DSMNavType *Nav       = &DSM->DsmNav;
-   const struct AcStarTrackerType *st = &AC->ST[Ist];
+   double tmpM[3][3]                       = {{0.0}}, CSB[3][3];
+   static _Thread_local double **tmpAssign = NULL;
+   const struct DSMNavType *Nav            = &DSM->DsmNav;
+   const struct AcStarTrackerType *st      = &AC->ST[Ist];
    long i, j;
 
    if (tmpAssign == NULL)
@@ -1019,8 +952,6 @@ double **startrackJacobianFun(struct AcType *const AC,
       for (j = 0; j < 3; j++)
          tmpAssign[i][j] = 0.0;
 
-   double **jacobian =
-       CreateMatrix(Nav->measTypes[STARTRACK_SENSOR][Ist].errDim, Nav->navDim);
    Q2C(st->qb, CSB);
 
    switch (Nav->type) {
@@ -1046,17 +977,15 @@ double **startrackJacobianFun(struct AcType *const AC,
          exit(EXIT_FAILURE);
          break;
    }
-
-   return (jacobian);
 }
 
-double **gpsJacobianFun(struct AcType *const AC, struct DSMType *const DSM,
-                        const long Igps)
+void gpsJacobianFun(struct AcType *const AC, struct DSMType *const DSM,
+                    const long Igps, double **jacobian)
 {
    double tmp1[3][3] = {{0.0}}, tmp2[3][3] = {{0.0}}, tmp3[3][3] = {{0.0}},
           tmpX[3][3] = {{0.0}}, tmpV[3] = {0.0};
-   static double **tmpAssign    = NULL;
-   const struct DSMNavType *Nav = &DSM->DsmNav;
+   static _Thread_local double **tmpAssign = NULL;
+   const struct DSMNavType *Nav            = &DSM->DsmNav;
    long i, j;
 
    if (tmpAssign == NULL)
@@ -1066,9 +995,6 @@ double **gpsJacobianFun(struct AcType *const AC, struct DSMType *const DSM,
       for (j = 0; j < 3; j++)
          tmpAssign[i][j] = 0.0;
 
-   double **jacobian =
-       CreateMatrix(Nav->measTypes[GPS_SENSOR][Igps].dim, Nav->navDim);
-
    switch (Nav->type) {
       case LIEKF_NAV:
          for (i = 0; i < 3; i++)
@@ -1157,18 +1083,13 @@ double **gpsJacobianFun(struct AcType *const AC, struct DSMType *const DSM,
          exit(EXIT_FAILURE);
          break;
    }
-
-   return (jacobian);
 }
 
-double **accelJacobianFun(struct AcType *const AC, struct DSMType *const DSM,
-                          const long Iaccel)
+void accelJacobianFun(struct AcType *const AC, struct DSMType *const DSM,
+                      const long Iaccel, double **jacobian)
 {
    const struct DSMNavType *Nav = &DSM->DsmNav;
 
-   double **jacobian =
-       CreateMatrix(Nav->measTypes[ACCEL_SENSOR][Iaccel].dim, Nav->navDim);
-
    switch (Nav->type) {
       case LIEKF_NAV:
          break;
@@ -1181,29 +1102,24 @@ double **accelJacobianFun(struct AcType *const AC, struct DSMType *const DSM,
          exit(EXIT_FAILURE);
          break;
    }
-
-   return (jacobian);
 }
 
-double *gyroFun(struct AcType *const AC, struct DSMType *const DSM,
-                const long Ig)
+void gyroFun(struct AcType *const AC, struct DSMType *const DSM, const long Ig,
+             double *gyroEst)
 {
    const struct AcGyroType *G   = &AC->Gyro[Ig];
    const struct DSMNavType *Nav = &DSM->DsmNav;
    double wbn[3], wrn[3];
    long i;
 
-   double *gyroEst = calloc(1, sizeof(double));
-
    MTxV(Nav->CRB, Nav->refOmega, wrn);
    for (i = 0; i < 3; i++)
       wbn[i] = Nav->wbr[i] + wrn[i];
    gyroEst[0] = VoV(G->Axis, wbn) * R2D;
-   return (gyroEst);
 }
 
-double *magFun(struct AcType *const AC, struct DSMType *const DSM,
-               const long Imag)
+void magFun(struct AcType *const AC, struct DSMType *const DSM, const long Imag,
+            double *magEst)
 {
    const struct AcMagnetometerType *MAG = &AC->MAG[Imag];
    const struct DSMNavType *Nav         = &DSM->DsmNav;
@@ -1211,8 +1127,6 @@ double *magFun(struct AcType *const AC, struct DSMType *const DSM,
    const double T2mG = 1.0e7; // tesla to milligauss
    long i;
 
-   double *magEst = calloc(1, sizeof(double));
-
    // Not to really be used.
    for (i = 0; i < 3; i++)
       bvn[i] = AC->bvn[i];
@@ -1220,35 +1134,27 @@ double *magFun(struct AcType *const AC, struct DSMType *const DSM,
    MTxM(Nav->CRB, Nav->refCRN, CBN);
    MxV(CBN, bvn, bvb);
    magEst[0] = VoV(MAG->Axis, bvb) * T2mG;
-
-   return (magEst);
 }
 
-double *cssFun(struct AcType *const AC, struct DSMType *const DSM,
-               const long Icss)
+void cssFun(struct AcType *const AC, struct DSMType *const DSM, const long Icss,
+            double *IllumEst)
 {
    const struct AcCssType *css  = &AC->CSS[Icss];
    const struct DSMNavType *Nav = &DSM->DsmNav;
    double svb[3], CBN[3][3];
 
-   double *IllumEst = calloc(1, sizeof(double));
-
    MTxM(Nav->CRB, Nav->refCRN, CBN);
    MxV(CBN, AC->svn, svb);
    IllumEst[0] = VoV(svb, css->Axis) * css->Scale;
-
-   return (IllumEst);
 }
 
-double *fssFun(struct AcType *const AC, struct DSMType *const DSM,
-               const long Ifss)
+void fssFun(struct AcType *const AC, struct DSMType *const DSM, const long Ifss,
+            double *SunAngEst)
 {
    const struct AcFssType *fss  = &AC->FSS[Ifss];
    const struct DSMNavType *Nav = &DSM->DsmNav;
    double svb[3], svs[3], CBN[3][3];
 
-   double *SunAngEst = calloc(2, sizeof(double));
-
    const long BoreAxis = fss->BoreAxis;
    const long H_Axis   = fss->H_Axis;
    const long V_Axis   = fss->V_Axis;
@@ -1273,35 +1179,27 @@ double *fssFun(struct AcType *const AC, struct DSMType *const DSM,
                  "Invalid FSS Type. How did it get this far? Exiting...\n");
          exit(EXIT_FAILURE);
    }
-
-   return (SunAngEst);
 }
 
-double *startrackFun(struct AcType *const AC, struct DSMType *const DSM,
-                     const long Ist)
+void startrackFun(struct AcType *const AC, struct DSMType *const DSM,
+                  const long Ist, double *qsnEst)
 {
    const struct AcStarTrackerType *st = &AC->ST[Ist];
    const struct DSMNavType *Nav       = &DSM->DsmNav;
    double qbn[4], qrn[4];
 
-   double *qsnEst = calloc(4, sizeof(double));
-
    C2Q(Nav->refCRN, qrn);
    QxQ(Nav->qbr, qrn, qbn);
    QxQ(st->qb, qbn, qsnEst);
-
-   return (qsnEst);
 }
 
-double *gpsFun(struct AcType *const AC, struct DSMType *const DSM,
-               const long Igps)
+void gpsFun(struct AcType *const AC, struct DSMType *const DSM, const long Igps,
+            double *posNVelNEst)
 {
    const struct DSMNavType *Nav = &DSM->DsmNav;
    double tmp3V[3], tmpPosN[3], tmpVelN[3];
    long i;
 
-   double *posNVelNEst = calloc(6, sizeof(double));
-
    for (i = 0; i < 3; i++)
       tmp3V[i] = Nav->PosR[i] + Nav->refPos[i];
    MTxV(Nav->refCRN, tmp3V, tmpPosN);
@@ -1320,15 +1218,12 @@ double *gpsFun(struct AcType *const AC, struct DSMType *const DSM,
       posNVelNEst[i]     = tmpPosN[i];
       posNVelNEst[3 + i] = tmpVelN[i];
    }
-
-   return (posNVelNEst);
 }
 
 // don't need this at the moment, WIP
-double *accelFun(struct AcType *const AC, struct DSMType *const DSM,
-                 const long Ia)
+void accelFun(struct AcType *const AC, struct DSMType *const DSM, const long Ia,
+              double *accelEst)
 {
-   return (NULL);
 } /*{
    static double prevVelB[3]={0.0}, prevQBN[4]={0.0, 0.0, 0.0, 1.0};
    struct AcAccelType *A;
@@ -1433,9 +1328,9 @@ void eomRIEKFJacobianFun(struct AcType *const AC, struct DSMType *const DSM,
 {
    double tmpM[3][3] = {{0.0}}, tmpM2[3][3] = {{0.0}}, tmpM3[3][3] = {{0.0}},
           tmpV[3] = {0.0}, tmpV2[3] = {0.0}, tmpV3[3] = {0.0};
-   static double **tmpAssign = NULL;
-   double wrnd[3]            = {0.0};
-   struct DSMNavType *Nav    = &DSM->DsmNav;
+   static _Thread_local double **tmpAssign = NULL;
+   double wrnd[3]                          = {0.0};
+   struct DSMNavType *Nav                  = &DSM->DsmNav;
    long i, j, rowInd;
    enum States state;
 
@@ -1848,9 +1743,9 @@ void eomLIEKFJacobianFun(struct AcType *const AC, struct DSMType *const DSM,
 {
    double tmpM[3][3] = {{0.0}}, tmpM2[3][3] = {{0.0}}, tmpM3[3][3] = {{0.0}},
           tmpV[3] = {0.0}, tmpV2[3] = {0.0}, tmpV3[3] = {0.0};
-   static double **tmpAssign = NULL;
-   double wrnd[3]            = {0.0};
-   struct DSMNavType *Nav    = &DSM->DsmNav;
+   static _Thread_local double **tmpAssign = NULL;
+   double wrnd[3]                          = {0.0};
+   struct DSMNavType *Nav                  = &DSM->DsmNav;
    long i, j, rowInd;
    enum States state;
 
@@ -2229,9 +2124,9 @@ void eomMEKFJacobianFun(struct AcType *const AC, struct DSMType *const DSM,
 {
    double tmpM[3][3] = {{0.0}}, tmpM2[3][3] = {{0.0}}, tmpM3[3][3] = {{0.0}},
           tmpV[3] = {0.0}, tmpV2[3] = {0.0}, tmpV3[3] = {0.0};
-   static double **tmpAssign = NULL;
-   double wrnd[3]            = {0.0};
-   struct DSMNavType *Nav    = &DSM->DsmNav;
+   static _Thread_local double **tmpAssign = NULL;
+   double wrnd[3]                          = {0.0};
+   struct DSMNavType *Nav                  = &DSM->DsmNav;
    long i, j, rowInd;
    enum States state;
 
@@ -2477,7 +2372,7 @@ void MEKFUpdateLaw(struct DSMNavType *const Nav)
 double **GetStateLinTForm(struct DSMNavType *const Nav)
 {
    double **tForm, tmpM[3][3] = {{0.0}};
-   static double **tmpAssign = NULL;
+   static _Thread_local double **tmpAssign = NULL;
    long i, j;
 
    tForm = CreateMatrix(Nav->navDim, Nav->navDim);
@@ -2971,6 +2866,72 @@ void updateNavCCSDS(ccsdsCoarse *sec, ccsdsFine *subsec, const double dSeconds)
    }
 }
 
+// STM = expm(jacobian * dt), taken one group of states at a time.  States
+// whose jacobian blocks are zero in both directions never mix, so the STM is
+// block diagonal over those groups and each group only pays for its own size.
+void StateTransitionMatrix(struct DSMNavType *const Nav, const double dt,
+                           double **STM)
+{
+   long Grp[FIN_STATE + 1], Idx[Nav->navDim];
+   enum States s1, s2, s3;
+   long i, j, ng, Old, Coupled;
+
+   for (s1 = INIT_STATE; s1 <= FIN_STATE; s1++)
+      Grp[s1] = s1;
+   for (s1 = INIT_STATE; s1 <= FIN_STATE; s1++) {
+      if (!Nav->stateActive[s1])
+         continue;
+      for (s2 = s1 + 1; s2 <= FIN_STATE; s2++) {
+         if (!Nav->stateActive[s2] || Grp[s2] == Grp[s1])
+            continue;
+         Coupled = FALSE;
+         for (i = 0; i < Nav->navSize[s1] && !Coupled; i++) {
+            for (j = 0; j < Nav->navSize[s2] && !Coupled; j++) {
+               Coupled =
+                   Nav->jacobian[Nav->navInd[s1] + i][Nav->navInd[s2] + j] !=
+                       0.0 ||
+                   Nav->jacobian[Nav->navInd[s2] + j][Nav->navInd[s1] + i] !=
+                       0.0;
+            }
+         }
+         if (Coupled) {
+            Old = Grp[s2];
+            for (s3 = INIT_STATE; s3 <= FIN_STATE; s3++)
+               if (Grp[s3] == Old)
+                  Grp[s3] = Grp[s1];
+         }
+      }
+   }
+
+   for (i = 0; i < Nav->navDim; i++)
+      for (j = 0; j < Nav->navDim; j++)
+         STM[i][j] = 0.0;
+
+   for (s1 = INIT_STATE; s1 <= FIN_STATE; s1++) {
+      if (!Nav->stateActive[s1])
+         continue;
+      /* Only the first state of each group gathers it */
+      for (s2 = INIT_STATE; s2 < s1; s2++)
+         if (Nav->stateActive[s2] && Grp[s2] == Grp[s1])
+            break;
+      if (s2 < s1)
+         continue;
+      ng = 0;
+      for (s2 = s1; s2 <= FIN_STATE; s2++)
+         if (Nav->stateActive[s2] && Grp[s2] == Grp[s1])
+            for (i = 0; i < Nav->navSize[s2]; i++)
+               Idx[ng++] = Nav->navInd[s2] + i;
+
+      for (i = 0; i < ng; i++)
+         for (j = 0; j < ng; j++)
+            Nav->NxN[i][j] = Nav->jacobian[Idx[i]][Idx[j]] * dt;
+      expmPade(Nav->NxN, Nav->NxN2, ng, Nav->expmWork);
+      for (i = 0; i < ng; i++)
+         for (j = 0; j < ng; j++)
+            STM[Idx[i]][Idx[j]] = Nav->NxN2[i][j];
+   }
+}
+
 void PropagateNav(struct AcType *const AC, struct DSMType *const DSM,
                   const long dCCSDSSec, const long dCCSDSSubSec,
                   const long init)
@@ -3034,17 +2995,8 @@ void PropagateNav(struct AcType *const AC, struct DSMType *const DSM,
       }
       (*Nav->EOMJacobianFun)(AC, DSM, &Nav->Date, Nav->CRB, Nav->qbr, Nav->PosR,
                              Nav->VelR, Nav->wbr, Nav->whlH, AtmoDensity);
-      // TODO: find a better way to simplify the STM calculation. This is bound
-      // to be quite slow due to the number of multiplications.
-      for (i = 0; i < Nav->navDim; i++)
-         for (j = 0; j < Nav->navDim; j++)
-            Nav->NxN2[i][j] = Nav->jacobian[i][j] * ccsdsStepSize;
-      expm(Nav->NxN2, Nav->STMStep, Nav->navDim);
-
-      for (i = 0; i < Nav->navDim; i++)
-         for (j = 0; j < Nav->navDim; j++)
-            Nav->NxN2[i][j] = Nav->jacobian[i][j] * Nav->subStepSize;
-      expm(Nav->NxN2, Nav->STM, Nav->navDim);
+      StateTransitionMatrix(Nav, ccsdsStepSize, Nav->STMStep);
+      StateTransitionMatrix(Nav, Nav->subStepSize, Nav->STM);
    }
    double dLerpAlpha = 0.0;
    // RK4
@@ -3242,6 +3194,225 @@ void PropagateNav(struct AcType *const AC, struct DSMType *const DSM,
    configureRefFrame(Nav, DSM->refOrb, DT / Nav->DT, FALSE);
 }
 
+// Size the Kalman update workspace for a batch of measDim measurements. It
+// only grows, so once the largest batch has been seen the filter stops
+// allocating.
+struct DSMKalmanWorkType *ReserveKalmanWork(struct DSMNavType *const Nav,
+                                            long const measDim)
+{
+   struct DSMKalmanWorkType *W = &Nav->kfWork;
+   const long n                = Nav->navDim;
+
+   if (measDim <= 0 || (W->navDim == n && W->measDim >= measDim))
+      return (W);
+
+   DestroyKalmanWork(Nav);
+   W->navDim  = n;
+   W->measDim = measDim;
+   W->H       = CreateMatrix(measDim, n);
+   W->N       = CreateMatrix(measDim, measDim);
+   W->resid   = calloc(measDim, sizeof(double));
+   W->R       = calloc(measDim, sizeof(double));
+   // star tracker estimates are quaternions, one longer than their errDim
+   W->est = calloc(measDim + 1, sizeof(double));
+   W->HS  = CreateMatrix(measDim, n);
+   W->NR  = CreateMatrix(measDim, measDim);
+   W->C   = CreateMatrix(n, measDim);
+   W->Sz  = CreateMatrix(measDim, measDim);
+   W->Uk  = CreateMatrix(n, measDim);
+   W->K   = CreateMatrix(n, measDim);
+   W->QR  = CreateMatrix(n + measDim, measDim);
+   W->U   = CreateMatrix(n + measDim, measDim);
+   return (W);
+}
+
+void DestroyKalmanWork(struct DSMNavType *const Nav)
+{
+   struct DSMKalmanWorkType *W = &Nav->kfWork;
+
+   if (W->measDim == 0)
+      return;
+   DestroyMatrix(W->H);
+   DestroyMatrix(W->N);
+   free(W->resid);
+   free(W->R);
+   free(W->est);
+   DestroyMatrix(W->HS);
+   DestroyMatrix(W->NR);
+   DestroyMatrix(W->C);
+   DestroyMatrix(W->Sz);
+   DestroyMatrix(W->Uk);
+   DestroyMatrix(W->K);
+   DestroyMatrix(W->QR);
+   DestroyMatrix(W->U);
+   W->navDim  = 0;
+   W->measDim = 0;
+}
+
+// Batched square-root update. The QR of the stacked [(HS)^T; (NR)^T] gives
+// the upper-triangular innovation factor Sz, and the gain and the covariance
+// downdate both come from triangular solves against it.
+void QRMeasUpdate(struct DSMNavType *const Nav, const long measDim)
+{
+   struct DSMKalmanWorkType *W = &Nav->kfWork;
+   const long n                = Nav->navDim;
+
+   double **HS = W->HS, **NR = W->NR, **C = W->C, **Sz = W->Sz;
+   double **Uk = W->Uk, **K = W->K, **tmp = W->QR;
+   long i, j, k;
+
+   // UNDERWEIGHTING
+   MxMG(W->H, Nav->S, HS, measDim, n, n);
+   for (i = 0; i < measDim; i++)
+      for (j = 0; j < measDim; j++)
+         NR[i][j] = W->N[i][j] * W->R[j];
+
+   // Compare square of matrix 2-norms for underweighting
+   if (M2Norm2G(HS, measDim, n) >= (5.0 * M2Norm2G(NR, measDim, measDim))) {
+      const double rtp = sqrt(1.2);
+      for (i = 0; i < n; i++)
+         for (j = 0; j < measDim; j++)
+            tmp[i][j] = HS[j][i] * rtp;
+   }
+   else {
+      for (i = 0; i < n; i++)
+         for (j = 0; j < measDim; j++)
+            tmp[i][j] = HS[j][i];
+   }
+
+   for (i = 0; i < measDim; i++)
+      for (j = 0; j < measDim; j++)
+         tmp[i + n][j] = NR[j][i];
+
+   // hqrd only fills the upper triangle of Sz
+   for (i = 0; i < measDim; i++)
+      for (j = 0; j < measDim; j++)
+         Sz[i][j] = 0.0;
+   hqrd(tmp, W->U, Sz, n + measDim, measDim);
+
+   MxMTG(Nav->S, HS, C, n, n, measDim);
+
+   // Uk = C*Sz^-1, then K = Uk*Sz^-T, so K*(Sz^T*Sz) = C
+   for (i = 0; i < n; i++) {
+      for (j = 0; j < measDim; j++) {
+         double x = C[i][j];
+         for (k = 0; k < j; k++)
+            x -= Uk[i][k] * Sz[k][j];
+         Uk[i][j] = x / Sz[j][j];
+      }
+      for (j = measDim - 1; j >= 0; j--) {
+         double x = Uk[i][j];
+         for (k = j + 1; k < measDim; k++)
+            x -= K[i][k] * Sz[j][k];
+         K[i][j] = x / Sz[j][j];
+      }
+   }
+   MxVG(K, W->resid, Nav->delta, n, measDim);
+   (*Nav->updateLaw)(Nav);
+
+   for (i = 0; i < n; i++)
+      for (j = 0; j <= i; j++) {
+         Nav->NxN[j][i] = 0.0;
+         Nav->NxN[i][j] = Nav->S[i][j];
+      }
+   for (i = 0; i < measDim; i++) {
+      double u[n];
+      for (j = 0; j < n; j++)
+         u[j] = Uk[j][i];
+      if (cholDowndate(Nav->NxN, u, n) == FALSE) {
+         fprintf(stderr, "Cholesky Downdate failed! Exiting...\n");
+         exit(EXIT_FAILURE);
+         // TODO: data dump to help diagnose downdate failure??
+         // TODO: Defer downdate if failure?
+      }
+   }
+   for (i = 0; i < n; i++)
+      for (j = 0; j <= i; j++)
+         Nav->S[i][j] = Nav->NxN[i][j];
+}
+
+// TRUE if the stacked noise mapping N is diagonal, so the rows of the batch
+// are uncorrelated and may be processed one at a time
+long DiagonalMeasNoise(const struct DSMKalmanWorkType *W, const long measDim)
+{
+   long i, j;
+
+   for (i = 0; i < measDim; i++)
+      for (j = 0; j < measDim; j++)
+         if (i != j && W->N[i][j] != 0.0)
+            return (FALSE);
+   return (TRUE);
+}
+
+// Sequential scalar update for batches with uncorrelated noise. Each row
+// costs O(navDim^2) with no matrix inverse. The error state delta is
+// accumulated across rows about the same linearization point and applied by
+// the update law once at the end, matching QRMeasUpdate for a single row.
+void SequentialMeasUpdate(struct DSMNavType *const Nav, const long measDim)
+{
+   const struct DSMKalmanWorkType *W = &Nav->kfWork;
+   const long n                      = Nav->navDim;
+   double f[n], c[n];
+   long i, j, k;
+
+   for (i = 0; i < n; i++) {
+      Nav->delta[i] = 0.0;
+      for (j = 0; j <= i; j++) {
+         Nav->NxN[j][i] = 0.0;
+         Nav->NxN[i][j] = Nav->S[i][j];
+      }
+   }
+   for (k = 0; k < measDim; k++) {
+      const double *h = W->H[k];
+      const double r  = W->N[k][k] * W->R[k];
+
+      // f = S^T*h, c = S*f = P*h
+      double ff = 0.0;
+      for (j = 0; j < n; j++) {
+         f[j] = 0.0;
+         for (i = j; i < n; i++)
+            f[j] += Nav->NxN[i][j] * h[i];
+         ff += f[j] * f[j];
+      }
+      for (i = 0; i < n; i++) {
+         c[i] = 0.0;
+         for (j = 0; j <= i; j++)
+            c[i] += Nav->NxN[i][j] * f[j];
+      }
+
+      // UNDERWEIGHTING
+      const double a = (ff >= 5.0 * r * r ? 1.2 * ff : ff) + r * r;
+
+      double innov = W->resid[k];
+      for (i = 0; i < n; i++)
+         innov -= h[i] * Nav->delta[i];
+      const double sqrta = sqrt(a);
+      for (i = 0; i < n; i++) {
+         Nav->delta[i] += c[i] * innov / a;
+         c[i]          /= sqrta;
+      }
+      if (cholDowndate(Nav->NxN, c, n) == FALSE) {
+         fprintf(stderr, "Cholesky Downdate failed! Exiting...\n");
+         exit(EXIT_FAILURE);
+      }
+   }
+   (*Nav->updateLaw)(Nav);
+   for (i = 0; i < n; i++)
+      for (j = 0; j <= i; j++)
+         Nav->S[i][j] = Nav->NxN[i][j];
+}
+
+// Apply the stacked batch in kfWork with the configured update. Correlated
+// noise cannot be split into scalar rows, so it always takes the QR update.
+void MeasUpdate(struct DSMNavType *const Nav, const long measDim)
+{
+   if (Nav->update == SEQUENTIAL_UPDATE &&
+       DiagonalMeasNoise(&Nav->kfWork, measDim))
+      SequentialMeasUpdate(Nav, measDim);
+   else
+      QRMeasUpdate(Nav, measDim);
+}
+
 void KalmanFilt(struct AcType *const AC, struct DSMType *const DSM)
 {
    long i, j;
@@ -3274,7 +3445,6 @@ void KalmanFilt(struct AcType *const AC, struct DSMType *const DSM)
          const long measSec              = measList->head->ccsdsSeconds;
          const long measSubsec           = measList->head->ccsdsSubseconds;
 
-         // TODO: avoid this preallocation mess and go with realloc (maybe?)
          switch (Nav->batching) {
             case NONE_BATCH:
                measDim = measList->head->errDim;
@@ -3344,15 +3514,13 @@ void KalmanFilt(struct AcType *const AC, struct DSMType *const DSM)
             exit(EXIT_FAILURE);
          }
 
-         double **bigH, *bigResid, *bigR, **bigN;
-         bigH     = CreateMatrix(measDim, Nav->navDim);
-         bigN     = CreateMatrix(measDim, measDim);
-         bigResid = calloc(measDim, sizeof(double));
-         bigR     = calloc(measDim, sizeof(double));
+         struct DSMKalmanWorkType *W = ReserveKalmanWork(Nav, measDim);
+         for (i = 0; i < measDim; i++)
+            for (j = 0; j < measDim; j++)
+               W->N[i][j] = 0.0;
 
          long curDim = 0;
          long dim    = -2;
-         double *measEstData, **measJacobian;
 
          while (measList->head != NULL) {
             struct DSMMeasType *meas = pop_DSMMeas(measList);
@@ -3360,17 +3528,20 @@ void KalmanFilt(struct AcType *const AC, struct DSMType *const DSM)
                dim = meas->errDim;
 
             double resid[dim];
-            measEstData  = (*meas->measFun)(AC, DSM, meas->sensorNum);
-            measJacobian = (*meas->measJacobianFun)(AC, DSM, meas->sensorNum);
+            for (i = 0; i < dim; i++)
+               for (j = 0; j < Nav->navDim; j++)
+                  W->H[curDim + i][j] = 0.0;
+            (*meas->measFun)(AC, DSM, meas->sensorNum, W->est);
+            (*meas->measJacobianFun)(AC, DSM, meas->sensorNum, &W->H[curDim]);
 
             if (meas->type == STARTRACK_SENSOR) {
                double tmpq[4];
-               QxQT(meas->data, measEstData, tmpq);
+               QxQT(meas->data, W->est, tmpq);
                Q2AngleVec(tmpq, resid);
             }
             else {
                for (i = 0; i < dim; i++)
-                  resid[i] = meas->data[i] - measEstData[i];
+                  resid[i] = meas->data[i] - W->est[i];
             }
 #if REPORT_RESIDUALS == TRUE
             Nav->residuals[meas->type][meas->sensorNum] =
@@ -3380,18 +3551,14 @@ void KalmanFilt(struct AcType *const AC, struct DSMType *const DSM)
 #endif
 
             for (i = 0; i < dim; i++) {
-               bigResid[curDim + i] = resid[i];
-               bigR[curDim + i]     = meas->R[i];
-               for (j = 0; j < Nav->navDim; j++)
-                  bigH[curDim + i][j] = measJacobian[i][j];
+               W->resid[curDim + i] = resid[i];
+               W->R[curDim + i]     = meas->R[i];
                for (j = 0; j < dim; j++)
-                  bigN[curDim + i][curDim + j] = meas->N[i][j];
+                  W->N[curDim + i][curDim + j] = meas->N[i][j];
             }
 
             curDim += dim;
-            free(measEstData);
-            DestroyMatrix(measJacobian);
-            DestroyMeas(meas);
+            ReleaseMeas(Nav, meas);
 
             if ((Nav->batching == NONE_BATCH) || (measList->head == NULL) ||
                 (measList->head->ccsdsSubseconds != measSubsec ||
@@ -3402,92 +3569,7 @@ void KalmanFilt(struct AcType *const AC, struct DSMType *const DSM)
             }
          }
 
-         double **Sz, **K, **C, **tmp;
-         C = CreateMatrix(Nav->navDim, measDim);
-
-         // UNDERWEIGHTING
-         double **HS = CreateMatrix(measDim, Nav->navDim);
-         MxMG(bigH, Nav->S, HS, measDim, Nav->navDim, Nav->navDim);
-         double **NR = CreateMatrix(measDim, measDim);
-         for (i = 0; i < measDim; i++)
-            for (j = 0; j < measDim; j++)
-               NR[i][j] = bigN[i][j] * bigR[j];
-
-         tmp = CreateMatrix(Nav->navDim + measDim, measDim);
-         // Compare square of matrix 2-norms for underweighting
-         if (M2Norm2G(HS, measDim, Nav->navDim) >=
-             (5.0 * M2Norm2G(NR, measDim, measDim))) {
-            const double rtp = sqrt(1.2);
-            for (i = 0; i < Nav->navDim; i++)
-               for (j = 0; j < measDim; j++)
-                  tmp[i][j] = HS[j][i] * rtp;
-         }
-         else {
-            for (i = 0; i < Nav->navDim; i++)
-               for (j = 0; j < measDim; j++)
-                  tmp[i][j] = HS[j][i];
-         }
-
-         for (i = 0; i < measDim; i++)
-            for (j = 0; j < measDim; j++)
-               tmp[i + Nav->navDim][j] = NR[j][i];
-
-         DestroyMatrix(NR);
-         Sz         = CreateMatrix(measDim, measDim);
-         double **U = CreateMatrix(Nav->navDim + measDim, measDim);
-         hqrd(tmp, U, Sz, Nav->navDim + measDim, measDim);
-
-         DestroyMatrix(U);
-         DestroyMatrix(tmp);
-
-         double **Uk = CreateMatrix(Nav->navDim, measDim);
-
-         MxMTG(Nav->S, HS, C, Nav->navDim, Nav->navDim, measDim);
-         DestroyMatrix(HS);
-
-         MxMINVG(C, Sz, Uk, Nav->navDim, measDim);
-         for (i = 0; i < measDim; i++) {
-            for (j = i + 1; j < measDim; j++) {
-               Sz[j][i] = Sz[i][j];
-               Sz[i][j] = 0.0;
-            }
-         }
-         K = CreateMatrix(Nav->navDim, measDim);
-         MxMINVG(Uk, Sz, K, Nav->navDim, measDim);
-         MxVG(K, bigResid, Nav->delta, Nav->navDim, measDim);
-         (*Nav->updateLaw)(Nav);
-
-         // long downdateFail = FALSE;
-         for (i = 0; i < Nav->navDim; i++)
-            for (j = 0; j <= i; j++) {
-               Nav->NxN[j][i] = 0.0;
-               Nav->NxN[i][j] = Nav->S[i][j];
-            }
-         for (i = 0; i < measDim; i++) {
-            double u[Nav->navDim];
-            for (j = 0; j < Nav->navDim; j++)
-               u[j] = Uk[j][i];
-            if (cholDowndate(Nav->NxN, u, Nav->navDim) == FALSE) {
-               // downdateFail = TRUE;
-               fprintf(stderr, "Cholesky Downdate failed! Exiting...\n");
-               exit(EXIT_FAILURE);
-               // TODO: data dump to help diagnose downdate failure??
-               // TODO: Defer downdate if failure?
-            }
-         }
-         for (i = 0; i < Nav->navDim; i++)
-            for (j = 0; j <= i; j++)
-               Nav->S[i][j] = Nav->NxN[i][j];
-
-         DestroyMatrix(Sz);
-         DestroyMatrix(Uk);
-         DestroyMatrix(K);
-
-         DestroyMatrix(bigH);
-         DestroyMatrix(bigN);
-         DestroyMatrix(C);
-         free(bigResid);
-         free(bigR);
+         MeasUpdate(Nav, measDim);
       }
       if (Nav->ccsdsSeconds < finSeconds ||
           Nav->ccsdsSubseconds < finSubseconds)
@@ -2362,11 +2362,11 @@ void TDRSPosVel(double PriMerAng, double time, double ptn[10][3],
    double S1, C1, C2, S3, C3;
    long j;
 
-   static double p[10];
+   static SIMLOCAL double p[10];
    static double LAN0[10] = {0.0,   36.0,  72.0,  108.0, 144.0,
                              180.0, 216.0, 252.0, 288.0, 324.0}; /* deg */
-   static double om0[10];
-   static long First = 1;
+   static SIMLOCAL double om0[10];
+   static SIMLOCAL long First = 1;
 
    if (First) {
       First = 0;
@@ -100,6 +100,7 @@ report
 //|        to calculate these values in some other way.
 //|
 //|============================================================================*/
+#include "42constants.h"
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -110,18 +111,18 @@ report
 #define AE_MAX 2
 #define AP_MAX 3
 
-int *MAP;
-float FISTEP;
-int I1;
-float FKB1, FKB2, FINCR2, FINCR1;
-float FKBM, FLOGM, SL2, FNB, DFL;
-int J1, J2, ITIME, L1, L2;
-int FLOG1, FLOG2;
-float FKBJ1, FKBJ2, SL1;
-float FKB, FLOG;
+SIMLOCAL int *MAP;
+SIMLOCAL float FISTEP;
+SIMLOCAL int I1;
+SIMLOCAL float FKB1, FKB2, FINCR2, FINCR1;
+SIMLOCAL float FKBM, FLOGM, SL2, FNB, DFL;
+SIMLOCAL int J1, J2, ITIME, L1, L2;
+SIMLOCAL int FLOG1, FLOG2;
+SIMLOCAL float FKBJ1, FKBJ2, SL1;
+SIMLOCAL float FKB, FLOG;
 
-int Descriptors[4][8];
-int *MapAeMin, *MapApMin, *MapAeMax, *MapApMax;
+SIMLOCAL int Descriptors[4][8];
+SIMLOCAL int *MapAeMin, *MapApMin, *MapAeMax, *MapApMax;
 
 /******************************************************************************/
 void LoadMapsFromFiles(void)
@@ -556,7 +557,7 @@ void RadBelt(float RadiusKm, float MagLatDeg, int NumEnergies,
 {
    float Lvalue, BB0;
    float bottomF, altrad, RE, BetaValueF;
-   static int First = 1;
+   static SIMLOCAL int First = 1;
    static float *LogFlux;
    int Ie;
 
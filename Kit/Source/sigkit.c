@@ -12,6 +12,7 @@
 /*    All Other Rights Reserved.                                      */
 
 #include "sigkit.h"
+#include "42constants.h"
 
 /* #ifdef __cplusplus
 ** namespace Kit {
@@ -160,6 +161,188 @@ double GaussianRandom(struct RandomProcessType *RP)
    }
 }
 /**********************************************************************/
+/* Philox4x32-10, from Salmon et al, "Parallel Random Numbers: As     */
+/* Easy as 1, 2, 3", SC11.  Ten rounds of a keyed bijection on a      */
+/* 128-bit counter; the output passes BigCrush.                       */
+#define PHILOX_M0     0xD2511F53u
+#define PHILOX_M1     0xCD9E8D57u
+#define PHILOX_W0     0x9E3779B9u
+#define PHILOX_W1     0xBB67AE85u
+#define PHILOX_ROUNDS 10
+/* Blocks run in lockstep by GaussianStreamVec, so the rounds vectorize */
+#define PHILOX_LANES  8
+void Philox4x32(const uint32_t Ctr[4], const uint32_t Key[2], uint32_t Out[4])
+{
+   uint32_t c0 = Ctr[0], c1 = Ctr[1], c2 = Ctr[2], c3 = Ctr[3];
+   uint32_t k0 = Key[0], k1 = Key[1];
+   uint64_t p0, p1;
+   long r;
+
+   for (r = 0; r < PHILOX_ROUNDS; r++) {
+      p0  = (uint64_t)PHILOX_M0 * c0;
+      p1  = (uint64_t)PHILOX_M1 * c2;
+      c0  = (uint32_t)(p1 >> 32) ^ c1 ^ k0;
+      c1  = (uint32_t)p1;
+      c2  = (uint32_t)(p0 >> 32) ^ c3 ^ k1;
+      c3  = (uint32_t)p0;
+      k0 += PHILOX_W0;
+      k1 += PHILOX_W1;
+   }
+   Out[0] = c0;
+   Out[1] = c1;
+   Out[2] = c2;
+   Out[3] = c3;
+}
+/**********************************************************************/
+/* Seed keys the generator.  Id0 (32 bits), Id1 (8), Id2 (16) and Id3 */
+/* (8) name the stream, e.g. spacecraft, sensor kind, sensor, axis.   */
+void InitRandomStream(struct RandomStreamType *RS, long Seed, long Id0,
+                      long Id1, long Id2, long Id3)
+{
+   RS->Key[0] = (uint32_t)((uint64_t)Seed & 0xFFFFFFFFu);
+   RS->Key[1] = (uint32_t)((uint64_t)Seed >> 32);
+   RS->Id[0]  = (uint32_t)Id0;
+   RS->Id[1]  = ((uint32_t)(Id1 & 0xFF) << 24) |
+               ((uint32_t)(Id2 & 0xFFFF) << 8) | (uint32_t)(Id3 & 0xFF);
+
+   RS->Count    = 0;
+   RS->HaveNext = 0;
+}
+/**********************************************************************/
+/* Block b of a stream is Philox of (b, Id).  Its 128 bits make two   */
+/* 53-bit uniforms in [0,1), samples 2b and 2b+1 of the stream.       */
+#define PHILOX_U53(Hi, Lo)                                                     \
+   ((double)(((uint64_t)(Hi) << 21) ^ ((Lo) >> 11)) * 0x1.0p-53)
+static void StreamBlock(const struct RandomStreamType *RS, uint64_t Block,
+                        double U[2])
+{
+   uint32_t Ctr[4], Out[4];
+
+   Ctr[0] = (uint32_t)Block;
+   Ctr[1] = (uint32_t)(Block >> 32);
+   Ctr[2] = RS->Id[0];
+   Ctr[3] = RS->Id[1];
+   Philox4x32(Ctr, RS->Key, Out);
+   U[0] = PHILOX_U53(Out[0], Out[1]);
+   U[1] = PHILOX_U53(Out[2], Out[3]);
+}
+/**********************************************************************/
+/* PHILOX_LANES consecutive blocks at once, in lockstep */
+static void StreamBlocks(const struct RandomStreamType *RS, uint64_t Block,
+                         double U0[PHILOX_LANES], double U1[PHILOX_LANES])
+{
+   uint32_t c0[PHILOX_LANES], c1[PHILOX_LANES], c2[PHILOX_LANES],
+       c3[PHILOX_LANES];
+   uint32_t k0 = RS->Key[0], k1 = RS->Key[1], t0, t2;
+   uint64_t p0, p1;
+   long j, r;
+
+   for (j = 0; j < PHILOX_LANES; j++) {
+      c0[j] = (uint32_t)(Block + j);
+      c1[j] = (uint32_t)((Block + j) >> 32);
+      c2[j] = RS->Id[0];
+      c3[j] = RS->Id[1];
+   }
+   for (r = 0; r < PHILOX_ROUNDS; r++) {
+      for (j = 0; j < PHILOX_LANES; j++) {
+         p0    = (uint64_t)PHILOX_M0 * c0[j];
+         p1    = (uint64_t)PHILOX_M1 * c2[j];
+         t0    = (uint32_t)(p1 >> 32) ^ c1[j] ^ k0;
+         t2    = (uint32_t)(p0 >> 32) ^ c3[j] ^ k1;
+         c0[j] = t0;
+         c1[j] = (uint32_t)p1;
+         c2[j] = t2;
+         c3[j] = (uint32_t)p0;
+      }
+      k0 += PHILOX_W0;
+      k1 += PHILOX_W1;
+   }
+   for (j = 0; j < PHILOX_LANES; j++) {
+      U0[j] = PHILOX_U53(c0[j], c1[j]);
+      U1[j] = PHILOX_U53(c2[j], c3[j]);
+   }
+}
+/**********************************************************************/
+/* Uniform deviate in [0,1) */
+double UniformStream(struct RandomStreamType *RS)
+{
+   double U[2];
+   uint64_t n = RS->Count++;
+
+   RS->HaveNext = 0;
+   StreamBlock(RS, n / 2, U);
+   return (U[n % 2]);
+}
+/**********************************************************************/
+/* Zero-mean, unit-variance deviate.  Box-Muller rather than the      */
+/* polar method, so every sample costs exactly one half-block and     */
+/* sample n can be found without drawing the ones before it.          */
+double GaussianStream(struct RandomStreamType *RS)
+{
+   double U[2], r, th;
+   uint64_t n = RS->Count++;
+
+   if (RS->HaveNext) {
+      RS->HaveNext = 0;
+      return (RS->Next);
+   }
+   StreamBlock(RS, n / 2, U);
+   r  = sqrt(-2.0 * log(1.0 - U[0]));
+   th = TWOPI * U[1];
+   if (n % 2)
+      return (r * sin(th));
+   RS->HaveNext = 1;
+   RS->Next     = r * sin(th);
+   return (r * cos(th));
+}
+/**********************************************************************/
+/* The next N Gaussian deviates of the stream, as N calls to          */
+/* GaussianStream would give them.                                    */
+void GaussianStreamVec(struct RandomStreamType *RS, double *Out, long N)
+{
+   double U0[PHILOX_LANES], U1[PHILOX_LANES], r, th;
+   uint64_t First, Block, n;
+   long Nb, j, i;
+
+   if (N <= 0)
+      return;
+   if (RS->HaveNext) {
+      RS->HaveNext = 0;
+      *Out++       = RS->Next;
+      RS->Count++;
+      if (--N == 0)
+         return;
+   }
+   First = RS->Count / 2;
+   for (Block = First; 2 * Block < RS->Count + N; Block += Nb) {
+      Nb = (long)((RS->Count + N + 1) / 2 - Block);
+      if (Nb > PHILOX_LANES)
+         Nb = PHILOX_LANES;
+      StreamBlocks(RS, Block, U0, U1);
+      for (j = 0; j < Nb; j++) {
+         r  = sqrt(-2.0 * log(1.0 - U0[j]));
+         th = TWOPI * U1[j];
+         n  = 2 * (Block + j);
+         if (n >= RS->Count) {
+            i      = (long)(n - RS->Count);
+            Out[i] = r * cos(th);
+         }
+         if (n + 1 < RS->Count + N) {
+            i      = (long)(n + 1 - RS->Count);
+            Out[i] = r * sin(th);
+         }
+      }
+   }
+   RS->Count += N;
+}
+#undef PHILOX_M0
+#undef PHILOX_M1
+#undef PHILOX_W0
+#undef PHILOX_W1
+#undef PHILOX_ROUNDS
+#undef PHILOX_LANES
+#undef PHILOX_U53
+/**********************************************************************/
 /* Returns a uniform deviate in range [-1:1].  No internal states,    */
 /* so suitable for procedural textures and other deterministic        */
 /* applications.                                                      */
@@ -444,9 +444,9 @@ double usec(void)
 {
 #if defined(_WIN32)
 
-   static LARGE_INTEGER SysFreq;
+   static SIMLOCAL LARGE_INTEGER SysFreq;
    LARGE_INTEGER SysCtr;
-   static long First = 1;
+   static SIMLOCAL long First = 1;
 
    if (First) {
       First = 0;
@@ -492,13 +492,13 @@ void RealSystemTime(long *Year, long *DOY, long *Month, long *Day, long *Hour,
 /**********************************************************************/
 double RealRunTime(double *RealTimeDT, double LSB)
 {
-   static double RunTime = 0.0;
-   static long First     = 1;
+   static SIMLOCAL double RunTime = 0.0;
+   static SIMLOCAL long First     = 1;
 
 #if defined(_WIN32)
 
-   static LARGE_INTEGER SysFreq;
-   static LARGE_INTEGER OldSysCtr;
+   static SIMLOCAL LARGE_INTEGER SysFreq;
+   static SIMLOCAL LARGE_INTEGER OldSysCtr;
    LARGE_INTEGER SysCtr;
 
    if (First) {
@@ -514,7 +514,7 @@ double RealRunTime(double *RealTimeDT, double LSB)
 
 #elif (defined(__APPLE__) || defined(__linux__))
 
-   static double OldSysTime;
+   static SIMLOCAL double OldSysTime;
    double SysTime;
    long Year, DOY, Month, Day, Hour, Minute;
    double Second;
@@ -153,34 +153,29 @@ long SimCmdInterpreter(char CmdLine[512], double *CmdTime)
    return (NewCmdProcessed);
 }
 /**********************************************************************/
-void CmdInterpreter(void)
+void CmdInterpreter(struct SimContextType *Ctx)
 {
-   static FILE *CmdFile;
-   static char CmdLine[512];
-   static double CmdTime;
    long NewCmdProcessed;
 
-   static long First         = 1;
-   static long CmdFileActive = 1;
-
-   if (First) {
-      First = 0;
+   if (!Ctx->CmdInit) {
+      Ctx->CmdInit = 1;
       if (!strcmp(CmdFileName, "NONE"))
-         CmdFileActive = 0;
+         Ctx->CmdFileActive = 0;
       else {
-         CmdFile = FileOpen(InOutPath, CmdFileName, "rt");
-         fgets(CmdLine, 512, CmdFile);
-         fgets(CmdLine, 512, CmdFile);
-         sscanf(CmdLine, "%lf", &CmdTime);
-         if (!strncmp(CmdLine, "EOF", 3)) {
-            fclose(CmdFile);
+         Ctx->CmdFile = FileOpen(InOutPath, CmdFileName, "rt");
+         fgets(Ctx->CmdLine, 512, Ctx->CmdFile);
+         fgets(Ctx->CmdLine, 512, Ctx->CmdFile);
+         sscanf(Ctx->CmdLine, "%lf", &Ctx->CmdTime);
+         if (!strncmp(Ctx->CmdLine, "EOF", 3)) {
+            fclose(Ctx->CmdFile);
             printf("Reached CmdScript EOF at Time = %lf\n", SimTime);
-            CmdFileActive = 0;
+            Ctx->CmdFileActive = 0;
          }
       }
    }
 
-   while (CmdTime <= SimTime + 0.5 * DTSIM && CmdFileActive) {
+   while (Ctx->CmdTime <= SimTime + 0.5 * DTSIM && Ctx->CmdFileActive) {
+      char *CmdLine   = Ctx->CmdLine;
       NewCmdProcessed = FALSE;
       /* Look for known command patterns */
 
@@ -191,28 +186,28 @@ void CmdInterpreter(void)
          NewCmdProcessed = TRUE;
 
       /* Sim Commands */
-      else if (SimCmdInterpreter(CmdLine, &CmdTime))
+      else if (SimCmdInterpreter(CmdLine, &Ctx->CmdTime))
          NewCmdProcessed = TRUE;
 
 /* Visualization Commands */
 #ifdef _ENABLE_GUI_
-      else if (GuiCmdInterpreter(CmdLine, &CmdTime))
+      else if (GuiCmdInterpreter(CmdLine, &Ctx->CmdTime))
          NewCmdProcessed = TRUE;
 #endif
 
       /* FSW Commands */
-      else if (FswCmdInterpreter(CmdLine, &CmdTime))
+      else if (FswCmdInterpreter(CmdLine, &Ctx->CmdTime))
          NewCmdProcessed = TRUE;
 
       /* If any match found, get next command */
       if (NewCmdProcessed) {
          printf("%s", CmdLine);
-         fgets(CmdLine, 512, CmdFile);
-         sscanf(CmdLine, "%lf", &CmdTime);
+         fgets(CmdLine, 512, Ctx->CmdFile);
+         sscanf(CmdLine, "%lf", &Ctx->CmdTime);
          if (!strncmp(CmdLine, "EOF", 3)) {
-            fclose(CmdFile);
+            fclose(Ctx->CmdFile);
             printf("Reached CmdScript EOF at Time = %lf\n", SimTime);
-            CmdFileActive = 0;
+            Ctx->CmdFileActive = 0;
          }
          fflush(stdout);
       }
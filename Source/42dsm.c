@@ -205,6 +205,7 @@ void InitDSM(struct SCType *S)
 
    Nav->type             = IDEAL_NAV;
    Nav->batching         = NONE_BATCH;
+   Nav->update           = QR_UPDATE;
    Nav->refFrame         = FRAME_N;
    Nav->NavigationActive = FALSE;
    Nav->DT               = S->AC.DT;
@@ -227,8 +228,11 @@ void InitDSM(struct SCType *S)
       Nav->sensorActive[i] = FALSE;
       Nav->measTypes[i]    = NULL;
       Nav->residuals[i]    = NULL;
+      Nav->measPool[i]     = NULL;
    }
    InitMeasList(&Nav->measList);
+   Nav->kfWork.navDim  = 0;
+   Nav->kfWork.measDim = 0;
    /* Initialize pointers to NULL */
    Nav->sqrQ       = NULL;
    Nav->M          = NULL;
@@ -237,6 +241,7 @@ void InitDSM(struct SCType *S)
    Nav->jacobian   = NULL;
    Nav->STM        = NULL;
    Nav->STMStep    = NULL;
+   Nav->expmWork   = NULL;
    Nav->NxN        = NULL;
    Nav->NxN2       = NULL;
    Nav->whlH       = NULL;
@@ -1503,8 +1508,15 @@ long ConfigureNavigationSensors(struct AcType *const AC,
       numSensors[sensor]++;
       Nav->residuals[sensor][sensorNum] = calloc(meas->errDim, sizeof(double));
    }
-   for (sensor = INIT_SENSOR; sensor <= FIN_SENSOR; sensor++)
+   // Size the Kalman workspace for every configured sensor reporting at once,
+   // the largest batch TIME_BATCH can build
+   long maxMeasDim = 0;
+   for (sensor = INIT_SENSOR; sensor <= FIN_SENSOR; sensor++) {
       Nav->sensorActive[sensor] = (numSensors[sensor] > 0 ? TRUE : FALSE);
+      for (i = 0; i < Nav->nSensor[sensor]; i++)
+         maxMeasDim += Nav->measTypes[sensor][i].errDim;
+   }
+   ReserveKalmanWork(Nav, maxMeasDim);
 
    return (DataProcessed);
 }
@@ -1733,6 +1745,9 @@ long GetNavigationCmd(struct AcType *const AC, struct DSMType *const DSM,
          DestroyMatrix(Nav->P);
          DestroyMatrix(Nav->STM);
          DestroyMatrix(Nav->STMStep);
+         for (i = 0; i < EXPM_NWORK; i++)
+            DestroyMatrix(Nav->expmWork[i]);
+         free(Nav->expmWork);
          Nav->sqrQ     = NULL;
          Nav->M        = NULL;
          Nav->delta    = NULL;
@@ -1741,11 +1756,14 @@ long GetNavigationCmd(struct AcType *const AC, struct DSMType *const DSM,
          Nav->jacobian = NULL;
          Nav->STM      = NULL;
          Nav->STMStep  = NULL;
+         Nav->expmWork = NULL;
          Nav->NxN      = NULL;
          Nav->NxN2     = NULL;
          Nav->whlH     = NULL;
       }
       DestroyMeasList(&Nav->measList);
+      DestroyMeasPool(Nav);
+      DestroyKalmanWork(Nav);
 
       if (!strcmp(navType, "RIEKF")) {
          Nav->type = RIEKF_NAV;
@@ -1779,6 +1797,22 @@ long GetNavigationCmd(struct AcType *const AC, struct DSMType *const DSM,
          exit(EXIT_FAILURE);
       }
 
+      // Update is optional and defaults to the batched QR update
+      char updateType[FIELDWIDTH + 1] = "QR";
+      fy_node_scanf(cmdNode, "/Update %" STR(FIELDWIDTH) "s", updateType);
+      if (!strcmp(updateType, "QR")) {
+         Nav->update = QR_UPDATE;
+      }
+      else if (!strcmp(updateType, "Sequential")) {
+         Nav->update = SEQUENTIAL_UPDATE;
+      }
+      else {
+         printf("%s is an invalid update type for Navigation Command %s. "
+                "Exiting...\n",
+                updateType, cmdName);
+         exit(EXIT_FAILURE);
+      }
+
       if (refFrame == 'N') {
          Nav->refFrame = FRAME_N;
          // } else if (refFrame == 'L') {
@@ -1939,6 +1973,9 @@ long GetNavigationCmd(struct AcType *const AC, struct DSMType *const DSM,
       Nav->STMStep  = CreateMatrix(Nav->navDim, Nav->navDim);
       Nav->NxN      = CreateMatrix(Nav->navDim, Nav->navDim);
       Nav->NxN2     = CreateMatrix(Nav->navDim, Nav->navDim);
+      Nav->expmWork = calloc(EXPM_NWORK, sizeof(double **));
+      for (i = 0; i < EXPM_NWORK; i++)
+         Nav->expmWork[i] = CreateMatrix(Nav->navDim, Nav->navDim);
       for (i = 0; i < Nav->navDim; i++) {
          Nav->STM[i][i]     = 1.0;
          Nav->STMStep[i][i] = 1.0;
@@ -2170,32 +2207,32 @@ void DsmSensorModule(struct AcType *const AC, struct DSMType *const DSM)
    InitMeasList(&measList);
 
    for (enum SensorType sensor = INIT_SENSOR; sensor <= FIN_SENSOR; sensor++) {
-      struct DSMMeasListType *newMeasList = NULL;
       switch (sensor) {
          case GYRO_SENSOR:
-            newMeasList = DSM_GyroProcessing(AC, DSM);
+            DSM_GyroProcessing(AC, DSM, &measList);
             break;
          case MAG_SENSOR: // maybe add a condition to not run if
                           // magnetorquers are active??
-            newMeasList = DSM_MagnetometerProcessing(AC, DSM);
+            DSM_MagnetometerProcessing(AC, DSM, &measList);
             break;
-         case FSS_SENSOR:
-            newMeasList = DSM_FssProcessing(AC, DSM);
-            if (newMeasList != NULL && newMeasList->head != NULL)
+         case FSS_SENSOR: {
+            const long nMeas = measList.length;
+            DSM_FssProcessing(AC, DSM, &measList);
+            if (measList.length > nMeas)
                haveFSSMeas = TRUE;
-            break;
+         } break;
          case CSS_SENSOR: // Fine sun sensors preempt coarse sun sensors
             if (haveFSSMeas == FALSE)
-               newMeasList = DSM_CssProcessing(AC, DSM);
+               DSM_CssProcessing(AC, DSM, &measList);
             break;
          case STARTRACK_SENSOR:
-            newMeasList = DSM_StarTrackerProcessing(AC, DSM);
+            DSM_StarTrackerProcessing(AC, DSM, &measList);
             break;
          case GPS_SENSOR:
-            newMeasList = DSM_GpsProcessing(AC, DSM);
+            DSM_GpsProcessing(AC, DSM, &measList);
             break;
          case ACCEL_SENSOR:
-            newMeasList = DSM_AccelProcessing(AC, DSM);
+            DSM_AccelProcessing(AC, DSM, &measList);
             break;
          default:
             printf("Invalid Sensor in INIT_SENSOR and FIN_SENSOR interval. "
@@ -2203,15 +2240,10 @@ void DsmSensorModule(struct AcType *const AC, struct DSMType *const DSM)
             exit(EXIT_FAILURE);
             break;
       }
-      if (newMeasList != NULL) {
-         appendList(&measList, newMeasList);
-         free(newMeasList);
-         newMeasList = NULL;
-      }
    }
 
    if (Nav->NavigationActive == TRUE && ((measList.head) != NULL)) {
-      bubbleSort(&measList);
+      SortMeasList(&measList);
       appendList(&Nav->measList, &measList);
    }
 }
@@ -3812,7 +3844,7 @@ void DsmFSW(struct SCType *S)
 {
    // load the DSM file statically so that all DsmFSW calls have access to
    // same object. Document is destroyed at program exit
-   static struct fy_node *dsmRoot = NULL, *dsmCmds = NULL;
+   static SIMLOCAL struct fy_node *dsmRoot = NULL, *dsmCmds = NULL;
    if (dsmRoot == NULL) {
       struct fy_document *fyd =
           fy_document_build_and_check(NULL, InOutPath, "Inp_DSM.yaml");
@@ -3874,3 +3906,14 @@ void DsmFSW(struct SCType *S)
    // Implement Control Through Actuators
    ActuatorModule(AC, DSM);
 }
+
+// Release the measurement lists, the measurement pool, and the Kalman
+// workspace that the navigation filter holds between steps
+void ShutdownDSM(struct SCType *S)
+{
+   struct DSMNavType *Nav = &S->DSM.DsmNav;
+
+   DestroyMeasList(&Nav->measList);
+   DestroyMeasPool(Nav);
+   DestroyKalmanWork(Nav);
+}
@@ -1669,9 +1669,9 @@ void EchoEOM(double **COEF, double *State, double *RHS, long Ns)
 /**********************************************************************/
 void EchoUdot(double *State, long Ns)
 {
-   static FILE *outfile;
+   static SIMLOCAL FILE *outfile;
    long i;
-   static long First = 1;
+   static SIMLOCAL long First = 1;
 
    if (First) {
       First   = 0;
@@ -1730,6 +1730,22 @@ void EchoRemAcc(struct SCType *S)
    fclose(outfile);
 }
 /**********************************************************************/
+/*  Rigid-body COEF is symmetric by construction.  Flex coupling      */
+/*  terms need not be, so check before using a symmetric solver.      */
+static long CoefIsSymmetric(double **COEF, long N)
+{
+   long i, j;
+
+   for (i = 1; i < N; i++) {
+      for (j = 0; j < i; j++) {
+         if (fabs(COEF[i][j] - COEF[j][i]) >
+             1.0E-12 * (fabs(COEF[i][i]) + fabs(COEF[j][j])))
+            return (FALSE);
+      }
+   }
+   return (TRUE);
+}
+/**********************************************************************/
 void KaneNBodyEOM(double *u, double *x, double *h, double *a, double *uf,
                   double *xf, double *udot, double *xdot, double *hdot,
                   double *adot, double *ufdot, double *xfdot, struct SCType *S)
@@ -1936,7 +1952,21 @@ void KaneNBodyEOM(double *u, double *x, double *h, double *a, double *uf,
    //    First = 0;
    //    EchoEOM(D->COEF,D->ActiveState,D->RHS,D->Ns);
    // }
-   LINSOLVE(D->COEF, D->ActiveState, D->RHS, D->Ns);
+   /* COEF is the symmetric, positive-definite generalized mass */
+   /* matrix, solved by L*D*L^T in place.  Flex terms may leave it */
+   /* unsymmetric, and a failed factorization leaves the upper     */
+   /* triangle intact; both fall back to Gaussian elimination.     */
+   if (S->FlexActive && !CoefIsSymmetric(D->COEF, D->Ns))
+      LINSOLVE(D->COEF, D->ActiveState, D->RHS, D->Ns);
+   else if (LDLFactor(D->COEF, D->LDLd, D->Ns))
+      LDLSolve(D->COEF, D->LDLd, D->ActiveState, D->RHS, D->Ns);
+   else {
+      for (i = 1; i < D->Ns; i++) {
+         for (j = 0; j < i; j++)
+            D->COEF[i][j] = D->COEF[j][i];
+      }
+      LINSOLVE(D->COEF, D->ActiveState, D->RHS, D->Ns);
+   }
    // EchoUdot(D->ActiveState,D->Ns);
 
    /* .. Map out result */
@@ -2562,7 +2592,7 @@ void OneBodyEOM(double *u, double *x, double *h, double *uf, double *xf,
          }
       }
       else {
-         LINSOLVE(B->Mf, ufdot, D->FlexFrc, Nf);
+         LDLSolve(D->MfL, D->MfD, ufdot, D->FlexFrc, Nf);
       }
       /* Flex Kinematics */
       for (If = 0; If < Nf; If++) {
@@ -3891,7 +3921,7 @@ void EnckeEOM(double u[6], double udot[6], double R[3], double muR3,
 /**********************************************************************/
 /* Integration of orbital equations of motion                         */
 /* by 4th order Runge-Kutta                                           */
-void EnckeRK4(struct SCType *S)
+void EnckeRK4(struct SCType *S, double dt)
 {
    double accel[3], R[3], magr, muR3;
    double u[6], uu[6], m1[6], m2[6], m3[6], m4[6];
@@ -3920,16 +3950,16 @@ void EnckeRK4(struct SCType *S)
    /* .. 4th Order Runga-Kutta Integration */
    EnckeEOM(u, m1, R, muR3, accel);
    for (j = 0; j < 6; j++)
-      uu[j] = u[j] + 0.5 * DTSIM * m1[j];
+      uu[j] = u[j] + 0.5 * dt * m1[j];
    EnckeEOM(uu, m2, R, muR3, accel);
    for (j = 0; j < 6; j++)
-      uu[j] = u[j] + 0.5 * DTSIM * m2[j];
+      uu[j] = u[j] + 0.5 * dt * m2[j];
    EnckeEOM(uu, m3, R, muR3, accel);
    for (j = 0; j < 6; j++)
-      uu[j] = u[j] + DTSIM * m3[j];
+      uu[j] = u[j] + dt * m3[j];
    EnckeEOM(uu, m4, R, muR3, accel);
    for (j = 0; j < 6; j++)
-      u[j] += DTSIM / 6.0 * (m1[j] + 2.0 * (m2[j] + m3[j]) + m4[j]);
+      u[j] += dt / 6.0 * (m1[j] + 2.0 * (m2[j] + m3[j]) + m4[j]);
 
    S->PosR[0] = u[0];
    S->PosR[1] = u[1];
@@ -3982,7 +4012,7 @@ void CowellEOMMrk2(double u[6], double udot[6], double mu, double mass,
 /**********************************************************************/
 /* Integration of orbital equations of motion using Cowell's method   */
 /* by 4th order Runge-Kutta                                           */
-void CowellRK4Mrk2(struct SCType *S)
+void CowellRK4Mrk2(struct SCType *S, double dt)
 {
    double u[6], uu[6], m1[6], m2[6], m3[6], m4[6];
    double dt0, dt1, dt2, dt3;
@@ -3999,9 +4029,9 @@ void CowellRK4Mrk2(struct SCType *S)
    u[5] = S->VelN[2];
 
    dt0 = 0.0;
-   dt1 = 0.5 * DTSIM;
-   dt2 = 0.5 * DTSIM;
-   dt3 = DTSIM;
+   dt1 = 0.5 * dt;
+   dt2 = 0.5 * dt;
+   dt3 = dt;
 
    /* .. 4th Order Runga-Kutta Integration */
    CowellEOMMrk2(u, m1, O->mu, S->mass, S->FrcN, S, dt0);
@@ -4015,7 +4045,7 @@ void CowellRK4Mrk2(struct SCType *S)
       uu[j] = u[j] + dt3 * m3[j];
    CowellEOMMrk2(uu, m4, O->mu, S->mass, S->FrcN, S, dt3);
    for (j = 0; j < 6; j++)
-      u[j] += DTSIM / 6.0 * (m1[j] + 2.0 * (m2[j] + m3[j]) + m4[j]);
+      u[j] += dt / 6.0 * (m1[j] + 2.0 * (m2[j] + m3[j]) + m4[j]);
 
    S->PosN[0] = u[0];
    S->PosN[1] = u[1];
@@ -4027,7 +4057,7 @@ void CowellRK4Mrk2(struct SCType *S)
 /**********************************************************************/
 /* Integration of orbital equations of motion using Cowell's method   */
 /* by 4th order Runge-Kutta                                           */
-void CowellRK4(struct SCType *S)
+void CowellRK4(struct SCType *S, double dt)
 {
    double u[6], uu[6], m1[6], m2[6], m3[6], m4[6];
    long j;
@@ -4045,16 +4075,16 @@ void CowellRK4(struct SCType *S)
    /* .. 4th Order Runga-Kutta Integration */
    CowellEOM(u, m1, O->mu, S->mass, S->FrcN);
    for (j = 0; j < 6; j++)
-      uu[j] = u[j] + 0.5 * DTSIM * m1[j];
+      uu[j] = u[j] + 0.5 * dt * m1[j];
    CowellEOM(uu, m2, O->mu, S->mass, S->FrcN);
    for (j = 0; j < 6; j++)
-      uu[j] = u[j] + 0.5 * DTSIM * m2[j];
+      uu[j] = u[j] + 0.5 * dt * m2[j];
    CowellEOM(uu, m3, O->mu, S->mass, S->FrcN);
    for (j = 0; j < 6; j++)
-      uu[j] = u[j] + DTSIM * m3[j];
+      uu[j] = u[j] + dt * m3[j];
    CowellEOM(uu, m4, O->mu, S->mass, S->FrcN);
    for (j = 0; j < 6; j++)
-      u[j] += DTSIM / 6.0 * (m1[j] + 2.0 * (m2[j] + m3[j]) + m4[j]);
+      u[j] += dt / 6.0 * (m1[j] + 2.0 * (m2[j] + m3[j]) + m4[j]);
 
    S->PosN[0] = u[0];
    S->PosN[1] = u[1];
@@ -4075,9 +4105,24 @@ void PolyhedronCowellEOM(double u[6], double udot[6], double mass,
    udot[5] = GravAcc[2] + Frc[2] / mass;
 }
 /**********************************************************************/
+/* Far from the body, its fitted exterior expansion is much cheaper   */
+/* than summing over every edge and face.  Nearer in, the near-field  */
+/* grid interpolates the sum where it has been found accurate enough. */
+static void PolyhedronCowellGravAcc(struct WorldType *W, struct GeomType *G,
+                                    long Far, double PosN[3],
+                                    double GravAccN[3])
+{
+   if (Far)
+      PolyhedronFarGravAcc(&W->PolyGravModel, W->mu, PosN, W->CWN, GravAccN);
+   else if (W->PolyGravGrid != NULL)
+      PolyGravGridAcc(W->PolyGravGrid, PosN, W->CWN, GravAccN);
+   else
+      PolyhedronGravAcc(G, W->Density, PosN, W->CWN, GravAccN);
+}
+/**********************************************************************/
 /* Integration of orbital equations of motion using Cowell's method   */
 /* by 4th order Runge-Kutta                                           */
-void PolyhedronCowellRK4(struct SCType *S)
+void PolyhedronCowellRK4(struct SCType *S, double dt)
 {
    double u[6], uu[6], m1[6], m2[6], m3[6], m4[6];
    long j;
@@ -4085,6 +4130,7 @@ void PolyhedronCowellRK4(struct SCType *S)
    struct WorldType *W;
    struct GeomType *G;
    double GravAccN[3];
+   long Far;
 
    O = &Orb[S->RefOrb];
    W = &World[O->World];
@@ -4097,26 +4143,32 @@ void PolyhedronCowellRK4(struct SCType *S)
    u[4] = S->VelN[1];
    u[5] = S->VelN[2];
 
+   /* .. One model for the whole step, so no stage straddles the switch. */
+   /*    The expansion only if, to first order, every stage stays past  */
+   /*    PolyGravFarRad.                                                */
+   Far = (W->PolyGravModel.N > 0 &&
+          MAGV(&u[0]) - MAGV(&u[3]) * dt > W->PolyGravFarRad);
+
    /* .. 4th Order Runga-Kutta Integration */
-   PolyhedronGravAcc(G, W->Density, u, W->CWN, GravAccN);
+   PolyhedronCowellGravAcc(W, G, Far, u, GravAccN);
    PolyhedronCowellEOM(u, m1, S->mass, GravAccN, S->FrcN);
    for (j = 0; j < 6; j++)
-      uu[j] = u[j] + 0.5 * DTSIM * m1[j];
+      uu[j] = u[j] + 0.5 * dt * m1[j];
 
-   PolyhedronGravAcc(G, W->Density, uu, W->CWN, GravAccN);
+   PolyhedronCowellGravAcc(W, G, Far, uu, GravAccN);
    PolyhedronCowellEOM(uu, m2, S->mass, GravAccN, S->FrcN);
    for (j = 0; j < 6; j++)
-      uu[j] = u[j] + 0.5 * DTSIM * m2[j];
+      uu[j] = u[j] + 0.5 * dt * m2[j];
 
-   PolyhedronGravAcc(G, W->Density, uu, W->CWN, GravAccN);
+   PolyhedronCowellGravAcc(W, G, Far, uu, GravAccN);
    PolyhedronCowellEOM(uu, m3, S->mass, GravAccN, S->FrcN);
    for (j = 0; j < 6; j++)
-      uu[j] = u[j] + DTSIM * m3[j];
+      uu[j] = u[j] + dt * m3[j];
 
-   PolyhedronGravAcc(G, W->Density, uu, W->CWN, GravAccN);
+   PolyhedronCowellGravAcc(W, G, Far, uu, GravAccN);
    PolyhedronCowellEOM(uu, m4, S->mass, GravAccN, S->FrcN);
    for (j = 0; j < 6; j++)
-      u[j] += DTSIM / 6.0 * (m1[j] + 2.0 * (m2[j] + m3[j]) + m4[j]);
+      u[j] += dt / 6.0 * (m1[j] + 2.0 * (m2[j] + m3[j]) + m4[j]);
 
    S->PosN[0] = u[0];
    S->PosN[1] = u[1];
@@ -4159,7 +4211,7 @@ void ThreeBodyEnckeEOM(double u[6], double udot[6], double R1[3], double muR13,
 /**********************************************************************/
 /* Integration of equations of perturbed motion from three-body orbit */
 /* by 4th order Runge-Kutta                                           */
-void ThreeBodyEnckeRK4(struct SCType *S)
+void ThreeBodyEnckeRK4(struct SCType *S, double dt)
 {
    double accel[3], R1[3], MagR1, muR13, R2[3], MagR2, muR23;
    double u[6], uu[6], m1[6], m2[6], m3[6], m4[6];
@@ -4194,16 +4246,16 @@ void ThreeBodyEnckeRK4(struct SCType *S)
    /* .. 4th Order Runga-Kutta Integration */
    ThreeBodyEnckeEOM(u, m1, R1, muR13, R2, muR23, accel);
    for (j = 0; j < 6; j++)
-      uu[j] = u[j] + 0.5 * DTSIM * m1[j];
+      uu[j] = u[j] + 0.5 * dt * m1[j];
    ThreeBodyEnckeEOM(uu, m2, R1, muR13, R2, muR23, accel);
    for (j = 0; j < 6; j++)
-      uu[j] = u[j] + 0.5 * DTSIM * m2[j];
+      uu[j] = u[j] + 0.5 * dt * m2[j];
    ThreeBodyEnckeEOM(uu, m3, R1, muR13, R2, muR23, accel);
    for (j = 0; j < 6; j++)
-      uu[j] = u[j] + DTSIM * m3[j];
+      uu[j] = u[j] + dt * m3[j];
    ThreeBodyEnckeEOM(uu, m4, R1, muR13, R2, muR23, accel);
    for (j = 0; j < 6; j++)
-      u[j] += DTSIM / 6.0 * (m1[j] + 2.0 * (m2[j] + m3[j]) + m4[j]);
+      u[j] += dt / 6.0 * (m1[j] + 2.0 * (m2[j] + m3[j]) + m4[j]);
 
    S->PosR[0] = u[0];
    S->PosR[1] = u[1];
@@ -4228,7 +4280,7 @@ void EulHillEOM(double u[6], double udot[6], double n, double a[3])
 /* Integration of orbital equations of motion                         */
 /* by 4th order Runge-Kutta                                           */
 /* State u[0:2] = r, u[3:5] = v                                       */
-void EulHillRK4(struct SCType *S)
+void EulHillRK4(struct SCType *S, double dt)
 {
    double accelN[3], accel[3];
    double CLprop[3][3], CLN[3][3];
@@ -4250,22 +4302,22 @@ void EulHillRK4(struct SCType *S)
    /* .. 4th Order Runga-Kutta Integration */
    EulHillEOM(u, m1, O->MeanMotion, accel);
    for (j = 0; j < 6; j++)
-      uu[j] = u[j] + 0.5 * DTSIM * m1[j];
-   SimpRot(O->CLN[1], -O->MeanMotion * 0.5 * DTSIM, CLprop);
+      uu[j] = u[j] + 0.5 * dt * m1[j];
+   SimpRot(O->CLN[1], -O->MeanMotion * 0.5 * dt, CLprop);
    MxM(O->CLN, CLprop, CLN);
    MxV(CLN, accelN, accel);
    EulHillEOM(uu, m2, O->MeanMotion, accel);
    for (j = 0; j < 6; j++)
-      uu[j] = u[j] + 0.5 * DTSIM * m2[j];
+      uu[j] = u[j] + 0.5 * dt * m2[j];
    EulHillEOM(uu, m3, O->MeanMotion, accel);
    for (j = 0; j < 6; j++)
-      uu[j] = u[j] + DTSIM * m3[j];
-   SimpRot(O->CLN[1], -O->MeanMotion * DTSIM, CLprop);
+      uu[j] = u[j] + dt * m3[j];
+   SimpRot(O->CLN[1], -O->MeanMotion * dt, CLprop);
    MxM(O->CLN, CLprop, CLN);
    MxV(CLN, accelN, accel);
    EulHillEOM(uu, m4, O->MeanMotion, accel);
    for (j = 0; j < 6; j++)
-      u[j] += DTSIM / 6.0 * (m1[j] + 2.0 * (m2[j] + m3[j]) + m4[j]);
+      u[j] += dt / 6.0 * (m1[j] + 2.0 * (m2[j] + m3[j]) + m4[j]);
 
    for (j = 0; j < 3; j++) {
       S->PosEH[j] = u[j];
@@ -4356,6 +4408,271 @@ void FixedOrbitPosition(struct SCType *S)
    }
 }
 /**********************************************************************/
+/*  Adaptive orbit integration by Runge-Kutta-Fehlberg 7(8)           */
+/*  See Fehlberg, NASA TR R-287, 1968                                 */
+/*  Steps are sized by the embedded error estimate, independent of    */
+/*  DTSIM.  The state at each DTSIM sample is found from a two-point  */
+/*  Hermite interpolant matching position, velocity, acceleration     */
+/*  and jerk at the step ends.  The perturbing acceleration FrcN/mass */
+/*  is held constant over each step; if it drifts far enough to       */
+/*  matter, or the state is changed from outside, integration         */
+/*  restarts from the current sample.                                 */
+static const double RKF78c[13] = {0.0,        2.0 / 27.0, 1.0 / 9.0,
+                                  1.0 / 6.0,  5.0 / 12.0, 1.0 / 2.0,
+                                  5.0 / 6.0,  1.0 / 6.0,  2.0 / 3.0,
+                                  1.0 / 3.0,  1.0,        0.0,
+                                  1.0};
+static const double RKF78a[13][12] = {
+    {0.0},
+    {2.0 / 27.0},
+    {1.0 / 36.0, 1.0 / 12.0},
+    {1.0 / 24.0, 0.0, 1.0 / 8.0},
+    {5.0 / 12.0, 0.0, -25.0 / 16.0, 25.0 / 16.0},
+    {1.0 / 20.0, 0.0, 0.0, 1.0 / 4.0, 1.0 / 5.0},
+    {-25.0 / 108.0, 0.0, 0.0, 125.0 / 108.0, -65.0 / 27.0, 125.0 / 54.0},
+    {31.0 / 300.0, 0.0, 0.0, 0.0, 61.0 / 225.0, -2.0 / 9.0, 13.0 / 900.0},
+    {2.0, 0.0, 0.0, -53.0 / 6.0, 704.0 / 45.0, -107.0 / 9.0, 67.0 / 90.0,
+     3.0},
+    {-91.0 / 108.0, 0.0, 0.0, 23.0 / 108.0, -976.0 / 135.0, 311.0 / 54.0,
+     -19.0 / 60.0, 17.0 / 6.0, -1.0 / 12.0},
+    {2383.0 / 4100.0, 0.0, 0.0, -341.0 / 164.0, 4496.0 / 1025.0, -301.0 / 82.0,
+     2133.0 / 4100.0, 45.0 / 82.0, 45.0 / 164.0, 18.0 / 41.0},
+    {3.0 / 205.0, 0.0, 0.0, 0.0, 0.0, -6.0 / 41.0, -3.0 / 205.0, -3.0 / 41.0,
+     3.0 / 41.0, 6.0 / 41.0, 0.0},
+    {-1777.0 / 4100.0, 0.0, 0.0, -341.0 / 164.0, 4496.0 / 1025.0,
+     -289.0 / 82.0, 2193.0 / 4100.0, 51.0 / 82.0, 33.0 / 164.0, 12.0 / 41.0,
+     0.0, 1.0}
+};
+/* 8th order weights */
+static const double RKF78b[13] = {0.0,          0.0,          0.0,
+                                  0.0,          0.0,          34.0 / 105.0,
+                                  9.0 / 35.0,   9.0 / 35.0,   9.0 / 280.0,
+                                  9.0 / 280.0,  0.0,          41.0 / 840.0,
+                                  41.0 / 840.0};
+/**********************************************************************/
+/* Steps are propagated by Encke's method if the SC is propagated     */
+/* that way in Dynamics, else by Cowell's method                      */
+static long OrbIntIsEncke(struct SCType *S)
+{
+   return (Orb[S->RefOrb].Regime == ORB_CENTRAL &&
+           S->OrbDOF != ORBDOF_COWELL);
+}
+/**********************************************************************/
+/* Jerk of a point mass in a central field, m/s^3                     */
+static void KeplerJerk(double mu, double r[3], double v[3], double j[3])
+{
+   double magr, muR3, rdv;
+
+   magr = MAGV(r);
+   muR3 = mu / (magr * magr * magr);
+   rdv  = 3.0 * VoV(r, v) / (magr * magr);
+
+   j[0] = -muR3 * (v[0] - rdv * r[0]);
+   j[1] = -muR3 * (v[1] - rdv * r[1]);
+   j[2] = -muR3 * (v[2] - rdv * r[2]);
+}
+/**********************************************************************/
+/* State derivative at DynTime t, with jerk if j is not NULL          */
+static void OrbIntEOM(struct SCType *S, double t, double u[6], double udot[6],
+                      double j[3])
+{
+   struct OrbitType *O;
+   double R[3], V[3], r[3], v[3], jR[3], magr, anom;
+   long i;
+
+   O = &Orb[S->RefOrb];
+   S->OrbInt.Nfev++;
+
+   if (OrbIntIsEncke(S)) {
+      Eph2RV(O->mu, O->SLR, O->ecc, O->inc, O->RAAN, O->ArgP, t - O->tp, R,
+             V, &anom);
+      magr = MAGV(R);
+      EnckeEOM(u, udot, R, O->mu / (magr * magr * magr), S->OrbInt.Acc);
+      if (j != NULL) {
+         for (i = 0; i < 3; i++) {
+            r[i] = R[i] + u[i];
+            v[i] = V[i] + u[i + 3];
+         }
+         KeplerJerk(O->mu, r, v, j);
+         KeplerJerk(O->mu, R, V, jR);
+         for (i = 0; i < 3; i++)
+            j[i] -= jR[i];
+      }
+   }
+   else {
+      CowellEOM(u, udot, O->mu, 1.0, S->OrbInt.Acc);
+      if (j != NULL)
+         KeplerJerk(O->mu, &u[0], &u[3], j);
+   }
+}
+/**********************************************************************/
+/* One RKF7(8) step of size h from (t,u,f).  Returns the 8th order    */
+/* state in unew, and the error estimate scaled by the tolerance.     */
+static double RKF78Step(struct SCType *S, double t, double u[6], double f[6],
+                        double h, double unew[6])
+{
+   double k[13][6], uu[6], err[6], magr, magv, ErrR, ErrV;
+   long i, j, m;
+
+   for (m = 0; m < 6; m++)
+      k[0][m] = f[m];
+   for (i = 1; i < 13; i++) {
+      for (m = 0; m < 6; m++) {
+         uu[m] = u[m];
+         for (j = 0; j < i; j++)
+            uu[m] += h * RKF78a[i][j] * k[j][m];
+      }
+      OrbIntEOM(S, t + RKF78c[i] * h, uu, k[i], NULL);
+   }
+   for (m = 0; m < 6; m++) {
+      unew[m] = u[m];
+      for (i = 0; i < 13; i++)
+         unew[m] += h * RKF78b[i] * k[i][m];
+      err[m] = h * 41.0 / 840.0 * (k[0][m] + k[10][m] - k[11][m] - k[12][m]);
+   }
+
+   /* Mixed relative/absolute scale on the integrated state (relative */
+   /* to the reference orbit under Encke), floored at 1 m and 1 m/s    */
+   magr = MAGV(&u[0]);
+   magv = MAGV(&u[3]);
+   ErrR = MAGV(&err[0]) / (S->OrbInt.Tol * (magr + 1.0));
+   ErrV = MAGV(&err[3]) / (S->OrbInt.Tol * (magv + 1.0));
+   return (MAX(ErrR, ErrV));
+}
+/**********************************************************************/
+/* Two-point Hermite interpolation of the current step at DynTime t   */
+static void OrbIntSample(struct OrbIntType *I, double t, double u[6])
+{
+   double h, s, c[8], D0, D1, D2, D3;
+   long i, k;
+
+   h = I->t1 - I->t0;
+   s = (t - I->t0) / h;
+
+   for (i = 0; i < 3; i++) {
+      c[0] = I->u0[i];
+      c[1] = h * I->f0[i];
+      c[2] = 0.5 * h * h * I->f0[i + 3];
+      c[3] = h * h * h * I->j0[i] / 6.0;
+      D0   = I->u1[i] - (c[0] + c[1] + c[2] + c[3]);
+      D1   = h * I->f1[i] - (c[1] + 2.0 * c[2] + 3.0 * c[3]);
+      D2   = h * h * I->f1[i + 3] - (2.0 * c[2] + 6.0 * c[3]);
+      D3   = h * h * h * I->j1[i] - 6.0 * c[3];
+      c[4] = 35.0 * D0 - 15.0 * D1 + 2.5 * D2 - D3 / 6.0;
+      c[5] = -84.0 * D0 + 39.0 * D1 - 7.0 * D2 + 0.5 * D3;
+      c[6] = 70.0 * D0 - 34.0 * D1 + 6.5 * D2 - 0.5 * D3;
+      c[7] = -20.0 * D0 + 10.0 * D1 - 2.0 * D2 + D3 / 6.0;
+
+      u[i]     = c[7];
+      u[i + 3] = 7.0 * c[7];
+      for (k = 6; k > 0; k--) {
+         u[i]     = u[i] * s + c[k];
+         u[i + 3] = u[i + 3] * s + k * c[k];
+      }
+      u[i]      = u[i] * s + c[0];
+      u[i + 3] /= h;
+   }
+}
+/**********************************************************************/
+void OrbitRKF78(struct SCType *S)
+{
+   struct OrbIntType *I;
+   double *pos, *vel, u[6], Acc[3], dA[3], tOut, dt, unew[6], err;
+   long j;
+
+   I = &S->OrbInt;
+   if (OrbIntIsEncke(S)) {
+      pos = S->PosR;
+      vel = S->VelR;
+   }
+   else {
+      pos = S->PosN;
+      vel = S->VelN;
+   }
+   for (j = 0; j < 3; j++) {
+      u[j]     = pos[j];
+      u[j + 3] = vel[j];
+      Acc[j]   = S->FrcN[j] / S->mass;
+   }
+   tOut = DynTime + DTSIM;
+
+   /* .. Restart if state was changed from outside, or if held */
+   /*    acceleration has drifted enough to matter over the step */
+   if (I->Active) {
+      for (j = 0; j < 6; j++) {
+         if (u[j] != I->uOut[j])
+            I->Active = FALSE;
+      }
+      if (DynTime < I->t0 || DynTime > I->t1)
+         I->Active = FALSE;
+   }
+   if (I->Active) {
+      for (j = 0; j < 3; j++)
+         dA[j] = Acc[j] - I->Acc[j];
+      dt = I->t1 - DynTime;
+      if (0.5 * MAGV(dA) * dt * dt > I->Tol * (MAGV(S->PosN) + 1.0))
+         I->Active = FALSE;
+   }
+   if (!I->Active) {
+      I->t1 = DynTime;
+      for (j = 0; j < 6; j++)
+         I->u1[j] = u[j];
+      for (j = 0; j < 3; j++)
+         I->Acc[j] = Acc[j];
+      OrbIntEOM(S, I->t1, I->u1, I->f1, I->j1);
+      if (I->h <= 0.0)
+         I->h = DTSIM;
+      I->Active = TRUE;
+   }
+
+   /* .. Step until the current step brackets tOut */
+   while (I->t1 < tOut) {
+      if (Acc[0] != I->Acc[0] || Acc[1] != I->Acc[1] || Acc[2] != I->Acc[2]) {
+         for (j = 0; j < 3; j++)
+            I->Acc[j] = Acc[j];
+         OrbIntEOM(S, I->t1, I->u1, I->f1, I->j1);
+      }
+      do {
+         err = RKF78Step(S, I->t1, I->u1, I->f1, I->h, unew);
+         if (err > 1.0) {
+            I->h *= MAX(0.1, 0.9 * pow(err, -0.125));
+            if (I->h < 1.0E-6) {
+               fprintf(stderr,
+                       "OrbitRKF78 step size underflow for SC[%ld].  Bailing "
+                       "out.\n",
+                       S->ID);
+               exit(EXIT_FAILURE);
+            }
+         }
+      } while (err > 1.0);
+
+      I->t0 = I->t1;
+      for (j = 0; j < 6; j++) {
+         I->u0[j] = I->u1[j];
+         I->f0[j] = I->f1[j];
+         I->u1[j] = unew[j];
+      }
+      for (j = 0; j < 3; j++)
+         I->j0[j] = I->j1[j];
+      I->t1 += I->h;
+      OrbIntEOM(S, I->t1, I->u1, I->f1, I->j1);
+      I->Nstep++;
+
+      if (err > 0.0)
+         I->h *= MIN(4.0, 0.9 * pow(err, -0.125));
+      else
+         I->h *= 4.0;
+   }
+
+   OrbIntSample(I, tOut, u);
+   for (j = 0; j < 3; j++) {
+      pos[j] = u[j];
+      vel[j] = u[j + 3];
+   }
+   for (j = 0; j < 6; j++)
+      I->uOut[j] = u[j];
+}
+/**********************************************************************/
 /*   Divide acting forces into two components:                        */
 /*   The external component perturbs the orbit and the internal       */
 /*   (differential) component affects only attitude motion (for       */
@@ -4388,35 +4705,22 @@ void PartitionForces(struct SCType *S)
    }
 }
 /**********************************************************************/
-void Dynamics(struct SCType *S)
+/* Advance the translational state by dt with the RK4 propagator      */
+/* for this SC's orbit regime                                         */
+static void PropagateOrbit(struct SCType *S, double dt)
 {
    struct OrbitType *O;
 
    O = &Orb[S->RefOrb];
 
-   // if (S->Nb > 1) {
-   switch (S->DynMethod) {
-      case DYN_GAUSS_ELIM:
-         KaneNBodyRK4(S);
-         break;
-      case DYN_ORDER_N:
-         OrderNMultiBodyRK4(S);
-         break;
-      default:
-         fprintf(stderr, "Unknown Dynamics Solution option.  Bailing out.\n");
-         exit(EXIT_FAILURE);
-   }
-   //}
-   // else OneBodyRK4(S);
-
    switch (O->Regime) {
       case ORB_ZERO:
       case ORB_FLIGHT:
          if (O->PolyhedronGravityEnabled) {
-            PolyhedronCowellRK4(S);
+            PolyhedronCowellRK4(S, dt);
          }
          else
-            CowellRK4(S);
+            CowellRK4(S, dt);
          break;
       case ORB_CENTRAL:
          switch (S->OrbDOF) {
@@ -4424,19 +4728,19 @@ void Dynamics(struct SCType *S)
                FixedOrbitPosition(S);
                break;
             case ORBDOF_EULER_HILL:
-               EulHillRK4(S);
+               EulHillRK4(S, dt);
                break;
             case ORBDOF_COWELL:
-               CowellRK4(S);
+               CowellRK4(S, dt);
                break;
             default:
-               EnckeRK4(S);
+               EnckeRK4(S, dt);
          }
          break;
       case ORB_N_BODY:
          switch (S->OrbDOF) {
             case ORBDOF_COWELL:
-               CowellRK4Mrk2(S);
+               CowellRK4Mrk2(S, dt);
                break;
             default:
                printf("ERROR: MUST USE COWELLS METHOD!!! \n");
@@ -4449,13 +4753,13 @@ void Dynamics(struct SCType *S)
                FixedOrbitPosition(S);
                break;
             case ORBDOF_EULER_HILL:
-               EulHillRK4(S);
+               EulHillRK4(S, dt);
                break;
             case ORBDOF_COWELL:
-               CowellRK4(S);
+               CowellRK4(S, dt);
                break;
             default:
-               ThreeBodyEnckeRK4(S);
+               ThreeBodyEnckeRK4(S, dt);
          }
          break;
       default:
@@ -4463,6 +4767,142 @@ void Dynamics(struct SCType *S)
          exit(EXIT_FAILURE);
    }
 }
+/**********************************************************************/
+/* Orbit propagators that integrate Pos/VelR rather than Pos/VelN     */
+static long OrbitStateIsRelative(struct SCType *S)
+{
+   long Regime = Orb[S->RefOrb].Regime;
+
+   return ((Regime == ORB_CENTRAL || Regime == ORB_THREE_BODY) &&
+           S->OrbDOF != ORBDOF_COWELL);
+}
+/**********************************************************************/
+/*  Multirate orbit propagation.  Every OrbMaxCounter DTSIM steps,    */
+/*  one RK4 step of OrbSampleTime is taken, with FrcN sampled at its  */
+/*  start.  Samples in between come from a cubic Hermite interpolant  */
+/*  on the step end points.  Whatever FrcN does differently over the  */
+/*  step is summed as an impulse and applied at the next step, so     */
+/*  thruster burns keep their delta-v.                                */
+void MultirateOrbit(struct SCType *S)
+{
+   struct OrbIntType *I;
+   double *pos, *vel, h, s, h00, h10, h01, h11;
+   long j;
+
+   I = &S->OrbInt;
+   if (OrbitStateIsRelative(S)) {
+      pos = S->PosR;
+      vel = S->VelR;
+   }
+   else {
+      pos = S->PosN;
+      vel = S->VelN;
+   }
+
+   /* .. Mid-step departure of FrcN from the held accel */
+   if (S->OrbSampleCounter > 0 && S->OrbSampleCounter < S->OrbMaxCounter) {
+      for (j = 0; j < 3; j++)
+         I->DelV[j] += (S->FrcN[j] / S->mass - I->Acc[j]) * DTSIM;
+   }
+
+   /* .. Restart if state was changed from outside */
+   for (j = 0; j < 3; j++) {
+      if (pos[j] != I->uOut[j] || vel[j] != I->uOut[j + 3])
+         I->Active = FALSE;
+   }
+
+   if (!I->Active || S->OrbSampleCounter >= S->OrbMaxCounter) {
+      for (j = 0; j < 3; j++) {
+         vel[j]      += I->DelV[j];
+         I->DelV[j]   = 0.0;
+         I->Acc[j]    = S->FrcN[j] / S->mass;
+         I->u0[j]     = pos[j];
+         I->u0[j + 3] = vel[j];
+      }
+      PropagateOrbit(S, S->OrbSampleTime);
+      for (j = 0; j < 3; j++) {
+         I->u1[j]     = pos[j];
+         I->u1[j + 3] = vel[j];
+      }
+      S->OrbSampleCounter = 0;
+      I->Active           = TRUE;
+   }
+
+   S->OrbSampleCounter++;
+   if (S->OrbSampleCounter < S->OrbMaxCounter) {
+      h   = S->OrbSampleTime;
+      s   = ((double)S->OrbSampleCounter) / ((double)S->OrbMaxCounter);
+      h00 = (1.0 + 2.0 * s) * (1.0 - s) * (1.0 - s);
+      h10 = s * (1.0 - s) * (1.0 - s);
+      h01 = s * s * (3.0 - 2.0 * s);
+      h11 = s * s * (s - 1.0);
+      for (j = 0; j < 3; j++) {
+         pos[j] = h00 * I->u0[j] + h * h10 * I->u0[j + 3] + h01 * I->u1[j] +
+                  h * h11 * I->u1[j + 3];
+         vel[j] = (6.0 * s * (s - 1.0) * (I->u0[j] - I->u1[j])) / h +
+                  (1.0 - s) * (1.0 - 3.0 * s) * I->u0[j + 3] +
+                  s * (3.0 * s - 2.0) * I->u1[j + 3];
+      }
+   }
+   else {
+      for (j = 0; j < 3; j++) {
+         pos[j] = I->u1[j];
+         vel[j] = I->u1[j + 3];
+      }
+   }
+   for (j = 0; j < 3; j++) {
+      I->uOut[j]     = pos[j];
+      I->uOut[j + 3] = vel[j];
+   }
+}
+/**********************************************************************/
+/* Size of the N-body Cowell step Dynamics will take for S this tick, */
+/* or zero if it takes none.  Mirrors the tests in Dynamics and       */
+/* MultirateOrbit.  A wrong guess costs time, never accuracy.         */
+double NBodyOrbitStep(struct SCType *S)
+{
+   struct OrbIntType *I;
+   long j;
+
+   I = &S->OrbInt;
+   if (Orb[S->RefOrb].Regime != ORB_N_BODY || S->OrbDOF != ORBDOF_COWELL ||
+       I->Method == ORBINT_RKF78)
+      return (0.0);
+   if (S->OrbMaxCounter <= 1)
+      return (DTSIM);
+   if (!I->Active || S->OrbSampleCounter >= S->OrbMaxCounter)
+      return (S->OrbSampleTime);
+   for (j = 0; j < 3; j++) {
+      if (S->PosN[j] != I->uOut[j] || S->VelN[j] != I->uOut[j + 3])
+         return (S->OrbSampleTime);
+   }
+   return (0.0);
+}
+/**********************************************************************/
+void Dynamics(struct SCType *S)
+{
+   // if (S->Nb > 1) {
+   switch (S->DynMethod) {
+      case DYN_GAUSS_ELIM:
+         KaneNBodyRK4(S);
+         break;
+      case DYN_ORDER_N:
+         OrderNMultiBodyRK4(S);
+         break;
+      default:
+         fprintf(stderr, "Unknown Dynamics Solution option.  Bailing out.\n");
+         exit(EXIT_FAILURE);
+   }
+   //}
+   // else OneBodyRK4(S);
+
+   if (S->OrbInt.Method == ORBINT_RKF78)
+      OrbitRKF78(S);
+   else if (S->OrbMaxCounter > 1)
+      MultirateOrbit(S);
+   else
+      PropagateOrbit(S, DTSIM);
+}
 
 /* #ifdef __cplusplus
 ** }
@@ -13,6 +13,7 @@
 
 #include "42.h"
 #include <mathkit.h>
+#include <pthread.h>
 #include <stdio.h>
 #include <timekit.h>
 
@@ -22,6 +23,331 @@
 ** #endif
 */
 
+/**********************************************************************/
+/* Solar flux and geomagnetic index at JD, per AtmoOption             */
+static void SpaceWeatherAt(double JD, double *F10p7, double *Ap)
+{
+   if (AtmoOption == TWOSIGMA_ATMO) {
+      *F10p7 = LinInterp(SchattenTable[0], SchattenTable[1], JD, 1009);
+      *Ap    = LinInterp(SchattenTable[0], SchattenTable[3], JD, 1009);
+   }
+   else if (AtmoOption == NOMINAL_ATMO) {
+      *F10p7 = LinInterp(SchattenTable[0], SchattenTable[2], JD, 1009);
+      *Ap    = LinInterp(SchattenTable[0], SchattenTable[4], JD, 1009);
+   }
+   else {
+      /* USER_ATMO: Flux10p7, GeomagIndex read from Inp_Sim.txt */
+      *F10p7 = Flux10p7;
+      *Ap    = GeomagIndex;
+   }
+}
+/**********************************************************************/
+/*  Tabulated atmosphere density.                                     */
+/*  NRLMSISE00 is sampled on a grid of geodetic latitude, local solar */
+/*  time and altitude at epochs UpdateDT apart.  Lookups interpolate  */
+/*  log density bilinearly in lat and LST, with a cubic through four  */
+/*  altitude nodes, and linearly in time between the two grids that   */
+/*  bracket DynTime.  Since the grid turns with the Sun rather than   */
+/*  the Earth, only the slower longitude and seasonal terms change    */
+/*  between epochs.  The grid for the epoch after next is built on a  */
+/*  background thread while the sim runs.  Its indices come from      */
+/*  SchattenTable at that epoch, so the result does not depend on how */
+/*  fast the builder runs.                                            */
+struct AtmoGridType {
+   struct AtmoTableType *Table; /* Layout, for the builder thread */
+   double Epoch;                /* DynTime, sec */
+   double F10p7;
+   double Ap;
+   long Nnode;
+   double *LogDens; /* Altitude varies fastest, then LST, then lat */
+   double *Pos;     /* Node positions in W, for the build */
+   double **PosW;
+};
+
+static SIMLOCAL struct AtmoGridType AtmoGrid[3];
+static SIMLOCAL struct AtmoGridType *PrevGrid = NULL, *NextGrid = NULL,
+                                    *SpareGrid = NULL;
+static SIMLOCAL pthread_t AtmoBuilder;
+static SIMLOCAL long AtmoBuilderBusy = FALSE;
+static SIMLOCAL long AtmoChecked     = FALSE;
+static SIMLOCAL FILE *AtmoTableFile  = NULL;
+/**********************************************************************/
+/* Runs on the builder thread.  Touches nothing but its own grid.     */
+static void *BuildAtmoGrid(void *Arg)
+{
+   struct AtmoGridType *G  = (struct AtmoGridType *)Arg;
+   struct AtmoTableType *T = G->Table;
+   long Year, Month, Day, Hour, Minute, doy;
+   double Second, DayHr, Lat, Lng;
+   long Ilat, Ilst, Ialt, In;
+
+   TimeToDate(G->Epoch, &Year, &Month, &Day, &Hour, &Minute, &Second, 1.0E-3);
+   doy   = MD2DOY(Year, Month, Day);
+   DayHr = Hour + Minute / 60.0 + Second / 3600.0;
+
+   In = 0;
+   for (Ilat = 0; Ilat < T->Nlat; Ilat++) {
+      Lat = -0.5 * PI + (Ilat + 0.5) * T->DLat;
+      for (Ilst = 0; Ilst < T->Nlst; Ilst++) {
+         /* Longitude where local solar time is Ilst*DLst at Epoch */
+         Lng = (Ilst * T->DLst - DayHr) * TWOPI / 24.0;
+         for (Ialt = 0; Ialt < T->Nalt; Ialt++) {
+            WGS84ToECEF(Lat, Lng, T->MinAlt + Ialt * T->DAlt, G->PosW[In]);
+            In++;
+         }
+      }
+   }
+   NRLMSISE00Batch(Year, doy, Hour, Minute, Second, G->Nnode, G->PosW,
+                   G->F10p7, G->Ap, G->LogDens);
+   for (In = 0; In < G->Nnode; In++)
+      G->LogDens[In] = log(G->LogDens[In]);
+
+   return (NULL);
+}
+/**********************************************************************/
+static void StartAtmoGrid(struct AtmoGridType *G, double Epoch)
+{
+   G->Epoch = Epoch;
+   SpaceWeatherAt(TimeToJD(Epoch), &G->F10p7, &G->Ap);
+   if (pthread_create(&AtmoBuilder, NULL, BuildAtmoGrid, G)) {
+      fprintf(stderr, "Could not start density table thread.  Bailing out!\n");
+      exit(EXIT_FAILURE);
+   }
+   AtmoBuilderBusy = TRUE;
+}
+/**********************************************************************/
+static void FinishAtmoGrid(void)
+{
+   if (AtmoBuilderBusy) {
+      pthread_join(AtmoBuilder, NULL);
+      AtmoBuilderBusy = FALSE;
+   }
+}
+/**********************************************************************/
+/* Build the grids at Epoch and Epoch+UpdateDT, and start the next    */
+static void RestartAtmoTable(double Epoch)
+{
+   FinishAtmoGrid();
+   StartAtmoGrid(NextGrid, Epoch + AtmoTable.UpdateDT);
+   PrevGrid->Epoch = Epoch;
+   SpaceWeatherAt(TimeToJD(Epoch), &PrevGrid->F10p7, &PrevGrid->Ap);
+   BuildAtmoGrid(PrevGrid);
+   FinishAtmoGrid();
+   StartAtmoGrid(SpareGrid, NextGrid->Epoch + AtmoTable.UpdateDT);
+   AtmoChecked = FALSE;
+}
+/**********************************************************************/
+static void InitAtmoTable(void)
+{
+   struct AtmoGridType *G;
+   long Nnode, Ig, In;
+
+   Nnode = AtmoTable.Nlat * AtmoTable.Nlst * AtmoTable.Nalt;
+   for (Ig = 0; Ig < 3; Ig++) {
+      G          = &AtmoGrid[Ig];
+      G->Table   = &AtmoTable;
+      G->Nnode   = Nnode;
+      G->LogDens = (double *)calloc(Nnode, sizeof(double));
+      G->Pos     = (double *)calloc(3 * Nnode, sizeof(double));
+      G->PosW    = (double **)calloc(Nnode, sizeof(double *));
+      if (G->LogDens == NULL || G->Pos == NULL || G->PosW == NULL) {
+         fprintf(stderr,
+                 "AtmoGrid calloc returned null pointer.  Bailing out!\n");
+         exit(EXIT_FAILURE);
+      }
+      for (In = 0; In < Nnode; In++)
+         G->PosW[In] = &G->Pos[3 * In];
+   }
+   PrevGrid  = &AtmoGrid[0];
+   NextGrid  = &AtmoGrid[1];
+   SpareGrid = &AtmoGrid[2];
+
+   AtmoTable.MaxRelErr = 0.0;
+   AtmoTable.RmsRelErr = 0.0;
+   AtmoTable.Ncheck    = 0;
+   AtmoTableFile       = FileOpen(InOutPath, "AtmoTable.42", "wt");
+
+   printf("Tabulating NRLMSISE00 density on %ld x %ld x %ld grid\n",
+          AtmoTable.Nlat, AtmoTable.Nlst, AtmoTable.Nalt);
+}
+/**********************************************************************/
+/* Density at PosW (m, Earth-fixed) from the grids.  Returns FALSE,   */
+/* leaving Density alone, if PosW is outside the grid's altitudes.    */
+static long AtmoTableDensity(double PosW[3], double *Density)
+{
+   struct AtmoGridType *G[2] = {PrevGrid, NextGrid};
+   double Lat, Lng, Alt, Lst, x, y, z, u, v, w;
+   double X[4], Y[4], Yg, *L;
+   long Ilat, Ilst, Jlst, Ialt, Ig, j;
+
+   ECEFToWGS84(PosW, &Lat, &Lng, &Alt);
+   if (Alt < AtmoTable.MinAlt || Alt > AtmoTable.MaxAlt)
+      return (FALSE);
+
+   Lst = TT.Hour + TT.Minute / 60.0 + TT.Second / 3600.0 + Lng * 24.0 / TWOPI;
+   Lst = fmod(Lst, 24.0);
+   if (Lst < 0.0)
+      Lst += 24.0;
+
+   /* Lat nodes sit at cell centers; hold the end rows out to the poles */
+   x = (Lat + 0.5 * PI) / AtmoTable.DLat - 0.5;
+   if (x < 0.0)
+      x = 0.0;
+   if (x > AtmoTable.Nlat - 1)
+      x = AtmoTable.Nlat - 1;
+   Ilat = (long)x;
+   if (Ilat > AtmoTable.Nlat - 2)
+      Ilat = AtmoTable.Nlat - 2;
+   u    = x - Ilat;
+   y    = Lst / AtmoTable.DLst;
+   Ilst = (long)y;
+   if (Ilst > AtmoTable.Nlst - 1)
+      Ilst = AtmoTable.Nlst - 1;
+   v    = y - Ilst;
+   Jlst = (Ilst + 1) % AtmoTable.Nlst;
+   z    = (Alt - AtmoTable.MinAlt) / AtmoTable.DAlt;
+   Ialt = (long)z;
+   /* Four altitude nodes, centered on the interval where possible */
+   if (Ialt > AtmoTable.Nalt - 3)
+      Ialt = AtmoTable.Nalt - 3;
+   if (Ialt < 1)
+      Ialt = 1;
+   w = (DynTime - G[0]->Epoch) / (G[1]->Epoch - G[0]->Epoch);
+
+   for (j = 0; j < 4; j++) {
+      X[j] = AtmoTable.MinAlt + (Ialt - 1 + j) * AtmoTable.DAlt;
+      Y[j] = 0.0;
+      for (Ig = 0; Ig < 2; Ig++) {
+         L  = &G[Ig]->LogDens[Ialt - 1 + j];
+         Yg = (1.0 - u) * (1.0 - v) *
+                  L[(Ilat * AtmoTable.Nlst + Ilst) * AtmoTable.Nalt] +
+              u * (1.0 - v) *
+                  L[((Ilat + 1) * AtmoTable.Nlst + Ilst) * AtmoTable.Nalt] +
+              (1.0 - u) * v *
+                  L[(Ilat * AtmoTable.Nlst + Jlst) * AtmoTable.Nalt] +
+              u * v * L[((Ilat + 1) * AtmoTable.Nlst + Jlst) * AtmoTable.Nalt];
+         Y[j] += (Ig == 0 ? 1.0 - w : w) * Yg;
+      }
+   }
+   /* Bottom and top intervals of the grid are linear in log density */
+   if (Alt < X[1])
+      *Density = exp(Y[0] + (Alt - X[0]) / AtmoTable.DAlt * (Y[1] - Y[0]));
+   else if (Alt > X[2])
+      *Density = exp(Y[2] + (Alt - X[2]) / AtmoTable.DAlt * (Y[3] - Y[2]));
+   else
+      *Density = exp(CubicSpline(Alt, X, Y));
+
+   return (TRUE);
+}
+/**********************************************************************/
+/* Compare lookup with the full model at each Earth-orbiting SC       */
+static void CheckAtmoTable(void)
+{
+   struct SCType *S;
+   double PosW[3], Exact, Approx, Err, MaxErr = 0.0, SumSq = 0.0;
+   long Isc, N = 0;
+
+   for (Isc = 0; Isc < Nsc; Isc++) {
+      S = &SC[Isc];
+      if (!S->Exists || Orb[S->RefOrb].World != EARTH)
+         continue;
+      MxV(World[EARTH].CWN, S->PosN, PosW);
+      if (!AtmoTableDensity(PosW, &Approx))
+         continue;
+      Exact = NRLMSISE00(TT.Year, TT.doy, TT.Hour, TT.Minute, TT.Second, PosW,
+                         Flux10p7, GeomagIndex);
+      Err   = fabs(Approx / Exact - 1.0);
+      if (Err > MaxErr)
+         MaxErr = Err;
+      SumSq += Err * Err;
+      N++;
+   }
+   if (N == 0)
+      return;
+
+   if (MaxErr > AtmoTable.MaxRelErr)
+      AtmoTable.MaxRelErr = MaxErr;
+   AtmoTable.RmsRelErr =
+       sqrt((AtmoTable.RmsRelErr * AtmoTable.RmsRelErr * AtmoTable.Ncheck +
+             SumSq) /
+            (AtmoTable.Ncheck + N));
+   AtmoTable.Ncheck += N;
+   fprintf(AtmoTableFile, "%lf %lf %lf %le %le\n", SimTime, Flux10p7,
+           GeomagIndex, MaxErr, sqrt(SumSq / N));
+}
+/**********************************************************************/
+/* Keep PrevGrid and NextGrid bracketing DynTime.  Called once per    */
+/* step, ahead of the per-SC Environment calls.                       */
+static void UpdateAtmoTable(void)
+{
+   struct AtmoGridType *G;
+   double w;
+
+   if (PrevGrid == NULL) {
+      InitAtmoTable();
+      RestartAtmoTable(DynTime);
+      return;
+   }
+
+   while (DynTime >= NextGrid->Epoch) {
+      FinishAtmoGrid();
+      G         = PrevGrid;
+      PrevGrid  = NextGrid;
+      NextGrid  = SpareGrid;
+      SpareGrid = G;
+      StartAtmoGrid(SpareGrid, NextGrid->Epoch + AtmoTable.UpdateDT);
+      AtmoChecked = FALSE;
+   }
+
+   /* Indices set by command or IPC may jump away from the grids' */
+   w = (DynTime - PrevGrid->Epoch) / (NextGrid->Epoch - PrevGrid->Epoch);
+   if (fabs(Flux10p7 - ((1.0 - w) * PrevGrid->F10p7 + w * NextGrid->F10p7)) >
+           AtmoTable.FluxTol ||
+       fabs(GeomagIndex - ((1.0 - w) * PrevGrid->Ap + w * NextGrid->Ap)) >
+           AtmoTable.ApTol) {
+      RestartAtmoTable(DynTime);
+      return;
+   }
+
+   /* Interpolation error is largest midway between grids */
+   if (!AtmoChecked && w >= 0.5) {
+      CheckAtmoTable();
+      AtmoChecked = TRUE;
+   }
+}
+/**********************************************************************/
+/* Solar flux and geomagnetic index are common to all SC, so they are */
+/* refreshed once per step ahead of the per-SC Environment calls      */
+void SpaceWeather(void)
+{
+   SpaceWeatherAt(TT.JulDay, &Flux10p7, &GeomagIndex);
+   if (AtmoTable.Enabled)
+      UpdateAtmoTable();
+}
+/**********************************************************************/
+void ShutdownAtmoTable(void)
+{
+   long Ig;
+
+   if (PrevGrid == NULL)
+      return;
+
+   FinishAtmoGrid();
+   if (AtmoTable.Ncheck > 0)
+      printf("Density table error vs NRLMSISE00: max %.2le, rms %.2le over "
+             "%ld checks\n",
+             AtmoTable.MaxRelErr, AtmoTable.RmsRelErr, AtmoTable.Ncheck);
+   fclose(AtmoTableFile);
+   AtmoTableFile = NULL;
+   for (Ig = 0; Ig < 3; Ig++) {
+      free(AtmoGrid[Ig].LogDens);
+      free(AtmoGrid[Ig].Pos);
+      free(AtmoGrid[Ig].PosW);
+   }
+   PrevGrid  = NULL;
+   NextGrid  = NULL;
+   SpareGrid = NULL;
+}
 /**********************************************************************/
 /* #define _RADBELT_ */
 void Environment(struct SCType *S)
@@ -34,9 +360,9 @@ void Environment(struct SCType *S)
    int NumEnergies         = 5;
    float ElectronEnergy[5] = {0.15, 0.5, 1.0, 3.0, 4.0};    /* MeV */
    float ProtonEnergy[5]   = {4.0, 10.0, 20.0, 30.0, 50.0}; /* MeV */
-   static double **Flux;
+   static SIMLOCAL double **Flux;
    double MagLat;
-   static long First = 1;
+   static SIMLOCAL long First = 1;
 
    if (First) {
       First = 0;
@@ -47,66 +373,62 @@ void Environment(struct SCType *S)
    O = &Orb[S->RefOrb];
    P = &World[O->World];
 
-   /* .. Magnetic Field */
-   if (MagModel.Type == DIPOLE) {
-      DipoleMagField(P->DipoleMoment, P->DipoleAxis, P->DipoleOffset, S->PosN,
-                     P->PriMerAng, S->bvn);
-   }
-   else if (MagModel.Type == IGRF && O->World == EARTH) {
-      IGRFMagField(ModelPath, UTC, MagModel.N, MagModel.M, S->PosN,
-                   P->PriMerAng, S->bvn);
-   }
-   else {
-      S->bvn[0] = 0.0;
-      S->bvn[1] = 0.0;
-      S->bvn[2] = 0.0;
-   }
-
-   MxV(S->B[0].CN, S->bvn, S->bvb);
+   /* .. Field and density depend only on position and time, so they */
+   /*    may be held over EnvMaxCounter steps                          */
+   S->EnvSampleCounter++;
+   if (S->EnvSampleCounter >= S->EnvMaxCounter) {
+      S->EnvSampleCounter = 0;
 
-   /* .. Atmospheric Density */
-   if (O->World == EARTH) {
-      if (AtmoOption == TWOSIGMA_ATMO) {
-         Flux10p7 =
-             LinInterp(SchattenTable[0], SchattenTable[1], TT.JulDay, 1009);
-         GeomagIndex =
-             LinInterp(SchattenTable[0], SchattenTable[3], TT.JulDay, 1009);
+      /* .. Magnetic Field */
+      if (MagModel.Type == DIPOLE) {
+         DipoleMagField(P->DipoleMoment, P->DipoleAxis, P->DipoleOffset,
+                        S->PosN, P->PriMerAng, S->bvn);
+      }
+      else if (MagModel.Type == IGRF && O->World == EARTH) {
+         IGRFMagField(ModelPath, UTC, MagModel.EpochDT, MagModel.N, MagModel.M,
+                      S->PosN, P->PriMerAng, S->bvn);
       }
-      else if (AtmoOption == NOMINAL_ATMO) {
-         Flux10p7 =
-             LinInterp(SchattenTable[0], SchattenTable[2], TT.JulDay, 1009);
-         GeomagIndex =
-             LinInterp(SchattenTable[0], SchattenTable[4], TT.JulDay, 1009);
+      else {
+         S->bvn[0] = 0.0;
+         S->bvn[1] = 0.0;
+         S->bvn[2] = 0.0;
       }
-      /* else USER_ATMO: Flux10p7, GeomagIndex read from Inp_Sim.txt */
 
-      MxV(World[EARTH].CWN, S->PosN, PosW);
-      Alt = MAGV(PosW) - World[EARTH].rad;
-      if (Alt < 1000.0E3) { /* What is max alt of MSISE00 validity? */
-         S->AtmoDensity = NRLMSISE00(TT.Year, TT.doy, TT.Hour, TT.Minute,
-                                     TT.Second, PosW, Flux10p7, GeomagIndex);
+      /* .. Atmospheric Density */
+      if (O->World == EARTH) {
+         MxV(World[EARTH].CWN, S->PosN, PosW);
+         Alt = MAGV(PosW) - World[EARTH].rad;
+         if (Alt < 1000.0E3) { /* What is max alt of MSISE00 validity? */
+            if (!AtmoTable.Enabled ||
+                !AtmoTableDensity(PosW, &S->AtmoDensity))
+               S->AtmoDensity = NRLMSISE00(TT.Year, TT.doy, TT.Hour,
+                                           TT.Minute, TT.Second, PosW,
+                                           Flux10p7, GeomagIndex);
+         }
+         else
+            S->AtmoDensity = 0.0;
       }
-      else
-         S->AtmoDensity = 0.0;
-   }
 
-   else if (O->World == MARS) {
-      S->AtmoDensity = MarsAtmosphereModel(S->PosN);
-   }
+      else if (O->World == MARS) {
+         S->AtmoDensity = MarsAtmosphereModel(S->PosN);
+      }
 
-   else
-      S->AtmoDensity = 0.0;
+      else
+         S->AtmoDensity = 0.0;
 
-   /* .. Radiation Belt Electron and Proton Fluxes, particles/cm^2/sec */
+      /* .. Radiation Belt Electron and Proton Fluxes, particles/cm^2/sec */
 #ifdef _RADBELT_
-   if (O->World == EARTH) {
-      MxV(World[EARTH].CWN, S->PosN, PosW);
-      UNITV(PosW);
-      MagLat = asin(VoV(PosW, World[EARTH].DipoleAxis));
-      RadBelt(MAGV(S->PosN) / 1000.0, fabs(MagLat) * R2D, NumEnergies,
-              ElectronEnergy, ProtonEnergy, Flux);
-   }
+      if (O->World == EARTH) {
+         MxV(World[EARTH].CWN, S->PosN, PosW);
+         UNITV(PosW);
+         MagLat = asin(VoV(PosW, World[EARTH].DipoleAxis));
+         RadBelt(MAGV(S->PosN) / 1000.0, fabs(MagLat) * R2D, NumEnergies,
+                 ElectronEnergy, ProtonEnergy, Flux);
+      }
 #endif
+   }
+
+   MxV(S->B[0].CN, S->bvn, S->bvb);
 }
 
 /* #ifdef __cplusplus
@@ -473,7 +473,7 @@ void OrbitMotion(double Time)
    struct RegionType *R;
 
 #if 0
-      static long RectCtr = 0;
+      static SIMLOCAL long RectCtr = 0;
       RectCtr++;
       if (RectCtr > 100) {
          RectCtr = 0;
@@ -15,6 +15,8 @@
 #include "42.h"
 #undef DECLARE_GLOBALS
 
+#include <pthread.h>
+
 /* #ifdef __cplusplus
 ** namespace _42 {
 ** using namespace Kit;
@@ -22,71 +24,80 @@
 */
 
 #ifdef _ENABLE_GUI_
-extern int HandoffToGui(int argc, char **argv);
+extern int HandoffToGui(struct SimContextType *Ctx, int argc, char **argv);
 #endif
 
+/* Worker pool for the per-SC phases of SimStep.  Each SC is updated by */
+/* exactly one thread, and nothing written for one SC during a phase is */
+/* read for another until the phase ends, so results do not depend on   */
+/* the number of threads.                                               */
+struct ScPoolType {
+   long Nthread; /* Including the calling thread */
+   pthread_t *Thread;
+   pthread_mutex_t Mutex;
+   pthread_cond_t StartCond;
+   pthread_cond_t DoneCond;
+   void (*Phase)(struct SCType *S);
+   long Generation; /* Bumped once per phase */
+   long NextSc;     /* Next SC to be claimed */
+   long Nbusy;      /* Workers still in the current phase */
+   long Shutdown;
+};
+static SIMLOCAL struct ScPoolType ScPool = {1};
+
 /**********************************************************************/
-void ReportProgress(void)
+void ReportProgress(struct SimContextType *Ctx)
 {
 #define PROGRESSPERCENT 10
 
-   static long ProgressPercent = 0;
-   static long ProgressCtr     = 0;
-   static double ProgressTime  = 0.0;
-
    if (TimeMode == FAST_TIME) {
 
-      if (SimTime >= ProgressTime) {
-         ProgressCtr++;
-         ProgressTime =
-             (double)(ProgressCtr * PROGRESSPERCENT) / 100.0 * STOPTIME;
+      if (SimTime >= Ctx->ProgressTime) {
+         Ctx->ProgressCtr++;
+         Ctx->ProgressTime =
+             (double)(Ctx->ProgressCtr * PROGRESSPERCENT) / 100.0 * STOPTIME;
          printf("    42 Case %s is %3.1li%% Complete at Time = %12.3f\n",
-                InOutPath, ProgressPercent, SimTime);
-         ProgressPercent += PROGRESSPERCENT;
+                InOutPath, Ctx->ProgressPercent, SimTime);
+         Ctx->ProgressPercent += PROGRESSPERCENT;
       }
    }
 }
 /**********************************************************************/
-void ManageFlags(void)
+void ManageFlags(struct SimContextType *Ctx)
 {
    long nout, GLnout;
-   static long iout   = 1000000;
-   static long GLiout = 1000000;
 
    nout   = ((long)(DTOUT / DTSIM + 0.5));
    GLnout = ((long)(DTOUTGL / DTSIM + 0.5));
 
-   iout++;
-   if (iout >= nout) {
-      iout    = 0;
-      OutFlag = TRUE;
+   Ctx->iout++;
+   if (Ctx->iout >= nout) {
+      Ctx->iout = 0;
+      OutFlag   = TRUE;
    }
    else
       OutFlag = FALSE;
 
-   GLiout++;
-   if (GLiout >= GLnout) {
-      GLiout    = 0;
-      GLOutFlag = TRUE;
+   Ctx->GLiout++;
+   if (Ctx->GLiout >= GLnout) {
+      Ctx->GLiout = 0;
+      GLOutFlag   = TRUE;
    }
    else
       GLOutFlag = FALSE;
 }
 /**********************************************************************/
-long AdvanceTime(void)
+long AdvanceTime(struct SimContextType *Ctx)
 {
-   static long itime    = 0;
-   static long PrevTick = 0;
-   static long CurrTick = 1;
    long Done;
 
    /* Advance time to next Timestep */
    switch (TimeMode) {
       case FAST_TIME:
-         SimTime += DTSIM;
-         itime    = (long)((SimTime + 0.5 * DTSIM) / (DTSIM));
-         SimTime  = ((double)itime) * DTSIM;
-         DynTime  = DynTime0 + SimTime;
+         SimTime   += DTSIM;
+         Ctx->itime = (long)((SimTime + 0.5 * DTSIM) / (DTSIM));
+         SimTime    = ((double)Ctx->itime) * DTSIM;
+         DynTime    = DynTime0 + SimTime;
 
          AtomicTime = DynTime - 32.184;     /* TAI */
          CivilTime  = AtomicTime - LeapSec; /* UTC "clock" time */
@@ -113,10 +124,10 @@ long AdvanceTime(void)
          break;
       case REAL_TIME:
          usleep(1.0E6 * DTSIM);
-         SimTime += DTSIM;
-         itime    = (long)((SimTime + 0.5 * DTSIM) / (DTSIM));
-         SimTime  = ((double)itime) * DTSIM;
-         DynTime  = DynTime0 + SimTime;
+         SimTime   += DTSIM;
+         Ctx->itime = (long)((SimTime + 0.5 * DTSIM) / (DTSIM));
+         SimTime    = ((double)Ctx->itime) * DTSIM;
+         DynTime    = DynTime0 + SimTime;
 
          AtomicTime = DynTime - 32.184;     /* TAI */
          CivilTime  = AtomicTime - LeapSec; /* UTC "clock" time */
@@ -142,13 +153,13 @@ long AdvanceTime(void)
 
          break;
       case EXTERNAL_TIME:
-         while (CurrTick == PrevTick) {
-            CurrTick = (long)(1.0E-6 * usec() / DTSIM);
+         while (Ctx->CurrTick == Ctx->PrevTick) {
+            Ctx->CurrTick = (long)(1.0E-6 * usec() / DTSIM);
          }
-         PrevTick  = CurrTick;
-         SimTime  += DTSIM;
-         itime     = (long)((SimTime + 0.5 * DTSIM) / (DTSIM));
-         SimTime   = ((double)itime) * DTSIM;
+         Ctx->PrevTick = Ctx->CurrTick;
+         SimTime      += DTSIM;
+         Ctx->itime    = (long)((SimTime + 0.5 * DTSIM) / (DTSIM));
+         SimTime       = ((double)Ctx->itime) * DTSIM;
 
          RealSystemTime(&UTC.Year, &UTC.doy, &UTC.Month, &UTC.Day, &UTC.Hour,
                         &UTC.Minute, &UTC.Second, DTSIM);
@@ -261,15 +272,14 @@ void UpdateScBoundingBox(struct SCType *S)
 #undef REFPT_CM
 }
 /**********************************************************************/
-void ManageBoundingBoxes(void)
+void ManageBoundingBoxes(struct SimContextType *Ctx)
 {
-   static long BBoxCtr = 100;
    long Isc;
    struct SCType *S;
 
-   BBoxCtr++;
-   if (BBoxCtr > 100) {
-      BBoxCtr = 0;
+   Ctx->BBoxCtr++;
+   if (Ctx->BBoxCtr > 100) {
+      Ctx->BBoxCtr = 0;
       for (Isc = 0; Isc < Nsc; Isc++) {
          S = &SC[Isc];
          if (S->Exists) {
@@ -330,36 +340,184 @@ void ZeroFrcTrq(void)
    }
 }
 /**********************************************************************/
-long SimStep(void)
+/* Everything between the ephemeris update and Report for one SC     */
+static void ScFrcTrqPhase(struct SCType *S)
+{
+   Environment(S);     /* Magnetic Field, Atmospheric Density */
+   Perturbations(S);   /* Environmental Forces and Torques */
+   Sensors(S);
+   FlightSoftWare(S);
+   Actuators(S);
+   PartitionForces(S); /* Orbit-affecting and "internal" */
+}
+/**********************************************************************/
+static void ClaimScs(void)
+{
+   long Isc;
+
+   while (1) {
+      pthread_mutex_lock(&ScPool.Mutex);
+      Isc = ScPool.NextSc++;
+      pthread_mutex_unlock(&ScPool.Mutex);
+      if (Isc >= Nsc)
+         break;
+      if (SC[Isc].Exists)
+         ScPool.Phase(&SC[Isc]);
+   }
+}
+/**********************************************************************/
+static void *ScPoolWorker(void *Arg)
+{
+   long Generation = 0;
+
+   pthread_mutex_lock(&ScPool.Mutex);
+   while (1) {
+      while (!ScPool.Shutdown && ScPool.Generation == Generation)
+         pthread_cond_wait(&ScPool.StartCond, &ScPool.Mutex);
+      if (ScPool.Shutdown)
+         break;
+      Generation = ScPool.Generation;
+      pthread_mutex_unlock(&ScPool.Mutex);
+
+      ClaimScs();
+
+      pthread_mutex_lock(&ScPool.Mutex);
+      ScPool.Nbusy--;
+      if (ScPool.Nbusy == 0)
+         pthread_cond_signal(&ScPool.DoneCond);
+   }
+   pthread_mutex_unlock(&ScPool.Mutex);
+   return (NULL);
+}
+/**********************************************************************/
+/* Apply Phase to every existing SC, in SC order when run serially    */
+static void ForEachSc(void (*Phase)(struct SCType *S), long Serial)
+{
+   long Isc;
+
+   if (Serial || ScPool.Nthread < 2) {
+      for (Isc = 0; Isc < Nsc; Isc++) {
+         if (SC[Isc].Exists)
+            Phase(&SC[Isc]);
+      }
+      return;
+   }
+
+   pthread_mutex_lock(&ScPool.Mutex);
+   ScPool.Phase  = Phase;
+   ScPool.NextSc = 0;
+   ScPool.Nbusy  = ScPool.Nthread - 1;
+   ScPool.Generation++;
+   pthread_cond_broadcast(&ScPool.StartCond);
+   pthread_mutex_unlock(&ScPool.Mutex);
+
+   ClaimScs();
+
+   pthread_mutex_lock(&ScPool.Mutex);
+   while (ScPool.Nbusy > 0)
+      pthread_cond_wait(&ScPool.DoneCond, &ScPool.Mutex);
+   pthread_mutex_unlock(&ScPool.Mutex);
+}
+/**********************************************************************/
+/* Contact forces act on SC pairs, and CSS albedo is rendered on the  */
+/* GUI thread, so either keeps the force phase on one thread          */
+static long FrcTrqPhaseIsSerial(void)
+{
+   return (ContactActive || AlbedoActive);
+}
+/**********************************************************************/
+void InitScThreads(void)
+{
+   long Nthread, It;
+
+   /* The exact polyhedron sum runs on its own pool, shared by SC */
+   if (Nmb > 0)
+      StartPolyhedronGravPool(Nthreads);
+
+   Nthread = Nthreads;
+#if defined(_REENTRANT_SIM_) || defined(_RADBELT_) || defined(_AC_STANDALONE_)
+   if (Nthread > 1) {
+      printf("Per-SC threading is not supported in this build.  Running on "
+             "one thread.\n");
+      Nthread = 1;
+   }
+#endif
+   if (Nthread > Nsc)
+      Nthread = Nsc;
+   if (Nthread < 1)
+      Nthread = 1;
+
+   ScPool.Nthread    = Nthread;
+   ScPool.Generation = 0;
+   ScPool.Shutdown   = FALSE;
+   if (Nthread < 2)
+      return;
+
+   pthread_mutex_init(&ScPool.Mutex, NULL);
+   pthread_cond_init(&ScPool.StartCond, NULL);
+   pthread_cond_init(&ScPool.DoneCond, NULL);
+   ScPool.Thread = (pthread_t *)calloc(Nthread - 1, sizeof(pthread_t));
+   if (ScPool.Thread == NULL) {
+      fprintf(stderr,
+              "ScPool.Thread calloc returned null pointer.  Bailing out!\n");
+      exit(EXIT_FAILURE);
+   }
+   for (It = 0; It < Nthread - 1; It++) {
+      if (pthread_create(&ScPool.Thread[It], NULL, ScPoolWorker, NULL)) {
+         fprintf(stderr,
+                 "Could not start SC worker thread %ld.  Bailing out!\n", It);
+         exit(EXIT_FAILURE);
+      }
+   }
+   printf("Spacecraft updates running on %ld threads\n", Nthread);
+}
+/**********************************************************************/
+void ShutdownScThreads(void)
+{
+   long It;
+
+   if (Nmb > 0)
+      StopPolyhedronGravPool();
+
+   if (ScPool.Nthread < 2)
+      return;
+
+   pthread_mutex_lock(&ScPool.Mutex);
+   ScPool.Shutdown = TRUE;
+   pthread_cond_broadcast(&ScPool.StartCond);
+   pthread_mutex_unlock(&ScPool.Mutex);
+   for (It = 0; It < ScPool.Nthread - 1; It++)
+      pthread_join(ScPool.Thread[It], NULL);
+   free(ScPool.Thread);
+   ScPool.Thread = NULL;
+   pthread_cond_destroy(&ScPool.DoneCond);
+   pthread_cond_destroy(&ScPool.StartCond);
+   pthread_mutex_destroy(&ScPool.Mutex);
+   ScPool.Nthread = 1;
+}
+/**********************************************************************/
+long SimStep(struct SimContextType *Ctx)
 {
    long Isc;
-   static long First = 1;
    struct SCType *S;
    long SimComplete;
-   double TotalRunTime;
 
-   if (First) {
-      First   = 0;
-      SimTime = 0.0;
+   if (!Ctx->Initialized) {
+      Ctx->Initialized = 1;
+      SimTime          = 0.0;
       /* First call just initializes timer */
-      RealRunTime(&TotalRunTime, DTSIM);
-      ManageFlags();
+      RealRunTime(&Ctx->TotalRunTime, DTSIM);
+      ManageFlags(Ctx);
 
       Ephemerides(); /* Sun, Moon, Planets, Spacecraft, Useful Auxiliary Frames
                       */
+      SpaceWeather();
 
       ZeroFrcTrq();
-      for (Isc = 0; Isc < Nsc; Isc++) {
-         S = &SC[Isc];
-         if (S->Exists) {
-            Environment(S);   /* Magnetic Field, Atmospheric Density */
-            Perturbations(S); /* Environmental Forces and Torques */
-            Sensors(S);
-            FlightSoftWare(S);
-            Actuators(S);
-            PartitionForces(S); /* Orbit-affecting and "internal" */
-         }
-      }
+      if (ContactActive)
+         FindContactCandidates();
+      /* Serial, so models that load data on first use do so only once */
+      ForEachSc(ScFrcTrqPhase, TRUE);
       for (Isc = 0; Isc < Nsc; Isc++) {
          S = &SC[Isc];
          if (S->Exists && S->FswTag == DSM_FSW) {
@@ -370,37 +528,28 @@ long SimStep(void)
       Report(); /* File Output */
    }
 
-   ReportProgress();
-   ManageFlags();
+   ReportProgress(Ctx);
+   ManageFlags(Ctx);
 
    /* Read and Interpret Command Script File */
-   CmdInterpreter();
+   CmdInterpreter(Ctx);
 
    /* Update Dynamics to next Timestep */
-   for (Isc = 0; Isc < Nsc; Isc++) {
-      if (SC[Isc].Exists)
-         Dynamics(&SC[Isc]);
-   }
-   SimComplete = AdvanceTime();
+   GravPertStages();
+   ForEachSc(Dynamics, FALSE);
+   SimComplete = AdvanceTime(Ctx);
    OrbitMotion(DynTime);
 
    /* Update SC Bounding Boxes occasionally */
-   ManageBoundingBoxes();
+   ManageBoundingBoxes(Ctx);
 
    InterProcessComm(); /* Send and receive from external processes */
    Ephemerides(); /* Sun, Moon, Planets, Spacecraft, Useful Auxiliary Frames */
+   SpaceWeather();
    ZeroFrcTrq();
-   for (Isc = 0; Isc < Nsc; Isc++) {
-      S = &SC[Isc];
-      if (S->Exists) {
-         Environment(S);   /* Magnetic Field, Atmospheric Density */
-         Perturbations(S); /* Environmental Forces and Torques */
-         Sensors(S);
-         FlightSoftWare(S);
-         Actuators(S);
-         PartitionForces(S); /* Orbit-affecting and "internal" */
-      }
-   }
+   if (ContactActive)
+      FindContactCandidates();
+   ForEachSc(ScFrcTrqPhase, FrcTrqPhaseIsSerial());
    for (Isc = 0; Isc < Nsc; Isc++) {
       S = &SC[Isc];
       if (S->Exists && S->FswTag == DSM_FSW) {
@@ -413,17 +562,28 @@ long SimStep(void)
    /* Exit when Stoptime is reached */
    if (SimComplete) {
       if (TimeMode == FAST_TIME) {
-         RealRunTime(&TotalRunTime, DTSIM);
-         printf("     Total Run Time = %9.2lf sec\n", TotalRunTime);
-         printf("     Sim Speed = %8.2lf x Real\n", STOPTIME / TotalRunTime);
+         RealRunTime(&Ctx->TotalRunTime, DTSIM);
+         printf("     Total Run Time = %9.2lf sec\n", Ctx->TotalRunTime);
+         printf("     Sim Speed = %8.2lf x Real\n",
+                STOPTIME / Ctx->TotalRunTime);
       }
    }
    return (SimComplete);
 }
 /**********************************************************************/
-int exec(int argc, char **argv)
+void InitSimContext(struct SimContextType *Ctx)
 {
-   long Done = 0;
+   memset(Ctx, 0, sizeof(struct SimContextType));
+   Ctx->iout          = 1000000;
+   Ctx->GLiout        = 1000000;
+   Ctx->CurrTick      = 1;
+   Ctx->BBoxCtr       = 100;
+   Ctx->CmdFileActive = 1;
+}
+/**********************************************************************/
+int RunSimCase(struct SimContextType *Ctx, int argc, char **argv)
+{
+   long Isc, Done = 0;
 
    MapTime      = 0.0;
    JointTime    = 0.0;
@@ -436,24 +596,36 @@ int exec(int argc, char **argv)
    SubstTime    = 0.0;
    SolveTime    = 0.0;
 
-   InitSim(argc, argv);
-   CmdInterpreter();
+   InitSim(Ctx, argc, argv);
+   CmdInterpreter(Ctx);
    InitInterProcessComm();
+   InitScThreads();
 #ifdef _ENABLE_GUI_
    if (GLEnable) {
-      HandoffToGui(argc, argv);
+      HandoffToGui(Ctx, argc, argv);
    }
    else {
       while (!Done) {
-         Done = SimStep();
+         Done = SimStep(Ctx);
       }
    }
 #else
    /* Crunch numbers till done */
    while (!Done) {
-      Done = SimStep();
+      Done = SimStep(Ctx);
    }
 #endif
+   ShutdownScThreads();
+   for (Isc = 0; Isc < Nsc; Isc++) {
+      ShutdownDSM(&SC[Isc]);
+      FreeSilArena(&SC[Isc].Sil);
+   }
+   ShutdownInterProcessComm();
+   ShutdownGravPertStages();
+   ShutdownShadowLut();
+   ShutdownMinorBodies();
+   ShutdownAtmoTable();
+   ShutdownReport();
 
    // printf("\n\nMap Time = %lf sec\n",MapTime);
    // printf("Joint Partial Time = %lf sec\n",JointTime);
@@ -467,6 +639,27 @@ int exec(int argc, char **argv)
    // printf("Solve Time = %lf sec\n",SolveTime);
    return (0);
 }
+/**********************************************************************/
+int exec(int argc, char **argv)
+{
+   struct SimContextType *Ctx;
+   DocoptArgs Args;
+   int Status;
+
+   Args = docopt(argc, argv, /* help */ 1);
+   if (Args.campaign != NULL)
+      return (RunMonteCarlo(argc, argv, Args.campaign));
+
+   Ctx = (struct SimContextType *)calloc(1, sizeof(struct SimContextType));
+   if (Ctx == NULL) {
+      fprintf(stderr,
+              "SimContext calloc returned null pointer.  Bailing out!\n");
+      exit(EXIT_FAILURE);
+   }
+   Status = RunSimCase(Ctx, argc, argv);
+   free(Ctx);
+   return (Status);
+}
 
 /* #ifdef __cplusplus
 ** }
@@ -19,9 +19,6 @@ void RbtFSW(struct SCType *S);
 #endif
 
 void AcFsw(struct AcType *AC);
-void WriteToSocket(SOCKET Socket, char **Prefix, long Nprefix,
-                   long EchoEnabled);
-void ReadFromSocket(SOCKET Socket, long EchoEnabled);
 
 /* #ifdef __cplusplus
 ** namespace _42 {
@@ -1404,7 +1401,6 @@ void MomBiasFSW(struct SCType *S)
    double PitchRateError, PitchTcmd;
    double Tcmd[3], magb2, Mcmd[3];
    double Bdot[3];
-   static double bvbold[3];
    double PitchRateCmd = -0.001059;
    double Kry          = 5.0;
    double Kpy          = 0.1;
@@ -1429,8 +1425,8 @@ void MomBiasFSW(struct SCType *S)
 
       AC->Whl[0].Tcmd = -Kry * (AC->Whl[0].H - Hwcmd);
       for (i = 0; i < 3; i++) {
-         Bdot[i]         = (AC->bvb[i] - bvbold[i]) / AC->DT;
-         bvbold[i]       = AC->bvb[i];
+         Bdot[i]         = (AC->bvb[i] - C->bvbold[i]) / AC->DT;
+         C->bvbold[i]    = AC->bvb[i];
          AC->MTB[i].Mcmd = -Kbdot * Bdot[i];
 
          AC->G[0].Cmd.Ang[i]     = 0.0;
@@ -1675,10 +1671,6 @@ void CmgFSW(struct SCType *S)
    double CBL[3][3], qbl[4], qbr[4];
    double CRL[3][3];
    double Axis[4][3], Gim[4][3], H[4];
-   static double MoveTime  = 200.0;
-   static double RPYCmd[3] = {1.0, 1.0, 1.0};
-   static double qrl[4];
-   static long Idx = 0;
    long i, j;
 
    AC = &S->AC;
@@ -1686,8 +1678,11 @@ void CmgFSW(struct SCType *S)
 
    if (C->Init) {
       C->Init = 0;
-      for (i = 0; i < 3; i++)
+      for (i = 0; i < 3; i++) {
          FindPDGains(AC->MOI[i][i], 0.5, 0.7, &C->Kr[i], &C->Kp[i]);
+         C->RPYCmd[i] = 1.0;
+      }
+      C->MoveTime = 200.0;
       for (i = 0; i < 4; i++) {
          AC->G[i].Cmd.Ang[0]     = 0.0;
          AC->G[i].AngGain[0]     = 0.0;
@@ -1697,21 +1692,21 @@ void CmgFSW(struct SCType *S)
       }
    }
 
-   MoveTime -= AC->DT;
-   if (MoveTime < 0.0) {
-      MoveTime = 200.0;
-      Idx      = (Idx + 1) % 3;
-      if (RPYCmd[Idx] > 0.0)
-         RPYCmd[Idx] = -60.0 * D2R;
+   C->MoveTime -= AC->DT;
+   if (C->MoveTime < 0.0) {
+      C->MoveTime = 200.0;
+      C->Idx      = (C->Idx + 1) % 3;
+      if (C->RPYCmd[C->Idx] > 0.0)
+         C->RPYCmd[C->Idx] = -60.0 * D2R;
       else
-         RPYCmd[Idx] = 60.0 * D2R;
-      A2C(123, RPYCmd[0], RPYCmd[1], RPYCmd[2], CRL);
-      C2Q(CRL, qrl);
+         C->RPYCmd[C->Idx] = 60.0 * D2R;
+      A2C(123, C->RPYCmd[0], C->RPYCmd[1], C->RPYCmd[2], CRL);
+      C2Q(CRL, C->qrl);
    }
 
    MxMT(S->B[0].CN, S->CLN, CBL);
    C2Q(CBL, qbl);
-   QxQT(qbl, qrl, qbr);
+   QxQT(qbl, C->qrl, qbr);
    RECTIFYQ(qbr);
    for (i = 0; i < 3; i++) {
       C->therr[i] = 2.0 * qbr[i];
@@ -1727,7 +1722,7 @@ void CmgFSW(struct SCType *S)
       H[i] = 75.0;
    }
 
-   CMGLaw4x1DOF(C->Tcmd, Axis, Gim, H, C->AngRateCmd);
+   CMGLaw4x1DOF(C->Tcmd, Axis, Gim, H, &C->DitherPhase, C->AngRateCmd);
 
    for (i = 0; i < 4; i++) {
       AC->G[i].Cmd.AngRate[0] = C->AngRateCmd[i];
@@ -1739,18 +1734,15 @@ void ThrFSW(struct SCType *S)
    struct AcType *AC;
    struct AcThrType *T;
    struct AcThrCtrlType *C;
-   static double MoveTime = 0.0;
-   double RollCmd[4]      = {30.0, 0.0, -30.0, 0.0};
-   double PitchCmd[4]     = {0.0, 30.0, 0.0, -30.0};
-   double YawCmd[4]       = {0.0, 0.0, 0.0, 0.0};
-   double PosXcmd[4]      = {0.0, 0.0, 0.0, 0.0};
-   double PosYcmd[4]      = {24.0, 0.0, -24.0, 0.0};
-   double PosZcmd[4]      = {0.0, 24.0, 0.0, -24.0};
-   static double CRL[3][3], PosRL[3];
+   double RollCmd[4]  = {30.0, 0.0, -30.0, 0.0};
+   double PitchCmd[4] = {0.0, 30.0, 0.0, -30.0};
+   double YawCmd[4]   = {0.0, 0.0, 0.0, 0.0};
+   double PosXcmd[4]  = {0.0, 0.0, 0.0, 0.0};
+   double PosYcmd[4]  = {24.0, 0.0, -24.0, 0.0};
+   double PosZcmd[4]  = {0.0, 24.0, 0.0, -24.0};
    double CRN[3][3], qrn[4], PosRN[3];
    double FcmdB[3];
    double FoA, TorxA;
-   static long Idx = 0;
    long i;
 
    AC = &S->AC;
@@ -1764,20 +1756,21 @@ void ThrFSW(struct SCType *S)
    }
 
    /* .. Commanded Attitude and Position */
-   MoveTime -= AC->DT;
-   if (MoveTime < 0.0) {
-      MoveTime = 1000.0;
-      Idx      = (Idx + 1) % 4;
-      A2C(123, RollCmd[Idx] * D2R, PitchCmd[Idx] * D2R, YawCmd[Idx] * D2R, CRL);
-      PosRL[0] = PosXcmd[Idx];
-      PosRL[1] = PosYcmd[Idx];
-      PosRL[2] = PosZcmd[Idx];
-   }
-   MxM(CRL, S->CLN, CRN);
+   C->MoveTime -= AC->DT;
+   if (C->MoveTime < 0.0) {
+      C->MoveTime = 1000.0;
+      C->Idx      = (C->Idx + 1) % 4;
+      A2C(123, RollCmd[C->Idx] * D2R, PitchCmd[C->Idx] * D2R,
+          YawCmd[C->Idx] * D2R, C->CRL);
+      C->PosRL[0] = PosXcmd[C->Idx];
+      C->PosRL[1] = PosYcmd[C->Idx];
+      C->PosRL[2] = PosZcmd[C->Idx];
+   }
+   MxM(C->CRL, S->CLN, CRN);
    C2Q(CRN, qrn);
    QxQT(AC->qbn, qrn, AC->qbr);
    RECTIFYQ(AC->qbr);
-   MTxV(S->CLN, PosRL, PosRN);
+   MTxV(S->CLN, C->PosRL, PosRN);
 
    /* .. Force and Torque Commands */
    for (i = 0; i < 3; i++) {
@@ -1969,15 +1962,15 @@ void FlightSoftWare(struct SCType *S)
                S->AC.ParmDumpEnabled = 1;
                S->AC.EchoEnabled     = 1;
 
-               WriteToSocket(I->Socket, I->Prefix, I->Nprefix, I->EchoEnabled);
-               ReadFromSocket(I->Socket, I->EchoEnabled);
+               WriteToLink(I);
+               ReadFromLink(I);
 
                S->AC.ParmLoadEnabled = 0;
                S->AC.ParmDumpEnabled = 0;
             }
             else {
-               WriteToSocket(I->Socket, I->Prefix, I->Nprefix, I->EchoEnabled);
-               ReadFromSocket(I->Socket, I->EchoEnabled);
+               WriteToLink(I);
+               ReadFromLink(I);
             }
          }
       }
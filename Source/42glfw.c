@@ -75,7 +75,7 @@ void MainLoop(void)
          POV.w[0] = 0.0;
          POV.w[1] = 0.0;
          POV.w[2] = 0.0;
-         Done     = SimStep();
+         Done     = SimStep(GuiSimCtx);
          if (GLOutFlag) {
             glfwMakeContextCurrent(CamWindow);
             CamRenderExec();
@@ -1403,8 +1403,9 @@ long GuiCmdInterpreter(char CmdLine[512], double *CmdTime)
    return (NewCmdProcessed);
 }
 /*********************************************************************/
-void HandoffToGui(int argc, char **argv)
+void HandoffToGui(struct SimContextType *Ctx, int argc, char **argv)
 {
+   GuiSimCtx     = Ctx;
    PausedByMouse = 0;
 
    ReadGraphicsInpFile();
@@ -82,7 +82,7 @@ void Idle(void)
       if (TimerHasExpired) {
          TimerHasExpired = 0;
          glutTimerFunc(TimerDuration, TimerHandler, 0);
-         Done = SimStep();
+         Done = SimStep(GuiSimCtx);
          if (GLOutFlag) {
             glutSetWindow(CamWindow);
             CamRenderExec();
@@ -1427,8 +1427,9 @@ long GuiCmdInterpreter(char CmdLine[512], double *CmdTime)
    return (NewCmdProcessed);
 }
 /*********************************************************************/
-int HandoffToGui(int argc, char **argv)
+int HandoffToGui(struct SimContextType *Ctx, int argc, char **argv)
 {
+   GuiSimCtx     = Ctx;
    PausedByMouse = 0;
 
    ReadGraphicsInpFile();
@@ -31,6 +31,7 @@
 
 #include <dirent.h>
 #include <errno.h>
+#include <pthread.h>
 #include <strings.h>
 
 #ifdef _ENABLE_SPICE_
@@ -254,6 +255,11 @@ long DecodeString(char *s)
    else if (!strcmp(s, "COWELL"))
       return ORBDOF_COWELL;
 
+   else if (!strcmp(s, "RK4"))
+      return ORBINT_RK4;
+   else if (!strcmp(s, "RKF78"))
+      return ORBINT_RKF78;
+
    else if (!strcmp(s, "PASSIVE_FSW"))
       return PASSIVE_FSW;
    else if (!strcmp(s, "PROTOTYPE_FSW"))
@@ -413,6 +419,8 @@ long DecodeString(char *s)
       return IPC_CLIENT;
    else if (!strcmp(s, "GMSEC_CLIENT"))
       return IPC_GMSEC_CLIENT;
+   else if (!strcmp(s, "SHM"))
+      return IPC_SHM;
 
    else if (!strcmp(s, "MEAN"))
       return EPH_MEAN;
@@ -2191,9 +2199,8 @@ void InitShakers(struct SCType *S)
          if (!Sh->RandomActive) {
             fscanf(infile, "%[^\n] %[\n]", junk, &newline);
             fscanf(infile, "%[^\n] %[\n]", junk, &newline);
-            Sh->RandomProc = NULL;
-            Sh->Lowpass    = NULL;
-            Sh->Highpass   = NULL;
+            Sh->Lowpass  = NULL;
+            Sh->Highpass = NULL;
          }
          else {
             fscanf(infile, "%lf %lf %[^\n] %[\n]", &Sh->LowBandLimit,
@@ -2204,7 +2211,7 @@ void InitShakers(struct SCType *S)
             Sh->LowBandLimit  *= TwoPi;
 
             /* Lowpass and Highpass overlap to form Bandpass */
-            Sh->RandomProc = CreateRandomProcess(RngSeed + Ish);
+            InitRandomStream(&Sh->Rng, RngSeed, S->ID, RAND_SHAKER, Ish, 0);
             Sh->Lowpass = CreateSecondOrderLowpassFilter(Sh->HighBandLimit, 1.0,
                                                          DTSIM, 1.0E6, 1.0E-12);
             if (Sh->LowBandLimit > 0.0)
@@ -2409,9 +2416,131 @@ void InitOrderNDynamics(struct SCType *S)
    }
 }
 /**********************************************************************/
+/* Optional adaptive orbit integrator.  RKF78 covers point-mass       */
+/* Cowell and Keplerian-reference Encke propagation; other cases      */
+/* keep RK4.                                                          */
+static void InitOrbitIntegrator(struct SCType *S, struct fy_node *node)
+{
+   struct OrbitType *O = &Orb[S->RefOrb];
+   struct fy_node *tolNode;
+   char method[50] = {0};
+   long Supported;
+
+   S->OrbInt.Method = ORBINT_RK4;
+   S->OrbInt.Tol    = 1.0E-12;
+   S->OrbInt.Active = FALSE;
+   S->OrbInt.h      = 0.0;
+   if (!fy_node_scanf(node, "/Integrator %49s", method))
+      return;
+   S->OrbInt.Method = DecodeString(method);
+   if (S->OrbInt.Method != ORBINT_RK4 && S->OrbInt.Method != ORBINT_RKF78) {
+      fprintf(stderr, "Unknown orbit Integrator %s for SC[%ld]. Exiting...\n",
+              method, S->ID);
+      exit(EXIT_FAILURE);
+   }
+   tolNode = fy_node_by_path_def(node, "/Integrator Tolerance");
+   if (tolNode != NULL &&
+       (!fy_node_scanf(tolNode, "/ %lf", &S->OrbInt.Tol) ||
+        S->OrbInt.Tol <= 0.0)) {
+      fprintf(stderr, "Integrator Tolerance for SC[%ld] must be positive. "
+                      "Exiting...\n",
+              S->ID);
+      exit(EXIT_FAILURE);
+   }
+   if (S->OrbInt.Method == ORBINT_RK4)
+      return;
+
+   switch (O->Regime) {
+      case ORB_ZERO:
+      case ORB_FLIGHT:
+         Supported = !O->PolyhedronGravityEnabled;
+         break;
+      case ORB_CENTRAL:
+         Supported = S->OrbDOF == ORBDOF_COWELL ||
+                     (S->OrbDOF == ORBDOF_ENCKE && !O->SplineActive &&
+                      !O->J2DriftEnabled);
+         break;
+      default:
+         Supported = FALSE;
+   }
+   if (!Supported) {
+      printf("SC[%ld] orbit propagation is not supported by RKF78.  "
+             "Falling back to RK4.\n",
+             S->ID);
+      S->OrbInt.Method = ORBINT_RK4;
+   }
+}
+/**********************************************************************/
+/* Optional orbit and environment steps, as multiples of DTSIM.       */
+/* Attitude and flex stay at DTSIM.                                   */
+static long ReadStepMultiple(struct fy_node *node, const char *key,
+                             double *SampleTime)
+{
+   struct fy_node *stepNode;
+   long MaxCounter;
+
+   *SampleTime = DTSIM;
+   stepNode    = fy_node_by_path_def(node, key);
+   if (stepNode == NULL)
+      return (1);
+   if (!fy_node_scanf(stepNode, "/ %lf", SampleTime) ||
+       *SampleTime < DTSIM) {
+      fprintf(stderr, "Dynamics Flags %s must be at least DTSIM. Exiting...\n",
+              key + 1);
+      exit(EXIT_FAILURE);
+   }
+   MaxCounter  = (long)(*SampleTime / DTSIM + 0.5);
+   *SampleTime = MaxCounter * DTSIM;
+   return (MaxCounter);
+}
+/**********************************************************************/
+static void InitMultirate(struct SCType *S, struct fy_node *node)
+{
+   struct OrbitType *O = &Orb[S->RefOrb];
+
+   S->OrbMaxCounter = ReadStepMultiple(node, "/Orbit Step", &S->OrbSampleTime);
+   S->EnvMaxCounter =
+       ReadStepMultiple(node, "/Environment Step", &S->EnvSampleTime);
+   S->OrbSampleCounter = 0;
+   S->EnvSampleCounter = S->EnvMaxCounter;
+
+   if (S->OrbMaxCounter > 1 &&
+       (S->OrbDOF == ORBDOF_FIXED || S->OrbDOF == ORBDOF_EULER_HILL ||
+        (O->Regime == ORB_THREE_BODY && S->OrbDOF == ORBDOF_COWELL))) {
+      printf("SC[%ld] orbit propagation does not support an Orbit Step.  "
+             "Using DTSIM.\n",
+             S->ID);
+      S->OrbMaxCounter = 1;
+      S->OrbSampleTime = DTSIM;
+   }
+}
+/**********************************************************************/
+/* Each sensor draws from its own counter-based stream, keyed by      */
+/* (RngSeed, SC, sensor kind, sensor index), so its noise does not    */
+/* depend on how many draws other sensors or SC have made             */
+static void InitSensorNoise(struct SCType *S)
+{
+   long i;
+
+   for (i = 0; i < S->Nacc; i++)
+      InitRandomStream(&S->Accel[i].Rng, RngSeed, S->ID, RAND_ACCEL, i, 0);
+   for (i = 0; i < S->Ngyro; i++)
+      InitRandomStream(&S->Gyro[i].Rng, RngSeed, S->ID, RAND_GYRO, i, 0);
+   for (i = 0; i < S->Nmag; i++)
+      InitRandomStream(&S->MAG[i].Rng, RngSeed, S->ID, RAND_MAG, i, 0);
+   for (i = 0; i < S->Nfss; i++)
+      InitRandomStream(&S->FSS[i].Rng, RngSeed, S->ID, RAND_FSS, i, 0);
+   for (i = 0; i < S->Nst; i++)
+      InitRandomStream(&S->ST[i].Rng, RngSeed, S->ID, RAND_ST, i, 0);
+   for (i = 0; i < S->Ngps; i++)
+      InitRandomStream(&S->GPS[i].Rng, RngSeed, S->ID, RAND_GPS, i, 0);
+   for (i = 0; i < S->Nfgs; i++)
+      InitRandomStream(&S->Fgs[i].Rng, RngSeed, S->ID, RAND_FGS, i, 0);
+}
+/**********************************************************************/
 void InitSpacecraft(struct SCType *S)
 {
-   long i, j, k;
+   long i, j, k, Ipoly;
 
    char fileName[50];
    strcpy(fileName, S->FileName);
@@ -2456,6 +2585,7 @@ void InitSpacecraft(struct SCType *S)
       exit(EXIT_FAILURE);
    }
    S->OrbDOF = DecodeString(dummy);
+   InitOrbitIntegrator(S, node);
    if (!fy_node_scanf(node, "/Pos Specifier %49s", dummy)) {
       fprintf(stderr,
               "Could not find Position Specifier for spacecraft. Exiting...\n");
@@ -2555,6 +2685,8 @@ void InitSpacecraft(struct SCType *S)
       exit(EXIT_FAILURE);
    }
 
+   InitMultirate(S, node);
+
    S->ConstraintsRequested =
        getYAMLBool(fy_node_by_path_def(node, "/Compute Constraints"));
    S->FlexActive = getYAMLBool(fy_node_by_path_def(node, "/Flex Active"));
@@ -3596,6 +3728,33 @@ void InitSpacecraft(struct SCType *S)
    D->ActiveStateIdx = (long *)calloc(D->Nu + D->Nf, sizeof(long));
    D->COEF           = CreateMatrix(D->Nu + D->Nf, D->Nu + D->Nf);
    D->RHS            = (double *)calloc(D->Nu + D->Nf, sizeof(double));
+   D->LDLd           = (double *)calloc(D->Nu + D->Nf, sizeof(double));
+   if (D->LDLd == NULL) {
+      fprintf(stderr, "D->LDLd calloc returned null pointer.  Bailing out!\n");
+      exit(EXIT_FAILURE);
+   }
+   /* .. Flex mass matrix is constant, so factor it once for OneBodyEOM */
+   if (S->FlexActive && S->B[0].Nf > 0 && !S->B[0].MfIsDiagonal) {
+      long Nf0 = S->B[0].Nf;
+      D->MfL   = CreateMatrix(Nf0, Nf0);
+      D->MfD   = (double *)calloc(Nf0, sizeof(double));
+      if (D->MfD == NULL) {
+         fprintf(stderr,
+                 "D->MfD calloc returned null pointer.  Bailing out!\n");
+         exit(EXIT_FAILURE);
+      }
+      for (i = 0; i < Nf0; i++) {
+         for (j = 0; j < Nf0; j++)
+            D->MfL[i][j] = S->B[0].Mf[i][j];
+      }
+      if (!LDLFactor(D->MfL, D->MfD, Nf0)) {
+         fprintf(stderr,
+                 "SC[%ld] Body 0 flex mass matrix is not positive definite.  "
+                 "Bailing out!\n",
+                 S->ID);
+         exit(EXIT_FAILURE);
+      }
+   }
 
    MapStateVectorToBodyStates(D->u, D->x, D->h, D->a, D->uf, D->xf, S);
    MotionConstraints(S);
@@ -3614,6 +3773,26 @@ void InitSpacecraft(struct SCType *S)
          LoadOctree(&Geom[Ngeom - 1]);
    }
 
+   /* .. Shadowing workspace, unshadowed until FindUnshadedAreas runs */
+   for (j = 0; j < S->Nb; j++) {
+      struct BodyType *B = &S->B[j];
+      struct GeomType *G = &Geom[B->GeomTag];
+      B->UnshadedArea    = (double *)calloc(G->Npoly, sizeof(double));
+      B->UnshadedCtr     = CreateMatrix(3, G->Npoly);
+      if (B->UnshadedArea == NULL) {
+         fprintf(stderr,
+                 "B->UnshadedArea calloc returned null pointer.  Bailing "
+                 "out!\n");
+         exit(EXIT_FAILURE);
+      }
+      for (Ipoly = 0; Ipoly < G->Npoly; Ipoly++) {
+         B->UnshadedArea[Ipoly] = G->Poly[Ipoly].Area;
+         for (i = 0; i < 3; i++)
+            B->UnshadedCtr[i][Ipoly] = G->Poly[Ipoly].Centroid[i];
+      }
+   }
+   InitShadowLut(S);
+
    /* .. Initialize Bounding Box */
    memcpy(&S->BBox, &Geom[S->B[0].GeomTag].BBox,
           sizeof(struct BoundingBoxType));
@@ -3625,6 +3804,8 @@ void InitSpacecraft(struct SCType *S)
 
    InitShakers(S);
 
+   InitSensorNoise(S);
+
    InitDSM(S);
 
    /* .. Loop Gain and Delays allow verification of stability margins in the
@@ -3693,6 +3874,10 @@ void LoadGravModel(const char *modelPath, struct SphereHarmType *GravModel)
       GravModel->Norm = NULL;
       GravModel->C    = NULL;
       GravModel->S    = NULL;
+      GravModel->HFa  = NULL;
+      GravModel->HFb  = NULL;
+      GravModel->HFe  = NULL;
+      GravModel->HFs  = NULL;
       GravModel->N    = 0;
       GravModel->M    = 0;
    }
@@ -3740,6 +3925,7 @@ void LoadGravModel(const char *modelPath, struct SphereHarmType *GravModel)
          }
          GravModel->Norm[n][0] = sqrt(2 * n + 1);
       }
+      InitSphereHarmRecursion(GravModel);
    }
 }
 
@@ -5447,6 +5633,19 @@ void LoadMoonsOfPluto(void)
 #undef Nm
 }
 /**********************************************************************/
+static void FreePolyGravModel(struct SphereHarmType *PG)
+{
+   DestroyMatrix(PG->C);
+   DestroyMatrix(PG->S);
+   DestroyMatrix(PG->Norm);
+   DestroySphereHarmRecursion(PG);
+   PG->C    = NULL;
+   PG->S    = NULL;
+   PG->Norm = NULL;
+   PG->N    = 0;
+   PG->M    = 0;
+}
+/**********************************************************************/
 void LoadMinorBodies(void)
 {
    // TODO: change minorbodies.txt to yaml
@@ -5458,7 +5657,7 @@ void LoadMinorBodies(void)
    char junk[120], newline, response[120];
    long Ib, i;
    long EpochYear, EpochMon, EpochDay, EpochHour;
-   double CNJ[3][3], PoleRA, PoleDec, Epoch;
+   double CNJ[3][3], PoleRA, PoleDec, Epoch, FarErr;
    const double ZAxis[3] = {0.0, 0.0, 1.0};
    char GravFileName[32] = {0};
 
@@ -5523,6 +5722,47 @@ void LoadMinorBodies(void)
                               &Ngeom, &W->GeomTag, TRUE);
       W->Density = W->mu / (6.67408E-11 * PolyhedronVolume(&Geom[W->GeomTag]));
 
+      /* Exterior expansion stands in for the polyhedron sum far away */
+      W->PolyGravModel.N = 0;
+      if (PolyGravDegree > 0) {
+         struct SphereHarmType *PG = &W->PolyGravModel;
+         PG->N                     = PolyGravDegree;
+         PG->M                     = PolyGravDegree;
+         PG->C                     = CreateMatrix(PG->N + 1, PG->N + 1);
+         PG->S                     = CreateMatrix(PG->N + 1, PG->N + 1);
+         PG->Norm                  = CreateMatrix(PG->N + 1, PG->N + 1);
+         PG->r_ref         = PolyhedronSphereHarm(&Geom[W->GeomTag], PG->N,
+                                                  PG->C, PG->S);
+         W->PolyGravFarRad = PolyGravFarRatio * PG->r_ref;
+         /* Fully normalize, as SphereHarmGrav expects */
+         LegendreNorm(PG->N, PG->M, PG->Norm);
+         for (i = 0; i <= PG->N; i++) {
+            for (long j = 0; j <= i; j++) {
+               PG->C[i][j] /= PG->Norm[i][j];
+               PG->S[i][j] /= PG->Norm[i][j];
+            }
+         }
+         InitSphereHarmRecursion(PG);
+
+         /* .. The switch must not be felt as a kick */
+         FarErr = PolyhedronFarFieldError(&Geom[W->GeomTag], W->Density, PG,
+                                          W->mu, W->PolyGravFarRad);
+         printf("%s far-field gravity: degree %ld, %.1le relative error at "
+                "%.3lf km\n",
+                W->Name, PG->N, FarErr, W->PolyGravFarRad / 1000.0);
+         if (FarErr > 1.0E-4) {
+            printf("   Too coarse.  Using the exact polyhedron sum "
+                   "everywhere; raise Degree or Radius Ratio.\n");
+            FreePolyGravModel(PG);
+         }
+      }
+
+      /* .. Interpolated near field, filled in as SC visit it */
+      W->PolyGravGrid = NULL;
+      if (PolyGravNearTol > 0.0)
+         W->PolyGravGrid = CreatePolyGravGrid(
+             &Geom[W->GeomTag], W->Density, PolyGravNearTol, PolyGravFarRatio);
+
       W->Parent         = SOL;
       W->Nsat           = 0;
       W->RadOfInfluence = 100.0E3; /* Being generous */
@@ -5574,6 +5814,17 @@ void LoadMinorBodies(void)
    fclose(infile);
 }
 /**********************************************************************/
+void ShutdownMinorBodies(void)
+{
+   long Ib;
+
+   for (Ib = 0; Ib < Nmb; Ib++) {
+      FreePolyGravModel(&World[55 + Ib].PolyGravModel);
+      DestroyPolyGravGrid(World[55 + Ib].PolyGravGrid);
+      World[55 + Ib].PolyGravGrid = NULL;
+   }
+}
+/**********************************************************************/
 void LoadRegions(void)
 {
    struct fy_document *fyd =
@@ -5736,347 +5987,419 @@ void UpdateLagrangePoints(void)
    }
 }
 /******************************************************************************/
-long LoadJplEphems(char EphemPath[80], double JD)
+/* Layout of a JPL ephemeris block, from the header.4xx files:        */
+/* Starting Entry (1-based), Order, Number of Segments for each World */
+struct JplLayoutType {
+   long World;
+   long Start;
+   long N;
+   long Nseg;
+};
+#define NJPLBODY 11
+static const struct JplLayoutType JplLayout[NJPLBODY] = {
+    {MERCURY, 3, 14, 4},
+    {VENUS, 171, 10, 2},
+    {EARTH, 231, 13, 2}, /* Earth-Moon barycenter */
+    {MARS, 309, 11, 1},
+    {JUPITER, 342, 8, 1},
+    {SATURN, 366, 7, 1},
+    {URANUS, 387, 6, 1},
+    {NEPTUNE, 405, 6, 1},
+    {PLUTO, 423, 6, 1},
+    {LUNA, 441, 13, 8}, /* Geocentric */
+    {SOL, 753, 11, 2}};
+
+/* The ascp*.4xx text files are converted once to <file>.bin beside   */
+/* them: a JplBinHeaderType followed by Nblock blocks of Ncoef        */
+/* doubles.  Blocks are contiguous and of equal span, so the block    */
+/* holding any JD is found by index, and the file is memory-mapped    */
+/* rather than re-read at each block boundary.  The .bin is written   */
+/* under a scratch name and renamed into place, since other runs may  */
+/* have it mapped, and is checksummed so a damaged one is rebuilt.    */
+#define JPL_BIN_MAGIC "42JPLBN2"
+struct JplBinHeaderType {
+   char Magic[8];
+   int64_t Nblock;
+   int64_t Ncoef;
+   double JD1;        /* Start of first block */
+   double Span;       /* Days per block */
+   uint64_t Checksum; /* JplChecksum of the blocks */
+};
+struct JplStoreType {
+   char FileName[40];
+   void *Map; /* Mapped .bin file, or NULL */
+   size_t MapSize;
+   double *Data;        /* Converted in memory if the .bin can't be written */
+   const double *Block; /* Nblock x Ncoef */
+   long Nblock;
+   long Ncoef;
+   double JD1;
+   double Span;
+};
+/* At most one store per file of an EphemOption, so entries never     */
+/* move.  Stores are opened on first use, which may be from the per-  */
+/* SC threads (RK stages past the loaded block), hence the mutex.     */
+#define NJPLSTORE 4
+static SIMLOCAL struct JplStoreType JplStore[NJPLSTORE];
+static SIMLOCAL long NjplStore       = 0;
+static pthread_mutex_t JplStoreMutex = PTHREAD_MUTEX_INITIALIZER;
+/**********************************************************************/
+/* Returns -1 or +1 if JD is before or after the files for EphemOption */
+static long JplEphemFile(double JD, const char **FileName)
 {
-   FILE *infile;
-   double Block[1020];
-   long BlockNum, NumEntries;
-   long FoundBlock;
-   char line[512];
-   double JD1, JD2;
-   long i, n, Ic, Iw;
-   long Nseg, Start, N;
-   struct Cheb3DType *Cheb;
-
-   /* .. Select input file */
+   *FileName = NULL;
    if (EphemOption == EPH_DE430 || EphemOption == EPH_DE440) {
-      if (JD < 2433264.5) {
-         fprintf(stderr,
-                 "JD earlier than JPL ephem input files.  Falling back to "
-                 "lower-precision planetary ephemerides.\n");
-         return (1);
-      }
-      else if (JD < 2469808.5) {
-         if (EphemOption == EPH_DE430)
-            infile = FileOpen(EphemPath, "ascp1950.430", "rt");
-         else if (EphemOption == EPH_DE440)
-            infile = FileOpen(EphemPath, "ascp01950.440", "rt");
-      }
-      else if (JD < 2506352.5) {
-         if (EphemOption == EPH_DE430)
-            infile = FileOpen(EphemPath, "ascp2050.430", "rt");
-         else if (EphemOption == EPH_DE440)
-            infile = FileOpen(EphemPath, "ascp02050.440", "rt");
-      }
-      else if (JD < 2542864.5) {
-         if (EphemOption == EPH_DE430)
-            infile = FileOpen(EphemPath, "ascp2150.430", "rt");
-         else if (EphemOption == EPH_DE440)
-            infile = FileOpen(EphemPath, "ascp02150.440", "rt");
-      }
-      else {
-         printf("JD later than JPL ephem input files.  Falling back to "
-                "lower-precision planetary ephemerides.\n");
+      if (JD < 2433264.5)
+         return (-1);
+      else if (JD < 2469808.5)
+         *FileName =
+             (EphemOption == EPH_DE430 ? "ascp1950.430" : "ascp01950.440");
+      else if (JD < 2506352.5)
+         *FileName =
+             (EphemOption == EPH_DE430 ? "ascp2050.430" : "ascp02050.440");
+      else if (JD < 2542864.5)
+         *FileName =
+             (EphemOption == EPH_DE430 ? "ascp2150.430" : "ascp02150.440");
+      else
          return (1);
-      }
    }
    else if (EphemOption == EPH_DE421 || EphemOption == EPH_GMAT421) {
-      if (JD < 2415020.5) {
-         fprintf(stderr,
-                 "JD earlier than JPL ephem input files.  Falling back to "
-                 "lower-precision planetary ephemerides.\n");
-         return (1);
-      }
-      else if (JD < 2469807.5) {
-         infile = FileOpen(EphemPath, "ascp1900.421", "rt");
-      }
-      else if (JD < 2524593.5) {
-         infile = FileOpen(EphemPath, "ascp2050.421", "rt");
-      }
-      else {
-         printf("JD later than JPL ephem input files.  Falling back to "
-                "lower-precision planetary ephemerides.\n");
+      if (JD < 2415020.5)
+         return (-1);
+      else if (JD < 2469807.5)
+         *FileName = "ascp1900.421";
+      else if (JD < 2524593.5)
+         *FileName = "ascp2050.421";
+      else
          return (1);
-      }
    }
    else if (EphemOption == EPH_DE424 || EphemOption == EPH_GMAT424) {
-      if (JD < 2415020.5) {
-         fprintf(stderr,
-                 "JD earlier than JPL ephem input files.  Falling back to "
-                 "lower-precision planetary ephemerides.\n");
-         return (1);
-      }
-      else if (JD < 2451544.5) {
-         infile = FileOpen(EphemPath, "ascp1900.424", "rt");
-      }
-      else if (JD < 2488069.5) {
-         infile = FileOpen(EphemPath, "ascp2000.424", "rt");
-      }
-      else if (JD < 2524593.5) {
-         infile = FileOpen(EphemPath, "ascp2100.424", "rt");
-      }
-      else if (JD < 2561117.5) {
-         infile = FileOpen(EphemPath, "ascp2200.424", "rt");
-      }
-      else {
-         printf("JD later than JPL ephem input files.  Falling back to "
-                "lower-precision planetary ephemerides.\n");
+      if (JD < 2415020.5)
+         return (-1);
+      else if (JD < 2451544.5)
+         *FileName = "ascp1900.424";
+      else if (JD < 2488069.5)
+         *FileName = "ascp2000.424";
+      else if (JD < 2524593.5)
+         *FileName = "ascp2100.424";
+      else if (JD < 2561117.5)
+         *FileName = "ascp2200.424";
+      else
          return (1);
-      }
    }
    else {
       fprintf(stderr, "Unknown Ephem Option in LoadJplEphems.\n");
       exit(EXIT_FAILURE);
    }
+   return (0);
+}
+/**********************************************************************/
+static uint64_t JplChecksum(const double *Block, long N)
+{
+   uint64_t Sum = 14695981039346656037ULL, Word;
+   long i;
 
-   /* .. Search for block */
-   FoundBlock = 0;
-   while (!FoundBlock) {
-      fgets(line, 511, infile);
-      if (sscanf(line, "%ld %ld", &BlockNum, &NumEntries) == 2) {
-         fgets(line, 511, infile);
-         if (sscanf(line, "%lf %lf %lf", &Block[0], &Block[1], &Block[2]) ==
-             3) {
-            if (JD >= Block[0] && JD < Block[1]) {
-               FoundBlock = 1;
-               JD1        = Block[0];
-               JD2        = Block[1];
-            }
+   for (i = 0; i < N; i++) {
+      memcpy(&Word, &Block[i], sizeof(Word));
+      Sum = (Sum ^ Word) * 1099511628211ULL;
+   }
+   return (Sum);
+}
+/**********************************************************************/
+/* Parse every block of the text file, then try to save the binary    */
+static void ConvertJplEphem(const char *EphemPath, struct JplStoreType *St)
+{
+   FILE *infile, *outfile;
+   struct JplBinHeaderType Hdr;
+   char line[512], *c, BinName[48], TmpName[1024];
+   long BlockNum, NumEntries, Nalloc, i, k;
+   double *Block;
+
+   infile     = FileOpen(EphemPath, St->FileName, "rt");
+   St->Nblock = 0;
+   St->Ncoef  = 0;
+   Nalloc     = 0;
+   St->Data   = NULL;
+   while (fgets(line, 511, infile) != NULL) {
+      if (sscanf(line, "%ld %ld", &BlockNum, &NumEntries) != 2)
+         continue;
+      if (St->Ncoef == 0)
+         St->Ncoef = 3 * ((NumEntries + 2) / 3);
+      if (St->Nblock == Nalloc) {
+         Nalloc   = (Nalloc == 0 ? 256 : 2 * Nalloc);
+         St->Data = (double *)realloc(St->Data,
+                                      Nalloc * St->Ncoef * sizeof(double));
+         if (St->Data == NULL) {
+            fprintf(stderr,
+                    "St->Data realloc returned null pointer.  Bailing out!\n");
+            exit(EXIT_FAILURE);
          }
       }
+      Block = &St->Data[St->Nblock * St->Ncoef];
+      for (i = 0; i < St->Ncoef / 3; i++) {
+         if (fgets(line, 511, infile) == NULL) {
+            fprintf(stderr, "Truncated block %ld in %s.  Bailing out.\n",
+                    BlockNum, St->FileName);
+            exit(EXIT_FAILURE);
+         }
+         /* JPL writes Fortran exponents (0.1D+01) */
+         for (c = line; *c != '\0'; c++) {
+            if (*c == 'D' || *c == 'd')
+               *c = 'E';
+         }
+         if (sscanf(line, "%lf %lf %lf", &Block[3 * i], &Block[3 * i + 1],
+                    &Block[3 * i + 2]) != 3) {
+            fprintf(stderr, "Bad line in block %ld of %s.  Bailing out.\n",
+                    BlockNum, St->FileName);
+            exit(EXIT_FAILURE);
+         }
+      }
+      St->Nblock++;
+   }
+   fclose(infile);
+   if (St->Nblock == 0) {
+      fprintf(stderr, "No ephemeris blocks found in %s.  Bailing out.\n",
+              St->FileName);
+      exit(EXIT_FAILURE);
    }
 
-   /* .. Load block */
-   for (i = 1; i < 340; i++) {
-      fgets(line, 511, infile);
-      sscanf(line, "%lf %lf %lf", &Block[3 * i], &Block[3 * i + 1],
-             &Block[3 * i + 2]);
+   /* .. Index lookup needs back-to-back blocks of one span */
+   St->JD1  = St->Data[0];
+   St->Span = St->Data[1] - St->Data[0];
+   for (k = 1; k < St->Nblock; k++) {
+      Block = &St->Data[k * St->Ncoef];
+      if (fabs(Block[0] - (St->JD1 + k * St->Span)) > 1.0E-6 ||
+          fabs(Block[1] - Block[0] - St->Span) > 1.0E-6) {
+         fprintf(stderr,
+                 "Ephemeris blocks in %s are not uniformly spaced.  Bailing "
+                 "out.\n",
+                 St->FileName);
+         exit(EXIT_FAILURE);
+      }
    }
-   fclose(infile);
+   St->Block = St->Data;
+
+   /* .. Save for next time, if EphemPath is writable */
+   memcpy(Hdr.Magic, JPL_BIN_MAGIC, 8);
+   Hdr.Nblock   = St->Nblock;
+   Hdr.Ncoef    = St->Ncoef;
+   Hdr.JD1      = St->JD1;
+   Hdr.Span     = St->Span;
+   Hdr.Checksum = JplChecksum(St->Data, St->Nblock * St->Ncoef);
+   snprintf(BinName, 48, "%s.bin", St->FileName);
+   outfile = OpenTempFile(EphemPath, BinName, TmpName);
+   if (outfile == NULL) {
+      printf("Could not write %s%s.  Using %s unconverted.\n", EphemPath,
+             BinName, St->FileName);
+      return;
+   }
+   if (fwrite(&Hdr, sizeof(Hdr), 1, outfile) != 1 ||
+       fwrite(St->Data, sizeof(double), St->Nblock * St->Ncoef, outfile) !=
+           (size_t)(St->Nblock * St->Ncoef)) {
+      fclose(outfile);
+      remove(TmpName);
+      printf("Could not write %s%s.  Using %s unconverted.\n", EphemPath,
+             BinName, St->FileName);
+      return;
+   }
+   if (CommitTempFile(outfile, TmpName, EphemPath, BinName)) {
+      printf("Could not write %s%s.  Using %s unconverted.\n", EphemPath,
+             BinName, St->FileName);
+      return;
+   }
+   printf("Converted %s to %s%s\n", St->FileName, EphemPath, BinName);
+}
+/**********************************************************************/
+/* Header and contents agree: counts match the size, the blocks tile  */
+/* [JD1, JD1 + Nblock*Span], and the checksum holds                   */
+static long JplBinIsValid(const void *Map, size_t MapSize)
+{
+   struct JplBinHeaderType Hdr;
+   const double *Block;
+
+   if (Map == NULL || MapSize < sizeof(Hdr))
+      return (FALSE);
+   memcpy(&Hdr, Map, sizeof(Hdr));
+   if (memcmp(Hdr.Magic, JPL_BIN_MAGIC, 8) || Hdr.Nblock <= 0 ||
+       Hdr.Ncoef < 2 || Hdr.Span <= 0.0 ||
+       MapSize != sizeof(Hdr) + Hdr.Nblock * Hdr.Ncoef * sizeof(double))
+      return (FALSE);
+   Block = (const double *)((const char *)Map + sizeof(Hdr));
+   if (Block[0] != Hdr.JD1 ||
+       fabs(Block[(Hdr.Nblock - 1) * Hdr.Ncoef + 1] -
+            (Hdr.JD1 + Hdr.Nblock * Hdr.Span)) > 1.0E-6)
+      return (FALSE);
+   return (JplChecksum(Block, Hdr.Nblock * Hdr.Ncoef) == Hdr.Checksum);
+}
+/**********************************************************************/
+static struct JplStoreType *OpenJplStore(const char *EphemPath,
+                                         const char *FileName)
+{
+   struct JplStoreType *St;
+   struct JplBinHeaderType Hdr;
+   char BinName[48];
+   long i;
 
-   /* .. Distribute to Worlds [Starting Entry (1-based), Order, Number of
-    * Segments] */
-   /* Mercury [3 14 4] */
-   Iw                  = MERCURY;
-   Nseg                = 4;
-   Start               = 3 - 1;
-   N                   = 14;
-   World[Iw].eph.Ncheb = Nseg;
-   World[Iw].eph.Cheb =
-       (struct Cheb3DType *)calloc(Nseg, sizeof(struct Cheb3DType));
-   for (Ic = 0; Ic < Nseg; Ic++) {
-      Cheb      = &World[Iw].eph.Cheb[Ic];
-      Cheb->JD1 = JD1 + ((double)Ic) * (JD2 - JD1) / ((double)Nseg);
-      Cheb->JD2 =
-          JD2 - ((double)(Nseg - 1 - Ic)) * (JD2 - JD1) / ((double)Nseg);
-      Cheb->N = N;
-      for (n = 0; n < N; n++) {
-         for (i = 0; i < 3; i++) {
-            Cheb->Coef[i][n] = Block[Start + N * 3 * Ic + N * i + n];
-         }
-      }
-   }
-   /* Venus [171 10 2] */
-   Iw                  = VENUS;
-   Nseg                = 2;
-   Start               = 171 - 1;
-   N                   = 10;
-   World[Iw].eph.Ncheb = Nseg;
-   World[Iw].eph.Cheb =
-       (struct Cheb3DType *)calloc(Nseg, sizeof(struct Cheb3DType));
-   for (Ic = 0; Ic < Nseg; Ic++) {
-      Cheb      = &World[Iw].eph.Cheb[Ic];
-      Cheb->JD1 = JD1 + ((double)Ic) * (JD2 - JD1) / ((double)Nseg);
-      Cheb->JD2 =
-          JD2 - ((double)(Nseg - 1 - Ic)) * (JD2 - JD1) / ((double)Nseg);
-      Cheb->N = N;
-      for (n = 0; n < N; n++) {
-         for (i = 0; i < 3; i++) {
-            Cheb->Coef[i][n] = Block[Start + N * 3 * Ic + N * i + n];
-         }
-      }
-   }
-   /* Earth-Moon barycenter [231 13 2] */
-   Iw                  = EARTH;
-   Nseg                = 2;
-   Start               = 231 - 1;
-   N                   = 13;
-   World[Iw].eph.Ncheb = Nseg;
-   World[Iw].eph.Cheb =
-       (struct Cheb3DType *)calloc(Nseg, sizeof(struct Cheb3DType));
-   for (Ic = 0; Ic < Nseg; Ic++) {
-      Cheb      = &World[Iw].eph.Cheb[Ic];
-      Cheb->JD1 = JD1 + ((double)Ic) * (JD2 - JD1) / ((double)Nseg);
-      Cheb->JD2 =
-          JD2 - ((double)(Nseg - 1 - Ic)) * (JD2 - JD1) / ((double)Nseg);
-      Cheb->N = N;
-      for (n = 0; n < N; n++) {
-         for (i = 0; i < 3; i++) {
-            Cheb->Coef[i][n] = Block[Start + N * 3 * Ic + N * i + n];
-         }
-      }
-   }
-   /* Mars [309 11 1] */
-   Iw                  = MARS;
-   Nseg                = 1;
-   Start               = 309 - 1;
-   N                   = 11;
-   World[Iw].eph.Ncheb = Nseg;
-   World[Iw].eph.Cheb =
-       (struct Cheb3DType *)calloc(Nseg, sizeof(struct Cheb3DType));
-   for (Ic = 0; Ic < Nseg; Ic++) {
-      Cheb      = &World[Iw].eph.Cheb[Ic];
-      Cheb->JD1 = JD1 + ((double)Ic) * (JD2 - JD1) / ((double)Nseg);
-      Cheb->JD2 =
-          JD2 - ((double)(Nseg - 1 - Ic)) * (JD2 - JD1) / ((double)Nseg);
-      Cheb->N = N;
-      for (n = 0; n < N; n++) {
-         for (i = 0; i < 3; i++) {
-            Cheb->Coef[i][n] = Block[Start + N * 3 * Ic + N * i + n];
-         }
-      }
-   }
-   /* Jupiter [342 8 1] */
-   Iw                  = JUPITER;
-   Nseg                = 1;
-   Start               = 342 - 1;
-   N                   = 8;
-   World[Iw].eph.Ncheb = Nseg;
-   World[Iw].eph.Cheb =
-       (struct Cheb3DType *)calloc(Nseg, sizeof(struct Cheb3DType));
-   for (Ic = 0; Ic < Nseg; Ic++) {
-      Cheb      = &World[Iw].eph.Cheb[Ic];
-      Cheb->JD1 = JD1 + ((double)Ic) * (JD2 - JD1) / ((double)Nseg);
-      Cheb->JD2 =
-          JD2 - ((double)(Nseg - 1 - Ic)) * (JD2 - JD1) / ((double)Nseg);
-      Cheb->N = N;
-      for (n = 0; n < N; n++) {
-         for (i = 0; i < 3; i++) {
-            Cheb->Coef[i][n] = Block[Start + N * 3 * Ic + N * i + n];
-         }
-      }
-   }
-   /* Saturn [366 7 1] */
-   Iw                  = SATURN;
-   Nseg                = 1;
-   Start               = 366 - 1;
-   N                   = 7;
-   World[Iw].eph.Ncheb = Nseg;
-   World[Iw].eph.Cheb =
-       (struct Cheb3DType *)calloc(Nseg, sizeof(struct Cheb3DType));
-   for (Ic = 0; Ic < Nseg; Ic++) {
-      Cheb      = &World[Iw].eph.Cheb[Ic];
-      Cheb->JD1 = JD1 + ((double)Ic) * (JD2 - JD1) / ((double)Nseg);
-      Cheb->JD2 =
-          JD2 - ((double)(Nseg - 1 - Ic)) * (JD2 - JD1) / ((double)Nseg);
-      Cheb->N = N;
-      for (n = 0; n < N; n++) {
-         for (i = 0; i < 3; i++) {
-            Cheb->Coef[i][n] = Block[Start + N * 3 * Ic + N * i + n];
-         }
-      }
-   }
-   /* Uranus [387 6 1] */
-   Iw                  = URANUS;
-   Nseg                = 1;
-   Start               = 387 - 1;
-   N                   = 6;
-   World[Iw].eph.Ncheb = Nseg;
-   World[Iw].eph.Cheb =
-       (struct Cheb3DType *)calloc(Nseg, sizeof(struct Cheb3DType));
-   for (Ic = 0; Ic < Nseg; Ic++) {
-      Cheb      = &World[Iw].eph.Cheb[Ic];
-      Cheb->JD1 = JD1 + ((double)Ic) * (JD2 - JD1) / ((double)Nseg);
-      Cheb->JD2 =
-          JD2 - ((double)(Nseg - 1 - Ic)) * (JD2 - JD1) / ((double)Nseg);
-      Cheb->N = N;
-      for (n = 0; n < N; n++) {
-         for (i = 0; i < 3; i++) {
-            Cheb->Coef[i][n] = Block[Start + N * 3 * Ic + N * i + n];
-         }
-      }
-   }
-   /* Neptune [405 6 1] */
-   Iw                  = NEPTUNE;
-   Nseg                = 1;
-   Start               = 405 - 1;
-   N                   = 6;
-   World[Iw].eph.Ncheb = Nseg;
-   World[Iw].eph.Cheb =
-       (struct Cheb3DType *)calloc(Nseg, sizeof(struct Cheb3DType));
-   for (Ic = 0; Ic < Nseg; Ic++) {
-      Cheb      = &World[Iw].eph.Cheb[Ic];
-      Cheb->JD1 = JD1 + ((double)Ic) * (JD2 - JD1) / ((double)Nseg);
-      Cheb->JD2 =
-          JD2 - ((double)(Nseg - 1 - Ic)) * (JD2 - JD1) / ((double)Nseg);
-      Cheb->N = N;
-      for (n = 0; n < N; n++) {
-         for (i = 0; i < 3; i++) {
-            Cheb->Coef[i][n] = Block[Start + N * 3 * Ic + N * i + n];
-         }
-      }
-   }
-   /* Pluto [423 6 1] */
-   Iw                  = PLUTO;
-   Nseg                = 1;
-   Start               = 423 - 1;
-   N                   = 6;
-   World[Iw].eph.Ncheb = Nseg;
-   World[Iw].eph.Cheb =
-       (struct Cheb3DType *)calloc(Nseg, sizeof(struct Cheb3DType));
-   for (Ic = 0; Ic < Nseg; Ic++) {
-      Cheb      = &World[Iw].eph.Cheb[Ic];
-      Cheb->JD1 = JD1 + ((double)Ic) * (JD2 - JD1) / ((double)Nseg);
-      Cheb->JD2 =
-          JD2 - ((double)(Nseg - 1 - Ic)) * (JD2 - JD1) / ((double)Nseg);
-      Cheb->N = N;
-      for (n = 0; n < N; n++) {
-         for (i = 0; i < 3; i++) {
-            Cheb->Coef[i][n] = Block[Start + N * 3 * Ic + N * i + n];
-         }
-      }
-   }
-   /* Moon (geocentric) [441 13 8] */
-   Iw                  = LUNA;
-   Nseg                = 8;
-   Start               = 441 - 1;
-   N                   = 13;
-   World[Iw].eph.Ncheb = Nseg;
-   World[Iw].eph.Cheb =
-       (struct Cheb3DType *)calloc(Nseg, sizeof(struct Cheb3DType));
-   for (Ic = 0; Ic < Nseg; Ic++) {
-      Cheb      = &World[Iw].eph.Cheb[Ic];
-      Cheb->JD1 = JD1 + ((double)Ic) * (JD2 - JD1) / ((double)Nseg);
-      Cheb->JD2 =
-          JD2 - ((double)(Nseg - 1 - Ic)) * (JD2 - JD1) / ((double)Nseg);
-      Cheb->N = N;
-      for (n = 0; n < N; n++) {
-         for (i = 0; i < 3; i++) {
-            Cheb->Coef[i][n] = Block[Start + N * 3 * Ic + N * i + n];
-         }
-      }
-   }
-   /* Sun [753 11 2] */
-   Iw                  = SOL;
-   Nseg                = 2;
-   Start               = 753 - 1;
-   N                   = 11;
-   World[Iw].eph.Ncheb = Nseg;
-   World[Iw].eph.Cheb =
-       (struct Cheb3DType *)calloc(Nseg, sizeof(struct Cheb3DType));
-   for (Ic = 0; Ic < Nseg; Ic++) {
-      Cheb      = &World[Iw].eph.Cheb[Ic];
-      Cheb->JD1 = JD1 + ((double)Ic) * (JD2 - JD1) / ((double)Nseg);
-      Cheb->JD2 =
-          JD2 - ((double)(Nseg - 1 - Ic)) * (JD2 - JD1) / ((double)Nseg);
-      Cheb->N = N;
-      for (n = 0; n < N; n++) {
-         for (i = 0; i < 3; i++) {
-            Cheb->Coef[i][n] = Block[Start + N * 3 * Ic + N * i + n];
-         }
+   pthread_mutex_lock(&JplStoreMutex);
+   for (i = 0; i < NjplStore; i++) {
+      if (!strcmp(JplStore[i].FileName, FileName)) {
+         pthread_mutex_unlock(&JplStoreMutex);
+         return (&JplStore[i]);
+      }
+   }
+   if (NjplStore == NJPLSTORE) {
+      fprintf(stderr, "Too many JPL ephemeris files open.  Bailing out!\n");
+      exit(EXIT_FAILURE);
+   }
+
+   St = &JplStore[NjplStore];
+   memset(St, 0, sizeof(struct JplStoreType));
+   strncpy(St->FileName, FileName, 39);
+
+   snprintf(BinName, 48, "%s.bin", FileName);
+   St->Map = MapFile(EphemPath, BinName, &St->MapSize);
+   if (JplBinIsValid(St->Map, St->MapSize)) {
+      memcpy(&Hdr, St->Map, sizeof(Hdr));
+      St->Nblock = Hdr.Nblock;
+      St->Ncoef  = Hdr.Ncoef;
+      St->JD1    = Hdr.JD1;
+      St->Span   = Hdr.Span;
+      St->Block  = (const double *)((const char *)St->Map + sizeof(Hdr));
+   }
+   else {
+      /* .. Missing, stale, or damaged binary */
+      UnmapFile(St->Map, St->MapSize);
+      St->Map     = NULL;
+      St->MapSize = 0;
+      ConvertJplEphem(EphemPath, St);
+   }
+   /* .. Publish only once filled in */
+   NjplStore++;
+   pthread_mutex_unlock(&JplStoreMutex);
+   return (St);
+}
+/**********************************************************************/
+/* Block holding JD, or NULL if JD is outside the JPL files           */
+static const double *FindJplBlock(const char *EphemPath, double JD)
+{
+   struct JplStoreType *St;
+   const char *FileName;
+   const double *Block;
+   long k;
+
+   if (JplEphemFile(JD, &FileName) != 0)
+      return (NULL);
+   St = OpenJplStore(EphemPath, FileName);
+
+   k = (long)floor((JD - St->JD1) / St->Span);
+   if (k < 0)
+      k = 0;
+   if (k > St->Nblock - 1)
+      k = St->Nblock - 1;
+   Block = &St->Block[k * St->Ncoef];
+   /* .. Guard against roundoff at block edges */
+   if (JD >= Block[1] && k < St->Nblock - 1)
+      Block += St->Ncoef;
+   else if (JD < Block[0] && k > 0)
+      Block -= St->Ncoef;
+   if (JD < Block[0] || JD >= Block[1])
+      return (NULL);
+   return (Block);
+}
+/**********************************************************************/
+static void JplChebFromBlock(const double *Block, long Il, long Ic,
+                             struct Cheb3DType *Cheb)
+{
+   const struct JplLayoutType *L = &JplLayout[Il];
+   const double JD1              = Block[0];
+   const double JD2              = Block[1];
+   long i, n;
+
+   Cheb->JD1 = JD1 + ((double)Ic) * (JD2 - JD1) / ((double)L->Nseg);
+   Cheb->JD2 =
+       JD2 - ((double)(L->Nseg - 1 - Ic)) * (JD2 - JD1) / ((double)L->Nseg);
+   Cheb->N = L->N;
+   for (n = 0; n < L->N; n++) {
+      for (i = 0; i < 3; i++) {
+         Cheb->Coef[i][n] = Block[L->Start - 1 + L->N * 3 * Ic + L->N * i + n];
+      }
+   }
+}
+/**********************************************************************/
+/* Segment of World Iw valid at JD.  Taken from the loaded block when */
+/* that covers JD, else decoded from the store into Scratch, so RK    */
+/* stages past the end of the block need no reload.                   */
+static struct Cheb3DType *JplChebAt(long Iw, double JD,
+                                    struct Cheb3DType *Scratch)
+{
+   struct OrbitType *Eph = &World[Iw].eph;
+   const double *Block;
+   long Ic, Il;
+
+   if (JD > Eph->Cheb[Eph->Ncheb - 1].JD2) {
+      Block = FindJplBlock(ModelPath, JD);
+      if (Block != NULL) {
+         for (Il = 0; JplLayout[Il].World != Iw; Il++)
+            ;
+         Ic = (long)((JD - Block[0]) / (Block[1] - Block[0]) *
+                     JplLayout[Il].Nseg);
+         if (Ic > JplLayout[Il].Nseg - 1)
+            Ic = JplLayout[Il].Nseg - 1;
+         JplChebFromBlock(Block, Il, Ic, Scratch);
+         return (Scratch);
       }
    }
 
+   Ic = 0;
+   while (Ic < Eph->Ncheb - 1 && JD > Eph->Cheb[Ic].JD2)
+      Ic++;
+   return (&Eph->Cheb[Ic]);
+}
+/**********************************************************************/
+long LoadJplEphems(char EphemPath[80], double JD)
+{
+   const char *FileName;
+   const double *Block;
+   long Il, Ic, Iw, Nseg, Status;
+
+   /* .. Select input file */
+   Status = JplEphemFile(JD, &FileName);
+   if (Status < 0) {
+      fprintf(stderr,
+              "JD earlier than JPL ephem input files.  Falling back to "
+              "lower-precision planetary ephemerides.\n");
+      return (1);
+   }
+   else if (Status > 0) {
+      printf("JD later than JPL ephem input files.  Falling back to "
+             "lower-precision planetary ephemerides.\n");
+      return (1);
+   }
+
+   /* .. Look up block */
+   Block = FindJplBlock(EphemPath, JD);
+   if (Block == NULL) {
+      fprintf(stderr, "JD %lf not found in %s.  Bailing out.\n", JD,
+              FileName);
+      exit(EXIT_FAILURE);
+   }
+
+   /* .. Distribute to Worlds */
+   for (Il = 0; Il < NJPLBODY; Il++) {
+      Iw   = JplLayout[Il].World;
+      Nseg = JplLayout[Il].Nseg;
+      if (World[Iw].eph.Cheb == NULL)
+         World[Iw].eph.Cheb =
+             (struct Cheb3DType *)calloc(Nseg, sizeof(struct Cheb3DType));
+      World[Iw].eph.Ncheb = Nseg;
+      for (Ic = 0; Ic < Nseg; Ic++)
+         JplChebFromBlock(Block, Il, Ic, &World[Iw].eph.Cheb[Ic]);
+   }
+
+   /* .. Open the next block's file now, so that RK stages reaching */
+   /*    into it don't have to */
+   FindJplBlock(EphemPath, Block[1]);
+
    /* Specific Earth-Moon Mass Ratio and AU  Definitions */
    /* These values are the exact values from the associated
       header.DE421, header.DE424, etc files  */
@@ -6213,9 +6536,8 @@ void Rk4JplEphems(double JD, long trgtWORLD, double trgtPosN[3],
                   double trgtPosH[3], double *trgtPriMerAng,
                   double trgtCNH[3][3])
 {
-   long i, j, Ic, Iw;
-   struct Cheb3DType *Cheb;
-   struct OrbitType *Eph;
+   long i, j, Iw;
+   struct Cheb3DType *Cheb, Scratch;
    struct WorldType *W;
    double u, dudJD, T[20], U[20], P, dPdu;
    double rh[3], PosJ[3], PosN[3], systemBC[3];
@@ -6227,14 +6549,9 @@ void Rk4JplEphems(double JD, long trgtWORLD, double trgtPosN[3],
    double CNH[3][3] = {0};
 
    /* .. Initialize position of system barycenter */
-   W   = &World[SOL];
-   Eph = &W->eph;
    /* Determine segment */
-   Ic = 0;
-   while (JD > Eph->Cheb[Ic].JD2)
-      Ic++;
+   Cheb = JplChebAt(SOL, JD, &Scratch);
    /* Apply Chebyshev polynomials */
-   Cheb  = &Eph->Cheb[Ic];
    dudJD = 2.0 / (Cheb->JD2 - Cheb->JD1);
    u     = (JD - Cheb->JD1) * dudJD - 1.0;
    ChebyPolys(u, Cheb->N, T, U);
@@ -6253,15 +6570,10 @@ void Rk4JplEphems(double JD, long trgtWORLD, double trgtPosN[3],
    if (trgtWORLD == EARTH || trgtWORLD == LUNA) {
       /* .. Initialize Planetary Pos for EARTH/LUNA */
       for (j = 0; j < 2; ++j) {
-         Iw  = WRLD[j];
-         W   = &World[Iw];
-         Eph = &W->eph;
+         Iw = WRLD[j];
          /* Determine segment */
-         Ic = 0;
-         while (JD > Eph->Cheb[Ic].JD2)
-            Ic++;
+         Cheb = JplChebAt(Iw, JD, &Scratch);
          /* Apply Chebyshev polynomials */
-         Cheb  = &Eph->Cheb[Ic];
          dudJD = 2.0 / (Cheb->JD2 - Cheb->JD1);
          u     = (JD - Cheb->JD1) * dudJD - 1.0;
          ChebyPolys(u, Cheb->N, T, U);
@@ -6298,14 +6610,9 @@ void Rk4JplEphems(double JD, long trgtWORLD, double trgtPosN[3],
    }
    else if (otherJPL) {
       /* .. Initialize Pos for other planet in JPL ephemerides */
-      W   = &World[trgtWORLD];
-      Eph = &W->eph;
       /* Determine segment */
-      Ic = 0;
-      while (JD > Eph->Cheb[Ic].JD2)
-         Ic++;
+      Cheb = JplChebAt(trgtWORLD, JD, &Scratch);
       /* Apply Chebyshev polynomials */
-      Cheb  = &Eph->Cheb[Ic];
       dudJD = 2.0 / (Cheb->JD2 - Cheb->JD1);
       u     = (JD - Cheb->JD1) * dudJD - 1.0;
       ChebyPolys(u, Cheb->N, T, U);
@@ -6802,7 +7109,65 @@ void LoadSchatten(void)
    fclose(infile);
 }
 /**********************************************************************/
-void InitSim(int argc, char **argv)
+/* Optional "Density Table" block of the Earth atmosphere model.      */
+/* Keys left out keep the defaults below.                             */
+static void InitAtmoTableInputs(struct fy_node *node)
+{
+   struct fy_node *dtNode;
+   double AltRange[2] = {100.0, 1000.0};  /* km */
+   double Spacing[3]  = {5.0, 1.0, 10.0}; /* deg lat, hr LST, km alt */
+   double Tol[2]      = {5.0, 3.0};       /* F10.7, Ap */
+   double UpdateDT    = 3600.0;           /* sec */
+
+   AtmoTable.Enabled = FALSE;
+   if (node == NULL)
+      return;
+   AtmoTable.Enabled = getYAMLBool(fy_node_by_path_def(node, "/Enabled"));
+   if (!AtmoTable.Enabled)
+      return;
+
+   dtNode = fy_node_by_path_def(node, "/Update Interval");
+   if (dtNode != NULL && !fy_node_scanf(dtNode, "/ %lf", &UpdateDT)) {
+      fprintf(stderr, "Could not read Density Table Update Interval. "
+                      "Exiting...\n");
+      exit(EXIT_FAILURE);
+   }
+   assignYAMLToDoubleArray(2, fy_node_by_path_def(node, "/Altitude Range"),
+                           AltRange);
+   assignYAMLToDoubleArray(3, fy_node_by_path_def(node, "/Grid Spacing"),
+                           Spacing);
+   assignYAMLToDoubleArray(2, fy_node_by_path_def(node, "/Index Tolerance"),
+                           Tol);
+   if (UpdateDT <= 0.0 || AltRange[0] < 0.0 || AltRange[1] <= AltRange[0] ||
+       Spacing[0] <= 0.0 || Spacing[1] <= 0.0 || Spacing[2] <= 0.0) {
+      fprintf(stderr, "Density Table needs a positive Update Interval, "
+                      "Grid Spacing and Altitude Range. Exiting...\n");
+      exit(EXIT_FAILURE);
+   }
+
+   /* Round spacing to a whole number of cells over each range.  Lat */
+   /* nodes are at cell centers, which keeps them off the poles.      */
+   AtmoTable.UpdateDT = UpdateDT;
+   AtmoTable.MinAlt   = AltRange[0] * 1.0E3;
+   AtmoTable.MaxAlt   = AltRange[1] * 1.0E3;
+   AtmoTable.Nlat     = (long)(180.0 / Spacing[0] + 0.5);
+   AtmoTable.Nlst     = (long)(24.0 / Spacing[1] + 0.5);
+   AtmoTable.Nalt = (long)((AltRange[1] - AltRange[0]) / Spacing[2] + 0.5) + 1;
+   if (AtmoTable.Nlat < 2)
+      AtmoTable.Nlat = 2;
+   if (AtmoTable.Nlst < 1)
+      AtmoTable.Nlst = 1;
+   if (AtmoTable.Nalt < 4)
+      AtmoTable.Nalt = 4;
+   AtmoTable.DLat    = PI / AtmoTable.Nlat;
+   AtmoTable.DLst    = 24.0 / AtmoTable.Nlst;
+   AtmoTable.DAlt    =
+       (AtmoTable.MaxAlt - AtmoTable.MinAlt) / (AtmoTable.Nalt - 1);
+   AtmoTable.FluxTol = Tol[0];
+   AtmoTable.ApTol   = Tol[1];
+}
+/**********************************************************************/
+void InitSim(struct SimContextType *Ctx, int argc, char **argv)
 {
    char response[120], response1[120], response2[120];
    long Iorb, Isc, i, Iw;
@@ -6814,6 +7179,8 @@ void InitSim(int argc, char **argv)
        {-0.867665382947348, -0.198076649977489, 0.455985113757595}};
    double CJH[3][3];
 
+   InitSimContext(Ctx);
+
    Pi          = PI;
    TwoPi       = TWOPI;
    HalfPi      = HALFPI;
@@ -6907,7 +7274,6 @@ void InitSim(int argc, char **argv)
    }
 
    if (CLI_ARGS.defaultdir != NULL) {
-      strcat(CLI_ARGS.defaultdir, "/");
       if (CLI_ARGS.indir == NULL) {
          strcpy(InOutPath, CLI_ARGS.defaultdir);
          strcat(InOutPath, "/InOut/");
@@ -6997,6 +7363,36 @@ void InitSim(int argc, char **argv)
    TimeMode = DecodeString(response);
    GLEnable = getYAMLBool(fy_node_by_path_def(node, "/Enable Graphics"));
 
+   /* .. Threads for per-SC updates, optional */
+   Nthreads                 = 1;
+   struct fy_node *thrdNode = fy_node_by_path_def(node, "/Threads");
+   if (thrdNode != NULL) {
+      if (!fy_node_scanf(thrdNode, "/ %ld", &Nthreads) || Nthreads < 1) {
+         fprintf(stderr, "Threads in Inp_Sim must be a positive integer. "
+                         "Exiting...\n");
+         exit(EXIT_FAILURE);
+      }
+   }
+
+   /* .. Report output format, optional */
+   OutputFormat            = OUTPUT_TEXT;
+   struct fy_node *fmtNode = fy_node_by_path_def(node, "/Output Format");
+   if (fmtNode != NULL) {
+      char fmt[20] = {0};
+      fy_node_scanf(fmtNode, "/ %19s", fmt);
+      if (!strcmp(fmt, "TEXT"))
+         OutputFormat = OUTPUT_TEXT;
+      else if (!strcmp(fmt, "BINARY"))
+         OutputFormat = OUTPUT_BINARY;
+      else if (!strcmp(fmt, "BOTH"))
+         OutputFormat = OUTPUT_TEXT | OUTPUT_BINARY;
+      else {
+         fprintf(stderr, "Output Format in Inp_Sim must be TEXT, BINARY, or "
+                         "BOTH. Exiting...\n");
+         exit(EXIT_FAILURE);
+      }
+   }
+
    if (CLI_ARGS.graphics != NULL) {
       printf("\n!!!!!! Graphics Overriden !!!!! \n");
       if (strlen(CLI_ARGS.graphics) != 1) {
@@ -7151,6 +7547,8 @@ void InitSim(int argc, char **argv)
             AtmoOption  = atmoType;
             Flux10p7    = f10p7;
             GeomagIndex = geomag;
+            InitAtmoTableInputs(
+                fy_node_by_path_def(iterNode, "/Density Table"));
             break;
          default:
             fprintf(stderr,
@@ -7203,10 +7601,22 @@ void InitSim(int argc, char **argv)
                     "Model. Exiting...\n");
             exit(EXIT_FAILURE);
          }
+         /* Optional, sec.  Coefficients are re-interpolated this often */
+         double EpochDT         = 86400.0;
+         struct fy_node *dtNode =
+             fy_node_by_path_def(iterNode, "/Coefficient Update");
+         if (dtNode != NULL) {
+            if (!fy_node_scanf(dtNode, "/ %lf", &EpochDT) || EpochDT < 0.0) {
+               fprintf(stderr, "Coefficient Update for Magnetic Field Model "
+                               "must be non-negative. Exiting...\n");
+               exit(EXIT_FAILURE);
+            }
+         }
          switch (Iw) {
             case EARTH:
-               MagModel.N = N;
-               MagModel.M = M;
+               MagModel.N       = N;
+               MagModel.M       = M;
+               MagModel.EpochDT = EpochDT;
                break;
             default:
                fprintf(stderr,
@@ -7281,10 +7691,47 @@ void InitSim(int argc, char **argv)
    SolPressActive = getYAMLBool(fy_node_by_path_def(node, "/SRP/Enabled"));
    SolPressShadowsActive =
        getYAMLBool(fy_node_by_path_def(node, "/SRP/Shadows"));
+   ShadowTableStep          = 0.0;
+   struct fy_node *stepNode = fy_node_by_path_def(node, "/Shadow Table Step");
+   if (stepNode != NULL &&
+       !fy_node_scanf(stepNode, "/ %lf", &ShadowTableStep)) {
+      fprintf(stderr, "Could not read Shadow Table Step. Exiting...\n");
+      exit(EXIT_FAILURE);
+   }
    ResidualDipoleActive =
        getYAMLBool(fy_node_by_path_def(node, "/Magnetic/Residual Mag Moment"));
    GravPertActive =
        getYAMLBool(fy_node_by_path_def(node, "/Gravitation/Enabled"));
+   PolyGravDegree          = 0;
+   PolyGravFarRatio        = 3.0;
+   PolyGravNearTol         = 0.0;
+   struct fy_node *farNode =
+       fy_node_by_path_def(node, "/Gravitation/Polyhedron Far Field");
+   if (farNode != NULL) {
+      if (!fy_node_scanf(farNode, "/Degree %ld", &PolyGravDegree) ||
+          PolyGravDegree < 0 || PolyGravDegree > 20) {
+         fprintf(stderr, "Polyhedron Far Field Degree must be 0 to 20. "
+                         "Exiting...\n");
+         exit(EXIT_FAILURE);
+      }
+      struct fy_node *ratioNode = fy_node_by_path_def(farNode, "/Radius Ratio");
+      if (ratioNode != NULL &&
+          (!fy_node_scanf(ratioNode, "/ %lf", &PolyGravFarRatio) ||
+           PolyGravFarRatio < 1.0)) {
+         fprintf(stderr, "Polyhedron Far Field Radius Ratio must be at least "
+                         "1. Exiting...\n");
+         exit(EXIT_FAILURE);
+      }
+   }
+   struct fy_node *nearNode =
+       fy_node_by_path_def(node, "/Gravitation/Polyhedron Near Field");
+   if (nearNode != NULL &&
+       (!fy_node_scanf(nearNode, "/Tolerance %lf", &PolyGravNearTol) ||
+        PolyGravNearTol < 0.0)) {
+      fprintf(stderr, "Polyhedron Near Field Tolerance must be at least 0. "
+                      "Exiting...\n");
+      exit(EXIT_FAILURE);
+   }
    ThrusterPlumesActive =
        getYAMLBool(fy_node_by_path_def(node, "/Thruster Plume"));
    ContactActive = getYAMLBool(fy_node_by_path_def(node, "/Contact"));
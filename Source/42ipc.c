@@ -36,6 +36,10 @@ void WriteToSocket(SOCKET Socket, char **Prefix, long Nprefix,
                    long EchoEnabled);
 void ReadFromFile(FILE *StateFile, long EchoEnabled);
 void ReadFromSocket(SOCKET Socket, long EchoEnabled);
+void WriteToBinSocket(struct IpcType *I);
+void ReadFromBinSocket(SOCKET Socket, long EchoEnabled);
+void WriteToShm(struct IpcType *I);
+void ReadFromShm(struct ShmLinkType *Shm, long EchoEnabled);
 
 /*********************************************************************/
 void InitInterProcessComm(void)
@@ -77,6 +81,23 @@ void InitInterProcessComm(void)
           getYAMLBool(fy_node_by_path_def(seqNode, "/Socket/Blocking"));
       I->EchoEnabled =
           getYAMLBool(fy_node_by_path_def(seqNode, "/Echo to stdout"));
+      I->Binary = 0;
+      if (fy_node_scanf(seqNode, "/Socket/Format %119s", response)) {
+         if (!strcmp(response, "BINARY"))
+            I->Binary = 1;
+         else if (strcmp(response, "TEXT")) {
+            fprintf(stderr, "Socket Format for IPC[%ld] must be TEXT or "
+                            "BINARY. Exiting...\n",
+                    Iipc);
+            exit(EXIT_FAILURE);
+         }
+      }
+      if (I->SocketRole == IPC_SHM && !I->Binary) {
+         fprintf(stderr, "Socket Role SHM for IPC[%ld] needs Socket Format "
+                         "BINARY. Exiting...\n",
+                 Iipc);
+         exit(EXIT_FAILURE);
+      }
       struct fy_node *prefixNode = fy_node_by_path_def(seqNode, "/Prefixes");
       I->Nprefix                 = fy_node_sequence_item_count(prefixNode);
       I->Prefix                  = (char **)calloc(I->Nprefix, sizeof(char *));
@@ -101,6 +122,9 @@ void InitInterProcessComm(void)
             I->Socket =
                 InitSocketClient(I->HostName, I->Port, I->AllowBlocking);
          }
+         else if (I->SocketRole == IPC_SHM) {
+            I->Shm = InitShmServer(I->Port, I->AllowBlocking);
+         }
 #ifdef _ENABLE_GMSEC_
          else if (I->SocketRole == IPC_GMSEC_CLIENT) {
             status  = statusCreate();
@@ -126,6 +150,9 @@ void InitInterProcessComm(void)
             I->Socket =
                 InitSocketClient(I->HostName, I->Port, I->AllowBlocking);
          }
+         else if (I->SocketRole == IPC_SHM) {
+            I->Shm = InitShmServer(I->Port, I->AllowBlocking);
+         }
 #ifdef _ENABLE_GMSEC_
          else if (I->SocketRole == IPC_GMSEC_CLIENT) {
             status  = statusCreate();
@@ -151,6 +178,9 @@ void InitInterProcessComm(void)
             I->Socket =
                 InitSocketClient(I->HostName, I->Port, I->AllowBlocking);
          }
+         else if (I->SocketRole == IPC_SHM) {
+            I->Shm = InitShmServer(I->Port, I->AllowBlocking);
+         }
 #ifdef _ENABLE_GMSEC_
          else if (I->SocketRole == IPC_GMSEC_CLIENT) {
             status  = statusCreate();
@@ -169,7 +199,10 @@ void InitInterProcessComm(void)
          }
       }
       else if (I->Mode == IPC_ACS) {
-         I->Socket = InitSocketServer(I->Port, I->AllowBlocking);
+         if (I->SocketRole == IPC_SHM)
+            I->Shm = InitShmServer(I->Port, I->AllowBlocking);
+         else
+            I->Socket = InitSocketServer(I->Port, I->AllowBlocking);
       }
       else if (I->Mode == IPC_WRITEFILE) {
          I->File = FileOpen(InOutPath, FileName, "wt");
@@ -186,6 +219,28 @@ void InitInterProcessComm(void)
    fy_document_destroy(fyd);
 }
 /*********************************************************************/
+/* Text or binary frames over a socket, or binary frames over shared */
+/* memory, for TX, RX, TXRX and ACS links                            */
+void WriteToLink(struct IpcType *I)
+{
+   if (I->Shm != NULL)
+      WriteToShm(I);
+   else if (I->Binary)
+      WriteToBinSocket(I);
+   else
+      WriteToSocket(I->Socket, I->Prefix, I->Nprefix, I->EchoEnabled);
+}
+/*********************************************************************/
+void ReadFromLink(struct IpcType *I)
+{
+   if (I->Shm != NULL)
+      ReadFromShm(I->Shm, I->EchoEnabled);
+   else if (I->Binary)
+      ReadFromBinSocket(I->Socket, I->EchoEnabled);
+   else
+      ReadFromSocket(I->Socket, I->EchoEnabled);
+}
+/*********************************************************************/
 void InterProcessComm(void)
 {
    struct IpcType *I;
@@ -195,7 +250,7 @@ void InterProcessComm(void)
       I = &IPC[Iipc];
       if (I->Mode == IPC_TX) {
          if (I->SocketRole != IPC_GMSEC_CLIENT) {
-            WriteToSocket(I->Socket, I->Prefix, I->Nprefix, I->EchoEnabled);
+            WriteToLink(I);
          }
 #ifdef _ENABLE_GMSEC_
          else {
@@ -206,7 +261,7 @@ void InterProcessComm(void)
       }
       else if (I->Mode == IPC_RX) {
          if (I->SocketRole != IPC_GMSEC_CLIENT) {
-            ReadFromSocket(I->Socket, I->EchoEnabled);
+            ReadFromLink(I);
          }
 #ifdef _ENABLE_GMSEC_
          else {
@@ -216,8 +271,8 @@ void InterProcessComm(void)
       }
       else if (I->Mode == IPC_TXRX) {
          if (I->SocketRole != IPC_GMSEC_CLIENT) {
-            WriteToSocket(I->Socket, I->Prefix, I->Nprefix, I->EchoEnabled);
-            ReadFromSocket(I->Socket, I->EchoEnabled);
+            WriteToLink(I);
+            ReadFromLink(I);
          }
 #ifdef _ENABLE_GMSEC_
          else {
@@ -240,6 +295,16 @@ void InterProcessComm(void)
 #endif
    }
 }
+/**********************************************************************/
+void ShutdownInterProcessComm(void)
+{
+   long Iipc;
+
+   for (Iipc = 0; Iipc < Nipc; Iipc++) {
+      CloseShmLink(IPC[Iipc].Shm);
+      IPC[Iipc].Shm = NULL;
+   }
+}
 
 /* #ifdef __cplusplus
 ** }
@@ -32,7 +32,7 @@ void ShakerJitter(struct ShakerType *Sh, struct SCType *S)
    }
 
    if (Sh->RandomActive) {
-      Signal = GaussianRandom(Sh->RandomProc);
+      Signal = GaussianStream(&Sh->Rng);
       Signal = SecondOrderLowpassFilter(Sh->Lowpass, Signal);
       if (Sh->LowBandLimit > 0.0)
          Signal = SecondOrderHighpassFilter(Sh->Highpass, Signal);
@@ -0,0 +1,535 @@
+/*    This file is distributed with 42,                               */
+/*    the (mostly harmless) spacecraft dynamics simulation            */
+/*    created by Eric Stoneking of NASA Goddard Space Flight Center   */
+
+/*    Copyright 2010 United States Government                         */
+/*    as represented by the Administrator                             */
+/*    of the National Aeronautics and Space Administration.           */
+
+/*    No copyright is claimed in the United States                    */
+/*    under Title 17, U.S. Code.                                      */
+
+/*    All Other Rights Reserved.                                      */
+
+#include "42.h"
+
+#include <pthread.h>
+
+/* #ifdef __cplusplus
+** namespace _42 {
+** using namespace Kit;
+** #endif
+*/
+
+/* Monte Carlo campaigns.  "42 -c Inp_MonteCarlo.yaml" runs Nrun cases */
+/* of the usual inputs, each with a few scalars redrawn from their     */
+/* distributions, on at most Nworker threads at once.  Each case is    */
+/* RunSimCase on a thread of its own, so it needs the REENTRANT build. */
+/* The dispersed values and per-run statistics of chosen Report.42b    */
+/* channels stream to one file, closed out by campaign statistics.     */
+
+#define MC_UNIFORM  0
+#define MC_GAUSSIAN 1
+
+/* Statistics kept per channel per run */
+#define MC_FINAL 0
+#define MC_MIN   1
+#define MC_MAX   2
+#define MC_NSTAT 3
+
+struct McDispersionType {
+   char File[64];
+   char Path[128];
+   long Distribution;
+   double Parm[2]; /* Min, Max or Mean, Sigma */
+};
+
+struct McCampaignType {
+   long Nrun;
+   long Nworker;
+   long Seed;
+   char OutDir[BUFSIZE];
+   long Ndisp;
+   struct McDispersionType *Disp;
+   long Nchan;
+   char (*Chan)[32];
+   long Npct;
+   double *Pct;
+   long Ncol;      /* Dispersed values, then MC_NSTAT per channel */
+   double *Result; /* Nrun rows of Ncol */
+   FILE *File;
+   long Nactive;
+   long Ndone;
+   pthread_mutex_t Mutex;
+   pthread_cond_t Cond;
+};
+
+struct McRunType {
+   struct McCampaignType *Mc;
+   long Irun;
+   long Nov;
+   struct YamlOverrideType *Ov;
+   int argc;
+   char **argv;
+   char OutDir[BUFSIZE];
+   long *Ichan; /* Found on the first sample */
+   long Nsample;
+   double *Stat; /* MC_NSTAT per channel */
+};
+
+/* The run on this thread, if any */
+static SIMLOCAL struct McRunType *McRun = NULL;
+
+/**********************************************************************/
+static void MakeDir(const char *Dir)
+{
+#if defined __MINGW32__
+   mkdir(Dir);
+#elif defined _WIN32
+   mkdir(Dir);
+#elif defined _WIN64
+   mkdir(Dir);
+#else
+   mkdir(Dir, 0777);
+#endif
+}
+/**********************************************************************/
+static void *McCalloc(long N, size_t Size, const char *Name)
+{
+   void *P = calloc(N > 0 ? N : 1, Size);
+
+   if (P == NULL) {
+      fprintf(stderr, "%s calloc returned null pointer.  Bailing out!\n",
+              Name);
+      exit(EXIT_FAILURE);
+   }
+   return (P);
+}
+/**********************************************************************/
+static void ReadCampaign(struct McCampaignType *Mc, const char *FileName)
+{
+   struct McDispersionType *D;
+   char Path[BUFSIZE], Dist[20];
+   const char *Name;
+   char *Slash;
+   long i;
+
+   /* Split FileName into directory and file for FileOpen */
+   snprintf(Path, sizeof(Path), "%s", FileName);
+   Slash = strrchr(Path, '/');
+   if (Slash != NULL) {
+      Slash[1] = '\0';
+      Name     = &FileName[Slash - Path + 1];
+   }
+   else {
+      strcpy(Path, "./");
+      Name = FileName;
+   }
+
+   struct fy_document *fyd  = fy_document_build_and_check(NULL, Path, Name);
+   struct fy_node *root     = fy_document_root(fyd);
+   struct fy_node *node     = fy_node_by_path_def(root, "/Campaign");
+   struct fy_node *iterNode = NULL;
+
+   if (fy_node_scanf(node,
+                     "/Runs %ld "
+                     "/Workers %ld "
+                     "/Seed %ld "
+                     "/Output Directory %998[^\n]",
+                     &Mc->Nrun, &Mc->Nworker, &Mc->Seed, Mc->OutDir) != 4 ||
+       Mc->Nrun < 1 || Mc->Nworker < 1) {
+      fprintf(stderr, "Campaign in %s is improperly configured. "
+                      "Exiting...\n",
+              Name);
+      exit(EXIT_FAILURE);
+   }
+
+   /* .. Percentiles, optional */
+   struct fy_node *pctNode = fy_node_by_path_def(node, "/Percentiles");
+   Mc->Npct                = fy_node_sequence_item_count(pctNode);
+   if (Mc->Npct < 0)
+      Mc->Npct = 0;
+   Mc->Pct = (double *)McCalloc(Mc->Npct, sizeof(double), "Mc->Pct");
+   assignYAMLToDoubleArray(Mc->Npct, pctNode, Mc->Pct);
+   for (i = 0; i < Mc->Npct; i++) {
+      if (Mc->Pct[i] < 0.0 || Mc->Pct[i] > 100.0) {
+         fprintf(stderr, "Percentiles in %s must lie in [0,100]. "
+                         "Exiting...\n",
+                 Name);
+         exit(EXIT_FAILURE);
+      }
+   }
+
+   /* .. Dispersions */
+   node      = fy_node_by_path_def(root, "/Dispersions");
+   Mc->Ndisp = fy_node_sequence_item_count(node);
+   if (Mc->Ndisp < 0)
+      Mc->Ndisp = 0;
+   Mc->Disp = (struct McDispersionType *)McCalloc(
+       Mc->Ndisp, sizeof(struct McDispersionType), "Mc->Disp");
+   i = 0;
+   WHILE_FY_ITER(node, iterNode)
+   {
+      D = &Mc->Disp[i];
+      if (fy_node_scanf(iterNode,
+                        "/File %63s "
+                        "/Path %127[^\n] "
+                        "/Distribution %19s",
+                        D->File, D->Path, Dist) != 3) {
+         fprintf(stderr, "Dispersion %ld in %s is improperly configured. "
+                         "Exiting...\n",
+                 i, Name);
+         exit(EXIT_FAILURE);
+      }
+      if (!strcmp(Dist, "UNIFORM")) {
+         D->Distribution = MC_UNIFORM;
+         if (fy_node_scanf(iterNode, "/Min %lf /Max %lf", &D->Parm[0],
+                           &D->Parm[1]) != 2) {
+            fprintf(stderr, "UNIFORM dispersion %ld in %s needs Min and Max. "
+                            "Exiting...\n",
+                    i, Name);
+            exit(EXIT_FAILURE);
+         }
+      }
+      else if (!strcmp(Dist, "GAUSSIAN")) {
+         D->Distribution = MC_GAUSSIAN;
+         if (fy_node_scanf(iterNode, "/Mean %lf /Sigma %lf", &D->Parm[0],
+                           &D->Parm[1]) != 2) {
+            fprintf(stderr, "GAUSSIAN dispersion %ld in %s needs Mean and "
+                            "Sigma. Exiting...\n",
+                    i, Name);
+            exit(EXIT_FAILURE);
+         }
+      }
+      else {
+         fprintf(stderr, "Distribution of dispersion %ld in %s must be "
+                         "UNIFORM or GAUSSIAN. Exiting...\n",
+                 i, Name);
+         exit(EXIT_FAILURE);
+      }
+      i++;
+   }
+
+   /* .. Channels */
+   node      = fy_node_by_path_def(root, "/Channels");
+   Mc->Nchan = fy_node_sequence_item_count(node);
+   if (Mc->Nchan < 0)
+      Mc->Nchan = 0;
+   Mc->Chan = (char(*)[32])McCalloc(Mc->Nchan, 32, "Mc->Chan");
+   i        = 0;
+   iterNode = NULL;
+   WHILE_FY_ITER(node, iterNode)
+   {
+      if (!fy_node_scanf(iterNode, "/ %31s", Mc->Chan[i])) {
+         fprintf(stderr, "Channel %ld in %s is not a name. Exiting...\n", i,
+                 Name);
+         exit(EXIT_FAILURE);
+      }
+      i++;
+   }
+   fy_document_destroy(fyd);
+
+   Mc->Ncol = Mc->Ndisp + MC_NSTAT * Mc->Nchan;
+}
+/**********************************************************************/
+/* Draws every run's dispersions up front.  Each (run, dispersion)    */
+/* has its own stream, so adding a dispersion or changing the worker  */
+/* count leaves the other draws alone.                                */
+static struct McRunType *PlanRuns(struct McCampaignType *Mc, int argc,
+                                  char **argv)
+{
+   struct RandomStreamType RS;
+   struct McDispersionType *D;
+   struct McRunType *Run, *R;
+   struct YamlOverrideType *O;
+   double Val;
+   long Irun, i;
+
+   Run = (struct McRunType *)McCalloc(Mc->Nrun, sizeof(struct McRunType),
+                                      "Run");
+   for (Irun = 0; Irun < Mc->Nrun; Irun++) {
+      R       = &Run[Irun];
+      R->Mc   = Mc;
+      R->Irun = Irun;
+      snprintf(R->OutDir, sizeof(R->OutDir), "%sRun%04ld", Mc->OutDir, Irun);
+
+      /* Fast time, and a sim RNG seed of its own, unless dispersed */
+      R->Nov = 2 + Mc->Ndisp;
+      R->Ov  = (struct YamlOverrideType *)McCalloc(
+          R->Nov, sizeof(struct YamlOverrideType), "R->Ov");
+      strcpy(R->Ov[0].File, "Inp_Sim.yaml");
+      strcpy(R->Ov[0].Path, "/Simulation Control/Mode");
+      strcpy(R->Ov[0].Value, "FAST");
+      strcpy(R->Ov[1].File, "Inp_Sim.yaml");
+      strcpy(R->Ov[1].Path, "/Simulation Control/RNG Seed");
+      snprintf(R->Ov[1].Value, sizeof(R->Ov[1].Value), "%ld",
+               Mc->Seed + Irun);
+      for (i = 0; i < Mc->Ndisp; i++) {
+         D = &Mc->Disp[i];
+         O = &R->Ov[2 + i];
+         InitRandomStream(&RS, Mc->Seed, Irun, RAND_DISPERSION, i, 0);
+         if (D->Distribution == MC_UNIFORM)
+            Val = D->Parm[0] + (D->Parm[1] - D->Parm[0]) * UniformStream(&RS);
+         else
+            Val = D->Parm[0] + D->Parm[1] * GaussianStream(&RS);
+         Mc->Result[Irun * Mc->Ncol + i] = Val;
+         strcpy(O->File, D->File);
+         strcpy(O->Path, D->Path);
+         snprintf(O->Value, sizeof(O->Value), "%.17g", Val);
+      }
+
+      /* Same command line, pointed at this run's output, no graphics */
+      R->argc = argc + 4;
+      R->argv = (char **)McCalloc(R->argc + 1, sizeof(char *), "R->argv");
+      for (i = 0; i < argc; i++)
+         R->argv[i] = argv[i];
+      R->argv[argc]     = "-o";
+      R->argv[argc + 1] = R->OutDir;
+      R->argv[argc + 2] = "-g";
+      R->argv[argc + 3] = "0";
+
+      R->Stat = (double *)McCalloc(MC_NSTAT * Mc->Nchan, sizeof(double),
+                                   "R->Stat");
+   }
+   return (Run);
+}
+/**********************************************************************/
+/* Called from Report on every OutFlag */
+void SampleMonteCarlo(void)
+{
+   struct McRunType *R = McRun;
+   struct McCampaignType *Mc;
+   const double *Val;
+   double *S;
+   long i;
+
+   if (R == NULL)
+      return;
+   Mc = R->Mc;
+
+   if (R->Ichan == NULL) {
+      R->Ichan = (long *)McCalloc(Mc->Nchan, sizeof(long), "R->Ichan");
+      for (i = 0; i < Mc->Nchan; i++) {
+         R->Ichan[i] = ReportChannelIndex(Mc->Chan[i]);
+         if (R->Ichan[i] < 0) {
+            fprintf(stderr, "Monte Carlo channel %s is not in the Report "
+                            "record.  Bailing out!\n",
+                    Mc->Chan[i]);
+            exit(EXIT_FAILURE);
+         }
+      }
+   }
+
+   Val = ReportChannelValues();
+   for (i = 0; i < Mc->Nchan; i++) {
+      S           = &R->Stat[MC_NSTAT * i];
+      S[MC_FINAL] = Val[R->Ichan[i]];
+      if (R->Nsample == 0 || S[MC_FINAL] < S[MC_MIN])
+         S[MC_MIN] = S[MC_FINAL];
+      if (R->Nsample == 0 || S[MC_FINAL] > S[MC_MAX])
+         S[MC_MAX] = S[MC_FINAL];
+   }
+   R->Nsample++;
+}
+/**********************************************************************/
+static void WriteCampaignHeader(struct McCampaignType *Mc)
+{
+   const char StatName[MC_NSTAT][6] = {"Final", "Min", "Max"};
+   long i, j, Icol;
+
+   fprintf(Mc->File, "%% 42 Monte Carlo campaign: %ld runs on %ld workers, "
+                     "seed %ld\n",
+           Mc->Nrun, Mc->Nworker, Mc->Seed);
+   fprintf(Mc->File, "%% Rows are in order of completion\n");
+   fprintf(Mc->File, "%% Column 1: Run\n");
+   Icol = 2;
+   for (i = 0; i < Mc->Ndisp; i++, Icol++)
+      fprintf(Mc->File, "%% Column %ld: %s %s\n", Icol, Mc->Disp[i].File,
+              Mc->Disp[i].Path);
+   for (i = 0; i < Mc->Nchan; i++) {
+      for (j = 0; j < MC_NSTAT; j++, Icol++)
+         fprintf(Mc->File, "%% Column %ld: %s %s\n", Icol, Mc->Chan[i],
+                 StatName[j]);
+   }
+   fflush(Mc->File);
+}
+/**********************************************************************/
+static void *McRunThread(void *Arg)
+{
+   struct McRunType *R       = (struct McRunType *)Arg;
+   struct McCampaignType *Mc = R->Mc;
+   struct SimContextType *Ctx;
+   double *Row;
+   long i;
+
+   Ctx = (struct SimContextType *)McCalloc(1, sizeof(struct SimContextType),
+                                           "SimContext");
+   McRun = R;
+   SetYamlOverrides(R->Ov, R->Nov);
+   RunSimCase(Ctx, R->argc, R->argv);
+   SetYamlOverrides(NULL, 0);
+   McRun = NULL;
+   free(Ctx);
+
+   pthread_mutex_lock(&Mc->Mutex);
+   Row = &Mc->Result[R->Irun * Mc->Ncol];
+   for (i = 0; i < MC_NSTAT * Mc->Nchan; i++)
+      Row[Mc->Ndisp + i] = R->Stat[i];
+   fprintf(Mc->File, "%6ld", R->Irun);
+   for (i = 0; i < Mc->Ncol; i++)
+      fprintf(Mc->File, " % .10le", Row[i]);
+   fprintf(Mc->File, "\n");
+   fflush(Mc->File);
+   Mc->Ndone++;
+   Mc->Nactive--;
+   printf("Monte Carlo run %ld done (%ld of %ld)\n", R->Irun, Mc->Ndone,
+          Mc->Nrun);
+   pthread_cond_signal(&Mc->Cond);
+   pthread_mutex_unlock(&Mc->Mutex);
+   return (NULL);
+}
+/**********************************************************************/
+static int CompareDoubles(const void *A, const void *B)
+{
+   double a = *(const double *)A;
+   double b = *(const double *)B;
+
+   return ((a > b) - (a < b));
+}
+/**********************************************************************/
+/* Min, max, mean, sigma and percentiles of every column over the     */
+/* runs.  Percentiles interpolate linearly between order statistics.  */
+static void WriteCampaignStats(struct McCampaignType *Mc)
+{
+   const char *Label[4] = {"Min", "Max", "Mean", "Sigma"};
+   double *Sorted, *Stat, Sum, Var, Rank, Frac;
+   long Nrow, Icol, Irun, i, Lo, Hi;
+
+   Nrow   = 4 + Mc->Npct;
+   Sorted = (double *)McCalloc(Mc->Nrun, sizeof(double), "Sorted");
+   Stat   = (double *)McCalloc(Nrow * Mc->Ncol, sizeof(double), "Stat");
+   for (Icol = 0; Icol < Mc->Ncol; Icol++) {
+      Sum = 0.0;
+      for (Irun = 0; Irun < Mc->Nrun; Irun++) {
+         Sorted[Irun] = Mc->Result[Irun * Mc->Ncol + Icol];
+         Sum         += Sorted[Irun];
+      }
+      qsort(Sorted, Mc->Nrun, sizeof(double), CompareDoubles);
+      Var = 0.0;
+      for (Irun = 0; Irun < Mc->Nrun; Irun++)
+         Var += (Sorted[Irun] - Sum / Mc->Nrun) *
+                (Sorted[Irun] - Sum / Mc->Nrun);
+      Stat[0 * Mc->Ncol + Icol] = Sorted[0];
+      Stat[1 * Mc->Ncol + Icol] = Sorted[Mc->Nrun - 1];
+      Stat[2 * Mc->Ncol + Icol] = Sum / Mc->Nrun;
+      Stat[3 * Mc->Ncol + Icol] =
+          (Mc->Nrun > 1 ? sqrt(Var / (Mc->Nrun - 1)) : 0.0);
+      for (i = 0; i < Mc->Npct; i++) {
+         Rank = 0.01 * Mc->Pct[i] * (Mc->Nrun - 1);
+         Lo   = (long)Rank;
+         Hi   = (Lo + 1 < Mc->Nrun ? Lo + 1 : Lo);
+         Frac = Rank - Lo;
+
+         Stat[(4 + i) * Mc->Ncol + Icol] =
+             (1.0 - Frac) * Sorted[Lo] + Frac * Sorted[Hi];
+      }
+   }
+
+   fprintf(Mc->File, "%% Statistics over %ld runs, by column from 2\n",
+           Mc->Nrun);
+   for (i = 0; i < Nrow; i++) {
+      if (i < 4)
+         fprintf(Mc->File, "%% %-5s", Label[i]);
+      else
+         fprintf(Mc->File, "%% P%-4g", Mc->Pct[i - 4]);
+      for (Icol = 0; Icol < Mc->Ncol; Icol++)
+         fprintf(Mc->File, " % .10le", Stat[i * Mc->Ncol + Icol]);
+      fprintf(Mc->File, "\n");
+   }
+   fflush(Mc->File);
+   free(Stat);
+   free(Sorted);
+}
+/**********************************************************************/
+int RunMonteCarlo(int argc, char **argv, const char *FileName)
+{
+   struct McCampaignType *Mc;
+   struct McRunType *Run;
+   pthread_attr_t Attr;
+   pthread_t Thread;
+   DocoptArgs Args;
+   long Irun;
+
+   Mc = (struct McCampaignType *)McCalloc(1, sizeof(struct McCampaignType),
+                                          "Campaign");
+   ReadCampaign(Mc, FileName);
+#ifndef _REENTRANT_SIM_
+   fprintf(stderr, "Monte Carlo campaigns need per-thread sim state.  "
+                   "Rebuild with REENTRANT on.  Exiting...\n");
+   exit(EXIT_FAILURE);
+#endif
+
+   /* --outdir overrides the campaign's Output Directory */
+   Args = docopt(argc, argv, /* help */ 1);
+   if (Args.outdir != NULL)
+      snprintf(Mc->OutDir, sizeof(Mc->OutDir) - 1, "%s", Args.outdir);
+   if (Mc->OutDir[strlen(Mc->OutDir) - 1] != '/')
+      strcat(Mc->OutDir, "/");
+   MakeDir(Mc->OutDir);
+   Mc->File = FileOpen(Mc->OutDir, "MonteCarlo.42", "w");
+
+   Mc->Result = (double *)McCalloc(Mc->Nrun * Mc->Ncol, sizeof(double),
+                                   "Mc->Result");
+   Run        = PlanRuns(Mc, argc, argv);
+   WriteCampaignHeader(Mc);
+
+   pthread_mutex_init(&Mc->Mutex, NULL);
+   pthread_cond_init(&Mc->Cond, NULL);
+   pthread_attr_init(&Attr);
+   pthread_attr_setdetachstate(&Attr, PTHREAD_CREATE_DETACHED);
+   /* Sim state is thread-local, so a run gets a fresh thread */
+   for (Irun = 0; Irun < Mc->Nrun; Irun++) {
+      pthread_mutex_lock(&Mc->Mutex);
+      while (Mc->Nactive >= Mc->Nworker)
+         pthread_cond_wait(&Mc->Cond, &Mc->Mutex);
+      Mc->Nactive++;
+      pthread_mutex_unlock(&Mc->Mutex);
+      if (pthread_create(&Thread, &Attr, McRunThread, &Run[Irun])) {
+         fprintf(stderr, "Could not start Monte Carlo run %ld.  Bailing "
+                         "out!\n",
+                 Irun);
+         exit(EXIT_FAILURE);
+      }
+   }
+   pthread_mutex_lock(&Mc->Mutex);
+   while (Mc->Nactive > 0)
+      pthread_cond_wait(&Mc->Cond, &Mc->Mutex);
+   pthread_mutex_unlock(&Mc->Mutex);
+   pthread_attr_destroy(&Attr);
+
+   WriteCampaignStats(Mc);
+   fclose(Mc->File);
+   printf("Monte Carlo campaign of %ld runs written to %sMonteCarlo.42\n",
+          Mc->Nrun, Mc->OutDir);
+
+   for (Irun = 0; Irun < Mc->Nrun; Irun++) {
+      free(Run[Irun].Ov);
+      free(Run[Irun].argv);
+      free(Run[Irun].Ichan);
+      free(Run[Irun].Stat);
+   }
+   free(Run);
+   pthread_cond_destroy(&Mc->Cond);
+   pthread_mutex_destroy(&Mc->Mutex);
+   free(Mc->Result);
+   free(Mc->Chan);
+   free(Mc->Disp);
+   free(Mc->Pct);
+   free(Mc);
+   return (0);
+}
+
+/* #ifdef __cplusplus
+** }
+** #endif
+*/
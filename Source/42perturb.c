@@ -73,31 +73,135 @@ long ClipEdgeAgainstPlane(double V1[3], double V2[3], double A[3], double B[3],
    return (Nout);
 }
 /*********************************************************************/
+static void *SilRealloc(void *Ptr, size_t Size)
+{
+   Ptr = realloc(Ptr, Size);
+   if (Ptr == NULL) {
+      fprintf(stderr, "FindUnshadedAreas realloc returned null pointer.  "
+                      "Bailing out!\n");
+      exit(EXIT_FAILURE);
+   }
+   return (Ptr);
+}
+/*********************************************************************/
+static long SilGrowCap(long Cap, long Need)
+{
+   if (Cap < 64)
+      Cap = 64;
+   while (Cap < Need)
+      Cap *= 2;
+   return (Cap);
+}
+/*********************************************************************/
+static void ReserveSilEdges(struct SilArenaType *A, long Need)
+{
+   if (Need <= A->EdgeCap)
+      return;
+   A->EdgeCap = SilGrowCap(A->EdgeCap, Need);
+   A->HashCap = 2 * A->EdgeCap;
+   A->Order   = (long *)SilRealloc(A->Order, A->EdgeCap * sizeof(long));
+   A->Pos     = (long *)SilRealloc(A->Pos, A->EdgeCap * sizeof(long));
+   A->Next    = (long *)SilRealloc(A->Next, A->EdgeCap * sizeof(long));
+   A->Match   = (long *)SilRealloc(A->Match, A->EdgeCap * sizeof(long));
+   A->Head    = (long *)SilRealloc(A->Head, A->HashCap * sizeof(long));
+   A->Edge    = (struct SilEdgeType *)SilRealloc(
+       A->Edge, A->EdgeCap * sizeof(struct SilEdgeType));
+}
+/*********************************************************************/
+static void ReserveSilVtx(struct SilArenaType *A, long Need)
+{
+   if (Need <= A->VtxCap)
+      return;
+   A->VtxCap = SilGrowCap(A->VtxCap, Need);
+   A->Pu     = (double *)SilRealloc(A->Pu, A->VtxCap * sizeof(double));
+   A->Pv     = (double *)SilRealloc(A->Pv, A->VtxCap * sizeof(double));
+   A->Vtx    = (struct SilVtxType *)SilRealloc(
+       A->Vtx, A->VtxCap * sizeof(struct SilVtxType));
+}
+/*********************************************************************/
+static struct SilVtxType *ReserveClipVtx(struct SilArenaType *A, long Ibuf,
+                                         long Need)
+{
+   if (Need > A->ClipCap[Ibuf]) {
+      A->ClipCap[Ibuf] = SilGrowCap(A->ClipCap[Ibuf], Need);
+      A->Clip[Ibuf]    = (struct SilVtxType *)SilRealloc(
+          A->Clip[Ibuf], A->ClipCap[Ibuf] * sizeof(struct SilVtxType));
+   }
+   return (A->Clip[Ibuf]);
+}
+/*********************************************************************/
+void FreeSilArena(struct SilArenaType *A)
+{
+   free(A->Edge);
+   free(A->Order);
+   free(A->Pos);
+   free(A->Next);
+   free(A->Match);
+   free(A->Head);
+   free(A->Vtx);
+   free(A->Pu);
+   free(A->Pv);
+   free(A->Clip[0]);
+   free(A->Clip[1]);
+   memset(A, 0, sizeof(struct SilArenaType));
+}
+/*********************************************************************/
+static long SilHash(long Body, long Iv, long Mask)
+{
+   return ((long)(((unsigned long)Iv * 2654435761UL + (unsigned long)Body) &
+                  (unsigned long)Mask));
+}
+/*********************************************************************/
+/* Distance of Pt above the plane through Org, measured along DirVec */
+static double HeightAlongDir(const double Pt[3], const double Org[3],
+                             const double Norm[3], double DoN)
+{
+   return (((Pt[0] - Org[0]) * Norm[0] + (Pt[1] - Org[1]) * Norm[1] +
+            (Pt[2] - Org[2]) * Norm[2]) /
+           DoN);
+}
+/*********************************************************************/
+static void SetSilVtx(struct SilVtxType *V, long Body, const double PosB[3],
+                      const double PosN[3])
+{
+   long i;
+
+   V->Body = Body;
+   for (i = 0; i < 3; i++) {
+      V->PosB[i] = PosB[i];
+      V->PosN[i] = PosN[i];
+   }
+}
+/*********************************************************************/
 void FindUnshadedAreas(struct SCType *S, double DirVecN[3])
 {
-   struct SilEdgeType *SilEdge = NULL, SwapEdge, *SE = NULL;
-   struct SilVtxType *SilVtx  = NULL;
-   struct SilVtxType *InVtx   = NULL;
-   struct SilVtxType *ClipVtx = NULL;
-   struct BodyType *B         = NULL;
-   struct GeomType *G         = NULL;
-   struct EdgeType *E         = NULL;
-   struct PolyType *P         = NULL;
+   struct SilArenaType *A      = &S->Sil;
+   struct SilEdgeType *SE      = NULL, *E0, *E1;
+   struct SilVtxType *SilVtx   = NULL;
+   struct SilVtxType *InVtx    = NULL;
+   struct SilVtxType *ClipVtx  = NULL;
+   struct BodyType *B          = NULL;
+   struct GeomType *G          = NULL;
+   struct EdgeType *E          = NULL;
+   struct PolyType *P          = NULL;
    double DirVecB[3], DoN1, DoN2;
    double Vtx[3][3], V1[3], V2[3], OutVtx[2][3];
    double ClipArea, ClipCtr[3], rA[3], ProjPtN[3], Bary[4];
    double PtA[3], PtB[3], PtC[3], dV1[3], dV2[3], V1xV2[3], dA;
-   long SilNe, SilNv, SilNc = 0, SilNin, Nout;
-   long Ib, Ie, Je, Ipoly, i, Ic, Iout, Iv;
-   double pn[3];
-   long B1, B2;
-
-   ClipVtx = (struct SilVtxType *)calloc(1, sizeof(struct SilVtxType));
+   double Up[3], Vp[3], NormN[3], DoN, h1, h2, Margin;
+   double TriU[2], TriV[2], HullU[2], HullV[2], u, v;
+   long SilNe, SilNv, SilNc = 0, SilNin, Nout, Ntot;
+   long Ib, Ie, Je, Ipoly, i, Ic, Iout, Iv, Nm, Ibuf, Slot, Mask;
+   long B1, B2, Hit, Nhull, Iend;
 
    /* .. Form Silhouette */
    /* TODO: This handles self-shadowing.  Extend to shadowing by other S/C in
     * same Orb */
    /* Form list of edges */
+   Ntot = 0;
+   for (Ib = 0; Ib < S->Nb; Ib++)
+      Ntot += Geom[S->B[Ib].GeomTag].Nedge;
+   ReserveSilEdges(A, Ntot);
    SilNe = 0;
    for (Ib = 0; Ib < S->Nb; Ib++) {
       B = &S->B[Ib];
@@ -108,15 +212,7 @@ void FindUnshadedAreas(struct SCType *S, double DirVecN[3])
          DoN1 = VoV(DirVecB, G->Poly[E->Poly1].Norm);
          DoN2 = VoV(DirVecB, G->Poly[E->Poly2].Norm);
          if ((DoN1 > 0.0 && DoN2 <= 0.0) || (DoN1 <= 0.0 && DoN2 > 0.0)) {
-            if (SilNe == 0) {
-               SilEdge =
-                   (struct SilEdgeType *)calloc(1, sizeof(struct SilEdgeType));
-            }
-            else {
-               SilEdge = (struct SilEdgeType *)realloc(
-                   SilEdge, (SilNe + 1) * sizeof(struct SilEdgeType));
-            }
-            SE       = &SilEdge[SilNe];
+            SE       = &A->Edge[SilNe];
             SE->Body = Ib;
             if (DoN1 > 0.0) {
                SE->Iv1 = E->Vtx1;
@@ -144,62 +240,77 @@ void FindUnshadedAreas(struct SCType *S, double DirVecN[3])
          }
       }
    }
-   /* Put list of edges in sequence */
+   /* Put list of edges in sequence.  Each edge's successor is found  */
+   /* through a hash on (Body, Iv1), then swapped into the next slot  */
+   /* just as a forward scan of the rest of the list would have done. */
+   Mask = A->HashCap - 1;
+   for (Slot = 0; Slot <= Mask; Slot++)
+      A->Head[Slot] = -1;
+   for (Ie = SilNe - 1; Ie >= 0; Ie--) {
+      Slot          = SilHash(A->Edge[Ie].Body, A->Edge[Ie].Iv1, Mask);
+      A->Next[Ie]   = A->Head[Slot];
+      A->Head[Slot] = Ie;
+      A->Order[Ie]  = Ie;
+      A->Pos[Ie]    = Ie;
+   }
    for (Ie = 0; Ie < SilNe - 1; Ie++) {
-      for (Je = Ie + 1; Je < SilNe; Je++) {
-         if (SilEdge[Je].Body == SilEdge[Ie].Body &&
-             SilEdge[Je].Iv1 == SilEdge[Ie].Iv2) {
-            memcpy(&SwapEdge, &SilEdge[Je], sizeof(struct SilEdgeType));
-            memcpy(&SilEdge[Je], &SilEdge[Ie + 1], sizeof(struct SilEdgeType));
-            memcpy(&SilEdge[Ie + 1], &SwapEdge, sizeof(struct SilEdgeType));
+      E0   = &A->Edge[A->Order[Ie]];
+      Slot = SilHash(E0->Body, E0->Iv2, Mask);
+      Nm   = 0;
+      for (Je = A->Head[Slot]; Je >= 0; Je = A->Next[Je]) {
+         if (A->Pos[Je] > Ie && A->Edge[Je].Body == E0->Body &&
+             A->Edge[Je].Iv1 == E0->Iv2) {
+            /* Keep matches in sequence order */
+            for (i = Nm; i > 0 && A->Pos[A->Match[i - 1]] > A->Pos[Je]; i--)
+               A->Match[i] = A->Match[i - 1];
+            A->Match[i] = Je;
+            Nm++;
          }
       }
+      for (i = 0; i < Nm; i++) {
+         Je                   = A->Pos[A->Match[i]];
+         A->Order[Je]         = A->Order[Ie + 1];
+         A->Order[Ie + 1]     = A->Match[i];
+         A->Pos[A->Order[Je]] = Je;
+         A->Pos[A->Match[i]]  = Ie + 1;
+      }
    }
    /* Form list of vertices, closing loops as needed */
-   SilVtx         = (struct SilVtxType *)calloc(1, sizeof(struct SilVtxType));
-   SilNv          = 1;
-   SilVtx[0].Body = SilEdge[0].Body;
-   for (i = 0; i < 3; i++) {
-      SilVtx[0].PosB[i] = SilEdge[0].PosV1B[i];
-      SilVtx[0].PosN[i] = SilEdge[0].PosV1N[i];
-   }
-   for (Ie = 0; Ie < SilNe - 1; Ie++) {
-      if (SilEdge[Ie + 1].Body == SilEdge[Ie].Body &&
-          SilEdge[Ie + 1].Iv1 == SilEdge[Ie].Iv2) {
-         SilVtx = (struct SilVtxType *)realloc(
-             SilVtx, (SilNv + 1) * sizeof(struct SilVtxType));
-         SilVtx[SilNv].Body = SilEdge[Ie].Body;
-         for (i = 0; i < 3; i++) {
-            SilVtx[SilNv].PosB[i] = SilEdge[Ie].PosV2B[i];
-            SilVtx[SilNv].PosN[i] = SilEdge[Ie].PosV2N[i];
-         }
-         SilNv++;
-      }
-      else {
-         SilVtx = (struct SilVtxType *)realloc(
-             SilVtx, (SilNv + 2) * sizeof(struct SilVtxType));
-         SilVtx[SilNv].Body = SilEdge[Ie].Body;
-         for (i = 0; i < 3; i++) {
-            SilVtx[SilNv].PosB[i] = SilEdge[Ie].PosV2B[i];
-            SilVtx[SilNv].PosN[i] = SilEdge[Ie].PosV2N[i];
-         }
-         SilNv++;
-         SilVtx[SilNv].Body = SilEdge[Ie + 1].Body;
-         for (i = 0; i < 3; i++) {
-            SilVtx[SilNv].PosB[i] = SilEdge[Ie + 1].PosV1B[i];
-            SilVtx[SilNv].PosN[i] = SilEdge[Ie + 1].PosV1N[i];
-         }
-         SilNv++;
+   ReserveSilVtx(A, 2 * SilNe + 1);
+   SilVtx = A->Vtx;
+   SilNv  = 0;
+   if (SilNe > 0) {
+      E0 = &A->Edge[A->Order[0]];
+      SetSilVtx(&SilVtx[SilNv++], E0->Body, E0->PosV1B, E0->PosV1N);
+      for (Ie = 0; Ie < SilNe - 1; Ie++) {
+         E0 = &A->Edge[A->Order[Ie]];
+         E1 = &A->Edge[A->Order[Ie + 1]];
+         SetSilVtx(&SilVtx[SilNv++], E0->Body, E0->PosV2B, E0->PosV2N);
+         if (E1->Body != E0->Body || E1->Iv1 != E0->Iv2)
+            SetSilVtx(&SilVtx[SilNv++], E1->Body, E1->PosV1B, E1->PosV1N);
       }
+      E0 = &A->Edge[A->Order[SilNe - 1]];
+      SetSilVtx(&SilVtx[SilNv++], E0->Body, E0->PosV2B, E0->PosV2N);
    }
-   SilVtx = (struct SilVtxType *)realloc(SilVtx, (SilNv + 1) *
-                                                     sizeof(struct SilVtxType));
-   SilVtx[SilNv].Body = SilEdge[SilNe - 1].Body;
-   for (i = 0; i < 3; i++) {
-      SilVtx[SilNv].PosB[i] = SilEdge[SilNe - 1].PosV2B[i];
-      SilVtx[SilNv].PosN[i] = SilEdge[SilNe - 1].PosV2N[i];
+
+   /* .. Silhouette projected onto plane normal to DirVecN, for culling */
+   i = 0;
+   if (fabs(DirVecN[1]) < fabs(DirVecN[i]))
+      i = 1;
+   if (fabs(DirVecN[2]) < fabs(DirVecN[i]))
+      i = 2;
+   Vp[0] = 0.0;
+   Vp[1] = 0.0;
+   Vp[2] = 0.0;
+   Vp[i] = 1.0;
+   VxV(DirVecN, Vp, Up);
+   UNITV(Up);
+   VxV(DirVecN, Up, Vp);
+   UNITV(Vp);
+   for (Iv = 0; Iv < SilNv; Iv++) {
+      A->Pu[Iv] = VoV(Up, SilVtx[Iv].PosN);
+      A->Pv[Iv] = VoV(Vp, SilVtx[Iv].PosN);
    }
-   SilNv++;
 
    /* .. Find unshaded areas, centroids */
    for (Ib = 0; Ib < S->Nb; Ib++) {
@@ -219,52 +330,104 @@ void FindUnshadedAreas(struct SCType *S, double DirVecN[3])
                Vtx[2][i] += B->pn[i];
             }
 
-            /* Clip Silhouette against Poly */
-            if (SilNv > 0) {
-               free(InVtx);
-               InVtx = (struct SilVtxType *)calloc(SilNv,
-                                                   sizeof(struct SilVtxType));
-               memcpy(InVtx, SilVtx, SilNv * sizeof(struct SilVtxType));
+            /* Broad phase.  The clipper keeps only silhouette edges     */
+            /* with both ends above the poly's plane (toward DirVecN),   */
+            /* and what it keeps lies within their hull.  If that hull's */
+            /* footprint misses the poly's, nothing can be clipped.      */
+            Hit = 0;
+            if (SilNv > 2) {
+               MTxV(B->CN, P->Norm, NormN);
+               DoN = VoV(DirVecN, NormN);
+               if (DoN <= 0.0)
+                  Hit = 1;
+               TriU[0] = VoV(Up, Vtx[0]);
+               TriU[1] = TriU[0];
+               TriV[0] = VoV(Vp, Vtx[0]);
+               TriV[1] = TriV[0];
+               for (Iv = 1; Iv < 3; Iv++) {
+                  u       = VoV(Up, Vtx[Iv]);
+                  v       = VoV(Vp, Vtx[Iv]);
+                  TriU[0] = (u < TriU[0] ? u : TriU[0]);
+                  TriU[1] = (u > TriU[1] ? u : TriU[1]);
+                  TriV[0] = (v < TriV[0] ? v : TriV[0]);
+                  TriV[1] = (v > TriV[1] ? v : TriV[1]);
+               }
+               Margin = 1.0E-5 * (TriU[1] - TriU[0] + TriV[1] - TriV[0]) +
+                        1.0E-9;
+               Nhull  = 0;
+               for (Ie = 0; Ie < SilNv && !Hit; Ie++) {
+                  Je = (Ie + 1) % SilNv;
+                  if (SilVtx[Ie].Body != SilVtx[Je].Body)
+                     continue;
+                  h1 = HeightAlongDir(SilVtx[Ie].PosN, Vtx[0], NormN, DoN);
+                  h2 = HeightAlongDir(SilVtx[Je].PosN, Vtx[0], NormN, DoN);
+                  if (h1 > 0.5E-6 && h2 > 0.5E-6) {
+                     if (Nhull++ == 0) {
+                        HullU[0] = A->Pu[Ie];
+                        HullU[1] = HullU[0];
+                        HullV[0] = A->Pv[Ie];
+                        HullV[1] = HullV[0];
+                     }
+                     for (Iend = 0; Iend < 2; Iend++) {
+                        Iv       = (Iend == 0 ? Ie : Je);
+                        u        = A->Pu[Iv];
+                        v        = A->Pv[Iv];
+                        HullU[0] = (u < HullU[0] ? u : HullU[0]);
+                        HullU[1] = (u > HullU[1] ? u : HullU[1]);
+                        HullV[0] = (v < HullV[0] ? v : HullV[0]);
+                        HullV[1] = (v > HullV[1] ? v : HullV[1]);
+                     }
+                     Hit = HullU[1] > TriU[0] - Margin &&
+                           HullU[0] < TriU[1] + Margin &&
+                           HullV[1] > TriV[0] - Margin &&
+                           HullV[0] < TriV[1] + Margin;
+                  }
+               }
             }
-            SilNin = SilNv;
-            for (Iv = 0; Iv < 3; Iv++) {
-               if (SilNin > 2) {
-                  SilNc = 0;
-                  for (Ie = 0; Ie < SilNin; Ie++) {
-                     B1 = InVtx[Ie].Body;
-                     B2 = InVtx[(Ie + 1) % SilNin].Body;
-                     if (B1 == B2) { /* Skip edges that jump between bodies */
-                        for (i = 0; i < 3; i++) {
-                           V1[i] = InVtx[Ie].PosN[i];
-                           V2[i] = InVtx[(Ie + 1) % SilNin].PosN[i];
-                        }
-                        Nout = ClipEdgeAgainstPlane(
-                            V1, V2, Vtx[Iv], Vtx[(Iv + 1) % 3],
-                            Vtx[(Iv + 2) % 3], DirVecN, OutVtx);
-                        if (Nout > 0) {
-                           ClipVtx = (struct SilVtxType *)realloc(
-                               ClipVtx,
-                               (SilNc + Nout) * sizeof(struct SilVtxType));
+
+            /* Clip Silhouette against Poly */
+            SilNc = 0;
+            if (Hit) {
+               InVtx  = SilVtx;
+               SilNin = SilNv;
+               Ibuf   = 0;
+               for (Iv = 0; Iv < 3; Iv++) {
+                  if (SilNin > 2) {
+                     ClipVtx = ReserveClipVtx(A, Ibuf, 2 * SilNin);
+                     SilNc   = 0;
+                     for (Ie = 0; Ie < SilNin; Ie++) {
+                        B1 = InVtx[Ie].Body;
+                        B2 = InVtx[(Ie + 1) % SilNin].Body;
+                        /* Skip edges that jump between bodies */
+                        if (B1 == B2) {
+                           for (i = 0; i < 3; i++) {
+                              V1[i] = InVtx[Ie].PosN[i];
+                              V2[i] = InVtx[(Ie + 1) % SilNin].PosN[i];
+                           }
+                           /* Edges not wholly above the poly give nothing */
+                           if (DoN > 0.0) {
+                              h1 = HeightAlongDir(V1, Vtx[0], NormN, DoN);
+                              h2 = HeightAlongDir(V2, Vtx[0], NormN, DoN);
+                              if (h1 < 0.5E-6 || h2 < 0.5E-6)
+                                 continue;
+                           }
+                           Nout = ClipEdgeAgainstPlane(
+                               V1, V2, Vtx[Iv], Vtx[(Iv + 1) % 3],
+                               Vtx[(Iv + 2) % 3], DirVecN, OutVtx);
                            for (Iout = 0; Iout < Nout; Iout++) {
-                              ClipVtx[SilNc + Iout].Body = B1;
-                              for (i = 0; i < 3; i++) {
-                                 ClipVtx[SilNc + Iout].PosN[i] =
-                                     OutVtx[Iout][i];
-                                 pn[i] = OutVtx[Iout][i] - S->B[B1].pn[i];
-                              }
-                              MxV(S->B[B1].CN, pn, ClipVtx[SilNc + Iout].PosB);
+                              ClipVtx[SilNc].Body = B1;
+                              for (i = 0; i < 3; i++)
+                                 ClipVtx[SilNc].PosN[i] = OutVtx[Iout][i];
+                              SilNc++;
                            }
-                           SilNc += Nout;
                         }
                      }
+                     if (SilNc > 0) {
+                        InVtx = ClipVtx;
+                        Ibuf  = 1 - Ibuf;
+                     }
+                     SilNin = SilNc;
                   }
-                  if (SilNc > 0) {
-                     free(InVtx);
-                     InVtx = (struct SilVtxType *)calloc(
-                         SilNc, sizeof(struct SilVtxType));
-                     memcpy(InVtx, ClipVtx, SilNc * sizeof(struct SilVtxType));
-                  }
-                  SilNin = SilNc;
                }
             }
 
@@ -311,24 +474,19 @@ void FindUnshadedAreas(struct SCType *S, double DirVecN[3])
                   ClipCtr[i] = rA[i] / ClipArea;
             }
             if (ClipArea < P->Area) {
-               P->UnshadedArea = P->Area - ClipArea;
+               B->UnshadedArea[Ipoly] = P->Area - ClipArea;
                for (i = 0; i < 3; i++) {
-                  P->UnshadedCtr[i] =
+                  B->UnshadedCtr[i][Ipoly] =
                       (P->Area * P->Centroid[i] - ClipArea * ClipCtr[i]) /
-                      P->UnshadedArea;
+                      B->UnshadedArea[Ipoly];
                }
             }
             else {
-               P->UnshadedArea = 0.0;
+               B->UnshadedArea[Ipoly] = 0.0;
             }
          }
       }
    }
-
-   free(SilEdge);
-   free(SilVtx);
-   free(InVtx);
-   free(ClipVtx);
 }
 
 /**********************************************************************/
@@ -518,118 +676,553 @@ void GravPertForce(struct SCType *S)
    /* else if O->CenterType == MINORBODY, use provided gravity model */
 }
 /**********************************************************************/
-void GravPertForceRK4(struct SCType *S, double u[6], double FrcN[3],
-                      double RKFdt)
+/* Third-body ephemerides are the same for every SC at a given RK4    */
+/* stage time, so GravPertStages looks them up once per (stage time,  */
+/* orbit center) before the per-SC Dynamics phase.  The table is      */
+/* read-only while that phase runs.  A stage missing from it (an SC   */
+/* that restarts its step mid-phase) is looked up directly.           */
+struct GravStageType {
+   double JD;
+   long World;       /* Orbit center */
+   double PriMerAng; /* Of World */
+   long Nbody;
+   long Body[NWORLD];
+   double p[NWORLD][3]; /* Third bodies, in World's N frame */
+};
+static SIMLOCAL struct GravStageType *GravStage = NULL;
+static SIMLOCAL long NgravStage                 = 0;
+static SIMLOCAL long NgravStageAlloc            = 0;
+/**********************************************************************/
+static double Rk4StageJD(double RKFdt)
 {
-   struct OrbitType *O;
-   double ph[3], p[3], s[3], SCPosN[3] = {0}, FrcNtemp[3] = {0};
-   double FrcN_harm[3] = {0}, SCPosN_harm[3] = {0};
-   double RK4TIME;
-   long Iw, Im, j;
-   long OrbCenter, SecCenter;
+   return (TDB.JulDay + RKFdt / 86400.0L);
+}
+/**********************************************************************/
+static void StageEphems(double JD, long Iw, double PosN[3], double PosH[3],
+                        double *PriMerAng, double CNH[3][3])
+{
+   if (EphemOption == EPH_SPICE)
+      Rk4SpiceEphems(JD, Iw, PosN, PosH, PriMerAng, CNH);
+   else
+      Rk4JplEphems(JD, Iw, PosN, PosH, PriMerAng, CNH);
+}
+/**********************************************************************/
+/* Sun and all existing planets, then moons of OrbCenter, in the      */
+/* order their forces have always been summed                         */
+static void FillGravStage(struct GravStageType *G, double JD, long OrbCenter)
+{
+   struct WorldType *WCenter = &World[OrbCenter];
    double trgtPosN[3], trgtPosH[3], trgtPriMerAng = 0, trgtCNH[3][3] = {0};
-   double cntrPosN[3], cntrPosH[3], cntrPriMerAng = 0, cntrCNH[3][3] = {0};
-   long revertCHEB = 0;
-
-   for (j = 0; j < 3; j++) {
-      SCPosN[j]      = u[j];
-      SCPosN_harm[j] = u[j];
-   }
-
-   RK4TIME = TDB.JulDay + RKFdt / 86400.0L;
-   if (EphemOption != EPH_SPICE) {
-      if (RK4TIME > World[SOL].eph.Cheb[1].JD2) {
-         revertCHEB = 1;
-         LoadJplEphems(ModelPath, RK4TIME);
-      }
-   }
-
-   O         = &Orb[S->RefOrb];
-   OrbCenter = O->World;
-   SecCenter = -1; /* Nonsense value */
+   double cntrPosN[3], cntrPosH[3], cntrCNH[3][3] = {0};
+   double ph[3];
+   long Iw, Im, j;
 
-   struct WorldType *WCenter = &World[OrbCenter];
-   if (EphemOption == EPH_SPICE) {
-      Rk4SpiceEphems(RK4TIME, OrbCenter, cntrPosN, cntrPosH, &cntrPriMerAng,
-                     cntrCNH);
-   }
-   else {
-      Rk4JplEphems(RK4TIME, OrbCenter, cntrPosN, cntrPosH, &cntrPriMerAng,
-                   cntrCNH);
-   }
+   G->JD        = JD;
+   G->World     = OrbCenter;
+   G->PriMerAng = 0.0;
+   G->Nbody     = 0;
+   StageEphems(JD, OrbCenter, cntrPosN, cntrPosH, &G->PriMerAng, cntrCNH);
 
-   /* Sun and all existing planets */
    for (Iw = SOL; Iw <= PLUTO; Iw++) {
-      if (World[Iw].Exists && !(Iw == OrbCenter || Iw == SecCenter)) {
-         if (EphemOption == EPH_SPICE) {
-            Rk4SpiceEphems(RK4TIME, Iw, trgtPosN, trgtPosH, &trgtPriMerAng,
-                           trgtCNH);
-         }
-         else {
-            Rk4JplEphems(RK4TIME, Iw, trgtPosN, trgtPosH, &trgtPriMerAng,
-                         trgtCNH);
-         }
+      if (World[Iw].Exists && Iw != OrbCenter) {
+         StageEphems(JD, Iw, trgtPosN, trgtPosH, &trgtPriMerAng, trgtCNH);
          for (j = 0; j < 3; j++)
             ph[j] = trgtPosH[j] - cntrPosH[j];
-         MxV(cntrCNH, ph, p);
-         for (j = 0; j < 3; j++)
-            s[j] = p[j] - SCPosN[j];
-         ThirdBodyGravForce(p, s, World[Iw].mu, S->mass, FrcNtemp);
-         for (j = 0; j < 3; j++)
-            FrcN[j] += FrcNtemp[j];
+         MxV(cntrCNH, ph, G->p[G->Nbody]);
+         G->Body[G->Nbody++] = Iw;
       }
    }
 
-   /* Moons of OrbCenter (but not SecCenter) */
    if (OrbCenter != SOL) {
       for (Im = 0; Im < WCenter->Nsat; Im++) {
          Iw = WCenter->Sat[Im];
-         if (Iw != SecCenter) {
-            if (EphemOption == EPH_SPICE) {
-               Rk4SpiceEphems(RK4TIME, Iw, trgtPosN, trgtPosH, &trgtPriMerAng,
-                              trgtCNH);
-            }
-            else {
-               Rk4JplEphems(RK4TIME, Iw, trgtPosN, trgtPosH, &trgtPriMerAng,
-                            trgtCNH);
-            }
-            for (j = 0; j < 3; j++) {
-               p[j] = trgtPosN[j];
-               s[j] = p[j] - SCPosN[j];
+         StageEphems(JD, Iw, trgtPosN, trgtPosH, &trgtPriMerAng, trgtCNH);
+         for (j = 0; j < 3; j++)
+            G->p[G->Nbody][j] = trgtPosN[j];
+         G->Body[G->Nbody++] = Iw;
+      }
+   }
+}
+/**********************************************************************/
+static struct GravStageType *FindGravStage(double JD, long OrbCenter)
+{
+   long Ig;
+
+   for (Ig = 0; Ig < NgravStage; Ig++) {
+      if (GravStage[Ig].JD == JD && GravStage[Ig].World == OrbCenter)
+         return (&GravStage[Ig]);
+   }
+   return (NULL);
+}
+/**********************************************************************/
+/* Fill the stage table for the N-body Cowell steps Dynamics is about */
+/* to take.  Call serially, ahead of ForEachSc(Dynamics, ...).        */
+void GravPertStages(void)
+{
+   struct SCType *S;
+   double dt, Offset[3], JD;
+   long Isc, OrbCenter, k;
+
+   NgravStage = 0;
+   if (!GravPertActive)
+      return;
+
+   for (Isc = 0; Isc < Nsc; Isc++) {
+      S = &SC[Isc];
+      if (!S->Exists)
+         continue;
+      dt = NBodyOrbitStep(S);
+      if (dt <= 0.0)
+         continue;
+      OrbCenter = Orb[S->RefOrb].World;
+      Offset[0] = 0.0;
+      Offset[1] = 0.5 * dt; /* RK4 stages 2 and 3 share a time */
+      Offset[2] = dt;
+      for (k = 0; k < 3; k++) {
+         JD = Rk4StageJD(Offset[k]);
+         if (FindGravStage(JD, OrbCenter) != NULL)
+            continue;
+         if (NgravStage == NgravStageAlloc) {
+            NgravStageAlloc = (NgravStageAlloc > 0 ? 2 * NgravStageAlloc : 4);
+            GravStage       = (struct GravStageType *)realloc(
+                GravStage, NgravStageAlloc * sizeof(struct GravStageType));
+            if (GravStage == NULL) {
+               fprintf(stderr,
+                       "GravStage realloc returned null pointer.  Bailing "
+                       "out!\n");
+               exit(EXIT_FAILURE);
             }
-            ThirdBodyGravForce(p, s, World[Iw].mu, S->mass, FrcNtemp);
-            for (j = 0; j < 3; j++)
-               FrcN[j] += FrcNtemp[j];
          }
+         FillGravStage(&GravStage[NgravStage++], JD, OrbCenter);
       }
    }
+}
+/**********************************************************************/
+/* Whether GravPertForceRK4 will find this stage in the table, rather */
+/* than look it up directly                                           */
+long GravStageIsTabled(double RKFdt, long OrbCenter)
+{
+   return (FindGravStage(Rk4StageJD(RKFdt), OrbCenter) != NULL);
+}
+/**********************************************************************/
+/* Release the stage table at the end of a sim case.  Each Monte      */
+/* Carlo run thread has its own.                                      */
+void ShutdownGravPertStages(void)
+{
+   free(GravStage);
+   GravStage       = NULL;
+   NgravStage      = 0;
+   NgravStageAlloc = 0;
+}
+/**********************************************************************/
+void GravPertForceRK4(struct SCType *S, double u[6], double FrcN[3],
+                      double RKFdt)
+{
+   struct GravStageType Direct, *G;
+   struct WorldType *WCenter;
+   double s[3], SCPosN[3] = {0}, FrcNtemp[3] = {0};
+   double FrcN_harm[3] = {0}, SCPosN_harm[3] = {0};
+   double RK4TIME;
+   long OrbCenter, k, j;
+
+   for (j = 0; j < 3; j++) {
+      SCPosN[j]      = u[j];
+      SCPosN_harm[j] = u[j];
+   }
+
+   /* Stages past the loaded JPL block are looked up by Rk4JplEphems */
+   RK4TIME = Rk4StageJD(RKFdt);
+
+   OrbCenter = Orb[S->RefOrb].World;
+   WCenter   = &World[OrbCenter];
+
+   G = FindGravStage(RK4TIME, OrbCenter);
+   if (G == NULL) {
+      FillGravStage(&Direct, RK4TIME, OrbCenter);
+      G = &Direct;
+   }
+
+   /* Sun, all existing planets, and moons of OrbCenter */
+   for (k = 0; k < G->Nbody; k++) {
+      for (j = 0; j < 3; j++)
+         s[j] = G->p[k][j] - SCPosN[j];
+      ThirdBodyGravForce(G->p[k], s, World[G->Body[k]].mu, S->mass,
+                         FrcNtemp);
+      for (j = 0; j < 3; j++)
+         FrcN[j] += FrcNtemp[j];
+   }
 
    struct SphereHarmType *gravModel = &WCenter->GravModel;
-   SphericalHarmGravForce(gravModel->N, gravModel->M, WCenter, cntrPriMerAng,
+   SphericalHarmGravForce(gravModel->N, gravModel->M, WCenter, G->PriMerAng,
                           S->mass, SCPosN_harm, FrcN_harm);
    for (j = 0; j < 3; j++)
       FrcN[j] += FrcN_harm[j];
 
-   if (EphemOption != EPH_SPICE) {
-      if (revertCHEB) {
-         LoadJplEphems(ModelPath, TDB.JulDay);
+   /* else if O->CenterType == MINORBODY, use provided gravity model */
+}
+/**********************************************************************/
+/* Projected area and area-weighted moment arm (about cm) of one     */
+/* body's wetted polys, seen along DirB.  Straight-line pass over    */
+/* the SoA surface table; the mask and the facing test are folded    */
+/* into the area so the loop body has no branches.                   */
+static double AeroSurfSum(const struct SurfTableType *T,
+                          const double *UnshadedArea, double **UnshadedCtr,
+                          const double DirB[3], const double cm[3],
+                          double Moment[3])
+{
+   const double *Cx = UnshadedCtr[0];
+   const double *Cy = UnshadedCtr[1];
+   const double *Cz = UnshadedCtr[2];
+   double Area = 0.0, Mx = 0.0, My = 0.0, Mz = 0.0;
+   double WoN, PolyArea;
+   long k;
+
+   for (k = 0; k < T->N; k++) {
+      WoN      = DirB[0] * T->Nx[k] + DirB[1] * T->Ny[k] + DirB[2] * T->Nz[k];
+      PolyArea = T->ForceMask[k] * (WoN > 0.0 ? WoN : 0.0) * UnshadedArea[k];
+      Area    += PolyArea;
+      Mx      += PolyArea * (Cx[k] - cm[0]);
+      My      += PolyArea * (Cy[k] - cm[1]);
+      Mz      += PolyArea * (Cz[k] - cm[2]);
+   }
+   Moment[0] = Mx;
+   Moment[1] = My;
+   Moment[2] = Mz;
+   return (Area);
+}
+/**********************************************************************/
+/* Solar pressure force and torque (about cm), in B, summed over one  */
+/* body's illuminated polys.  Returns the projected illuminated area. */
+static double SolPressSurfSum(const struct SurfTableType *T,
+                              const double *UnshadedArea,
+                              double **UnshadedCtr, const double svb[3],
+                              const double cm[3], double SolarPressure,
+                              double Fb[3], double Tb[3])
+{
+   const double *Cx = UnshadedCtr[0];
+   const double *Cy = UnshadedCtr[1];
+   const double *Cz = UnshadedCtr[2];
+   double Asum      = 0.0;
+   double Fx = 0.0, Fy = 0.0, Fz = 0.0, Tx = 0.0, Ty = 0.0, Tz = 0.0;
+   double SoN, Aproj, Coef, Cs, Cn, fx, fy, fz, rx, ry, rz;
+   long k;
+
+   for (k = 0; k < T->N; k++) {
+      SoN   = svb[0] * T->Nx[k] + svb[1] * T->Ny[k] + svb[2] * T->Nz[k];
+      SoN   = T->ForceMask[k] * (SoN > 0.0 ? SoN : 0.0);
+      Aproj = UnshadedArea[k] * SoN;
+      Coef  = -SolarPressure * Aproj;
+      Asum += Aproj;
+      Cs    = Coef * (1.0 - T->SpecFrac[k]);
+      Cn    = Coef * 2.0 * (T->SpecFrac[k] * SoN + T->DiffFrac[k] / 3.0);
+      fx    = Cs * svb[0] + Cn * T->Nx[k];
+      fy    = Cs * svb[1] + Cn * T->Ny[k];
+      fz    = Cs * svb[2] + Cn * T->Nz[k];
+      rx    = Cx[k] - cm[0];
+      ry    = Cy[k] - cm[1];
+      rz    = Cz[k] - cm[2];
+      Fx   += fx;
+      Fy   += fy;
+      Fz   += fz;
+      Tx   += ry * fz - rz * fy;
+      Ty   += rz * fx - rx * fz;
+      Tz   += rx * fy - ry * fx;
+   }
+   Fb[0] = Fx;
+   Fb[1] = Fy;
+   Fb[2] = Fz;
+   Tb[0] = Tx;
+   Tb[1] = Ty;
+   Tb[2] = Tz;
+   return (Asum);
+}
+/**********************************************************************/
+/* FNV-1a, used to key cached shadow tables to their geometry         */
+static unsigned long long HashBytes(unsigned long long h, const void *Data,
+                                    size_t N)
+{
+   const unsigned char *c = (const unsigned char *)Data;
+   size_t i;
+
+   for (i = 0; i < N; i++) {
+      h ^= c[i];
+      h *= 1099511628211ULL;
+   }
+   return (h);
+}
+/**********************************************************************/
+static unsigned long long ShadowLutKey(struct GeomType *G, long Naz,
+                                       long Nel)
+{
+   struct SurfTableType *T = &G->Surf;
+   unsigned long long h    = 14695981039346656037ULL;
+   long Version            = 2;
+   long i;
+
+   h = HashBytes(h, &Version, sizeof(long));
+   h = HashBytes(h, &Naz, sizeof(long));
+   h = HashBytes(h, &Nel, sizeof(long));
+   h = HashBytes(h, &G->Nv, sizeof(long));
+   for (i = 0; i < G->Nv; i++)
+      h = HashBytes(h, G->V[i], 3 * sizeof(double));
+   h = HashBytes(h, &G->Npoly, sizeof(long));
+   for (i = 0; i < G->Npoly; i++) {
+      h = HashBytes(h, &G->Poly[i].Nv, sizeof(long));
+      h = HashBytes(h, G->Poly[i].V, G->Poly[i].Nv * sizeof(long));
+   }
+   h = HashBytes(h, T->SpecFrac, T->N * sizeof(double));
+   h = HashBytes(h, T->DiffFrac, T->N * sizeof(double));
+   h = HashBytes(h, T->ForceMask, T->N * sizeof(double));
+   return (h);
+}
+/**********************************************************************/
+/* Returns 1 if Path/File holds a table for this Key and grid, whose */
+/* values match their checksum and run to the end of the file         */
+static long ReadShadowLut(const char *Path, const char *File,
+                          unsigned long long Key, struct ShadowLutType *L)
+{
+   FILE *infile;
+   char FileName[1024], Magic[8];
+   unsigned long long FileKey, Sum;
+   long Naz, Nel, Nval, Success = 0;
+
+   snprintf(FileName, sizeof(FileName), "%s%s", Path, File);
+   infile = fopen(FileName, "rb");
+   if (infile == NULL)
+      return (0);
+   Nval = SHADOW_LUT_NVAL * L->Naz * L->Nel;
+   if (fread(Magic, sizeof(char), 8, infile) == 8 &&
+       !memcmp(Magic, "42SHLUT", 8) &&
+       fread(&FileKey, sizeof(FileKey), 1, infile) == 1 && FileKey == Key &&
+       fread(&Naz, sizeof(long), 1, infile) == 1 && Naz == L->Naz &&
+       fread(&Nel, sizeof(long), 1, infile) == 1 && Nel == L->Nel &&
+       fread(L->Val, sizeof(double), Nval, infile) == (size_t)Nval &&
+       fread(&Sum, sizeof(Sum), 1, infile) == 1 && fgetc(infile) == EOF &&
+       Sum == HashBytes(Key, L->Val, Nval * sizeof(double)))
+      Success = 1;
+   fclose(infile);
+   return (Success);
+}
+/**********************************************************************/
+/* Written aside and renamed into place, so concurrent runs sharing   */
+/* OutPath never read a partial table                                 */
+static void WriteShadowLut(const char *Path, const char *File,
+                           unsigned long long Key, struct ShadowLutType *L)
+{
+   FILE *outfile;
+   char TmpName[1024];
+   unsigned long long Sum;
+   long Nval = SHADOW_LUT_NVAL * L->Naz * L->Nel;
+
+   outfile = OpenTempFile(Path, File, TmpName);
+   if (outfile == NULL) {
+      printf("Could not write %s%s.  Shadow table will be rebuilt next "
+             "run.\n",
+             Path, File);
+      return;
+   }
+   Sum = HashBytes(Key, L->Val, Nval * sizeof(double));
+   fwrite("42SHLUT", sizeof(char), 8, outfile);
+   fwrite(&Key, sizeof(Key), 1, outfile);
+   fwrite(&L->Naz, sizeof(long), 1, outfile);
+   fwrite(&L->Nel, sizeof(long), 1, outfile);
+   fwrite(L->Val, sizeof(double), Nval, outfile);
+   fwrite(&Sum, sizeof(Sum), 1, outfile);
+   if (ferror(outfile)) {
+      fclose(outfile);
+      remove(TmpName);
+   }
+   else if (!CommitTempFile(outfile, TmpName, Path, File))
+      return;
+   printf("Could not write %s%s.  Shadow table will be rebuilt next run.\n",
+          Path, File);
+}
+/**********************************************************************/
+/* Run the full silhouette clipper once per grid direction on a       */
+/* stand-in SC whose lone body sits at the origin, aligned with N.    */
+static void TabulateShadowLut(struct ShadowLutType *L)
+{
+   struct SCType *Tmp;
+   struct BodyType *B;
+   struct GeomType *G = &Geom[L->GeomTag];
+   double Zero[3]     = {0.0, 0.0, 0.0};
+   double DirB[3], Az, El, *Val;
+   long Iaz, Iel, Ipoly, i;
+
+   Tmp = (struct SCType *)calloc(1, sizeof(struct SCType));
+   B   = (struct BodyType *)calloc(1, sizeof(struct BodyType));
+   if (Tmp == NULL || B == NULL) {
+      fprintf(stderr, "TabulateShadowLut calloc returned null pointer.  "
+                      "Bailing out!\n");
+      exit(EXIT_FAILURE);
+   }
+   Tmp->Nb         = 1;
+   Tmp->B          = B;
+   B->GeomTag      = L->GeomTag;
+   B->UnshadedArea = (double *)calloc(G->Npoly, sizeof(double));
+   B->UnshadedCtr  = CreateMatrix(3, G->Npoly);
+   for (i = 0; i < 3; i++)
+      B->CN[i][i] = 1.0;
+   for (Ipoly = 0; Ipoly < G->Npoly; Ipoly++) {
+      B->UnshadedArea[Ipoly] = G->Poly[Ipoly].Area;
+      for (i = 0; i < 3; i++)
+         B->UnshadedCtr[i][Ipoly] = G->Poly[Ipoly].Centroid[i];
+   }
+
+   for (Iel = 0; Iel < L->Nel; Iel++) {
+      El = -HALFPI + Iel * L->dEl;
+      for (Iaz = 0; Iaz < L->Naz; Iaz++) {
+         Az      = Iaz * L->dAz;
+         DirB[0] = cos(El) * cos(Az);
+         DirB[1] = cos(El) * sin(Az);
+         DirB[2] = sin(El);
+         FindUnshadedAreas(Tmp, DirB);
+         Val    = &L->Val[SHADOW_LUT_NVAL * (Iel * L->Naz + Iaz)];
+         Val[0] = AeroSurfSum(&G->Surf, B->UnshadedArea, B->UnshadedCtr, DirB,
+                              Zero, &Val[1]);
+         SolPressSurfSum(&G->Surf, B->UnshadedArea, B->UnshadedCtr, DirB,
+                         Zero, 1.0, &Val[4], &Val[7]);
       }
    }
 
-   /* else if O->CenterType == MINORBODY, use provided gravity model */
+   free(B->UnshadedArea);
+   DestroyMatrix(B->UnshadedCtr);
+   FreeSilArena(&Tmp->Sil);
+   free(B);
+   free(Tmp);
+}
+/**********************************************************************/
+/* Bilinear in azimuth and elevation of DirB, which need not be unit  */
+static void ShadowLutLookup(const struct ShadowLutType *L,
+                            const double DirB[3],
+                            double Val[SHADOW_LUT_NVAL])
+{
+   const double *V00, *V01, *V10, *V11;
+   double Az, El, x, y;
+   long Iaz, Jaz, Iel, k;
+
+   Az = atan2(DirB[1], DirB[0]);
+   if (Az < 0.0)
+      Az += TWOPI;
+   El = atan2(DirB[2], sqrt(DirB[0] * DirB[0] + DirB[1] * DirB[1]));
+
+   x   = Az / L->dAz;
+   Iaz = (long)x;
+   if (Iaz >= L->Naz)
+      Iaz = L->Naz - 1;
+   x  -= Iaz;
+   Jaz = (Iaz + 1) % L->Naz;
+   y   = (El + HALFPI) / L->dEl;
+   Iel = (long)y;
+   if (Iel > L->Nel - 2)
+      Iel = L->Nel - 2;
+   y -= Iel;
+
+   V00 = &L->Val[SHADOW_LUT_NVAL * (Iel * L->Naz + Iaz)];
+   V01 = &L->Val[SHADOW_LUT_NVAL * (Iel * L->Naz + Jaz)];
+   V10 = &L->Val[SHADOW_LUT_NVAL * ((Iel + 1) * L->Naz + Iaz)];
+   V11 = &L->Val[SHADOW_LUT_NVAL * ((Iel + 1) * L->Naz + Jaz)];
+   for (k = 0; k < SHADOW_LUT_NVAL; k++) {
+      Val[k] = (1.0 - y) * ((1.0 - x) * V00[k] + x * V01[k]) +
+               y * ((1.0 - x) * V10[k] + x * V11[k]);
+   }
+}
+/**********************************************************************/
+/* Self-shadowing depends only on body-frame direction when the SC is */
+/* a single rigid body, so tabulate it once (or load it from the      */
+/* cache in OutPath) rather than clip silhouettes every step.  SC     */
+/* that share a Geom share a table.                                   */
+void InitShadowLut(struct SCType *S)
+{
+   struct ShadowLutType *L;
+   struct GeomType *G;
+   char FileName[40];
+   unsigned long long Key;
+   long Isc;
+
+   S->ShadowLut = NULL;
+   if (!(AeroShadowsActive || SolPressShadowsActive) ||
+       ShadowTableStep <= 0.0)
+      return;
+   if (S->Nb > 1) {
+      printf("SC[%ld] has %ld bodies.  Its self-shadowing will be found "
+             "every step.\n",
+             S->ID, S->Nb);
+      return;
+   }
+   G = &Geom[S->B[0].GeomTag];
+   if (G->Npoly == 0)
+      return;
+
+   for (Isc = 0; Isc < S->ID; Isc++) {
+      L = SC[Isc].ShadowLut;
+      if (L != NULL && L->GeomTag == S->B[0].GeomTag) {
+         S->ShadowLut = L;
+         return;
+      }
+   }
+
+   L = (struct ShadowLutType *)calloc(1, sizeof(struct ShadowLutType));
+   if (L == NULL) {
+      fprintf(stderr, "InitShadowLut calloc returned null pointer.  Bailing "
+                      "out!\n");
+      exit(EXIT_FAILURE);
+   }
+   L->GeomTag = S->B[0].GeomTag;
+   L->Naz     = (long)(360.0 / ShadowTableStep + 0.5);
+   L->Nel     = (long)(180.0 / ShadowTableStep + 0.5) + 1;
+   if (L->Naz < 4)
+      L->Naz = 4;
+   if (L->Nel < 3)
+      L->Nel = 3;
+   L->dAz = TWOPI / L->Naz;
+   L->dEl = PI / (L->Nel - 1);
+   L->Val = (double *)calloc(SHADOW_LUT_NVAL * L->Naz * L->Nel, sizeof(double));
+   if (L->Val == NULL) {
+      fprintf(stderr, "InitShadowLut calloc returned null pointer.  Bailing "
+                      "out!\n");
+      exit(EXIT_FAILURE);
+   }
+
+   Key = ShadowLutKey(G, L->Naz, L->Nel);
+   snprintf(FileName, sizeof(FileName), "ShadowLut_%016llx.bin", Key);
+   if (!ReadShadowLut(OutPath, FileName, Key, L)) {
+      printf("Tabulating self-shadowing of %s over %ld directions\n",
+             G->ObjFileName, L->Naz * L->Nel);
+      TabulateShadowLut(L);
+      WriteShadowLut(OutPath, FileName, Key, L);
+   }
+   S->ShadowLut = L;
+}
+/**********************************************************************/
+/* Free each table once, though SC sharing a Geom share it            */
+void ShutdownShadowLut(void)
+{
+   struct ShadowLutType *L;
+   long Isc, Jsc;
+
+   for (Isc = 0; Isc < Nsc; Isc++) {
+      L = SC[Isc].ShadowLut;
+      if (L == NULL)
+         continue;
+      for (Jsc = Isc; Jsc < Nsc; Jsc++) {
+         if (SC[Jsc].ShadowLut == L)
+            SC[Jsc].ShadowLut = NULL;
+      }
+      free(L->Val);
+      free(L);
+   }
 }
 /**********************************************************************/
 void AeroFrcTrq(struct SCType *S)
 {
 
-   double VrelN[3], WindSpeed, VrelB[3], Area, PolyArea, cp[3];
-   double WoN, Coef, Fb[3] = {0}, Fn[3] = {0}, Trq[3] = {0}, Tn[3] = {0};
+   double VrelN[3], WindSpeed, VrelB[3], Area, cp[3], Val[SHADOW_LUT_NVAL];
+   double Coef, Fb[3] = {0}, Fn[3] = {0}, Trq[3] = {0}, Tn[3] = {0};
    long Ib, i;
-   long Ipoly;
    long OrbCenter;
    struct BodyType *B;
    struct GeomType *G;
-   struct PolyType *P;
 
    for (i = 0; i < 3; i++) {
       S->aeroFrcN[i] = 0;
@@ -646,7 +1239,7 @@ void AeroFrcTrq(struct SCType *S)
    VrelN[2]  = S->VelN[2];
    WindSpeed = UNITV(VrelN);
 
-   if (AeroShadowsActive) {
+   if (AeroShadowsActive && S->ShadowLut == NULL) {
       FindUnshadedAreas(S, VrelN);
    }
 
@@ -658,22 +1251,16 @@ void AeroFrcTrq(struct SCType *S)
       MxV(B->CN, VrelN, VrelB);
 
       /* Find total projected area and cp for Body */
-      Area = 0.0;
-      for (i = 0; i < 3; i++)
-         cp[i] = 0.0;
-      G = &Geom[B->GeomTag];
-      for (Ipoly = 0; Ipoly < G->Npoly; Ipoly++) {
-         P = &G->Poly[Ipoly];
-         if (strncmp(Matl[P->Matl].Label, "SHADED",
-                     6)) { /* Aero doesn't see shaded polys */
-            WoN = VoV(VrelB, P->Norm);
-            if (WoN > 0.0) {
-               PolyArea  = WoN * P->UnshadedArea;
-               Area     += PolyArea;
-               for (i = 0; i < 3; i++)
-                  cp[i] += PolyArea * (P->UnshadedCtr[i] - B->cm[i]);
-            }
-         }
+      if (AeroShadowsActive && S->ShadowLut != NULL) {
+         ShadowLutLookup(S->ShadowLut, VrelB, Val);
+         Area = Val[0];
+         for (i = 0; i < 3; i++)
+            cp[i] = Val[1 + i] - Area * B->cm[i];
+      }
+      else {
+         G    = &Geom[B->GeomTag];
+         Area = AeroSurfSum(&G->Surf, B->UnshadedArea, B->UnshadedCtr, VrelB,
+                            B->cm, cp);
       }
       if (Area > 0.0) {
          for (i = 0; i < 3; i++)
@@ -706,13 +1293,10 @@ void AeroFrcTrq(struct SCType *S)
 void SolPressFrcTrq(struct SCType *S)
 {
    long Ib, i;
-   long Ipoly;
-   double svb[3], SoN, Coef, r[3], Fb[3] = {0}, Fn[3] = {0}, Tb[3] = {0},
-                                   Tn[3] = {0}, SolarPressure;
+   double svb[3], Fb[3] = {0}, Fn[3] = {0}, Tb[3] = {0}, Tn[3] = {0};
+   double SolarPressure, Val[SHADOW_LUT_NVAL], cxF[3];
    struct BodyType *B;
    struct GeomType *G;
-   struct PolyType *P;
-   struct MatlType *M;
    double srpAreaSum;
 
    for (i = 0; i < 3; i++) {
@@ -728,7 +1312,7 @@ void SolPressFrcTrq(struct SCType *S)
       /* and falls off as R^2                                  */
       SolarPressure = 4.5E-6 * 2.238E22 / VoV(S->PosH, S->PosH);
 
-      if (SolPressShadowsActive) {
+      if (SolPressShadowsActive && S->ShadowLut == NULL) {
          FindUnshadedAreas(S, S->svn);
       }
 
@@ -736,41 +1320,34 @@ void SolPressFrcTrq(struct SCType *S)
       for (Ib = 0; Ib < S->Nb; Ib++) {
          B = &S->B[Ib];
          G = &Geom[B->GeomTag];
+         MxV(B->CN, S->svn, svb);
 
-         /* Find force and torque on each illuminated polygon */
-         for (Ipoly = 0; Ipoly < G->Npoly; Ipoly++) {
-            P = &G->Poly[Ipoly];
-            if (strncmp(Matl[P->Matl].Label, "SHADED",
-                        6)) { /* SRP doesn't see shaded polys */
-               MxV(B->CN, S->svn, svb);
-               SoN = VoV(svb, P->Norm);
-               if (SoN > 0.0) {
-                  M           = &Matl[P->Matl];
-                  Coef        = -SolarPressure * P->UnshadedArea * SoN;
-                  srpAreaSum += P->UnshadedArea * SoN;
-                  for (i = 0; i < 3; i++) {
-                     Fb[i] =
-                         Coef * ((1.0 - M->SpecFrac) * svb[i] +
-                                 2.0 * (M->SpecFrac * SoN + M->DiffFrac / 3.0) *
-                                     P->Norm[i]);
-                  }
-                  for (i = 0; i < 3; i++)
-                     r[i] = P->UnshadedCtr[i] - B->cm[i];
-                  VxV(r, Fb, Tb);
-                  MTxV(B->CN, Tb, Tn);
-                  MTxV(B->CN, Fb, Fn);
-                  for (i = 0; i < 3; i++) {
-                     B->FrcN[i]    += Fn[i];
-                     B->FrcB[i]    += Fb[i];
-                     B->Trq[i]     += Tb[i];
-                     S->srpFrcN[i] += Fn[i];
-                     S->srpFrcB[i] += Fb[i];
-                     S->srpTrqN[i] += Tn[i];
-                     S->srpTrqB[i] += Tb[i];
-                  }
-               }
+         /* Sum force and torque over illuminated polygons */
+         if (SolPressShadowsActive && S->ShadowLut != NULL) {
+            ShadowLutLookup(S->ShadowLut, svb, Val);
+            srpAreaSum += Val[0];
+            VxV(B->cm, &Val[4], cxF);
+            for (i = 0; i < 3; i++) {
+               Fb[i] = SolarPressure * Val[4 + i];
+               Tb[i] = SolarPressure * (Val[7 + i] - cxF[i]);
             }
          }
+         else {
+            srpAreaSum += SolPressSurfSum(&G->Surf, B->UnshadedArea,
+                                          B->UnshadedCtr, svb, B->cm,
+                                          SolarPressure, Fb, Tb);
+         }
+         MTxV(B->CN, Fb, Fn);
+         MTxV(B->CN, Tb, Tn);
+         for (i = 0; i < 3; i++) {
+            B->FrcN[i]    += Fn[i];
+            B->FrcB[i]    += Fb[i];
+            B->Trq[i]     += Tb[i];
+            S->srpFrcN[i] += Fn[i];
+            S->srpFrcB[i] += Fb[i];
+            S->srpTrqN[i] += Tn[i];
+            S->srpTrqB[i] += Tb[i];
+         }
       }
    }
 
@@ -834,8 +1411,7 @@ void BodyRgnContactFrcTrq(struct SCType *S, long Ibody, struct RegionType *R)
    double ContactArea;
    double Dist, MinDist;
    double PosR[3], VelR[3], RelPosR[3], PosRR[3];
-   static long HitPoly = 0;
-   long OtherPoly;
+   long HitPoly, OtherPoly;
    long Ib, Ie, i, Done;
    double Fn[3], Fb[3], Tb[3];
 
@@ -843,6 +1419,9 @@ void BodyRgnContactFrcTrq(struct SCType *S, long Ibody, struct RegionType *R)
    Gb = &Geom[B->GeomTag];
    Gr = &Geom[R->GeomTag];
 
+   /* Warm start the search from where this body last touched down */
+   HitPoly = (B->RgnHitPoly < Gr->Npoly ? B->RgnHitPoly : 0);
+
    for (i = 0; i < 3; i++) {
       FrcN[i] = 0.0;
       FrcB[i] = 0.0;
@@ -937,6 +1516,7 @@ void BodyRgnContactFrcTrq(struct SCType *S, long Ibody, struct RegionType *R)
       B->FrcB[i] += FrcB[i];
       B->Trq[i]  += TrqB[i];
    }
+   B->RgnHitPoly = HitPoly;
 }
 /**********************************************************************/
 /* For each Poly in Body Ba, find force and torque due to contact     */
@@ -1096,6 +1676,165 @@ void BodyBodyContactFrcTrq(struct SCType *Sa, long Ibody, struct SCType *Sb,
    }
 }
 /**********************************************************************/
+/*  Contact broad phase.  Once per step, SC and Region bounding       */
+/*  spheres are sorted along the axis of greatest spread and swept,   */
+/*  keeping only overlapping pairs on the same World.  ContactFrcTrq  */
+/*  then visits just those candidates, in the original order, and     */
+/*  applies its usual proximity checks.                               */
+struct ContactProxyType {
+   double Min, Max; /* Extent along sweep axis */
+   double PosN[3];
+   double Radius;
+   long World;
+   long Isc; /* -1 for a Region */
+   long Ir;
+};
+struct ContactPairType {
+   long Isc;
+   long Key; /* Ir for a Region, Nrgn + Jsc for an SC */
+};
+static SIMLOCAL struct ContactProxyType *Proxy = NULL;
+static SIMLOCAL struct ContactPairType *Pair   = NULL;
+static SIMLOCAL long *PairStart                = NULL;
+static SIMLOCAL long NproxyAlloc               = 0;
+static SIMLOCAL long NpairAlloc                = 0;
+static SIMLOCAL long Npair                     = 0;
+/**********************************************************************/
+static int CompareProxies(const void *a, const void *b)
+{
+   const struct ContactProxyType *Pa = a, *Pb = b;
+
+   return ((Pa->Min > Pb->Min) - (Pa->Min < Pb->Min));
+}
+/**********************************************************************/
+static int ComparePairs(const void *a, const void *b)
+{
+   const struct ContactPairType *Pa = a, *Pb = b;
+
+   if (Pa->Isc != Pb->Isc)
+      return ((Pa->Isc > Pb->Isc) - (Pa->Isc < Pb->Isc));
+   return ((Pa->Key > Pb->Key) - (Pa->Key < Pb->Key));
+}
+/**********************************************************************/
+static void AddContactPair(long Isc, long Key)
+{
+   if (Npair == NpairAlloc) {
+      NpairAlloc = (NpairAlloc > 0 ? 2 * NpairAlloc : 64);
+      Pair       = (struct ContactPairType *)realloc(
+          Pair, NpairAlloc * sizeof(struct ContactPairType));
+      if (Pair == NULL) {
+         fprintf(stderr, "Pair realloc returned null pointer.  Bailing out!\n");
+         exit(EXIT_FAILURE);
+      }
+   }
+   Pair[Npair].Isc = Isc;
+   Pair[Npair].Key = Key;
+   Npair++;
+}
+/**********************************************************************/
+void FindContactCandidates(void)
+{
+   struct ContactProxyType *P, *Q;
+   struct RegionType *R;
+   struct SCType *S;
+   double Sum[3] = {0.0}, SumSq[3] = {0.0}, Var, MaxVar, dx[3];
+   long Nproxy, Axis, Isc, Ir, Ip, Jp, i;
+
+   if (NproxyAlloc < Nsc + Nrgn) {
+      NproxyAlloc = Nsc + Nrgn;
+      free(Proxy);
+      free(PairStart);
+      Proxy     = (struct ContactProxyType *)calloc(
+          NproxyAlloc, sizeof(struct ContactProxyType));
+      PairStart = (long *)calloc(Nsc + 1, sizeof(long));
+      if (Proxy == NULL || PairStart == NULL) {
+         fprintf(stderr, "Proxy calloc returned null pointer.  Bailing out!\n");
+         exit(EXIT_FAILURE);
+      }
+   }
+
+   /* .. Bounding spheres, padded to cover ContactFrcTrq's checks */
+   Nproxy = 0;
+   for (Isc = 0; Isc < Nsc; Isc++) {
+      S = &SC[Isc];
+      if (!S->Exists)
+         continue;
+      P         = &Proxy[Nproxy++];
+      P->Radius = 1.2 * S->BBox.radius;
+      P->World  = Orb[S->RefOrb].World;
+      P->Isc    = Isc;
+      P->Ir     = -1;
+      for (i = 0; i < 3; i++)
+         P->PosN[i] = S->PosN[i];
+   }
+   for (Ir = 0; Ir < Nrgn; Ir++) {
+      R = &Rgn[Ir];
+      if (!R->Exists)
+         continue;
+      P         = &Proxy[Nproxy++];
+      P->Radius = Geom[R->GeomTag].BBox.radius;
+      P->World  = R->World;
+      P->Isc    = -1;
+      P->Ir     = Ir;
+      for (i = 0; i < 3; i++)
+         P->PosN[i] = R->PosN[i];
+   }
+
+   /* .. Sweep along the axis of greatest spread */
+   for (Ip = 0; Ip < Nproxy; Ip++) {
+      for (i = 0; i < 3; i++) {
+         Sum[i]   += Proxy[Ip].PosN[i];
+         SumSq[i] += Proxy[Ip].PosN[i] * Proxy[Ip].PosN[i];
+      }
+   }
+   Axis   = 0;
+   MaxVar = -1.0;
+   for (i = 0; i < 3; i++) {
+      Var = SumSq[i] - Sum[i] * Sum[i] / (Nproxy > 0 ? Nproxy : 1);
+      if (Var > MaxVar) {
+         MaxVar = Var;
+         Axis   = i;
+      }
+   }
+   for (Ip = 0; Ip < Nproxy; Ip++) {
+      P      = &Proxy[Ip];
+      P->Min = P->PosN[Axis] - P->Radius;
+      P->Max = P->PosN[Axis] + P->Radius;
+   }
+   qsort(Proxy, Nproxy, sizeof(struct ContactProxyType), CompareProxies);
+
+   Npair = 0;
+   for (Ip = 0; Ip < Nproxy; Ip++) {
+      P = &Proxy[Ip];
+      for (Jp = Ip + 1; Jp < Nproxy && Proxy[Jp].Min <= P->Max; Jp++) {
+         Q = &Proxy[Jp];
+         if (P->World != Q->World || (P->Isc < 0 && Q->Isc < 0))
+            continue;
+         for (i = 0; i < 3; i++)
+            dx[i] = P->PosN[i] - Q->PosN[i];
+         if (MAGV(dx) > P->Radius + Q->Radius)
+            continue;
+         if (P->Isc < 0)
+            AddContactPair(Q->Isc, P->Ir);
+         else if (Q->Isc < 0)
+            AddContactPair(P->Isc, Q->Ir);
+         else if (P->Isc < Q->Isc)
+            AddContactPair(P->Isc, Nrgn + Q->Isc);
+         else
+            AddContactPair(Q->Isc, Nrgn + P->Isc);
+      }
+   }
+
+   /* .. Group by SC, Regions first, each in index order */
+   qsort(Pair, Npair, sizeof(struct ContactPairType), ComparePairs);
+   Ip = 0;
+   for (Isc = 0; Isc <= Nsc; Isc++) {
+      while (Ip < Npair && Pair[Ip].Isc < Isc)
+         Ip++;
+      PairStart[Isc] = Ip;
+   }
+}
+/**********************************************************************/
 void ContactFrcTrq(struct SCType *S)
 {
    struct OrbitType *O;
@@ -1104,32 +1843,36 @@ void ContactFrcTrq(struct SCType *S)
    struct BodyType *Bi, *Bj;
    struct GeomType *Gi, *Gj;
    double dx[3], cmb[3], cmni[3], cmnj[3];
-   long Ir, i, Ib, Isc, Jb;
+   long Ir, i, Ib, Isc, Jb, Ip;
 
    O = &Orb[S->RefOrb];
 
-   /* .. Contact with Regions */
-   for (Ir = 0; Ir < Nrgn; Ir++) {
-      R = &Rgn[Ir];
-      /* Cheap proximity checks */
-      if (!R->Exists)
-         continue;
-      if (R->World != O->World)
-         continue;
-      for (i = 0; i < 3; i++)
-         dx[i] = S->PosN[i] - R->PosN[i];
-      if (MAGV(dx) > S->BBox.radius + Geom[R->GeomTag].BBox.radius)
-         continue;
+   /* .. Candidates from FindContactCandidates, Regions first */
+   for (Ip = PairStart[S->ID]; Ip < PairStart[S->ID + 1]; Ip++) {
+      if (Pair[Ip].Key < Nrgn) {
+         /* .. Contact with Regions */
+         Ir = Pair[Ip].Key;
+         R  = &Rgn[Ir];
+         /* Cheap proximity checks */
+         if (!R->Exists)
+            continue;
+         if (R->World != O->World)
+            continue;
+         for (i = 0; i < 3; i++)
+            dx[i] = S->PosN[i] - R->PosN[i];
+         if (MAGV(dx) > S->BBox.radius + Geom[R->GeomTag].BBox.radius)
+            continue;
 
-      /* Check each body vs Region */
-      for (Ib = 0; Ib < S->Nb; Ib++) {
-         BodyRgnContactFrcTrq(S, Ib, R);
+         /* Check each body vs Region */
+         for (Ib = 0; Ib < S->Nb; Ib++) {
+            BodyRgnContactFrcTrq(S, Ib, R);
+         }
+         continue;
       }
-   }
 
-   /* .. Contact with other S/C */
-   for (Isc = S->ID + 1; Isc < Nsc; Isc++) {
-      Sc = &SC[Isc];
+      /* .. Contact with other S/C */
+      Isc = Pair[Ip].Key - Nrgn;
+      Sc  = &SC[Isc];
       /* Cheap S/Sc proximity checks */
       if (!Sc->Exists)
          continue;
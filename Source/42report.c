@@ -17,6 +17,10 @@
 #include "42.h"
 #include "navkit.h"
 
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdint.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 
@@ -76,7 +80,7 @@ double FindTotalUnshadedProjectedArea(struct SCType *S, double VecN[3])
          P   = &G->Poly[Ipoly];
          VoN = VoV(VecB, P->Norm);
          if (VoN > 0.0) {
-            ProjArea += VoN * P->UnshadedArea;
+            ProjArea += VoN * B->UnshadedArea[Ipoly];
          }
       }
    }
@@ -85,8 +89,8 @@ double FindTotalUnshadedProjectedArea(struct SCType *S, double VecN[3])
 /*********************************************************************/
 void MagReport(void)
 {
-   static FILE *magfile;
-   static long First = 1;
+   static SIMLOCAL FILE *magfile;
+   static SIMLOCAL long First = 1;
 
    if (First) {
       First   = 0;
@@ -101,8 +105,8 @@ void MagReport(void)
 /*********************************************************************/
 void GyroReport(void)
 {
-   static FILE *gyrofile;
-   static long First = 1;
+   static SIMLOCAL FILE *gyrofile;
+   static SIMLOCAL long First = 1;
 
    if (First) {
       First    = 0;
@@ -123,8 +127,8 @@ void GyroReport(void)
 /*********************************************************************/
 void DSM_AttitudeReport(void)
 {
-   static FILE **attitudefile;
-   static long First = 1;
+   static SIMLOCAL FILE **attitudefile;
+   static SIMLOCAL long First = 1;
    long Isc;
    char s[40];
 
@@ -157,8 +161,8 @@ void DSM_AttitudeReport(void)
 /*********************************************************************/
 void DSM_AC_AttitudeReport(void)
 {
-   static FILE **attitudefile;
-   static long First = 1;
+   static SIMLOCAL FILE **attitudefile;
+   static SIMLOCAL long First = 1;
    long Isc;
    char s[40];
 
@@ -191,8 +195,8 @@ void DSM_AC_AttitudeReport(void)
 /*********************************************************************/
 void DSM_InertialReport(void)
 {
-   static FILE **inertialfile;
-   static long First = 1;
+   static SIMLOCAL FILE **inertialfile;
+   static SIMLOCAL long First = 1;
    long Isc;
    double PosL[3];
    char s[40];
@@ -229,8 +233,8 @@ void DSM_InertialReport(void)
 /*********************************************************************/
 void DSM_RelativeReport(void)
 {
-   static FILE **relativefile;
-   static long First = 1;
+   static SIMLOCAL FILE **relativefile;
+   static SIMLOCAL long First = 1;
    long Isc;
    char s[40];
 
@@ -270,9 +274,9 @@ void DSM_RelativeReport(void)
 /*********************************************************************/
 void DSM_PlanetEphemReport(void)
 {
-   static FILE **ephemfile;
-   static FILE **suntrackfile;
-   static long First = 1;
+   static SIMLOCAL FILE **ephemfile;
+   static SIMLOCAL FILE **suntrackfile;
+   static SIMLOCAL long First = 1;
    long Iw;
    char s[40];
    double svh[3], svw[3], CWH[3][3];
@@ -324,8 +328,8 @@ void DSM_PlanetEphemReport(void)
 /*********************************************************************/
 void DSM_AC_InertialReport(void)
 {
-   static FILE **inertialfile;
-   static long First = 1;
+   static SIMLOCAL FILE **inertialfile;
+   static SIMLOCAL long First = 1;
    long Isc;
    char s[40];
 
@@ -357,8 +361,8 @@ void DSM_AC_InertialReport(void)
 /*********************************************************************/
 void DSM_StateRot3BodyReport(void)
 {
-   static FILE **staterotfile;
-   static long First = 1;
+   static SIMLOCAL FILE **staterotfile;
+   static SIMLOCAL long First = 1;
    long Isc;
    char s[50];
    double full_N_state[6], posRot[3], velRot[3];
@@ -407,8 +411,8 @@ void DSM_StateRot3BodyReport(void)
 /*********************************************************************/
 void DSM_PosHReport(void)
 {
-   static FILE **poshfile;
-   static long First = 1;
+   static SIMLOCAL FILE **poshfile;
+   static SIMLOCAL long First = 1;
    long Isc, i;
    char s[50];
    double CNJ[3][3];
@@ -500,8 +504,8 @@ void DSM_PosHReport(void)
 /*********************************************************************/
 void DSM_Rot3BodyReport(void)
 {
-   static FILE **rotfile;
-   static long First = 1;
+   static SIMLOCAL FILE **rotfile;
+   static SIMLOCAL long First = 1;
    long Isc;
    char s[50];
    double posRel[3], posRot[3], velRel[3], velRot[3], DCM[3][3];
@@ -559,8 +563,8 @@ void DSM_Rot3BodyReport(void)
 /*********************************************************************/
 void DSM_NAV_StateReport(void)
 {
-   static FILE **stateFile, **covFile, **timeFile;
-   static long First = 1;
+   static SIMLOCAL FILE **stateFile, **covFile, **timeFile;
+   static SIMLOCAL long First = 1;
    long Isc;
    enum States state;
    char s[40];
@@ -722,8 +726,8 @@ void DSM_NAV_StateReport(void)
 #if REPORT_RESIDUALS == TRUE
 void DSM_NAV_ResidualsReport(double time, double **residuals[FIN_SENSOR + 1])
 {
-   static FILE **residualFile;
-   static long First = TRUE;
+   static SIMLOCAL FILE **residualFile;
+   static SIMLOCAL long First = TRUE;
    long Isc;
    enum SensorType sensor;
    char s[40];
@@ -863,8 +867,8 @@ void DSM_NAV_ResidualsReport(double time, double **residuals[FIN_SENSOR + 1])
 /*********************************************************************/
 void DSM_ATT_ControlReport(void)
 {
-   static FILE **attcontrolfile;
-   static long First = 1;
+   static SIMLOCAL FILE **attcontrolfile;
+   static SIMLOCAL long First = 1;
    long Isc;
    char s[40];
 
@@ -907,8 +911,8 @@ void DSM_ATT_ControlReport(void)
 /*********************************************************************/
 void DSM_POS_ControlReport(void)
 {
-   static FILE **poscontrolfile;
-   static long First = 1;
+   static SIMLOCAL FILE **poscontrolfile;
+   static SIMLOCAL long First = 1;
    long Isc;
    char s[40];
 
@@ -948,8 +952,8 @@ void DSM_POS_ControlReport(void)
 /*********************************************************************/
 void DSM_EphemReport(void)
 {
-   static FILE **ephemfile;
-   static long First = 1;
+   static SIMLOCAL FILE **ephemfile;
+   static SIMLOCAL long First = 1;
    long Isc;
    char s[40];
 
@@ -1000,8 +1004,8 @@ void DSM_EphemReport(void)
 /*********************************************************************/
 void DSM_WHLReport(void)
 {
-   static FILE **WHLFile;
-   static long First = 1;
+   static SIMLOCAL FILE **WHLFile;
+   static SIMLOCAL long First = 1;
    long Isc;
    long i;
    char s[40];
@@ -1036,8 +1040,8 @@ void DSM_WHLReport(void)
 /*********************************************************************/
 void DSM_THRReport(void)
 {
-   static FILE **THRFile;
-   static long First = 1;
+   static SIMLOCAL FILE **THRFile;
+   static SIMLOCAL long First = 1;
    long Isc;
    long i;
    char s[40];
@@ -1072,8 +1076,8 @@ void DSM_THRReport(void)
 /*********************************************************************/
 void DSM_SVBReport(void)
 {
-   static FILE **SVBFile;
-   static long First = 1;
+   static SIMLOCAL FILE **SVBFile;
+   static SIMLOCAL long First = 1;
    long Isc;
    char s[40];
 
@@ -1103,8 +1107,8 @@ void DSM_SVBReport(void)
 #ifdef _ENABLE_SPICE_
 void DSM_GroundTrackReport(void)
 {
-   static FILE **gtrackfile;
-   static long First = 1;
+   static SIMLOCAL FILE **gtrackfile;
+   static SIMLOCAL long First = 1;
    long Isc;
    char s[40];
    struct WorldType *W;
@@ -1142,11 +1146,11 @@ void DSM_GroundTrackReport(void)
 /*********************************************************************/
 void OrbPropReport(void)
 {
-   static FILE *FixedFile;
-   static FILE *EnckeFile;
-   static FILE *CowellFile;
-   static FILE *EulHillFile;
-   static long First = 1;
+   static SIMLOCAL FILE *FixedFile;
+   static SIMLOCAL FILE *EnckeFile;
+   static SIMLOCAL FILE *CowellFile;
+   static SIMLOCAL FILE *EulHillFile;
+   static SIMLOCAL long First = 1;
 
    if (First) {
       First       = 0;
@@ -1178,8 +1182,8 @@ void OrbPropReport(void)
 /*********************************************************************/
 void GmatReport(void)
 {
-   static FILE *outfile;
-   static long First = 1;
+   static SIMLOCAL FILE *outfile;
+   static SIMLOCAL long First = 1;
    long i;
 
    if (First) {
@@ -1198,8 +1202,8 @@ void GmatReport(void)
 /*********************************************************************/
 void PerturbReport(void)
 {
-   static FILE *perturbfile;
-   static long First = 1;
+   static SIMLOCAL FILE *perturbfile;
+   static SIMLOCAL long First = 1;
 
    if (First) {
       perturbfile = FileOpen(OutPath, "perturb.42", "wt");
@@ -1242,37 +1246,456 @@ void PerturbReport(void)
    fflush(perturbfile);
 }
 /*********************************************************************/
-void Report(void)
+/* Position and velocity in the world and region frames, and roll,   */
+/* pitch, yaw of body 0 relative to L, shared by both output formats */
+static void FindReportStates(struct SCType *S, double PosW[3], double VelW[3],
+                             double PosR[3], double VelR[3], double RPY[3])
+{
+   struct WorldType *W;
+   struct OrbitType *O;
+   double WorldAngVel[3], wxR[3], VelN[3];
+   double CBR[3][3], CRN[3][3];
+   double CRL[3][3] = {{1.0, 0.0, 0.0}, {0.0, 1.0, 0.0}, {0.0, 0.0, 1.0}};
+   long i;
+
+   O              = &Orb[S->RefOrb];
+   W              = &World[O->World];
+   WorldAngVel[0] = 0.0;
+   WorldAngVel[1] = 0.0;
+   WorldAngVel[2] = W->w;
+   VxV(WorldAngVel, S->PosN, wxR);
+   for (i = 0; i < 3; i++)
+      VelN[i] = S->VelN[i] - wxR[i];
+   MxV(W->CWN, S->PosN, PosW);
+   MxV(W->CWN, VelN, VelW);
+   if (O->Regime == ORB_FLIGHT) {
+      MxV(Rgn[O->Region].CN, S->PosR, PosR);
+      MxV(Rgn[O->Region].CN, S->VelR, VelR);
+   }
+   else {
+      for (i = 0; i < 3; i++) {
+         PosR[i] = S->PosR[i];
+         VelR[i] = S->VelR[i];
+      }
+   }
+   MxM(CRL, S->CLN, CRN);
+   MxMT(S->B[0].CN, CRN, CBR);
+   C2A(123, CBR, &RPY[0], &RPY[1], &RPY[2]);
+   for (i = 0; i < 3; i++)
+      RPY[i] *= R2D;
+}
+/*********************************************************************/
+/* Binary output.  Each OutFlag, the channels named in ReportChannels */
+/* are packed into one fixed-size record of doubles.  Records go     */
+/* through a single-producer, single-consumer ring to a writer       */
+/* thread, so the sim thread neither formats text nor waits on disk. */
+/* Report.42b starts with a header naming each channel and its       */
+/* units, then holds the records back to back.                       */
+#define REPORT_LOG_VERSION 1
+#define REPORT_LOG_NSLOT   256
+struct ReportChanType {
+   char Name[32];
+   char Units[16];
+};
+struct ReportLogType {
+   FILE *File;
+   long Defining; /* First pass lists channels instead of packing them */
+   long Nchan;
+   long MaxChan;
+   long Ichan; /* Next channel of the record being packed */
+   struct ReportChanType *Chan;
+   double *Ring;        /* REPORT_LOG_NSLOT records of Nchan doubles */
+   atomic_long Head;    /* Records published by the sim thread */
+   atomic_long Tail;    /* Records written by the writer thread */
+   atomic_int Sleeping; /* Writer is waiting on Cond */
+   long Shutdown;
+   pthread_t Thread;
+   pthread_mutex_t Mutex;
+   pthread_cond_t Cond;
+};
+static SIMLOCAL struct ReportLogType *ReportLog = NULL;
+/* File-less log holding one record, for Monte Carlo statistics */
+static SIMLOCAL struct ReportLogType *ReportProbe = NULL;
+/*********************************************************************/
+static void LogChan(struct ReportLogType *L, const char *Name,
+                    const char *Units, double Val)
+{
+   long Islot;
+
+   if (L->Defining) {
+      if (L->Nchan == L->MaxChan) {
+         L->MaxChan = (L->MaxChan > 0 ? 2 * L->MaxChan : 64);
+         L->Chan    = (struct ReportChanType *)realloc(
+             L->Chan, L->MaxChan * sizeof(struct ReportChanType));
+         if (L->Chan == NULL) {
+            fprintf(stderr, "Realloc failed in LogChan\n");
+            exit(EXIT_FAILURE);
+         }
+      }
+      memset(&L->Chan[L->Nchan], 0, sizeof(struct ReportChanType));
+      snprintf(L->Chan[L->Nchan].Name, sizeof(L->Chan[0].Name), "%s", Name);
+      snprintf(L->Chan[L->Nchan].Units, sizeof(L->Chan[0].Units), "%s",
+               Units);
+      L->Nchan++;
+   }
+   else {
+      if (L->Ichan >= L->Nchan) {
+         fprintf(stderr, "Report record overran its %ld channels.  Bailing "
+                         "out!\n",
+                 L->Nchan);
+         exit(EXIT_FAILURE);
+      }
+      Islot = atomic_load(&L->Head) % REPORT_LOG_NSLOT;
+      L->Ring[Islot * L->Nchan + L->Ichan] = Val;
+      L->Ichan++;
+   }
+}
+/*********************************************************************/
+/* 3-vectors get _X,_Y,_Z suffixes, others their index               */
+static void LogVec(struct ReportLogType *L, const char *Name,
+                   const char *Units, const double *V, long N)
+{
+   const char Axis[3] = {'X', 'Y', 'Z'};
+   char s[40];
+   long i;
+
+   for (i = 0; i < N; i++) {
+      if (N == 3)
+         snprintf(s, sizeof(s), "%s_%c", Name, Axis[i]);
+      else
+         snprintf(s, sizeof(s), "%s_%ld", Name, i);
+      LogChan(L, s, Units, V[i]);
+   }
+}
+/*********************************************************************/
+/* The binary record.  Called once with L->Defining set to build the */
+/* header, then once per OutFlag, so the two always agree.           */
+static void ReportChannels(struct ReportLogType *L)
+{
+   struct SCType *S;
+   struct DynType *D;
+   double PosW[3], VelW[3], PosR[3], VelR[3], RPY[3];
+   double UtcVec[6];
+   char s[40];
+   long Isc, i;
+
+   LogChan(L, "SimTime", "sec", SimTime);
+   LogChan(L, "DynTime", "sec", DynTime);
+   UtcVec[0] = UTC.Year;
+   UtcVec[1] = UTC.Month;
+   UtcVec[2] = UTC.Day;
+   UtcVec[3] = UTC.Hour;
+   UtcVec[4] = UTC.Minute;
+   UtcVec[5] = UTC.Second;
+   LogVec(L, "UTC", "", UtcVec, 6);
+
+   for (Isc = 0; Isc < Nsc; Isc++) {
+      S = &SC[Isc];
+      if (!S->Exists)
+         continue;
+      D = &S->Dyn;
+      snprintf(s, sizeof(s), "u%02ld", Isc);
+      LogVec(L, s, "", D->u, D->Nu);
+      snprintf(s, sizeof(s), "x%02ld", Isc);
+      LogVec(L, s, "", D->x, D->Nx);
+      if (S->FlexActive) {
+         snprintf(s, sizeof(s), "uf%02ld", Isc);
+         LogVec(L, s, "", D->uf, D->Nf);
+         snprintf(s, sizeof(s), "xf%02ld", Isc);
+         LogVec(L, s, "", D->xf, D->Nf);
+      }
+      if (S->ConstraintsRequested) {
+         snprintf(s, sizeof(s), "Constraint%02ld", Isc);
+         LogVec(L, s, "", D->GenConstraintFrc, D->Nc);
+      }
+   }
+
+   if (!SC[0].Exists)
+      return;
+   S = &SC[0];
+   FindReportStates(S, PosW, VelW, PosR, VelR, RPY);
+   LogVec(L, "PosN", "m", S->PosN, 3);
+   LogVec(L, "VelN", "m/sec", S->VelN, 3);
+   LogVec(L, "PosW", "m", PosW, 3);
+   LogVec(L, "VelW", "m/sec", VelW, 3);
+   LogVec(L, "PosR", "m", PosR, 3);
+   LogVec(L, "VelR", "m/sec", VelR, 3);
+   LogVec(L, "qbn", "", S->B[0].qn, 4);
+   LogVec(L, "wbn", "rad/sec", S->B[0].wn, 3);
+   LogVec(L, "bvn", "T", S->bvn, 3);
+   LogVec(L, "bvb", "T", S->bvb, 3);
+   LogVec(L, "Hvn", "Nms", S->Hvn, 3);
+   LogVec(L, "Hvb", "Nms", S->Hvb, 3);
+   LogVec(L, "svn", "", S->svn, 3);
+   LogVec(L, "svb", "", S->svb, 3);
+   LogChan(L, "KE", "J", FindTotalKineticEnergy(S));
+   LogVec(L, "RPY", "deg", RPY, 3);
+   for (i = 0; i < S->Nw; i++) {
+      snprintf(s, sizeof(s), "Hwhl_%ld", i);
+      LogChan(L, s, "Nms", S->Whl[i].H);
+   }
+   for (i = 0; i < S->Nmtb; i++) {
+      snprintf(s, sizeof(s), "MTB_%ld", i);
+      LogChan(L, s, "A-m^2", S->MTB[i].M);
+   }
+   for (i = 0; i < S->Nthr; i++) {
+      snprintf(s, sizeof(s), "Thr_%ld", i);
+      LogChan(L, s, "N", S->Thr[i].F);
+   }
+   for (i = 0; i < S->Nacc; i++) {
+      snprintf(s, sizeof(s), "AccTrue_%ld", i);
+      LogChan(L, s, "m/sec^2", S->Accel[i].TrueAcc);
+      snprintf(s, sizeof(s), "AccMeas_%ld", i);
+      LogChan(L, s, "m/sec^2", S->Accel[i].MeasAcc);
+   }
+   if (S->Ngps > 0)
+      LogVec(L, "GpsPosN", "m", S->GPS[0].PosN, 3);
+   for (i = 0; i < S->Ncss; i++) {
+      snprintf(s, sizeof(s), "Illum_%ld", i);
+      LogChan(L, s, "", S->CSS[i].Illum);
+      snprintf(s, sizeof(s), "Albedo_%ld", i);
+      LogChan(L, s, "", S->CSS[i].Albedo);
+   }
+   LogVec(L, "gravTrqB", "Nm", S->gravTrqB, 3);
+   LogVec(L, "gravTrqN", "Nm", S->gravTrqN, 3);
+   LogVec(L, "srpTrqB", "Nm", S->srpTrqB, 3);
+   LogVec(L, "srpTrqN", "Nm", S->srpTrqN, 3);
+   LogVec(L, "aeroTrqB", "Nm", S->aeroTrqB, 3);
+   LogVec(L, "aeroTrqN", "Nm", S->aeroTrqN, 3);
+   LogVec(L, "srpFrcB", "N", S->srpFrcB, 3);
+   LogVec(L, "srpFrcN", "N", S->srpFrcN, 3);
+   LogVec(L, "aeroFrcB", "N", S->aeroFrcB, 3);
+   LogVec(L, "aeroFrcN", "N", S->aeroFrcN, 3);
+}
+/*********************************************************************/
+static void *ReportLogWriter(void *Arg)
+{
+   struct ReportLogType *L = (struct ReportLogType *)Arg;
+   long Head, Tail, Islot, N, Done;
+
+   while (1) {
+      Tail = atomic_load(&L->Tail);
+      Head = atomic_load(&L->Head);
+      if (Head == Tail) {
+         pthread_mutex_lock(&L->Mutex);
+         atomic_store(&L->Sleeping, 1);
+         while (!L->Shutdown && atomic_load(&L->Head) == Tail)
+            pthread_cond_wait(&L->Cond, &L->Mutex);
+         atomic_store(&L->Sleeping, 0);
+         Done = (L->Shutdown && atomic_load(&L->Head) == Tail);
+         pthread_mutex_unlock(&L->Mutex);
+         if (Done)
+            break;
+         continue;
+      }
+      /* Write the contiguous run of records up to the end of the ring */
+      Islot = Tail % REPORT_LOG_NSLOT;
+      N     = Head - Tail;
+      if (N > REPORT_LOG_NSLOT - Islot)
+         N = REPORT_LOG_NSLOT - Islot;
+      fwrite(&L->Ring[Islot * L->Nchan], L->Nchan * sizeof(double), N,
+             L->File);
+      atomic_store(&L->Tail, Tail + N);
+   }
+   fflush(L->File);
+   return (NULL);
+}
+/*********************************************************************/
+static struct ReportLogType *OpenReportLog(void)
+{
+   struct ReportLogType *L;
+   const int32_t Version   = REPORT_LOG_VERSION;
+   const int32_t ByteOrder = 0x01020304;
+   int32_t Nchan;
+
+   L = (struct ReportLogType *)calloc(1, sizeof(struct ReportLogType));
+   if (L == NULL) {
+      fprintf(stderr, "OpenReportLog calloc returned null pointer.  Bailing "
+                      "out!\n");
+      exit(EXIT_FAILURE);
+   }
+   L->Defining = 1;
+   ReportChannels(L);
+   L->Defining = 0;
+   L->Ring = (double *)calloc(REPORT_LOG_NSLOT * (L->Nchan > 0 ? L->Nchan : 1),
+                              sizeof(double));
+   if (L->Ring == NULL) {
+      fprintf(stderr, "OpenReportLog calloc returned null pointer.  Bailing "
+                      "out!\n");
+      exit(EXIT_FAILURE);
+   }
+   atomic_init(&L->Head, 0);
+   atomic_init(&L->Tail, 0);
+   atomic_init(&L->Sleeping, 0);
+
+   L->File = FileOpen(OutPath, "Report.42b", "wb");
+   Nchan   = (int32_t)L->Nchan;
+   fwrite("42REPORT", 1, 8, L->File);
+   fwrite(&Version, sizeof(int32_t), 1, L->File);
+   fwrite(&ByteOrder, sizeof(int32_t), 1, L->File);
+   fwrite(&Nchan, sizeof(int32_t), 1, L->File);
+   fwrite(L->Chan, sizeof(struct ReportChanType), L->Nchan, L->File);
+
+   pthread_mutex_init(&L->Mutex, NULL);
+   pthread_cond_init(&L->Cond, NULL);
+   if (pthread_create(&L->Thread, NULL, ReportLogWriter, L)) {
+      fprintf(stderr, "Could not start Report writer thread.  Bailing out!\n");
+      exit(EXIT_FAILURE);
+   }
+#ifndef _REENTRANT_SIM_
+   /* The GUI ends the run by calling exit() */
+   atexit(ShutdownReport);
+#endif
+   return (L);
+}
+/*********************************************************************/
+static void BinaryReport(void)
+{
+   struct ReportLogType *L;
+
+   if (ReportLog == NULL)
+      ReportLog = OpenReportLog();
+   L = ReportLog;
+
+   /* Wait for the writer only if it has fallen a whole ring behind */
+   while (atomic_load(&L->Head) - atomic_load(&L->Tail) >= REPORT_LOG_NSLOT)
+      sched_yield();
+   L->Ichan = 0;
+   ReportChannels(L);
+   if (L->Ichan != L->Nchan) {
+      fprintf(stderr, "Report record has %ld of its %ld channels.  Bailing "
+                      "out!\n",
+              L->Ichan, L->Nchan);
+      exit(EXIT_FAILURE);
+   }
+   atomic_fetch_add(&L->Head, 1);
+   if (atomic_load(&L->Sleeping)) {
+      pthread_mutex_lock(&L->Mutex);
+      pthread_cond_signal(&L->Cond);
+      pthread_mutex_unlock(&L->Mutex);
+   }
+}
+/*********************************************************************/
+static void ShutdownReportProbe(void)
+{
+   if (ReportProbe == NULL)
+      return;
+   free(ReportProbe->Ring);
+   free(ReportProbe->Chan);
+   free(ReportProbe);
+   ReportProbe = NULL;
+}
+/*********************************************************************/
+/* Drains the ring and closes Report.42b.  Safe to call more than    */
+/* once.                                                             */
+void ShutdownReport(void)
+{
+   struct ReportLogType *L = ReportLog;
+
+   ShutdownReportProbe();
+   if (L == NULL)
+      return;
+   ReportLog = NULL;
+
+   pthread_mutex_lock(&L->Mutex);
+   L->Shutdown = 1;
+   pthread_cond_signal(&L->Cond);
+   pthread_mutex_unlock(&L->Mutex);
+   pthread_join(L->Thread, NULL);
+   pthread_cond_destroy(&L->Cond);
+   pthread_mutex_destroy(&L->Mutex);
+
+   fclose(L->File);
+   free(L->Ring);
+   free(L->Chan);
+   free(L);
+}
+/*********************************************************************/
+static struct ReportLogType *OpenReportProbe(void)
+{
+   struct ReportLogType *L;
+
+   L = (struct ReportLogType *)calloc(1, sizeof(struct ReportLogType));
+   if (L == NULL) {
+      fprintf(stderr, "OpenReportProbe calloc returned null pointer.  "
+                      "Bailing out!\n");
+      exit(EXIT_FAILURE);
+   }
+   L->Defining = 1;
+   ReportChannels(L);
+   L->Defining = 0;
+   L->Ring     = (double *)calloc(L->Nchan > 0 ? L->Nchan : 1, sizeof(double));
+   if (L->Ring == NULL) {
+      fprintf(stderr, "OpenReportProbe calloc returned null pointer.  "
+                      "Bailing out!\n");
+      exit(EXIT_FAILURE);
+   }
+   atomic_init(&L->Head, 0);
+   atomic_init(&L->Tail, 0);
+   return (L);
+}
+/*********************************************************************/
+/* Index of the named channel in the Report.42b record, or -1.       */
+/* Valid once the case is initialized.                               */
+long ReportChannelIndex(const char *Name)
+{
+   long i;
+
+   if (ReportProbe == NULL)
+      ReportProbe = OpenReportProbe();
+   for (i = 0; i < ReportProbe->Nchan; i++) {
+      if (!strcmp(ReportProbe->Chan[i].Name, Name))
+         return (i);
+   }
+   return (-1);
+}
+/*********************************************************************/
+/* The current record, laid out as in Report.42b */
+const double *ReportChannelValues(void)
 {
-   static FILE *timefile, *DynTimeFile, *UtcDateFile;
-   static FILE **xfile, **ufile, **xffile, **uffile;
-   static FILE **ConstraintFile;
-   static FILE *PosNfile, *VelNfile, *qbnfile, *wbnfile;
-   static FILE *PosWfile, *VelWfile;
-   static FILE *PosRfile, *VelRfile;
-   static FILE *bvnfile, *bvbfile;
-   static FILE *Hvnfile, *KEfile;
-   static FILE *Hvbfile;
-   static FILE *svnfile, *svbfile;
-   static FILE *RPYfile;
-   static FILE *Hwhlfile;
-   static FILE *MTBfile;
-   static FILE *Thrfile;
-   static FILE *AlbedoFile;
-   static FILE *IllumFile;
+   struct ReportLogType *L;
+
+   if (ReportProbe == NULL)
+      ReportProbe = OpenReportProbe();
+   L        = ReportProbe;
+   L->Ichan = 0;
+   ReportChannels(L);
+   if (L->Ichan != L->Nchan) {
+      fprintf(stderr, "Report record has %ld of its %ld channels.  Bailing "
+                      "out!\n",
+              L->Ichan, L->Nchan);
+      exit(EXIT_FAILURE);
+   }
+   return (L->Ring);
+}
+/*********************************************************************/
+static void TextReport(void)
+{
+   static SIMLOCAL FILE *timefile, *DynTimeFile, *UtcDateFile;
+   static SIMLOCAL FILE **xfile, **ufile, **xffile, **uffile;
+   static SIMLOCAL FILE **ConstraintFile;
+   static SIMLOCAL FILE *PosNfile, *VelNfile, *qbnfile, *wbnfile;
+   static SIMLOCAL FILE *PosWfile, *VelWfile;
+   static SIMLOCAL FILE *PosRfile, *VelRfile;
+   static SIMLOCAL FILE *bvnfile, *bvbfile;
+   static SIMLOCAL FILE *Hvnfile, *KEfile;
+   static SIMLOCAL FILE *Hvbfile;
+   static SIMLOCAL FILE *svnfile, *svbfile;
+   static SIMLOCAL FILE *RPYfile;
+   static SIMLOCAL FILE *Hwhlfile;
+   static SIMLOCAL FILE *MTBfile;
+   static SIMLOCAL FILE *Thrfile;
+   static SIMLOCAL FILE *AlbedoFile;
+   static SIMLOCAL FILE *IllumFile;
    // static FILE *ProjAreaFile;
-   static FILE *AccFile;
-   static FILE *GpsFile;
+   static SIMLOCAL FILE *AccFile;
+   static SIMLOCAL FILE *GpsFile;
    // static FILE *Kepfile;
    // static FILE *EHfile;
-   static char First = TRUE;
+   static SIMLOCAL char First = TRUE;
    long Isc, i;
    struct DynType *D;
-   double CBR[3][3], CRN[3][3], Roll, Pitch, Yaw;
-   struct WorldType *W;
-   double WorldAngVel[3], wxR[3], VelN[3];
-   double PosW[3], VelW[3], PosR[3], VelR[3];
-   double CRL[3][3] = {{1.0, 0.0, 0.0}, {0.0, 1.0, 0.0}, {0.0, 0.0, 1.0}};
+   double PosW[3], VelW[3], PosR[3], VelR[3], RPY[3];
    // double SMA,ecc,inc,RAAN,ArgP,anom,tp,SLR,alpha,rmin,MeanMotion,Period;
    char s[40];
    // double ZAxis[3] = {0.0,0.0,1.0};
@@ -1382,31 +1805,13 @@ void Report(void)
                  SC[0].PosN[2]);
          fprintf(VelNfile, "%le %le %le\n", SC[0].VelN[0], SC[0].VelN[1],
                  SC[0].VelN[2]);
-         W              = &World[Orb[SC[0].RefOrb].World];
-         WorldAngVel[0] = 0.0;
-         WorldAngVel[1] = 0.0;
-         WorldAngVel[2] = W->w;
-         VxV(WorldAngVel, SC[0].PosN, wxR);
-         for (i = 0; i < 3; i++)
-            VelN[i] = SC[0].VelN[i] - wxR[i];
-         MxV(W->CWN, SC[0].PosN, PosW);
-         MxV(W->CWN, VelN, VelW);
+         FindReportStates(&SC[0], PosW, VelW, PosR, VelR, RPY);
          fprintf(PosWfile, "%18.36le %18.36le %18.36le\n", PosW[0], PosW[1],
                  PosW[2]);
          fprintf(VelWfile, "%18.36le %18.36le %18.36le\n", VelW[0], VelW[1],
                  VelW[2]);
-         if (Orb[SC[0].RefOrb].Regime == ORB_FLIGHT) {
-            MxV(Rgn[Orb[SC[0].RefOrb].Region].CN, SC[0].PosR, PosR);
-            MxV(Rgn[Orb[SC[0].RefOrb].Region].CN, SC[0].VelR, VelR);
-            fprintf(PosRfile, "%le %le %le\n", PosR[0], PosR[1], PosR[2]);
-            fprintf(VelRfile, "%le %le %le\n", VelR[0], VelR[1], VelR[2]);
-         }
-         else {
-            fprintf(PosRfile, "%le %le %le\n", SC[0].PosR[0], SC[0].PosR[1],
-                    SC[0].PosR[2]);
-            fprintf(VelRfile, "%le %le %le\n", SC[0].VelR[0], SC[0].VelR[1],
-                    SC[0].VelR[2]);
-         }
+         fprintf(PosRfile, "%le %le %le\n", PosR[0], PosR[1], PosR[2]);
+         fprintf(VelRfile, "%le %le %le\n", VelR[0], VelR[1], VelR[2]);
          fprintf(qbnfile, "%le %le %le %le\n", SC[0].B[0].qn[0],
                  SC[0].B[0].qn[1], SC[0].B[0].qn[2], SC[0].B[0].qn[3]);
          fprintf(wbnfile, "%le %le %le\n", SC[0].B[0].wn[0], SC[0].B[0].wn[1],
@@ -1427,10 +1832,7 @@ void Report(void)
          // fprintf(ProjAreaFile,"%18.36le %18.36le\n",
          //    FindTotalProjectedArea(&SC[0],ZAxis),
          //    FindTotalUnshadedProjectedArea(&SC[0],ZAxis));
-         MxM(CRL, SC[0].CLN, CRN);
-         MxMT(SC[0].B[0].CN, CRN, CBR);
-         C2A(123, CBR, &Roll, &Pitch, &Yaw);
-         fprintf(RPYfile, "%le %le %le\n", Roll * R2D, Pitch * R2D, Yaw * R2D);
+         fprintf(RPYfile, "%le %le %le\n", RPY[0], RPY[1], RPY[2]);
          if (SC[0].Nw > 0) {
             for (i = 0; i < SC[0].Nw; i++) {
                fprintf(Hwhlfile, "%lf ", SC[0].Whl[i].H);
@@ -1471,37 +1873,49 @@ void Report(void)
          // OrbPropReport();
          // GmatReport();
          PerturbReport();
-
-         if (SC[0].DSM.Init == 1) {
-            // DSM_AC_AttitudeReport();
-
-            DSM_AttitudeReport();
-            // DSM_AC_InertialReport();
-            DSM_InertialReport();
-            DSM_RelativeReport();
-            DSM_NAV_StateReport();
-            // DSM_PlanetEphemReport();
-            DSM_ATT_ControlReport();
-            DSM_POS_ControlReport();
-            DSM_EphemReport();
-            DSM_WHLReport();
-            DSM_THRReport();
-            DSM_SVBReport();
-            // DSM_GroundTrackReport();
-            DSM_StateRot3BodyReport();
-            DSM_PosHReport();
-            DSM_Rot3BodyReport();
-         }
       }
    }
 
-   /* An example how to call specialized reporting based on sim case */
-   /* if (!strcmp(OutPath,"./Potato/")) PotatoReport(); */
-
    if (CleanUpFlag) {
       fclose(timefile);
    }
 }
+/*********************************************************************/
+void Report(void)
+{
+   if (OutputFormat & OUTPUT_TEXT)
+      TextReport();
+
+   if (OutFlag) {
+      if (OutputFormat & OUTPUT_BINARY)
+         BinaryReport();
+      SampleMonteCarlo();
+
+      if (SC[0].Exists && SC[0].DSM.Init == 1) {
+         // DSM_AC_AttitudeReport();
+
+         DSM_AttitudeReport();
+         // DSM_AC_InertialReport();
+         DSM_InertialReport();
+         DSM_RelativeReport();
+         DSM_NAV_StateReport();
+         // DSM_PlanetEphemReport();
+         DSM_ATT_ControlReport();
+         DSM_POS_ControlReport();
+         DSM_EphemReport();
+         DSM_WHLReport();
+         DSM_THRReport();
+         DSM_SVBReport();
+         // DSM_GroundTrackReport();
+         DSM_StateRot3BodyReport();
+         DSM_PosHReport();
+         DSM_Rot3BodyReport();
+      }
+   }
+
+   /* An example how to call specialized reporting based on sim case */
+   /* if (!strcmp(OutPath,"./Potato/")) PotatoReport(); */
+}
 
 /* #ifdef __cplusplus
 ** }
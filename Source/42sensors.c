@@ -90,16 +90,16 @@ void AccelerometerModel(struct SCType *S)
          AvgAcc     = A->DV / A->SampleTime;
          A->TrueAcc = AvgAcc + AccGG;
 
-         PrevBias = A->CorrCoef * A->Bias;
-         A->Bias  = PrevBias + A->BiasStabCoef * GaussianRandom(RNG);
-         A->AccError =
-             0.5 * (A->Bias + PrevBias) + A->DVRWCoef * GaussianRandom(RNG);
+         PrevBias    = A->CorrCoef * A->Bias;
+         A->Bias     = PrevBias + A->BiasStabCoef * GaussianStream(&A->Rng);
+         A->AccError = 0.5 * (A->Bias + PrevBias) +
+                       A->DVRWCoef * GaussianStream(&A->Rng);
 
          A->MeasAcc =
              Limit(A->Scale * A->TrueAcc + A->AccError, -A->MaxAcc, A->MaxAcc);
 
-         A->DV =
-             A->MeasAcc * A->SampleTime + A->DVNoiseCoef * GaussianRandom(RNG);
+         A->DV = A->MeasAcc * A->SampleTime +
+                 A->DVNoiseCoef * GaussianStream(&A->Rng);
 
          A->Counts = (long)(A->DV / A->SampleTime / A->Quant + 0.5);
 
@@ -134,17 +134,17 @@ void GyroModel(struct SCType *S)
          QTxV(N->qb, G->Axis, Axis);
          G->TrueRate = VoV(N->AngVelB, Axis);
 
-         PrevBias = G->CorrCoef * G->Bias;
-         G->Bias  = PrevBias + G->BiasStabCoef * GaussianRandom(RNG);
-         RateError =
-             0.5 * (G->Bias + PrevBias) + G->ARWCoef * GaussianRandom(RNG);
+         PrevBias  = G->CorrCoef * G->Bias;
+         G->Bias   = PrevBias + G->BiasStabCoef * GaussianStream(&G->Rng);
+         RateError = 0.5 * (G->Bias + PrevBias) +
+                     G->ARWCoef * GaussianStream(&G->Rng);
 
          G->MeasRate =
              Limit(G->Scale * G->TrueRate + RateError, -G->MaxRate, G->MaxRate);
 
          PrevAngle = G->Angle;
          G->Angle  = PrevAngle + G->MeasRate * G->SampleTime +
-                     G->AngNoiseCoef * GaussianRandom(RNG);
+                     G->AngNoiseCoef * GaussianStream(&G->Rng);
 
          PrevCounts = (long)(PrevAngle / G->Quant + 0.5);
          Counts     = (long)(G->Angle / G->Quant + 0.5);
@@ -174,7 +174,7 @@ void MagnetometerModel(struct SCType *S)
          MAG->SampleCounter = 0;
 
          Signal     = MAG->Scale * VoV(S->bvb, MAG->Axis) +
-                      MAG->Noise * GaussianRandom(RNG);
+                      MAG->Noise * GaussianStream(&MAG->Rng);
          Signal     = Limit(Signal, -MAG->Saturation, MAG->Saturation);
          Counts     = (long)(Signal / MAG->Quant + 0.5);
          MAG->Field = ((double)Counts) * MAG->Quant;
@@ -248,17 +248,10 @@ void CssModel(struct SCType *S)
 void FssModel(struct SCType *S)
 {
    struct FssType *FSS;
-   static struct RandomProcessType *FssNoise;
-   double svs[3], SunAng[2], Signal;
+   double svs[3], SunAng[2], Signal, Wn[2];
    long Counts;
-   static long First = 1;
    long Ifss, i;
 
-   if (First) {
-      First    = 0;
-      FssNoise = CreateRandomProcess(10);
-   }
-
    for (Ifss = 0; Ifss < S->Nfss; Ifss++) {
       FSS = &S->FSS[Ifss];
 
@@ -302,8 +295,9 @@ void FssModel(struct SCType *S)
          }
 
          if (FSS->Valid) {
+            GaussianStreamVec(&FSS->Rng, Wn, 2);
             for (i = 0; i < 2; i++) {
-               Signal         = SunAng[i] + FSS->NEA * GaussianRandom(FssNoise);
+               Signal         = SunAng[i] + FSS->NEA * Wn[i];
                Counts         = (long)(Signal / FSS->Quant + 0.5);
                FSS->SunAng[i] = ((double)Counts) * FSS->Quant;
             }
@@ -327,20 +321,13 @@ void StarTrackerModel(struct SCType *S)
 {
    struct StarTrackerType *ST;
    struct NodeType *N;
-   static struct RandomProcessType *StNoise;
    struct WorldType *W;
-   double qsn[4], Qnoise[4];
+   double qsn[4], Qnoise[4], Wn[3];
    double BoS, OrbRad, LimbAng, NadirVecB[3], BoN;
    double mvn[3], MoonDist, mvb[3], BoM;
    double qsb[4];
-   static long First = 1;
    long Ist, i;
 
-   if (First) {
-      First   = 0;
-      StNoise = CreateRandomProcess(1);
-   }
-
    for (Ist = 0; Ist < S->Nst; Ist++) {
       ST = &S->ST[Ist];
 
@@ -378,8 +365,9 @@ void StarTrackerModel(struct SCType *S)
             QxQ(ST->qb, N->qb, qsb);
             QxQ(qsb, S->B[0].qn, qsn);
             /* Add Noise in ST frame */
+            GaussianStreamVec(&ST->Rng, Wn, 3);
             for (i = 0; i < 3; i++)
-               Qnoise[i] = 0.5 * ST->NEA[i] * GaussianRandom(StNoise);
+               Qnoise[i] = 0.5 * ST->NEA[i] * Wn[i];
             Qnoise[3] = 1.0;
             UNITQ(Qnoise);
             QxQ(Qnoise, qsn, ST->qn);
@@ -399,17 +387,15 @@ void StarTrackerModel(struct SCType *S)
 void GpsModel(struct SCType *S)
 {
    struct GpsType *GPS;
-   static struct RandomProcessType *GpsNoise;
-   double PosW[3], MagPosW;
+   double PosW[3], MagPosW, Wn[7];
    long Ig, i;
-   static long First = 1;
+   static SIMLOCAL long First = 1;
 
    if (First) {
       // TODO: AC->Time needs to be initialized before DsmSensorModule() is
       // called, but not here if possible
       S->AC.Time = DynTime;
       First      = 0;
-      GpsNoise   = CreateRandomProcess(2);
    }
 
    if (Orb[S->RefOrb].World == EARTH) {
@@ -422,15 +408,16 @@ void GpsModel(struct SCType *S)
 
             GPS->Valid = TRUE;
 
+            /* Time, then interleaved pos/vel, as drawn one at a time */
+            GaussianStreamVec(&GPS->Rng, Wn, 7);
+
             GPS->Rollover = GpsRollover;
             GPS->Week     = GpsWeek;
-            GPS->Sec = GpsSecond + GPS->TimeNoise * GaussianRandom(GpsNoise);
+            GPS->Sec      = GpsSecond + GPS->TimeNoise * Wn[0];
 
             for (i = 0; i < 3; i++) {
-               GPS->PosN[i] =
-                   S->PosN[i] + GPS->PosNoise * GaussianRandom(GpsNoise);
-               GPS->VelN[i] =
-                   S->VelN[i] + GPS->VelNoise * GaussianRandom(GpsNoise);
+               GPS->PosN[i] = S->PosN[i] + GPS->PosNoise * Wn[1 + 2 * i];
+               GPS->VelN[i] = S->VelN[i] + GPS->VelNoise * Wn[2 + 2 * i];
             }
             MxV(World[EARTH].CWN, S->PosN, PosW);
             MxV(World[EARTH].CWN, GPS->PosN, GPS->PosW);
@@ -585,8 +572,8 @@ void SimpleFgsModel(struct FgsType *F, struct SCType *S)
       QxV(qbr, F->StarVecR, StarVecB);
       QxQ(F->qb, N->qb, qfb);
       QxV(qfb, StarVecB, StarVecF);
-      F->H = StarVecF[F->H_Axis] + F->NEA * GaussianRandom(RNG);
-      F->V = StarVecF[F->V_Axis] + F->NEA * GaussianRandom(RNG);
+      F->H = StarVecF[F->H_Axis] + F->NEA * GaussianStream(&F->Rng);
+      F->V = StarVecF[F->V_Axis] + F->NEA * GaussianStream(&F->Rng);
 
       F->Ang[F->BoreAxis] = 0.0;
       F->Ang[F->H_Axis]   = (F->V - F->Vr);
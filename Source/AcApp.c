@@ -25,6 +25,10 @@ extern void WriteToSocket(SOCKET Socket, struct AcType *AC);
 extern void ReadFromFile(FILE *StateFile, struct AcType *AC);
 extern void ReadFromGmsec(struct AcType *AC);
 extern void ReadFromSocket(SOCKET Socket, struct AcType *AC);
+extern void WriteToBinSocket(SOCKET Socket, struct AcType *AC);
+extern void ReadFromBinSocket(SOCKET Socket, struct AcType *AC);
+extern void WriteToShm(struct ShmLinkType *Shm, struct AcType *AC);
+extern void ReadFromShm(struct ShmLinkType *Shm, struct AcType *AC);
 
 #ifdef _AC_STANDALONE_
 /**********************************************************************/
@@ -508,14 +512,43 @@ void AcFsw(struct AcType *AC)
 }
 #ifdef _AC_STANDALONE_
 /**********************************************************************/
+/* The link to 42, chosen on the command line to match Inp_IPC.yaml:  */
+/* TEXT (default) or BINARY over a socket, or SHM for binary frames   */
+/* over shared memory                                                 */
+struct AcLinkType {
+   long Binary;
+   SOCKET Socket;
+   struct ShmLinkType *Shm;
+};
+/**********************************************************************/
+void WriteMsg(struct AcLinkType *L, struct AcType *AC)
+{
+   if (L->Shm != NULL)
+      WriteToShm(L->Shm, AC);
+   else if (L->Binary)
+      WriteToBinSocket(L->Socket, AC);
+   else
+      WriteToSocket(L->Socket, AC);
+}
+/**********************************************************************/
+void ReadMsg(struct AcLinkType *L, struct AcType *AC)
+{
+   if (L->Shm != NULL)
+      ReadFromShm(L->Shm, AC);
+   else if (L->Binary)
+      ReadFromBinSocket(L->Socket, AC);
+   else
+      ReadFromSocket(L->Socket, AC);
+}
+/**********************************************************************/
 int main(int argc, char **argv)
 {
    FILE *ParmDumpFile;
    char FileName[120];
    struct AcType AC;
-   SOCKET Socket;
-   char hostname[20] = "localhost";
-   int Port          = 10001;
+   struct AcLinkType Link = {0};
+   char hostname[20]      = "localhost";
+   int Port               = 10001;
 
    if (argc > 1) {
       AC.ID = atoi(argv[1]);
@@ -524,11 +557,17 @@ int main(int argc, char **argv)
 
    AllocateAC(&AC);
 
-   Socket = InitSocketClient(hostname, Port, 1);
+   if (argc > 2 && !strcmp(argv[2], "SHM")) {
+      Link.Shm = InitShmClient(Port, 1);
+   }
+   else {
+      Link.Binary = (argc > 2 && !strcmp(argv[2], "BINARY"));
+      Link.Socket = InitSocketClient(hostname, Port, 1);
+   }
 
    /* Load parms */
    AC.EchoEnabled = 1;
-   ReadFromSocket(Socket, &AC);
+   ReadMsg(&Link, &AC);
 
    InitAC(&AC);
    AcFsw(&AC);
@@ -537,12 +576,12 @@ int main(int argc, char **argv)
    ParmDumpFile = fopen(FileName, "wt");
    WriteToFile(ParmDumpFile, &AC);
    fclose(ParmDumpFile);
-   WriteToSocket(Socket, &AC);
+   WriteMsg(&Link, &AC);
 
    while (1) {
-      ReadFromSocket(Socket, &AC);
+      ReadMsg(&Link, &AC);
       AcFsw(&AC);
-      WriteToSocket(Socket, &AC);
+      WriteMsg(&Link, &AC);
    }
 
    return (0);
@@ -0,0 +1,713 @@
+/* Note:  This file was autogenerated by Database/JsonToIPC.py */
+/*        See Database/Readme.txt for details. */
+/*        If you are hand-modifying this file, keep in mind that */
+/*        your work will be lost if you run JsonToIPC.py again. */
+
+#include "Ac.h"
+#include <stdint.h>
+
+#define IPC_NFIELD 350
+#define IPC_MAGIC 0x34324950
+#define IPC_SCHEMA 0x8a7e4f07
+
+struct IpcFieldType {
+   const char *Name; /* As in the text protocol */
+   long Nidx;
+   long Nval;
+};
+static const struct IpcFieldType IpcField[IPC_NFIELD] = {
+   {"TIME",0,5},
+   {"SC[%ld].PosR",1,3},
+   {"SC[%ld].VelR",1,3},
+   {"SC[%ld].svb",1,3},
+   {"SC[%ld].bvb",1,3},
+   {"SC[%ld].Hvb",1,3},
+   {"SC[%ld].AC.ID",1,1},
+   {"SC[%ld].AC.EchoEnabled",1,1},
+   {"SC[%ld].AC.ParmLoadEnabled",1,1},
+   {"SC[%ld].AC.ParmDumpEnabled",1,1},
+   {"SC[%ld].AC.Nb",1,1},
+   {"SC[%ld].AC.Ng",1,1},
+   {"SC[%ld].AC.Nwhl",1,1},
+   {"SC[%ld].AC.Nmtb",1,1},
+   {"SC[%ld].AC.Nthr",1,1},
+   {"SC[%ld].AC.Ncmg",1,1},
+   {"SC[%ld].AC.Ngyro",1,1},
+   {"SC[%ld].AC.Nmag",1,1},
+   {"SC[%ld].AC.Ncss",1,1},
+   {"SC[%ld].AC.Nfss",1,1},
+   {"SC[%ld].AC.Nst",1,1},
+   {"SC[%ld].AC.Ngps",1,1},
+   {"SC[%ld].AC.Nacc",1,1},
+   {"SC[%ld].AC.Pi",1,1},
+   {"SC[%ld].AC.TwoPi",1,1},
+   {"SC[%ld].AC.DT",1,1},
+   {"SC[%ld].AC.mass",1,1},
+   {"SC[%ld].AC.cm",1,3},
+   {"SC[%ld].AC.MOI",1,9},
+   {"SC[%ld].AC.svb",1,3},
+   {"SC[%ld].AC.bvb",1,3},
+   {"SC[%ld].AC.Hvb",1,3},
+   {"SC[%ld].AC.B[%ld].mass",2,1},
+   {"SC[%ld].AC.B[%ld].cm",2,3},
+   {"SC[%ld].AC.B[%ld].MOI",2,9},
+   {"SC[%ld].AC.G[%ld].IsSpherical",2,1},
+   {"SC[%ld].AC.G[%ld].RotDOF",2,1},
+   {"SC[%ld].AC.G[%ld].TrnDOF",2,1},
+   {"SC[%ld].AC.G[%ld].RotSeq",2,1},
+   {"SC[%ld].AC.G[%ld].TrnSeq",2,1},
+   {"SC[%ld].AC.G[%ld].CGiBi",2,9},
+   {"SC[%ld].AC.G[%ld].CBoGo",2,9},
+   {"SC[%ld].AC.G[%ld].AngGain",2,3},
+   {"SC[%ld].AC.G[%ld].AngRateGain",2,3},
+   {"SC[%ld].AC.G[%ld].PosGain",2,3},
+   {"SC[%ld].AC.G[%ld].PosRateGain",2,3},
+   {"SC[%ld].AC.G[%ld].MaxAngRate",2,3},
+   {"SC[%ld].AC.G[%ld].MaxPosRate",2,3},
+   {"SC[%ld].AC.G[%ld].MaxTrq",2,3},
+   {"SC[%ld].AC.G[%ld].MaxFrc",2,3},
+   {"SC[%ld].AC.G[%ld].Ang",2,3},
+   {"SC[%ld].AC.G[%ld].Cmd.AngRate",2,3},
+   {"SC[%ld].AC.G[%ld].Cmd.Ang",2,3},
+   {"SC[%ld].AC.Gyro[%ld].Axis",2,3},
+   {"SC[%ld].AC.Gyro[%ld].Rate",2,1},
+   {"SC[%ld].AC.MAG[%ld].Axis",2,3},
+   {"SC[%ld].AC.MAG[%ld].Field",2,1},
+   {"SC[%ld].AC.CSS[%ld].Body",2,1},
+   {"SC[%ld].AC.CSS[%ld].Axis",2,3},
+   {"SC[%ld].AC.CSS[%ld].Scale",2,1},
+   {"SC[%ld].AC.CSS[%ld].Valid",2,1},
+   {"SC[%ld].AC.CSS[%ld].Illum",2,1},
+   {"SC[%ld].AC.FSS[%ld].qb",2,4},
+   {"SC[%ld].AC.FSS[%ld].CB",2,9},
+   {"SC[%ld].AC.FSS[%ld].Valid",2,1},
+   {"SC[%ld].AC.FSS[%ld].SunAng",2,2},
+   {"SC[%ld].AC.ST[%ld].qb",2,4},
+   {"SC[%ld].AC.ST[%ld].CB",2,9},
+   {"SC[%ld].AC.ST[%ld].Valid",2,1},
+   {"SC[%ld].AC.ST[%ld].qn",2,4},
+   {"SC[%ld].AC.GPS[%ld].Valid",2,1},
+   {"SC[%ld].AC.GPS[%ld].Rollover",2,1},
+   {"SC[%ld].AC.GPS[%ld].Week",2,1},
+   {"SC[%ld].AC.GPS[%ld].Sec",2,1},
+   {"SC[%ld].AC.GPS[%ld].PosN",2,3},
+   {"SC[%ld].AC.GPS[%ld].VelN",2,3},
+   {"SC[%ld].AC.GPS[%ld].PosW",2,3},
+   {"SC[%ld].AC.GPS[%ld].VelW",2,3},
+   {"SC[%ld].AC.GPS[%ld].Lng",2,1},
+   {"SC[%ld].AC.GPS[%ld].Lat",2,1},
+   {"SC[%ld].AC.GPS[%ld].Alt",2,1},
+   {"SC[%ld].AC.GPS[%ld].WgsLng",2,1},
+   {"SC[%ld].AC.GPS[%ld].WgsLat",2,1},
+   {"SC[%ld].AC.GPS[%ld].WgsAlt",2,1},
+   {"SC[%ld].AC.Accel[%ld].PosB",2,3},
+   {"SC[%ld].AC.Accel[%ld].Axis",2,3},
+   {"SC[%ld].AC.Accel[%ld].Acc",2,1},
+   {"SC[%ld].AC.Whl[%ld].Body",2,1},
+   {"SC[%ld].AC.Whl[%ld].Axis",2,3},
+   {"SC[%ld].AC.Whl[%ld].DistVec",2,3},
+   {"SC[%ld].AC.Whl[%ld].J",2,1},
+   {"SC[%ld].AC.Whl[%ld].Tmax",2,1},
+   {"SC[%ld].AC.Whl[%ld].Hmax",2,1},
+   {"SC[%ld].AC.Whl[%ld].H",2,1},
+   {"SC[%ld].AC.Whl[%ld].Tcmd",2,1},
+   {"SC[%ld].AC.MTB[%ld].Axis",2,3},
+   {"SC[%ld].AC.MTB[%ld].DistVec",2,3},
+   {"SC[%ld].AC.MTB[%ld].Mmax",2,1},
+   {"SC[%ld].AC.MTB[%ld].Mcmd",2,1},
+   {"SC[%ld].AC.Thr[%ld].Body",2,1},
+   {"SC[%ld].AC.Thr[%ld].PosB",2,3},
+   {"SC[%ld].AC.Thr[%ld].Axis",2,3},
+   {"SC[%ld].AC.Thr[%ld].rxA",2,3},
+   {"SC[%ld].AC.Thr[%ld].Fmax",2,1},
+   {"SC[%ld].AC.Thr[%ld].PulseWidthCmd",2,1},
+   {"SC[%ld].AC.Thr[%ld].ThrustLevelCmd",2,1},
+   {"SC[%ld].AC.PrototypeCtrl.wc",1,1},
+   {"SC[%ld].AC.PrototypeCtrl.amax",1,1},
+   {"SC[%ld].AC.PrototypeCtrl.vmax",1,1},
+   {"SC[%ld].AC.PrototypeCtrl.Kprec",1,1},
+   {"SC[%ld].AC.PrototypeCtrl.Knute",1,1},
+   {"SC[%ld].AC.AdHocCtrl.Kr",1,3},
+   {"SC[%ld].AC.AdHocCtrl.Kp",1,3},
+   {"SC[%ld].AC.SpinnerCtrl.Ispin",1,1},
+   {"SC[%ld].AC.SpinnerCtrl.Itrans",1,1},
+   {"SC[%ld].AC.SpinnerCtrl.SpinRate",1,1},
+   {"SC[%ld].AC.SpinnerCtrl.Knute",1,1},
+   {"SC[%ld].AC.SpinnerCtrl.Kprec",1,1},
+   {"SC[%ld].AC.ThreeAxisCtrl.Kr",1,3},
+   {"SC[%ld].AC.ThreeAxisCtrl.Kp",1,3},
+   {"SC[%ld].AC.ThreeAxisCtrl.Kunl",1,1},
+   {"SC[%ld].AC.IssCtrl.Kr",1,3},
+   {"SC[%ld].AC.IssCtrl.Kp",1,3},
+   {"SC[%ld].AC.IssCtrl.Tmax",1,1},
+   {"SC[%ld].AC.CmgCtrl.Kr",1,3},
+   {"SC[%ld].AC.CmgCtrl.Kp",1,3},
+   {"SC[%ld].AC.ThrCtrl.Kw",1,3},
+   {"SC[%ld].AC.ThrCtrl.Kth",1,3},
+   {"SC[%ld].AC.ThrCtrl.Kv",1,1},
+   {"SC[%ld].AC.ThrCtrl.Kp",1,1},
+   {"SC[%ld].AC.CfsCtrl.Kr",1,3},
+   {"SC[%ld].AC.CfsCtrl.Kp",1,3},
+   {"SC[%ld].AC.CfsCtrl.Kunl",1,1},
+   {"SC[%ld].AC.ThrSteerCtrl.Kr",1,3},
+   {"SC[%ld].AC.ThrSteerCtrl.Kp",1,3},
+   {"SC[%ld].AC.Cmd.AngRate",1,3},
+   {"SC[%ld].AC.Cmd.Ang",1,3},
+   {"SC[%ld].B[%ld].wn",2,3},
+   {"SC[%ld].B[%ld].qn",2,4},
+   {"SC[%ld].G[%ld].Pos",2,3},
+   {"SC[%ld].G[%ld].PosRate",2,3},
+   {"SC[%ld].G[%ld].Ang",2,3},
+   {"SC[%ld].G[%ld].AngRate",2,3},
+   {"SC[%ld].GN.Pos",1,3},
+   {"SC[%ld].GN.PosRate",1,3},
+   {"SC[%ld].GN.Ang",1,3},
+   {"SC[%ld].GN.AngRate",1,3},
+   {"SC[%ld].Whl[%ld].H",2,1},
+   {"SC[%ld].Gyro[%ld].SampleTime",2,1},
+   {"SC[%ld].Gyro[%ld].MaxCounter",2,1},
+   {"SC[%ld].Gyro[%ld].Axis",2,3},
+   {"SC[%ld].Gyro[%ld].MaxRate",2,1},
+   {"SC[%ld].Gyro[%ld].Scale",2,1},
+   {"SC[%ld].Gyro[%ld].Quant",2,1},
+   {"SC[%ld].Gyro[%ld].SigV",2,1},
+   {"SC[%ld].Gyro[%ld].SigU",2,1},
+   {"SC[%ld].Gyro[%ld].SigE",2,1},
+   {"SC[%ld].Gyro[%ld].Node",2,1},
+   {"SC[%ld].Gyro[%ld].BiasStabCoef",2,1},
+   {"SC[%ld].Gyro[%ld].ARWCoef",2,1},
+   {"SC[%ld].Gyro[%ld].AngNoiseCoef",2,1},
+   {"SC[%ld].Gyro[%ld].CorrCoef",2,1},
+   {"SC[%ld].Gyro[%ld].TrueRate",2,1},
+   {"SC[%ld].MAG[%ld].SampleTime",2,1},
+   {"SC[%ld].MAG[%ld].MaxCounter",2,1},
+   {"SC[%ld].MAG[%ld].Axis",2,3},
+   {"SC[%ld].MAG[%ld].Saturation",2,1},
+   {"SC[%ld].MAG[%ld].Scale",2,1},
+   {"SC[%ld].MAG[%ld].Quant",2,1},
+   {"SC[%ld].MAG[%ld].Noise",2,1},
+   {"SC[%ld].MAG[%ld].Node",2,1},
+   {"SC[%ld].CSS[%ld].SampleTime",2,1},
+   {"SC[%ld].CSS[%ld].MaxCounter",2,1},
+   {"SC[%ld].CSS[%ld].Body",2,1},
+   {"SC[%ld].CSS[%ld].Axis",2,3},
+   {"SC[%ld].CSS[%ld].FovHalfAng",2,1},
+   {"SC[%ld].CSS[%ld].CosFov",2,1},
+   {"SC[%ld].CSS[%ld].Scale",2,1},
+   {"SC[%ld].CSS[%ld].Quant",2,1},
+   {"SC[%ld].CSS[%ld].Node",2,1},
+   {"SC[%ld].FSS[%ld].SampleTime",2,1},
+   {"SC[%ld].FSS[%ld].MaxCounter",2,1},
+   {"SC[%ld].FSS[%ld].qb",2,4},
+   {"SC[%ld].FSS[%ld].CB",2,9},
+   {"SC[%ld].FSS[%ld].FovHalfAng",2,2},
+   {"SC[%ld].FSS[%ld].NEA",2,1},
+   {"SC[%ld].FSS[%ld].Quant",2,1},
+   {"SC[%ld].FSS[%ld].Node",2,1},
+   {"SC[%ld].FSS[%ld].BoreAxis",2,1},
+   {"SC[%ld].FSS[%ld].H_Axis",2,1},
+   {"SC[%ld].FSS[%ld].V_Axis",2,1},
+   {"SC[%ld].ST[%ld].SampleTime",2,1},
+   {"SC[%ld].ST[%ld].MaxCounter",2,1},
+   {"SC[%ld].ST[%ld].qb",2,4},
+   {"SC[%ld].ST[%ld].CB",2,9},
+   {"SC[%ld].ST[%ld].FovHalfAng",2,2},
+   {"SC[%ld].ST[%ld].CosFov",2,2},
+   {"SC[%ld].ST[%ld].SunExclAng",2,1},
+   {"SC[%ld].ST[%ld].CosSunExclAng",2,1},
+   {"SC[%ld].ST[%ld].EarthExclAng",2,1},
+   {"SC[%ld].ST[%ld].CosEarthExclAng",2,1},
+   {"SC[%ld].ST[%ld].MoonExclAng",2,1},
+   {"SC[%ld].ST[%ld].CosMoonExclAng",2,1},
+   {"SC[%ld].ST[%ld].NEA",2,3},
+   {"SC[%ld].ST[%ld].Node",2,1},
+   {"SC[%ld].ST[%ld].BoreAxis",2,1},
+   {"SC[%ld].ST[%ld].H_Axis",2,1},
+   {"SC[%ld].ST[%ld].V_Axis",2,1},
+   {"SC[%ld].GPS[%ld].SampleTime",2,1},
+   {"SC[%ld].GPS[%ld].MaxCounter",2,1},
+   {"SC[%ld].GPS[%ld].PosNoise",2,1},
+   {"SC[%ld].GPS[%ld].VelNoise",2,1},
+   {"SC[%ld].GPS[%ld].TimeNoise",2,1},
+   {"SC[%ld].GPS[%ld].Node",2,1},
+   {"SC[%ld].Accel[%ld].SampleTime",2,1},
+   {"SC[%ld].Accel[%ld].SampleCounter",2,1},
+   {"SC[%ld].Accel[%ld].MaxCounter",2,1},
+   {"SC[%ld].Accel[%ld].Node",2,1},
+   {"SC[%ld].Accel[%ld].Axis",2,3},
+   {"SC[%ld].Accel[%ld].Quant",2,1},
+   {"SC[%ld].Accel[%ld].Scale",2,1},
+   {"SC[%ld].Accel[%ld].SigV",2,1},
+   {"SC[%ld].Accel[%ld].SigU",2,1},
+   {"SC[%ld].Accel[%ld].SigE",2,1},
+   {"SC[%ld].Shaker[%ld].Body",2,1},
+   {"SC[%ld].Shaker[%ld].Node",2,1},
+   {"SC[%ld].Shaker[%ld].FrcTrq",2,1},
+   {"SC[%ld].Shaker[%ld].Axis",2,3},
+   {"SC[%ld].Shaker[%ld].Ntone",2,1},
+   {"SC[%ld].Shaker[%ld].RandomActive",2,1},
+   {"SC[%ld].Shaker[%ld].ToneAmp",2,1},
+   {"SC[%ld].Shaker[%ld].ToneFreq",2,1},
+   {"SC[%ld].Shaker[%ld].TonePhase",2,1},
+   {"SC[%ld].Shaker[%ld].LowBandLimit",2,1},
+   {"SC[%ld].Shaker[%ld].HighBandLimit",2,1},
+   {"SC[%ld].Shaker[%ld].RandStd",2,1},
+   {"Orb[%ld].Tag",1,1},
+   {"Orb[%ld].Exists",1,1},
+   {"Orb[%ld].Epoch",1,1},
+   {"Orb[%ld].Regime",1,1},
+   {"Orb[%ld].PolyhedronGravityEnabled",1,1},
+   {"Orb[%ld].World",1,1},
+   {"Orb[%ld].Region",1,1},
+   {"Orb[%ld].Sys",1,1},
+   {"Orb[%ld].LP",1,1},
+   {"Orb[%ld].Body1",1,1},
+   {"Orb[%ld].Body2",1,1},
+   {"Orb[%ld].mu1",1,1},
+   {"Orb[%ld].mu2",1,1},
+   {"Orb[%ld].LagDOF",1,1},
+   {"Orb[%ld].Ax",1,1},
+   {"Orb[%ld].Bx",1,1},
+   {"Orb[%ld].Cx",1,1},
+   {"Orb[%ld].Dx",1,1},
+   {"Orb[%ld].Ay",1,1},
+   {"Orb[%ld].By",1,1},
+   {"Orb[%ld].Cy",1,1},
+   {"Orb[%ld].Dy",1,1},
+   {"Orb[%ld].Az",1,1},
+   {"Orb[%ld].Bz",1,1},
+   {"Orb[%ld].mu",1,1},
+   {"Orb[%ld].SMA",1,1},
+   {"Orb[%ld].ecc",1,1},
+   {"Orb[%ld].inc",1,1},
+   {"Orb[%ld].RAAN",1,1},
+   {"Orb[%ld].ArgP",1,1},
+   {"Orb[%ld].tp",1,1},
+   {"Orb[%ld].alpha",1,1},
+   {"Orb[%ld].SLR",1,1},
+   {"Orb[%ld].rmin",1,1},
+   {"Orb[%ld].Period",1,1},
+   {"Orb[%ld].MeanMotion",1,1},
+   {"Orb[%ld].J2DriftEnabled",1,1},
+   {"Orb[%ld].MeanSMA",1,1},
+   {"Orb[%ld].RAAN0",1,1},
+   {"Orb[%ld].ArgP0",1,1},
+   {"Orb[%ld].MeanAnom0",1,1},
+   {"Orb[%ld].RAANdot",1,1},
+   {"Orb[%ld].ArgPdot",1,1},
+   {"Orb[%ld].J2Rw2bya",1,1},
+   {"Orb[%ld].PosN",1,3},
+   {"Orb[%ld].VelN",1,3},
+   {"World[%ld].Exists",1,1},
+   {"World[%ld].Type",1,1},
+   {"World[%ld].Parent",1,1},
+   {"World[%ld].Nsat",1,1},
+   {"World[%ld].Sat",1,1},
+   {"World[%ld].mu",1,1},
+   {"World[%ld].J2",1,1},
+   {"World[%ld].rad",1,1},
+   {"World[%ld].w",1,1},
+   {"World[%ld].PriMerAngJ2000",1,1},
+   {"World[%ld].RadOfInfluence",1,1},
+   {"World[%ld].DipoleMoment",1,1},
+   {"World[%ld].DipoleAxis",1,3},
+   {"World[%ld].DipoleOffset",1,3},
+   {"World[%ld].RingInner,",1,1},
+   {"World[%ld].Density",1,1},
+   {"World[%ld].HasRing",1,1},
+   {"World[%ld].GeomTag",1,1},
+   {"World[%ld].NearExtent,FarExtent",1,1},
+   {"World[%ld].CNH",1,9},
+   {"World[%ld].qnh",1,4},
+   {"World[%ld].PosH",1,3},
+   {"World[%ld].eph.Tag",1,1},
+   {"World[%ld].eph.Exists",1,1},
+   {"World[%ld].eph.Epoch",1,1},
+   {"World[%ld].eph.Regime",1,1},
+   {"World[%ld].eph.PolyhedronGravityEnabled",1,1},
+   {"World[%ld].eph.World",1,1},
+   {"World[%ld].eph.Region",1,1},
+   {"World[%ld].eph.Sys",1,1},
+   {"World[%ld].eph.LP",1,1},
+   {"World[%ld].eph.Body1",1,1},
+   {"World[%ld].eph.Body2",1,1},
+   {"World[%ld].eph.mu1",1,1},
+   {"World[%ld].eph.mu2",1,1},
+   {"World[%ld].eph.LagDOF",1,1},
+   {"World[%ld].eph.Ax",1,1},
+   {"World[%ld].eph.Bx",1,1},
+   {"World[%ld].eph.Cx",1,1},
+   {"World[%ld].eph.Dx",1,1},
+   {"World[%ld].eph.Ay",1,1},
+   {"World[%ld].eph.By",1,1},
+   {"World[%ld].eph.Cy",1,1},
+   {"World[%ld].eph.Dy",1,1},
+   {"World[%ld].eph.Az",1,1},
+   {"World[%ld].eph.Bz",1,1},
+   {"World[%ld].eph.mu",1,1},
+   {"World[%ld].eph.SMA",1,1},
+   {"World[%ld].eph.ecc",1,1},
+   {"World[%ld].eph.inc",1,1},
+   {"World[%ld].eph.RAAN",1,1},
+   {"World[%ld].eph.ArgP",1,1},
+   {"World[%ld].eph.tp",1,1},
+   {"World[%ld].eph.alpha",1,1},
+   {"World[%ld].eph.SLR",1,1},
+   {"World[%ld].eph.rmin",1,1},
+   {"World[%ld].eph.Period",1,1},
+   {"World[%ld].eph.MeanMotion",1,1},
+   {"World[%ld].eph.J2DriftEnabled",1,1},
+   {"World[%ld].eph.MeanSMA",1,1},
+   {"World[%ld].eph.RAAN0",1,1},
+   {"World[%ld].eph.ArgP0",1,1},
+   {"World[%ld].eph.MeanAnom0",1,1},
+   {"World[%ld].eph.RAANdot",1,1},
+   {"World[%ld].eph.ArgPdot",1,1},
+   {"World[%ld].eph.J2Rw2bya",1,1},
+   {"World[%ld].eph.PosN",1,3},
+   {"World[%ld].eph.VelN",1,3},
+};
+
+static char *IpcBuf = NULL;
+static long IpcBufSize = 0;
+static long IpcLen = 0;
+
+/**********************************************************************/
+static void IpcReserve(long N)
+{
+      if (IpcLen+N > IpcBufSize) {
+         IpcBufSize = 2*(IpcLen+N);
+         IpcBuf = (char *) realloc(IpcBuf,IpcBufSize);
+         if (IpcBuf == NULL) {
+            fprintf(stderr,"IPC buffer realloc failed.  Bailing out!\n");
+            exit(EXIT_FAILURE);
+         }
+      }
+}
+/**********************************************************************/
+static void IpcPutHdr(long Id, long I0, long I1, long I2)
+{
+      uint16_t Id16 = (uint16_t) Id;
+      int32_t Idx[3];
+      long Nidx = IpcField[Id].Nidx;
+
+      Idx[0] = (int32_t) I0;
+      Idx[1] = (int32_t) I1;
+      Idx[2] = (int32_t) I2;
+      IpcReserve(2+4*Nidx+8*IpcField[Id].Nval);
+      memcpy(&IpcBuf[IpcLen],&Id16,2);
+      memcpy(&IpcBuf[IpcLen+2],Idx,4*Nidx);
+      IpcLen += 2+4*Nidx;
+}
+/**********************************************************************/
+static void IpcPutDbl(const double *Val, long N)
+{
+      memcpy(&IpcBuf[IpcLen],Val,8*N);
+      IpcLen += 8*N;
+}
+/**********************************************************************/
+static void IpcPutLong(const long *Val, long N)
+{
+      int64_t Val64;
+      long k;
+
+      for(k=0;k<N;k++) {
+         Val64 = (int64_t) Val[k];
+         memcpy(&IpcBuf[IpcLen],&Val64,8);
+         IpcLen += 8;
+      }
+}
+/**********************************************************************/
+/* Builds one frame in IpcBuf, for whichever transport sends it */
+static void PackBinFrame(struct AcType *AC)
+{
+
+      long Isc,i;
+      uint32_t Hdr[3];
+
+      IpcLen = 0;
+      IpcReserve(12);
+      IpcLen = 12;
+
+      Isc = AC->ID;
+
+      IpcPutHdr(29,Isc,0,0);
+      IpcPutDbl(AC->svb,3);
+      IpcPutHdr(30,Isc,0,0);
+      IpcPutDbl(AC->bvb,3);
+      IpcPutHdr(31,Isc,0,0);
+      IpcPutDbl(AC->Hvb,3);
+      for(i=0;i<AC->Ng;i++) {
+         IpcPutHdr(51,Isc,i,0);
+         IpcPutDbl(AC->G[i].Cmd.AngRate,3);
+         IpcPutHdr(52,Isc,i,0);
+         IpcPutDbl(AC->G[i].Cmd.Ang,3);
+      }
+
+      for(i=0;i<AC->Nwhl;i++) {
+         IpcPutHdr(94,Isc,i,0);
+         IpcPutDbl(&AC->Whl[i].Tcmd,1);
+      }
+
+      for(i=0;i<AC->Nmtb;i++) {
+         IpcPutHdr(98,Isc,i,0);
+         IpcPutDbl(&AC->MTB[i].Mcmd,1);
+      }
+
+      for(i=0;i<AC->Nthr;i++) {
+         IpcPutHdr(104,Isc,i,0);
+         IpcPutDbl(&AC->Thr[i].PulseWidthCmd,1);
+         IpcPutHdr(105,Isc,i,0);
+         IpcPutDbl(&AC->Thr[i].ThrustLevelCmd,1);
+      }
+
+      IpcPutHdr(135,Isc,0,0);
+      IpcPutDbl(AC->Cmd.AngRate,3);
+      IpcPutHdr(136,Isc,0,0);
+      IpcPutDbl(AC->Cmd.Ang,3);
+      if (AC->ParmDumpEnabled) {
+         IpcPutHdr(6,Isc,0,0);
+         IpcPutLong(&AC->ID,1);
+         IpcPutHdr(7,Isc,0,0);
+         IpcPutLong(&AC->EchoEnabled,1);
+         IpcPutHdr(10,Isc,0,0);
+         IpcPutLong(&AC->Nb,1);
+         IpcPutHdr(11,Isc,0,0);
+         IpcPutLong(&AC->Ng,1);
+         IpcPutHdr(12,Isc,0,0);
+         IpcPutLong(&AC->Nwhl,1);
+         IpcPutHdr(13,Isc,0,0);
+         IpcPutLong(&AC->Nmtb,1);
+         IpcPutHdr(14,Isc,0,0);
+         IpcPutLong(&AC->Nthr,1);
+         IpcPutHdr(15,Isc,0,0);
+         IpcPutLong(&AC->Ncmg,1);
+         IpcPutHdr(16,Isc,0,0);
+         IpcPutLong(&AC->Ngyro,1);
+         IpcPutHdr(17,Isc,0,0);
+         IpcPutLong(&AC->Nmag,1);
+         IpcPutHdr(18,Isc,0,0);
+         IpcPutLong(&AC->Ncss,1);
+         IpcPutHdr(19,Isc,0,0);
+         IpcPutLong(&AC->Nfss,1);
+         IpcPutHdr(20,Isc,0,0);
+         IpcPutLong(&AC->Nst,1);
+         IpcPutHdr(21,Isc,0,0);
+         IpcPutLong(&AC->Ngps,1);
+         IpcPutHdr(22,Isc,0,0);
+         IpcPutLong(&AC->Nacc,1);
+         IpcPutHdr(23,Isc,0,0);
+         IpcPutDbl(&AC->Pi,1);
+         IpcPutHdr(24,Isc,0,0);
+         IpcPutDbl(&AC->TwoPi,1);
+         IpcPutHdr(25,Isc,0,0);
+         IpcPutDbl(&AC->DT,1);
+         IpcPutHdr(26,Isc,0,0);
+         IpcPutDbl(&AC->mass,1);
+         IpcPutHdr(27,Isc,0,0);
+         IpcPutDbl(AC->cm,3);
+         IpcPutHdr(28,Isc,0,0);
+         IpcPutDbl(&AC->MOI[0][0],9);
+         for(i=0;i<AC->Nb;i++) {
+            IpcPutHdr(32,Isc,i,0);
+            IpcPutDbl(&AC->B[i].mass,1);
+            IpcPutHdr(33,Isc,i,0);
+            IpcPutDbl(AC->B[i].cm,3);
+            IpcPutHdr(34,Isc,i,0);
+            IpcPutDbl(&AC->B[i].MOI[0][0],9);
+         }
+
+         for(i=0;i<AC->Ng;i++) {
+            IpcPutHdr(35,Isc,i,0);
+            IpcPutLong(&AC->G[i].IsSpherical,1);
+            IpcPutHdr(36,Isc,i,0);
+            IpcPutLong(&AC->G[i].RotDOF,1);
+            IpcPutHdr(37,Isc,i,0);
+            IpcPutLong(&AC->G[i].TrnDOF,1);
+            IpcPutHdr(38,Isc,i,0);
+            IpcPutLong(&AC->G[i].RotSeq,1);
+            IpcPutHdr(39,Isc,i,0);
+            IpcPutLong(&AC->G[i].TrnSeq,1);
+            IpcPutHdr(40,Isc,i,0);
+            IpcPutDbl(&AC->G[i].CGiBi[0][0],9);
+            IpcPutHdr(41,Isc,i,0);
+            IpcPutDbl(&AC->G[i].CBoGo[0][0],9);
+            IpcPutHdr(42,Isc,i,0);
+            IpcPutDbl(AC->G[i].AngGain,3);
+            IpcPutHdr(43,Isc,i,0);
+            IpcPutDbl(AC->G[i].AngRateGain,3);
+            IpcPutHdr(44,Isc,i,0);
+            IpcPutDbl(AC->G[i].PosGain,3);
+            IpcPutHdr(45,Isc,i,0);
+            IpcPutDbl(AC->G[i].PosRateGain,3);
+            IpcPutHdr(46,Isc,i,0);
+            IpcPutDbl(AC->G[i].MaxAngRate,3);
+            IpcPutHdr(47,Isc,i,0);
+            IpcPutDbl(AC->G[i].MaxPosRate,3);
+            IpcPutHdr(48,Isc,i,0);
+            IpcPutDbl(AC->G[i].MaxTrq,3);
+            IpcPutHdr(49,Isc,i,0);
+            IpcPutDbl(AC->G[i].MaxFrc,3);
+         }
+
+         for(i=0;i<AC->Ngyro;i++) {
+            IpcPutHdr(53,Isc,i,0);
+            IpcPutDbl(AC->Gyro[i].Axis,3);
+         }
+
+         for(i=0;i<AC->Nmag;i++) {
+            IpcPutHdr(55,Isc,i,0);
+            IpcPutDbl(AC->MAG[i].Axis,3);
+         }
+
+         for(i=0;i<AC->Ncss;i++) {
+            IpcPutHdr(57,Isc,i,0);
+            IpcPutLong(&AC->CSS[i].Body,1);
+            IpcPutHdr(58,Isc,i,0);
+            IpcPutDbl(AC->CSS[i].Axis,3);
+            IpcPutHdr(59,Isc,i,0);
+            IpcPutDbl(&AC->CSS[i].Scale,1);
+         }
+
+         for(i=0;i<AC->Nfss;i++) {
+            IpcPutHdr(62,Isc,i,0);
+            IpcPutDbl(AC->FSS[i].qb,4);
+            IpcPutHdr(63,Isc,i,0);
+            IpcPutDbl(&AC->FSS[i].CB[0][0],9);
+         }
+
+         for(i=0;i<AC->Nst;i++) {
+            IpcPutHdr(66,Isc,i,0);
+            IpcPutDbl(AC->ST[i].qb,4);
+            IpcPutHdr(67,Isc,i,0);
+            IpcPutDbl(&AC->ST[i].CB[0][0],9);
+         }
+
+         for(i=0;i<AC->Nacc;i++) {
+            IpcPutHdr(84,Isc,i,0);
+            IpcPutDbl(AC->Accel[i].PosB,3);
+            IpcPutHdr(85,Isc,i,0);
+            IpcPutDbl(AC->Accel[i].Axis,3);
+         }
+
+         for(i=0;i<AC->Nwhl;i++) {
+            IpcPutHdr(87,Isc,i,0);
+            IpcPutLong(&AC->Whl[i].Body,1);
+            IpcPutHdr(88,Isc,i,0);
+            IpcPutDbl(AC->Whl[i].Axis,3);
+            IpcPutHdr(89,Isc,i,0);
+            IpcPutDbl(AC->Whl[i].DistVec,3);
+            IpcPutHdr(90,Isc,i,0);
+            IpcPutDbl(&AC->Whl[i].J,1);
+            IpcPutHdr(91,Isc,i,0);
+            IpcPutDbl(&AC->Whl[i].Tmax,1);
+            IpcPutHdr(92,Isc,i,0);
+            IpcPutDbl(&AC->Whl[i].Hmax,1);
+         }
+
+         for(i=0;i<AC->Nmtb;i++) {
+            IpcPutHdr(95,Isc,i,0);
+            IpcPutDbl(AC->MTB[i].Axis,3);
+            IpcPutHdr(96,Isc,i,0);
+            IpcPutDbl(AC->MTB[i].DistVec,3);
+            IpcPutHdr(97,Isc,i,0);
+            IpcPutDbl(&AC->MTB[i].Mmax,1);
+         }
+
+         for(i=0;i<AC->Nthr;i++) {
+            IpcPutHdr(99,Isc,i,0);
+            IpcPutLong(&AC->Thr[i].Body,1);
+            IpcPutHdr(100,Isc,i,0);
+            IpcPutDbl(AC->Thr[i].PosB,3);
+            IpcPutHdr(101,Isc,i,0);
+            IpcPutDbl(AC->Thr[i].Axis,3);
+            IpcPutHdr(102,Isc,i,0);
+            IpcPutDbl(AC->Thr[i].rxA,3);
+            IpcPutHdr(103,Isc,i,0);
+            IpcPutDbl(&AC->Thr[i].Fmax,1);
+         }
+
+         IpcPutHdr(106,Isc,0,0);
+         IpcPutDbl(&AC->PrototypeCtrl.wc,1);
+         IpcPutHdr(107,Isc,0,0);
+         IpcPutDbl(&AC->PrototypeCtrl.amax,1);
+         IpcPutHdr(108,Isc,0,0);
+         IpcPutDbl(&AC->PrototypeCtrl.vmax,1);
+         IpcPutHdr(109,Isc,0,0);
+         IpcPutDbl(&AC->PrototypeCtrl.Kprec,1);
+         IpcPutHdr(110,Isc,0,0);
+         IpcPutDbl(&AC->PrototypeCtrl.Knute,1);
+         IpcPutHdr(111,Isc,0,0);
+         IpcPutDbl(AC->AdHocCtrl.Kr,3);
+         IpcPutHdr(112,Isc,0,0);
+         IpcPutDbl(AC->AdHocCtrl.Kp,3);
+         IpcPutHdr(113,Isc,0,0);
+         IpcPutDbl(&AC->SpinnerCtrl.Ispin,1);
+         IpcPutHdr(114,Isc,0,0);
+         IpcPutDbl(&AC->SpinnerCtrl.Itrans,1);
+         IpcPutHdr(115,Isc,0,0);
+         IpcPutDbl(&AC->SpinnerCtrl.SpinRate,1);
+         IpcPutHdr(116,Isc,0,0);
+         IpcPutDbl(&AC->SpinnerCtrl.Knute,1);
+         IpcPutHdr(117,Isc,0,0);
+         IpcPutDbl(&AC->SpinnerCtrl.Kprec,1);
+         IpcPutHdr(118,Isc,0,0);
+         IpcPutDbl(AC->ThreeAxisCtrl.Kr,3);
+         IpcPutHdr(119,Isc,0,0);
+         IpcPutDbl(AC->ThreeAxisCtrl.Kp,3);
+         IpcPutHdr(120,Isc,0,0);
+         IpcPutDbl(&AC->ThreeAxisCtrl.Kunl,1);
+         IpcPutHdr(121,Isc,0,0);
+         IpcPutDbl(AC->IssCtrl.Kr,3);
+         IpcPutHdr(122,Isc,0,0);
+         IpcPutDbl(AC->IssCtrl.Kp,3);
+         IpcPutHdr(123,Isc,0,0);
+         IpcPutDbl(&AC->IssCtrl.Tmax,1);
+         IpcPutHdr(124,Isc,0,0);
+         IpcPutDbl(AC->CmgCtrl.Kr,3);
+         IpcPutHdr(125,Isc,0,0);
+         IpcPutDbl(AC->CmgCtrl.Kp,3);
+         IpcPutHdr(126,Isc,0,0);
+         IpcPutDbl(AC->ThrCtrl.Kw,3);
+         IpcPutHdr(127,Isc,0,0);
+         IpcPutDbl(AC->ThrCtrl.Kth,3);
+         IpcPutHdr(128,Isc,0,0);
+         IpcPutDbl(&AC->ThrCtrl.Kv,1);
+         IpcPutHdr(129,Isc,0,0);
+         IpcPutDbl(&AC->ThrCtrl.Kp,1);
+         IpcPutHdr(130,Isc,0,0);
+         IpcPutDbl(AC->CfsCtrl.Kr,3);
+         IpcPutHdr(131,Isc,0,0);
+         IpcPutDbl(AC->CfsCtrl.Kp,3);
+         IpcPutHdr(132,Isc,0,0);
+         IpcPutDbl(&AC->CfsCtrl.Kunl,1);
+         IpcPutHdr(133,Isc,0,0);
+         IpcPutDbl(AC->ThrSteerCtrl.Kr,3);
+         IpcPutHdr(134,Isc,0,0);
+         IpcPutDbl(AC->ThrSteerCtrl.Kp,3);
+      }
+
+      Hdr[0] = IPC_MAGIC;
+      Hdr[1] = IPC_SCHEMA;
+      Hdr[2] = (uint32_t) (IpcLen-12);
+      memcpy(IpcBuf,Hdr,12);
+      if (AC->EchoEnabled) printf("Binary IPC frame, %ld bytes\n",IpcLen);
+}
+/**********************************************************************/
+void WriteToBinSocket(SOCKET Socket, struct AcType *AC)
+{
+      char AckMsg[5] = "Ack\n";
+
+      PackBinFrame(AC);
+      send(Socket,IpcBuf,IpcLen,0);
+
+      /* Wait for Ack */
+      recv(Socket,AckMsg,5,0);
+}
+/**********************************************************************/
+/* No Ack: ShmSend waits whenever the ring is full */
+void WriteToShm(struct ShmLinkType *Shm, struct AcType *AC)
+{
+      PackBinFrame(AC);
+      ShmSend(Shm,IpcBuf,IpcLen);
+}
@@ -0,0 +1,1454 @@
+/* Note:  This file was autogenerated by Database/JsonToIPC.py */
+/*        See Database/Readme.txt for details. */
+/*        If you are hand-modifying this file, keep in mind that */
+/*        your work will be lost if you run JsonToIPC.py again. */
+
+#include "42.h"
+#include <stdint.h>
+
+#define IPC_NFIELD 350
+#define IPC_MAGIC 0x34324950
+#define IPC_SCHEMA 0x8a7e4f07
+
+struct IpcFieldType {
+   const char *Name; /* As in the text protocol */
+   long Nidx;
+   long Nval;
+};
+static const struct IpcFieldType IpcField[IPC_NFIELD] = {
+   {"TIME",0,5},
+   {"SC[%ld].PosR",1,3},
+   {"SC[%ld].VelR",1,3},
+   {"SC[%ld].svb",1,3},
+   {"SC[%ld].bvb",1,3},
+   {"SC[%ld].Hvb",1,3},
+   {"SC[%ld].AC.ID",1,1},
+   {"SC[%ld].AC.EchoEnabled",1,1},
+   {"SC[%ld].AC.ParmLoadEnabled",1,1},
+   {"SC[%ld].AC.ParmDumpEnabled",1,1},
+   {"SC[%ld].AC.Nb",1,1},
+   {"SC[%ld].AC.Ng",1,1},
+   {"SC[%ld].AC.Nwhl",1,1},
+   {"SC[%ld].AC.Nmtb",1,1},
+   {"SC[%ld].AC.Nthr",1,1},
+   {"SC[%ld].AC.Ncmg",1,1},
+   {"SC[%ld].AC.Ngyro",1,1},
+   {"SC[%ld].AC.Nmag",1,1},
+   {"SC[%ld].AC.Ncss",1,1},
+   {"SC[%ld].AC.Nfss",1,1},
+   {"SC[%ld].AC.Nst",1,1},
+   {"SC[%ld].AC.Ngps",1,1},
+   {"SC[%ld].AC.Nacc",1,1},
+   {"SC[%ld].AC.Pi",1,1},
+   {"SC[%ld].AC.TwoPi",1,1},
+   {"SC[%ld].AC.DT",1,1},
+   {"SC[%ld].AC.mass",1,1},
+   {"SC[%ld].AC.cm",1,3},
+   {"SC[%ld].AC.MOI",1,9},
+   {"SC[%ld].AC.svb",1,3},
+   {"SC[%ld].AC.bvb",1,3},
+   {"SC[%ld].AC.Hvb",1,3},
+   {"SC[%ld].AC.B[%ld].mass",2,1},
+   {"SC[%ld].AC.B[%ld].cm",2,3},
+   {"SC[%ld].AC.B[%ld].MOI",2,9},
+   {"SC[%ld].AC.G[%ld].IsSpherical",2,1},
+   {"SC[%ld].AC.G[%ld].RotDOF",2,1},
+   {"SC[%ld].AC.G[%ld].TrnDOF",2,1},
+   {"SC[%ld].AC.G[%ld].RotSeq",2,1},
+   {"SC[%ld].AC.G[%ld].TrnSeq",2,1},
+   {"SC[%ld].AC.G[%ld].CGiBi",2,9},
+   {"SC[%ld].AC.G[%ld].CBoGo",2,9},
+   {"SC[%ld].AC.G[%ld].AngGain",2,3},
+   {"SC[%ld].AC.G[%ld].AngRateGain",2,3},
+   {"SC[%ld].AC.G[%ld].PosGain",2,3},
+   {"SC[%ld].AC.G[%ld].PosRateGain",2,3},
+   {"SC[%ld].AC.G[%ld].MaxAngRate",2,3},
+   {"SC[%ld].AC.G[%ld].MaxPosRate",2,3},
+   {"SC[%ld].AC.G[%ld].MaxTrq",2,3},
+   {"SC[%ld].AC.G[%ld].MaxFrc",2,3},
+   {"SC[%ld].AC.G[%ld].Ang",2,3},
+   {"SC[%ld].AC.G[%ld].Cmd.AngRate",2,3},
+   {"SC[%ld].AC.G[%ld].Cmd.Ang",2,3},
+   {"SC[%ld].AC.Gyro[%ld].Axis",2,3},
+   {"SC[%ld].AC.Gyro[%ld].Rate",2,1},
+   {"SC[%ld].AC.MAG[%ld].Axis",2,3},
+   {"SC[%ld].AC.MAG[%ld].Field",2,1},
+   {"SC[%ld].AC.CSS[%ld].Body",2,1},
+   {"SC[%ld].AC.CSS[%ld].Axis",2,3},
+   {"SC[%ld].AC.CSS[%ld].Scale",2,1},
+   {"SC[%ld].AC.CSS[%ld].Valid",2,1},
+   {"SC[%ld].AC.CSS[%ld].Illum",2,1},
+   {"SC[%ld].AC.FSS[%ld].qb",2,4},
+   {"SC[%ld].AC.FSS[%ld].CB",2,9},
+   {"SC[%ld].AC.FSS[%ld].Valid",2,1},
+   {"SC[%ld].AC.FSS[%ld].SunAng",2,2},
+   {"SC[%ld].AC.ST[%ld].qb",2,4},
+   {"SC[%ld].AC.ST[%ld].CB",2,9},
+   {"SC[%ld].AC.ST[%ld].Valid",2,1},
+   {"SC[%ld].AC.ST[%ld].qn",2,4},
+   {"SC[%ld].AC.GPS[%ld].Valid",2,1},
+   {"SC[%ld].AC.GPS[%ld].Rollover",2,1},
+   {"SC[%ld].AC.GPS[%ld].Week",2,1},
+   {"SC[%ld].AC.GPS[%ld].Sec",2,1},
+   {"SC[%ld].AC.GPS[%ld].PosN",2,3},
+   {"SC[%ld].AC.GPS[%ld].VelN",2,3},
+   {"SC[%ld].AC.GPS[%ld].PosW",2,3},
+   {"SC[%ld].AC.GPS[%ld].VelW",2,3},
+   {"SC[%ld].AC.GPS[%ld].Lng",2,1},
+   {"SC[%ld].AC.GPS[%ld].Lat",2,1},
+   {"SC[%ld].AC.GPS[%ld].Alt",2,1},
+   {"SC[%ld].AC.GPS[%ld].WgsLng",2,1},
+   {"SC[%ld].AC.GPS[%ld].WgsLat",2,1},
+   {"SC[%ld].AC.GPS[%ld].WgsAlt",2,1},
+   {"SC[%ld].AC.Accel[%ld].PosB",2,3},
+   {"SC[%ld].AC.Accel[%ld].Axis",2,3},
+   {"SC[%ld].AC.Accel[%ld].Acc",2,1},
+   {"SC[%ld].AC.Whl[%ld].Body",2,1},
+   {"SC[%ld].AC.Whl[%ld].Axis",2,3},
+   {"SC[%ld].AC.Whl[%ld].DistVec",2,3},
+   {"SC[%ld].AC.Whl[%ld].J",2,1},
+   {"SC[%ld].AC.Whl[%ld].Tmax",2,1},
+   {"SC[%ld].AC.Whl[%ld].Hmax",2,1},
+   {"SC[%ld].AC.Whl[%ld].H",2,1},
+   {"SC[%ld].AC.Whl[%ld].Tcmd",2,1},
+   {"SC[%ld].AC.MTB[%ld].Axis",2,3},
+   {"SC[%ld].AC.MTB[%ld].DistVec",2,3},
+   {"SC[%ld].AC.MTB[%ld].Mmax",2,1},
+   {"SC[%ld].AC.MTB[%ld].Mcmd",2,1},
+   {"SC[%ld].AC.Thr[%ld].Body",2,1},
+   {"SC[%ld].AC.Thr[%ld].PosB",2,3},
+   {"SC[%ld].AC.Thr[%ld].Axis",2,3},
+   {"SC[%ld].AC.Thr[%ld].rxA",2,3},
+   {"SC[%ld].AC.Thr[%ld].Fmax",2,1},
+   {"SC[%ld].AC.Thr[%ld].PulseWidthCmd",2,1},
+   {"SC[%ld].AC.Thr[%ld].ThrustLevelCmd",2,1},
+   {"SC[%ld].AC.PrototypeCtrl.wc",1,1},
+   {"SC[%ld].AC.PrototypeCtrl.amax",1,1},
+   {"SC[%ld].AC.PrototypeCtrl.vmax",1,1},
+   {"SC[%ld].AC.PrototypeCtrl.Kprec",1,1},
+   {"SC[%ld].AC.PrototypeCtrl.Knute",1,1},
+   {"SC[%ld].AC.AdHocCtrl.Kr",1,3},
+   {"SC[%ld].AC.AdHocCtrl.Kp",1,3},
+   {"SC[%ld].AC.SpinnerCtrl.Ispin",1,1},
+   {"SC[%ld].AC.SpinnerCtrl.Itrans",1,1},
+   {"SC[%ld].AC.SpinnerCtrl.SpinRate",1,1},
+   {"SC[%ld].AC.SpinnerCtrl.Knute",1,1},
+   {"SC[%ld].AC.SpinnerCtrl.Kprec",1,1},
+   {"SC[%ld].AC.ThreeAxisCtrl.Kr",1,3},
+   {"SC[%ld].AC.ThreeAxisCtrl.Kp",1,3},
+   {"SC[%ld].AC.ThreeAxisCtrl.Kunl",1,1},
+   {"SC[%ld].AC.IssCtrl.Kr",1,3},
+   {"SC[%ld].AC.IssCtrl.Kp",1,3},
+   {"SC[%ld].AC.IssCtrl.Tmax",1,1},
+   {"SC[%ld].AC.CmgCtrl.Kr",1,3},
+   {"SC[%ld].AC.CmgCtrl.Kp",1,3},
+   {"SC[%ld].AC.ThrCtrl.Kw",1,3},
+   {"SC[%ld].AC.ThrCtrl.Kth",1,3},
+   {"SC[%ld].AC.ThrCtrl.Kv",1,1},
+   {"SC[%ld].AC.ThrCtrl.Kp",1,1},
+   {"SC[%ld].AC.CfsCtrl.Kr",1,3},
+   {"SC[%ld].AC.CfsCtrl.Kp",1,3},
+   {"SC[%ld].AC.CfsCtrl.Kunl",1,1},
+   {"SC[%ld].AC.ThrSteerCtrl.Kr",1,3},
+   {"SC[%ld].AC.ThrSteerCtrl.Kp",1,3},
+   {"SC[%ld].AC.Cmd.AngRate",1,3},
+   {"SC[%ld].AC.Cmd.Ang",1,3},
+   {"SC[%ld].B[%ld].wn",2,3},
+   {"SC[%ld].B[%ld].qn",2,4},
+   {"SC[%ld].G[%ld].Pos",2,3},
+   {"SC[%ld].G[%ld].PosRate",2,3},
+   {"SC[%ld].G[%ld].Ang",2,3},
+   {"SC[%ld].G[%ld].AngRate",2,3},
+   {"SC[%ld].GN.Pos",1,3},
+   {"SC[%ld].GN.PosRate",1,3},
+   {"SC[%ld].GN.Ang",1,3},
+   {"SC[%ld].GN.AngRate",1,3},
+   {"SC[%ld].Whl[%ld].H",2,1},
+   {"SC[%ld].Gyro[%ld].SampleTime",2,1},
+   {"SC[%ld].Gyro[%ld].MaxCounter",2,1},
+   {"SC[%ld].Gyro[%ld].Axis",2,3},
+   {"SC[%ld].Gyro[%ld].MaxRate",2,1},
+   {"SC[%ld].Gyro[%ld].Scale",2,1},
+   {"SC[%ld].Gyro[%ld].Quant",2,1},
+   {"SC[%ld].Gyro[%ld].SigV",2,1},
+   {"SC[%ld].Gyro[%ld].SigU",2,1},
+   {"SC[%ld].Gyro[%ld].SigE",2,1},
+   {"SC[%ld].Gyro[%ld].Node",2,1},
+   {"SC[%ld].Gyro[%ld].BiasStabCoef",2,1},
+   {"SC[%ld].Gyro[%ld].ARWCoef",2,1},
+   {"SC[%ld].Gyro[%ld].AngNoiseCoef",2,1},
+   {"SC[%ld].Gyro[%ld].CorrCoef",2,1},
+   {"SC[%ld].Gyro[%ld].TrueRate",2,1},
+   {"SC[%ld].MAG[%ld].SampleTime",2,1},
+   {"SC[%ld].MAG[%ld].MaxCounter",2,1},
+   {"SC[%ld].MAG[%ld].Axis",2,3},
+   {"SC[%ld].MAG[%ld].Saturation",2,1},
+   {"SC[%ld].MAG[%ld].Scale",2,1},
+   {"SC[%ld].MAG[%ld].Quant",2,1},
+   {"SC[%ld].MAG[%ld].Noise",2,1},
+   {"SC[%ld].MAG[%ld].Node",2,1},
+   {"SC[%ld].CSS[%ld].SampleTime",2,1},
+   {"SC[%ld].CSS[%ld].MaxCounter",2,1},
+   {"SC[%ld].CSS[%ld].Body",2,1},
+   {"SC[%ld].CSS[%ld].Axis",2,3},
+   {"SC[%ld].CSS[%ld].FovHalfAng",2,1},
+   {"SC[%ld].CSS[%ld].CosFov",2,1},
+   {"SC[%ld].CSS[%ld].Scale",2,1},
+   {"SC[%ld].CSS[%ld].Quant",2,1},
+   {"SC[%ld].CSS[%ld].Node",2,1},
+   {"SC[%ld].FSS[%ld].SampleTime",2,1},
+   {"SC[%ld].FSS[%ld].MaxCounter",2,1},
+   {"SC[%ld].FSS[%ld].qb",2,4},
+   {"SC[%ld].FSS[%ld].CB",2,9},
+   {"SC[%ld].FSS[%ld].FovHalfAng",2,2},
+   {"SC[%ld].FSS[%ld].NEA",2,1},
+   {"SC[%ld].FSS[%ld].Quant",2,1},
+   {"SC[%ld].FSS[%ld].Node",2,1},
+   {"SC[%ld].FSS[%ld].BoreAxis",2,1},
+   {"SC[%ld].FSS[%ld].H_Axis",2,1},
+   {"SC[%ld].FSS[%ld].V_Axis",2,1},
+   {"SC[%ld].ST[%ld].SampleTime",2,1},
+   {"SC[%ld].ST[%ld].MaxCounter",2,1},
+   {"SC[%ld].ST[%ld].qb",2,4},
+   {"SC[%ld].ST[%ld].CB",2,9},
+   {"SC[%ld].ST[%ld].FovHalfAng",2,2},
+   {"SC[%ld].ST[%ld].CosFov",2,2},
+   {"SC[%ld].ST[%ld].SunExclAng",2,1},
+   {"SC[%ld].ST[%ld].CosSunExclAng",2,1},
+   {"SC[%ld].ST[%ld].EarthExclAng",2,1},
+   {"SC[%ld].ST[%ld].CosEarthExclAng",2,1},
+   {"SC[%ld].ST[%ld].MoonExclAng",2,1},
+   {"SC[%ld].ST[%ld].CosMoonExclAng",2,1},
+   {"SC[%ld].ST[%ld].NEA",2,3},
+   {"SC[%ld].ST[%ld].Node",2,1},
+   {"SC[%ld].ST[%ld].BoreAxis",2,1},
+   {"SC[%ld].ST[%ld].H_Axis",2,1},
+   {"SC[%ld].ST[%ld].V_Axis",2,1},
+   {"SC[%ld].GPS[%ld].SampleTime",2,1},
+   {"SC[%ld].GPS[%ld].MaxCounter",2,1},
+   {"SC[%ld].GPS[%ld].PosNoise",2,1},
+   {"SC[%ld].GPS[%ld].VelNoise",2,1},
+   {"SC[%ld].GPS[%ld].TimeNoise",2,1},
+   {"SC[%ld].GPS[%ld].Node",2,1},
+   {"SC[%ld].Accel[%ld].SampleTime",2,1},
+   {"SC[%ld].Accel[%ld].SampleCounter",2,1},
+   {"SC[%ld].Accel[%ld].MaxCounter",2,1},
+   {"SC[%ld].Accel[%ld].Node",2,1},
+   {"SC[%ld].Accel[%ld].Axis",2,3},
+   {"SC[%ld].Accel[%ld].Quant",2,1},
+   {"SC[%ld].Accel[%ld].Scale",2,1},
+   {"SC[%ld].Accel[%ld].SigV",2,1},
+   {"SC[%ld].Accel[%ld].SigU",2,1},
+   {"SC[%ld].Accel[%ld].SigE",2,1},
+   {"SC[%ld].Shaker[%ld].Body",2,1},
+   {"SC[%ld].Shaker[%ld].Node",2,1},
+   {"SC[%ld].Shaker[%ld].FrcTrq",2,1},
+   {"SC[%ld].Shaker[%ld].Axis",2,3},
+   {"SC[%ld].Shaker[%ld].Ntone",2,1},
+   {"SC[%ld].Shaker[%ld].RandomActive",2,1},
+   {"SC[%ld].Shaker[%ld].ToneAmp",2,1},
+   {"SC[%ld].Shaker[%ld].ToneFreq",2,1},
+   {"SC[%ld].Shaker[%ld].TonePhase",2,1},
+   {"SC[%ld].Shaker[%ld].LowBandLimit",2,1},
+   {"SC[%ld].Shaker[%ld].HighBandLimit",2,1},
+   {"SC[%ld].Shaker[%ld].RandStd",2,1},
+   {"Orb[%ld].Tag",1,1},
+   {"Orb[%ld].Exists",1,1},
+   {"Orb[%ld].Epoch",1,1},
+   {"Orb[%ld].Regime",1,1},
+   {"Orb[%ld].PolyhedronGravityEnabled",1,1},
+   {"Orb[%ld].World",1,1},
+   {"Orb[%ld].Region",1,1},
+   {"Orb[%ld].Sys",1,1},
+   {"Orb[%ld].LP",1,1},
+   {"Orb[%ld].Body1",1,1},
+   {"Orb[%ld].Body2",1,1},
+   {"Orb[%ld].mu1",1,1},
+   {"Orb[%ld].mu2",1,1},
+   {"Orb[%ld].LagDOF",1,1},
+   {"Orb[%ld].Ax",1,1},
+   {"Orb[%ld].Bx",1,1},
+   {"Orb[%ld].Cx",1,1},
+   {"Orb[%ld].Dx",1,1},
+   {"Orb[%ld].Ay",1,1},
+   {"Orb[%ld].By",1,1},
+   {"Orb[%ld].Cy",1,1},
+   {"Orb[%ld].Dy",1,1},
+   {"Orb[%ld].Az",1,1},
+   {"Orb[%ld].Bz",1,1},
+   {"Orb[%ld].mu",1,1},
+   {"Orb[%ld].SMA",1,1},
+   {"Orb[%ld].ecc",1,1},
+   {"Orb[%ld].inc",1,1},
+   {"Orb[%ld].RAAN",1,1},
+   {"Orb[%ld].ArgP",1,1},
+   {"Orb[%ld].tp",1,1},
+   {"Orb[%ld].alpha",1,1},
+   {"Orb[%ld].SLR",1,1},
+   {"Orb[%ld].rmin",1,1},
+   {"Orb[%ld].Period",1,1},
+   {"Orb[%ld].MeanMotion",1,1},
+   {"Orb[%ld].J2DriftEnabled",1,1},
+   {"Orb[%ld].MeanSMA",1,1},
+   {"Orb[%ld].RAAN0",1,1},
+   {"Orb[%ld].ArgP0",1,1},
+   {"Orb[%ld].MeanAnom0",1,1},
+   {"Orb[%ld].RAANdot",1,1},
+   {"Orb[%ld].ArgPdot",1,1},
+   {"Orb[%ld].J2Rw2bya",1,1},
+   {"Orb[%ld].PosN",1,3},
+   {"Orb[%ld].VelN",1,3},
+   {"World[%ld].Exists",1,1},
+   {"World[%ld].Type",1,1},
+   {"World[%ld].Parent",1,1},
+   {"World[%ld].Nsat",1,1},
+   {"World[%ld].Sat",1,1},
+   {"World[%ld].mu",1,1},
+   {"World[%ld].J2",1,1},
+   {"World[%ld].rad",1,1},
+   {"World[%ld].w",1,1},
+   {"World[%ld].PriMerAngJ2000",1,1},
+   {"World[%ld].RadOfInfluence",1,1},
+   {"World[%ld].DipoleMoment",1,1},
+   {"World[%ld].DipoleAxis",1,3},
+   {"World[%ld].DipoleOffset",1,3},
+   {"World[%ld].RingInner,",1,1},
+   {"World[%ld].Density",1,1},
+   {"World[%ld].HasRing",1,1},
+   {"World[%ld].GeomTag",1,1},
+   {"World[%ld].NearExtent,FarExtent",1,1},
+   {"World[%ld].CNH",1,9},
+   {"World[%ld].qnh",1,4},
+   {"World[%ld].PosH",1,3},
+   {"World[%ld].eph.Tag",1,1},
+   {"World[%ld].eph.Exists",1,1},
+   {"World[%ld].eph.Epoch",1,1},
+   {"World[%ld].eph.Regime",1,1},
+   {"World[%ld].eph.PolyhedronGravityEnabled",1,1},
+   {"World[%ld].eph.World",1,1},
+   {"World[%ld].eph.Region",1,1},
+   {"World[%ld].eph.Sys",1,1},
+   {"World[%ld].eph.LP",1,1},
+   {"World[%ld].eph.Body1",1,1},
+   {"World[%ld].eph.Body2",1,1},
+   {"World[%ld].eph.mu1",1,1},
+   {"World[%ld].eph.mu2",1,1},
+   {"World[%ld].eph.LagDOF",1,1},
+   {"World[%ld].eph.Ax",1,1},
+   {"World[%ld].eph.Bx",1,1},
+   {"World[%ld].eph.Cx",1,1},
+   {"World[%ld].eph.Dx",1,1},
+   {"World[%ld].eph.Ay",1,1},
+   {"World[%ld].eph.By",1,1},
+   {"World[%ld].eph.Cy",1,1},
+   {"World[%ld].eph.Dy",1,1},
+   {"World[%ld].eph.Az",1,1},
+   {"World[%ld].eph.Bz",1,1},
+   {"World[%ld].eph.mu",1,1},
+   {"World[%ld].eph.SMA",1,1},
+   {"World[%ld].eph.ecc",1,1},
+   {"World[%ld].eph.inc",1,1},
+   {"World[%ld].eph.RAAN",1,1},
+   {"World[%ld].eph.ArgP",1,1},
+   {"World[%ld].eph.tp",1,1},
+   {"World[%ld].eph.alpha",1,1},
+   {"World[%ld].eph.SLR",1,1},
+   {"World[%ld].eph.rmin",1,1},
+   {"World[%ld].eph.Period",1,1},
+   {"World[%ld].eph.MeanMotion",1,1},
+   {"World[%ld].eph.J2DriftEnabled",1,1},
+   {"World[%ld].eph.MeanSMA",1,1},
+   {"World[%ld].eph.RAAN0",1,1},
+   {"World[%ld].eph.ArgP0",1,1},
+   {"World[%ld].eph.MeanAnom0",1,1},
+   {"World[%ld].eph.RAANdot",1,1},
+   {"World[%ld].eph.ArgPdot",1,1},
+   {"World[%ld].eph.J2Rw2bya",1,1},
+   {"World[%ld].eph.PosN",1,3},
+   {"World[%ld].eph.VelN",1,3},
+};
+
+static SIMLOCAL char *IpcBuf = NULL;
+static SIMLOCAL long IpcBufSize = 0;
+static SIMLOCAL long IpcLen = 0;
+
+/**********************************************************************/
+static void IpcReserve(long N)
+{
+      if (IpcLen+N > IpcBufSize) {
+         IpcBufSize = 2*(IpcLen+N);
+         IpcBuf = (char *) realloc(IpcBuf,IpcBufSize);
+         if (IpcBuf == NULL) {
+            fprintf(stderr,"IPC buffer realloc failed.  Bailing out!\n");
+            exit(EXIT_FAILURE);
+         }
+      }
+}
+/**********************************************************************/
+/* Returns 0 only if nothing at all has arrived */
+static long IpcRecvAll(SOCKET Socket, char *Dst, long N, long Started)
+{
+      long Got = 0;
+      int NumBytes;
+
+      while(Got < N) {
+         NumBytes = recv(Socket,&Dst[Got],N-Got,0);
+         if (NumBytes == 0 || (NumBytes < 0 && Got == 0 && !Started)) return(0);
+         if (NumBytes > 0) Got += NumBytes;
+      }
+      return(1);
+}
+/**********************************************************************/
+static void IpcCheckHdr(const uint32_t *Hdr)
+{
+      if (Hdr[0] != IPC_MAGIC || Hdr[1] != IPC_SCHEMA) {
+         fprintf(stderr,"Binary IPC frame has schema %08lx, expected %08lx.  Were both ends generated from the same 42.json?  Bailing out!\n",
+            (unsigned long) Hdr[1],(unsigned long) IPC_SCHEMA);
+         exit(EXIT_FAILURE);
+      }
+}
+/**********************************************************************/
+/* Reads one frame into IpcBuf and returns its total length, or 0 */
+static long IpcRecvFrame(SOCKET Socket)
+{
+      uint32_t Hdr[3];
+
+      if (!IpcRecvAll(Socket,(char *) Hdr,12,0)) return(0);
+      IpcCheckHdr(Hdr);
+      IpcLen = 0;
+      IpcReserve(12+Hdr[2]);
+      if (!IpcRecvAll(Socket,&IpcBuf[12],Hdr[2],1)) return(0);
+      return(12+Hdr[2]);
+}
+/**********************************************************************/
+static void IpcTruncated(void)
+{
+      fprintf(stderr,"Truncated binary IPC frame.  Bailing out!\n");
+      exit(EXIT_FAILURE);
+}
+/**********************************************************************/
+static void IpcGetLong(long *Dst, const char *Src, long N)
+{
+      int64_t Val64;
+      long k;
+
+      for(k=0;k<N;k++) {
+         memcpy(&Val64,&Src[8*k],8);
+         Dst[k] = (long) Val64;
+      }
+}
+/**********************************************************************/
+/* Decodes one frame in place, wherever the transport left it */
+static void UnpackBinFrame(const char *Frame, long Len, long EchoEnabled)
+{
+
+      struct SCType *S;
+      struct OrbitType *O;
+      struct DynType *D;
+      long Isc,Iorb,Iw,i;
+      long RequestTimeRefresh = 0;
+      uint16_t Id16;
+      int32_t Idx[3];
+      long Id,Ipos;
+      const char *Val;
+      double TimeVal[5];
+      long Year,doy,Hour,Minute;
+      double Second;
+
+      if (EchoEnabled) printf("Binary IPC frame, %ld bytes\n",Len);
+
+      Ipos = 12;
+      while(Ipos < Len) {
+         if (Ipos+2 > Len) IpcTruncated();
+         memcpy(&Id16,&Frame[Ipos],2);
+         Id = Id16;
+         if (Id >= IPC_NFIELD) {
+            fprintf(stderr,"Unknown field ID %ld in binary IPC frame.  Bailing out!\n",Id);
+            exit(EXIT_FAILURE);
+         }
+         /* Whole record present before any of it is read */
+         if (Ipos+2+4*IpcField[Id].Nidx+8*IpcField[Id].Nval > Len) IpcTruncated();
+         memcpy(Idx,&Frame[Ipos+2],4*IpcField[Id].Nidx);
+         Val = &Frame[Ipos+2+4*IpcField[Id].Nidx];
+         Ipos += 2+4*IpcField[Id].Nidx+8*IpcField[Id].Nval;
+
+         switch(Id) {
+            case 0:
+               memcpy(TimeVal,Val,sizeof(TimeVal));
+               Year = (long) TimeVal[0];
+               doy = (long) TimeVal[1];
+               Hour = (long) TimeVal[2];
+               Minute = (long) TimeVal[3];
+               Second = TimeVal[4];
+               RequestTimeRefresh = 1;
+               break;
+
+            case 1: /* SC[%ld].PosR */
+               Isc = Idx[0];
+               memcpy(SC[Isc].PosR,Val,24);
+               SC[Isc].RequestStateRefresh = 1;
+               break;
+
+            case 2: /* SC[%ld].VelR */
+               Isc = Idx[0];
+               memcpy(SC[Isc].VelR,Val,24);
+               SC[Isc].RequestStateRefresh = 1;
+               break;
+
+            case 3: /* SC[%ld].svb */
+               Isc = Idx[0];
+               memcpy(SC[Isc].svb,Val,24);
+               SC[Isc].RequestStateRefresh = 1;
+               break;
+
+            case 4: /* SC[%ld].bvb */
+               Isc = Idx[0];
+               memcpy(SC[Isc].bvb,Val,24);
+               SC[Isc].RequestStateRefresh = 1;
+               break;
+
+            case 5: /* SC[%ld].Hvb */
+               Isc = Idx[0];
+               memcpy(SC[Isc].Hvb,Val,24);
+               SC[Isc].RequestStateRefresh = 1;
+               break;
+
+            case 29: /* SC[%ld].AC.svb */
+               Isc = Idx[0];
+               memcpy(SC[Isc].AC.svb,Val,24);
+               break;
+
+            case 30: /* SC[%ld].AC.bvb */
+               Isc = Idx[0];
+               memcpy(SC[Isc].AC.bvb,Val,24);
+               break;
+
+            case 31: /* SC[%ld].AC.Hvb */
+               Isc = Idx[0];
+               memcpy(SC[Isc].AC.Hvb,Val,24);
+               break;
+
+            case 51: /* SC[%ld].AC.G[%ld].Cmd.AngRate */
+               Isc = Idx[0];
+               i = Idx[1];
+               memcpy(SC[Isc].AC.G[i].Cmd.AngRate,Val,24);
+               break;
+
+            case 52: /* SC[%ld].AC.G[%ld].Cmd.Ang */
+               Isc = Idx[0];
+               i = Idx[1];
+               memcpy(SC[Isc].AC.G[i].Cmd.Ang,Val,24);
+               break;
+
+            case 94: /* SC[%ld].AC.Whl[%ld].Tcmd */
+               Isc = Idx[0];
+               i = Idx[1];
+               memcpy(&SC[Isc].AC.Whl[i].Tcmd,Val,8);
+               break;
+
+            case 98: /* SC[%ld].AC.MTB[%ld].Mcmd */
+               Isc = Idx[0];
+               i = Idx[1];
+               memcpy(&SC[Isc].AC.MTB[i].Mcmd,Val,8);
+               break;
+
+            case 104: /* SC[%ld].AC.Thr[%ld].PulseWidthCmd */
+               Isc = Idx[0];
+               i = Idx[1];
+               memcpy(&SC[Isc].AC.Thr[i].PulseWidthCmd,Val,8);
+               break;
+
+            case 105: /* SC[%ld].AC.Thr[%ld].ThrustLevelCmd */
+               Isc = Idx[0];
+               i = Idx[1];
+               memcpy(&SC[Isc].AC.Thr[i].ThrustLevelCmd,Val,8);
+               break;
+
+            case 135: /* SC[%ld].AC.Cmd.AngRate */
+               Isc = Idx[0];
+               memcpy(SC[Isc].AC.Cmd.AngRate,Val,24);
+               break;
+
+            case 136: /* SC[%ld].AC.Cmd.Ang */
+               Isc = Idx[0];
+               memcpy(SC[Isc].AC.Cmd.Ang,Val,24);
+               break;
+
+            case 137: /* SC[%ld].B[%ld].wn */
+               Isc = Idx[0];
+               i = Idx[1];
+               memcpy(SC[Isc].B[i].wn,Val,24);
+               SC[Isc].RequestStateRefresh = 1;
+               break;
+
+            case 138: /* SC[%ld].B[%ld].qn */
+               Isc = Idx[0];
+               i = Idx[1];
+               memcpy(SC[Isc].B[i].qn,Val,32);
+               SC[Isc].RequestStateRefresh = 1;
+               break;
+
+            case 139: /* SC[%ld].G[%ld].Pos */
+               Isc = Idx[0];
+               i = Idx[1];
+               memcpy(SC[Isc].G[i].Pos,Val,24);
+               SC[Isc].RequestStateRefresh = 1;
+               break;
+
+            case 140: /* SC[%ld].G[%ld].PosRate */
+               Isc = Idx[0];
+               i = Idx[1];
+               memcpy(SC[Isc].G[i].PosRate,Val,24);
+               SC[Isc].RequestStateRefresh = 1;
+               break;
+
+            case 141: /* SC[%ld].G[%ld].Ang */
+               Isc = Idx[0];
+               i = Idx[1];
+               memcpy(SC[Isc].G[i].Ang,Val,24);
+               SC[Isc].RequestStateRefresh = 1;
+               break;
+
+            case 142: /* SC[%ld].G[%ld].AngRate */
+               Isc = Idx[0];
+               i = Idx[1];
+               memcpy(SC[Isc].G[i].AngRate,Val,24);
+               SC[Isc].RequestStateRefresh = 1;
+               break;
+
+            case 143: /* SC[%ld].GN.Pos */
+               Isc = Idx[0];
+               memcpy(SC[Isc].GN.Pos,Val,24);
+               SC[Isc].RequestStateRefresh = 1;
+               break;
+
+            case 144: /* SC[%ld].GN.PosRate */
+               Isc = Idx[0];
+               memcpy(SC[Isc].GN.PosRate,Val,24);
+               SC[Isc].RequestStateRefresh = 1;
+               break;
+
+            case 145: /* SC[%ld].GN.Ang */
+               Isc = Idx[0];
+               memcpy(SC[Isc].GN.Ang,Val,24);
+               SC[Isc].RequestStateRefresh = 1;
+               break;
+
+            case 146: /* SC[%ld].GN.AngRate */
+               Isc = Idx[0];
+               memcpy(SC[Isc].GN.AngRate,Val,24);
+               SC[Isc].RequestStateRefresh = 1;
+               break;
+
+            case 147: /* SC[%ld].Whl[%ld].H */
+               Isc = Idx[0];
+               i = Idx[1];
+               memcpy(&SC[Isc].Whl[i].H,Val,8);
+               SC[Isc].RequestStateRefresh = 1;
+               break;
+
+            case 303: /* World[%ld].PosH */
+               Iw = Idx[0];
+               memcpy(World[Iw].PosH,Val,24);
+               break;
+
+            case 348: /* World[%ld].eph.PosN */
+               Iw = Idx[0];
+               memcpy(World[Iw].eph.PosN,Val,24);
+               break;
+
+            case 349: /* World[%ld].eph.VelN */
+               Iw = Idx[0];
+               memcpy(World[Iw].eph.VelN,Val,24);
+               break;
+
+            case 280: /* Orb[%ld].PosN */
+               Iorb = Idx[0];
+               memcpy(Orb[Iorb].PosN,Val,24);
+               break;
+
+            case 281: /* Orb[%ld].VelN */
+               Iorb = Idx[0];
+               memcpy(Orb[Iorb].VelN,Val,24);
+               break;
+
+            case 6: /* SC[%ld].AC.ID */
+               Isc = Idx[0];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  IpcGetLong(&SC[Isc].AC.ID,Val,1);
+               }
+               break;
+
+            case 7: /* SC[%ld].AC.EchoEnabled */
+               Isc = Idx[0];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  IpcGetLong(&SC[Isc].AC.EchoEnabled,Val,1);
+               }
+               break;
+
+            case 10: /* SC[%ld].AC.Nb */
+               Isc = Idx[0];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  IpcGetLong(&SC[Isc].AC.Nb,Val,1);
+               }
+               break;
+
+            case 11: /* SC[%ld].AC.Ng */
+               Isc = Idx[0];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  IpcGetLong(&SC[Isc].AC.Ng,Val,1);
+               }
+               break;
+
+            case 12: /* SC[%ld].AC.Nwhl */
+               Isc = Idx[0];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  IpcGetLong(&SC[Isc].AC.Nwhl,Val,1);
+               }
+               break;
+
+            case 13: /* SC[%ld].AC.Nmtb */
+               Isc = Idx[0];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  IpcGetLong(&SC[Isc].AC.Nmtb,Val,1);
+               }
+               break;
+
+            case 14: /* SC[%ld].AC.Nthr */
+               Isc = Idx[0];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  IpcGetLong(&SC[Isc].AC.Nthr,Val,1);
+               }
+               break;
+
+            case 15: /* SC[%ld].AC.Ncmg */
+               Isc = Idx[0];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  IpcGetLong(&SC[Isc].AC.Ncmg,Val,1);
+               }
+               break;
+
+            case 16: /* SC[%ld].AC.Ngyro */
+               Isc = Idx[0];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  IpcGetLong(&SC[Isc].AC.Ngyro,Val,1);
+               }
+               break;
+
+            case 17: /* SC[%ld].AC.Nmag */
+               Isc = Idx[0];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  IpcGetLong(&SC[Isc].AC.Nmag,Val,1);
+               }
+               break;
+
+            case 18: /* SC[%ld].AC.Ncss */
+               Isc = Idx[0];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  IpcGetLong(&SC[Isc].AC.Ncss,Val,1);
+               }
+               break;
+
+            case 19: /* SC[%ld].AC.Nfss */
+               Isc = Idx[0];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  IpcGetLong(&SC[Isc].AC.Nfss,Val,1);
+               }
+               break;
+
+            case 20: /* SC[%ld].AC.Nst */
+               Isc = Idx[0];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  IpcGetLong(&SC[Isc].AC.Nst,Val,1);
+               }
+               break;
+
+            case 21: /* SC[%ld].AC.Ngps */
+               Isc = Idx[0];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  IpcGetLong(&SC[Isc].AC.Ngps,Val,1);
+               }
+               break;
+
+            case 22: /* SC[%ld].AC.Nacc */
+               Isc = Idx[0];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  IpcGetLong(&SC[Isc].AC.Nacc,Val,1);
+               }
+               break;
+
+            case 23: /* SC[%ld].AC.Pi */
+               Isc = Idx[0];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(&SC[Isc].AC.Pi,Val,8);
+               }
+               break;
+
+            case 24: /* SC[%ld].AC.TwoPi */
+               Isc = Idx[0];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(&SC[Isc].AC.TwoPi,Val,8);
+               }
+               break;
+
+            case 25: /* SC[%ld].AC.DT */
+               Isc = Idx[0];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(&SC[Isc].AC.DT,Val,8);
+               }
+               break;
+
+            case 26: /* SC[%ld].AC.mass */
+               Isc = Idx[0];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(&SC[Isc].AC.mass,Val,8);
+               }
+               break;
+
+            case 27: /* SC[%ld].AC.cm */
+               Isc = Idx[0];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(SC[Isc].AC.cm,Val,24);
+               }
+               break;
+
+            case 28: /* SC[%ld].AC.MOI */
+               Isc = Idx[0];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(&SC[Isc].AC.MOI[0][0],Val,72);
+               }
+               break;
+
+            case 32: /* SC[%ld].AC.B[%ld].mass */
+               Isc = Idx[0];
+               i = Idx[1];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(&SC[Isc].AC.B[i].mass,Val,8);
+               }
+               break;
+
+            case 33: /* SC[%ld].AC.B[%ld].cm */
+               Isc = Idx[0];
+               i = Idx[1];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(SC[Isc].AC.B[i].cm,Val,24);
+               }
+               break;
+
+            case 34: /* SC[%ld].AC.B[%ld].MOI */
+               Isc = Idx[0];
+               i = Idx[1];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(&SC[Isc].AC.B[i].MOI[0][0],Val,72);
+               }
+               break;
+
+            case 35: /* SC[%ld].AC.G[%ld].IsSpherical */
+               Isc = Idx[0];
+               i = Idx[1];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  IpcGetLong(&SC[Isc].AC.G[i].IsSpherical,Val,1);
+               }
+               break;
+
+            case 36: /* SC[%ld].AC.G[%ld].RotDOF */
+               Isc = Idx[0];
+               i = Idx[1];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  IpcGetLong(&SC[Isc].AC.G[i].RotDOF,Val,1);
+               }
+               break;
+
+            case 37: /* SC[%ld].AC.G[%ld].TrnDOF */
+               Isc = Idx[0];
+               i = Idx[1];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  IpcGetLong(&SC[Isc].AC.G[i].TrnDOF,Val,1);
+               }
+               break;
+
+            case 38: /* SC[%ld].AC.G[%ld].RotSeq */
+               Isc = Idx[0];
+               i = Idx[1];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  IpcGetLong(&SC[Isc].AC.G[i].RotSeq,Val,1);
+               }
+               break;
+
+            case 39: /* SC[%ld].AC.G[%ld].TrnSeq */
+               Isc = Idx[0];
+               i = Idx[1];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  IpcGetLong(&SC[Isc].AC.G[i].TrnSeq,Val,1);
+               }
+               break;
+
+            case 40: /* SC[%ld].AC.G[%ld].CGiBi */
+               Isc = Idx[0];
+               i = Idx[1];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(&SC[Isc].AC.G[i].CGiBi[0][0],Val,72);
+               }
+               break;
+
+            case 41: /* SC[%ld].AC.G[%ld].CBoGo */
+               Isc = Idx[0];
+               i = Idx[1];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(&SC[Isc].AC.G[i].CBoGo[0][0],Val,72);
+               }
+               break;
+
+            case 42: /* SC[%ld].AC.G[%ld].AngGain */
+               Isc = Idx[0];
+               i = Idx[1];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(SC[Isc].AC.G[i].AngGain,Val,24);
+               }
+               break;
+
+            case 43: /* SC[%ld].AC.G[%ld].AngRateGain */
+               Isc = Idx[0];
+               i = Idx[1];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(SC[Isc].AC.G[i].AngRateGain,Val,24);
+               }
+               break;
+
+            case 44: /* SC[%ld].AC.G[%ld].PosGain */
+               Isc = Idx[0];
+               i = Idx[1];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(SC[Isc].AC.G[i].PosGain,Val,24);
+               }
+               break;
+
+            case 45: /* SC[%ld].AC.G[%ld].PosRateGain */
+               Isc = Idx[0];
+               i = Idx[1];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(SC[Isc].AC.G[i].PosRateGain,Val,24);
+               }
+               break;
+
+            case 46: /* SC[%ld].AC.G[%ld].MaxAngRate */
+               Isc = Idx[0];
+               i = Idx[1];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(SC[Isc].AC.G[i].MaxAngRate,Val,24);
+               }
+               break;
+
+            case 47: /* SC[%ld].AC.G[%ld].MaxPosRate */
+               Isc = Idx[0];
+               i = Idx[1];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(SC[Isc].AC.G[i].MaxPosRate,Val,24);
+               }
+               break;
+
+            case 48: /* SC[%ld].AC.G[%ld].MaxTrq */
+               Isc = Idx[0];
+               i = Idx[1];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(SC[Isc].AC.G[i].MaxTrq,Val,24);
+               }
+               break;
+
+            case 49: /* SC[%ld].AC.G[%ld].MaxFrc */
+               Isc = Idx[0];
+               i = Idx[1];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(SC[Isc].AC.G[i].MaxFrc,Val,24);
+               }
+               break;
+
+            case 53: /* SC[%ld].AC.Gyro[%ld].Axis */
+               Isc = Idx[0];
+               i = Idx[1];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(SC[Isc].AC.Gyro[i].Axis,Val,24);
+               }
+               break;
+
+            case 55: /* SC[%ld].AC.MAG[%ld].Axis */
+               Isc = Idx[0];
+               i = Idx[1];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(SC[Isc].AC.MAG[i].Axis,Val,24);
+               }
+               break;
+
+            case 57: /* SC[%ld].AC.CSS[%ld].Body */
+               Isc = Idx[0];
+               i = Idx[1];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  IpcGetLong(&SC[Isc].AC.CSS[i].Body,Val,1);
+               }
+               break;
+
+            case 58: /* SC[%ld].AC.CSS[%ld].Axis */
+               Isc = Idx[0];
+               i = Idx[1];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(SC[Isc].AC.CSS[i].Axis,Val,24);
+               }
+               break;
+
+            case 59: /* SC[%ld].AC.CSS[%ld].Scale */
+               Isc = Idx[0];
+               i = Idx[1];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(&SC[Isc].AC.CSS[i].Scale,Val,8);
+               }
+               break;
+
+            case 62: /* SC[%ld].AC.FSS[%ld].qb */
+               Isc = Idx[0];
+               i = Idx[1];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(SC[Isc].AC.FSS[i].qb,Val,32);
+               }
+               break;
+
+            case 63: /* SC[%ld].AC.FSS[%ld].CB */
+               Isc = Idx[0];
+               i = Idx[1];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(&SC[Isc].AC.FSS[i].CB[0][0],Val,72);
+               }
+               break;
+
+            case 66: /* SC[%ld].AC.ST[%ld].qb */
+               Isc = Idx[0];
+               i = Idx[1];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(SC[Isc].AC.ST[i].qb,Val,32);
+               }
+               break;
+
+            case 67: /* SC[%ld].AC.ST[%ld].CB */
+               Isc = Idx[0];
+               i = Idx[1];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(&SC[Isc].AC.ST[i].CB[0][0],Val,72);
+               }
+               break;
+
+            case 84: /* SC[%ld].AC.Accel[%ld].PosB */
+               Isc = Idx[0];
+               i = Idx[1];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(SC[Isc].AC.Accel[i].PosB,Val,24);
+               }
+               break;
+
+            case 85: /* SC[%ld].AC.Accel[%ld].Axis */
+               Isc = Idx[0];
+               i = Idx[1];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(SC[Isc].AC.Accel[i].Axis,Val,24);
+               }
+               break;
+
+            case 87: /* SC[%ld].AC.Whl[%ld].Body */
+               Isc = Idx[0];
+               i = Idx[1];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  IpcGetLong(&SC[Isc].AC.Whl[i].Body,Val,1);
+               }
+               break;
+
+            case 88: /* SC[%ld].AC.Whl[%ld].Axis */
+               Isc = Idx[0];
+               i = Idx[1];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(SC[Isc].AC.Whl[i].Axis,Val,24);
+               }
+               break;
+
+            case 89: /* SC[%ld].AC.Whl[%ld].DistVec */
+               Isc = Idx[0];
+               i = Idx[1];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(SC[Isc].AC.Whl[i].DistVec,Val,24);
+               }
+               break;
+
+            case 90: /* SC[%ld].AC.Whl[%ld].J */
+               Isc = Idx[0];
+               i = Idx[1];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(&SC[Isc].AC.Whl[i].J,Val,8);
+               }
+               break;
+
+            case 91: /* SC[%ld].AC.Whl[%ld].Tmax */
+               Isc = Idx[0];
+               i = Idx[1];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(&SC[Isc].AC.Whl[i].Tmax,Val,8);
+               }
+               break;
+
+            case 92: /* SC[%ld].AC.Whl[%ld].Hmax */
+               Isc = Idx[0];
+               i = Idx[1];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(&SC[Isc].AC.Whl[i].Hmax,Val,8);
+               }
+               break;
+
+            case 95: /* SC[%ld].AC.MTB[%ld].Axis */
+               Isc = Idx[0];
+               i = Idx[1];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(SC[Isc].AC.MTB[i].Axis,Val,24);
+               }
+               break;
+
+            case 96: /* SC[%ld].AC.MTB[%ld].DistVec */
+               Isc = Idx[0];
+               i = Idx[1];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(SC[Isc].AC.MTB[i].DistVec,Val,24);
+               }
+               break;
+
+            case 97: /* SC[%ld].AC.MTB[%ld].Mmax */
+               Isc = Idx[0];
+               i = Idx[1];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(&SC[Isc].AC.MTB[i].Mmax,Val,8);
+               }
+               break;
+
+            case 99: /* SC[%ld].AC.Thr[%ld].Body */
+               Isc = Idx[0];
+               i = Idx[1];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  IpcGetLong(&SC[Isc].AC.Thr[i].Body,Val,1);
+               }
+               break;
+
+            case 100: /* SC[%ld].AC.Thr[%ld].PosB */
+               Isc = Idx[0];
+               i = Idx[1];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(SC[Isc].AC.Thr[i].PosB,Val,24);
+               }
+               break;
+
+            case 101: /* SC[%ld].AC.Thr[%ld].Axis */
+               Isc = Idx[0];
+               i = Idx[1];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(SC[Isc].AC.Thr[i].Axis,Val,24);
+               }
+               break;
+
+            case 102: /* SC[%ld].AC.Thr[%ld].rxA */
+               Isc = Idx[0];
+               i = Idx[1];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(SC[Isc].AC.Thr[i].rxA,Val,24);
+               }
+               break;
+
+            case 103: /* SC[%ld].AC.Thr[%ld].Fmax */
+               Isc = Idx[0];
+               i = Idx[1];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(&SC[Isc].AC.Thr[i].Fmax,Val,8);
+               }
+               break;
+
+            case 106: /* SC[%ld].AC.PrototypeCtrl.wc */
+               Isc = Idx[0];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(&SC[Isc].AC.PrototypeCtrl.wc,Val,8);
+               }
+               break;
+
+            case 107: /* SC[%ld].AC.PrototypeCtrl.amax */
+               Isc = Idx[0];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(&SC[Isc].AC.PrototypeCtrl.amax,Val,8);
+               }
+               break;
+
+            case 108: /* SC[%ld].AC.PrototypeCtrl.vmax */
+               Isc = Idx[0];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(&SC[Isc].AC.PrototypeCtrl.vmax,Val,8);
+               }
+               break;
+
+            case 109: /* SC[%ld].AC.PrototypeCtrl.Kprec */
+               Isc = Idx[0];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(&SC[Isc].AC.PrototypeCtrl.Kprec,Val,8);
+               }
+               break;
+
+            case 110: /* SC[%ld].AC.PrototypeCtrl.Knute */
+               Isc = Idx[0];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(&SC[Isc].AC.PrototypeCtrl.Knute,Val,8);
+               }
+               break;
+
+            case 111: /* SC[%ld].AC.AdHocCtrl.Kr */
+               Isc = Idx[0];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(SC[Isc].AC.AdHocCtrl.Kr,Val,24);
+               }
+               break;
+
+            case 112: /* SC[%ld].AC.AdHocCtrl.Kp */
+               Isc = Idx[0];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(SC[Isc].AC.AdHocCtrl.Kp,Val,24);
+               }
+               break;
+
+            case 113: /* SC[%ld].AC.SpinnerCtrl.Ispin */
+               Isc = Idx[0];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(&SC[Isc].AC.SpinnerCtrl.Ispin,Val,8);
+               }
+               break;
+
+            case 114: /* SC[%ld].AC.SpinnerCtrl.Itrans */
+               Isc = Idx[0];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(&SC[Isc].AC.SpinnerCtrl.Itrans,Val,8);
+               }
+               break;
+
+            case 115: /* SC[%ld].AC.SpinnerCtrl.SpinRate */
+               Isc = Idx[0];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(&SC[Isc].AC.SpinnerCtrl.SpinRate,Val,8);
+               }
+               break;
+
+            case 116: /* SC[%ld].AC.SpinnerCtrl.Knute */
+               Isc = Idx[0];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(&SC[Isc].AC.SpinnerCtrl.Knute,Val,8);
+               }
+               break;
+
+            case 117: /* SC[%ld].AC.SpinnerCtrl.Kprec */
+               Isc = Idx[0];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(&SC[Isc].AC.SpinnerCtrl.Kprec,Val,8);
+               }
+               break;
+
+            case 118: /* SC[%ld].AC.ThreeAxisCtrl.Kr */
+               Isc = Idx[0];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(SC[Isc].AC.ThreeAxisCtrl.Kr,Val,24);
+               }
+               break;
+
+            case 119: /* SC[%ld].AC.ThreeAxisCtrl.Kp */
+               Isc = Idx[0];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(SC[Isc].AC.ThreeAxisCtrl.Kp,Val,24);
+               }
+               break;
+
+            case 120: /* SC[%ld].AC.ThreeAxisCtrl.Kunl */
+               Isc = Idx[0];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(&SC[Isc].AC.ThreeAxisCtrl.Kunl,Val,8);
+               }
+               break;
+
+            case 121: /* SC[%ld].AC.IssCtrl.Kr */
+               Isc = Idx[0];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(SC[Isc].AC.IssCtrl.Kr,Val,24);
+               }
+               break;
+
+            case 122: /* SC[%ld].AC.IssCtrl.Kp */
+               Isc = Idx[0];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(SC[Isc].AC.IssCtrl.Kp,Val,24);
+               }
+               break;
+
+            case 123: /* SC[%ld].AC.IssCtrl.Tmax */
+               Isc = Idx[0];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(&SC[Isc].AC.IssCtrl.Tmax,Val,8);
+               }
+               break;
+
+            case 124: /* SC[%ld].AC.CmgCtrl.Kr */
+               Isc = Idx[0];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(SC[Isc].AC.CmgCtrl.Kr,Val,24);
+               }
+               break;
+
+            case 125: /* SC[%ld].AC.CmgCtrl.Kp */
+               Isc = Idx[0];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(SC[Isc].AC.CmgCtrl.Kp,Val,24);
+               }
+               break;
+
+            case 126: /* SC[%ld].AC.ThrCtrl.Kw */
+               Isc = Idx[0];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(SC[Isc].AC.ThrCtrl.Kw,Val,24);
+               }
+               break;
+
+            case 127: /* SC[%ld].AC.ThrCtrl.Kth */
+               Isc = Idx[0];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(SC[Isc].AC.ThrCtrl.Kth,Val,24);
+               }
+               break;
+
+            case 128: /* SC[%ld].AC.ThrCtrl.Kv */
+               Isc = Idx[0];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(&SC[Isc].AC.ThrCtrl.Kv,Val,8);
+               }
+               break;
+
+            case 129: /* SC[%ld].AC.ThrCtrl.Kp */
+               Isc = Idx[0];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(&SC[Isc].AC.ThrCtrl.Kp,Val,8);
+               }
+               break;
+
+            case 130: /* SC[%ld].AC.CfsCtrl.Kr */
+               Isc = Idx[0];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(SC[Isc].AC.CfsCtrl.Kr,Val,24);
+               }
+               break;
+
+            case 131: /* SC[%ld].AC.CfsCtrl.Kp */
+               Isc = Idx[0];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(SC[Isc].AC.CfsCtrl.Kp,Val,24);
+               }
+               break;
+
+            case 132: /* SC[%ld].AC.CfsCtrl.Kunl */
+               Isc = Idx[0];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(&SC[Isc].AC.CfsCtrl.Kunl,Val,8);
+               }
+               break;
+
+            case 133: /* SC[%ld].AC.ThrSteerCtrl.Kr */
+               Isc = Idx[0];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(SC[Isc].AC.ThrSteerCtrl.Kr,Val,24);
+               }
+               break;
+
+            case 134: /* SC[%ld].AC.ThrSteerCtrl.Kp */
+               Isc = Idx[0];
+               if (SC[Isc].AC.ParmDumpEnabled) {
+                  memcpy(SC[Isc].AC.ThrSteerCtrl.Kp,Val,24);
+               }
+               break;
+
+            default: /* Not read by this program */
+               break;
+         }
+      }
+
+      if (RequestTimeRefresh) {
+         /* Update time variables */
+         UTC.Year = Year;
+         UTC.doy = doy;
+         UTC.Hour = Hour;
+         UTC.Minute = Minute;
+         UTC.Second = Second;
+         DOY2MD(UTC.Year,UTC.doy,&UTC.Month,&UTC.Day);
+         CivilTime = DateToTime(UTC.Year,UTC.Month,UTC.Day,UTC.Hour,UTC.Minute,UTC.Second);
+         AtomicTime = CivilTime + LeapSec;
+         GpsTime = AtomicTime - 19.0;
+         DynTime = AtomicTime + 32.184;
+         TT.JulDay = TimeToJD(DynTime);
+         TimeToDate(DynTime,&TT.Year,&TT.Month,&TT.Day,
+            &TT.Hour,&TT.Minute,&TT.Second,DTSIM);
+         TT.doy = MD2DOY(TT.Year,TT.Month,TT.Day);
+         UTC.JulDay = TimeToJD(CivilTime);
+         GpsTimeToGpsDate(GpsTime,&GpsRollover,&GpsWeek,&GpsSecond);
+         SimTime = DynTime-DynTime0;
+      }
+
+
+/* .. Refresh SC states that depend on inputs */
+
+      for(Isc=0;Isc<Nsc;Isc++) {
+         if (SC[Isc].RequestStateRefresh) {
+            S = &SC[Isc];
+            S->RequestStateRefresh = 0;
+            if (S->Exists) {
+               /* Update  RefOrb */
+               O = &Orb[S->RefOrb];
+               O->Epoch = DynTime;
+               for(i=0;i<3;i++) {
+                  S->PosN[i] = O->PosN[i] + S->PosR[i];
+                  S->VelN[i] = O->VelN[i] + S->VelR[i];
+               }
+               RV2Eph(O->Epoch,O->mu,O->PosN,O->VelN,
+                  &O->SMA,&O->ecc,&O->inc,&O->RAAN,
+                  &O->ArgP,&O->anom,&O->tp,
+                  &O->SLR,&O->alpha,&O->rmin,
+                  &O->MeanMotion,&O->Period);
+               FindCLN(O->PosN,O->VelN,O->CLN,O->wln);
+
+               /* Update Dyn */
+               MapJointStatesToStateVector(S);
+               D = &S->Dyn;
+               MapStateVectorToBodyStates(D->u,D->x,D->h,D->a,D->uf,D->xf,S);
+               MotionConstraints(S);
+            }
+         }
+      }
+}
+/**********************************************************************/
+void ReadFromBinSocket(SOCKET Socket, long EchoEnabled)
+{
+      char AckMsg[5] = "Ack\n";
+      long Len;
+
+      Len = IpcRecvFrame(Socket);
+      if (Len == 0) return; /* Bail out if no message */
+      UnpackBinFrame(IpcBuf,Len,EchoEnabled);
+
+      /* Acknowledge receipt, all five bytes the writer waits for */
+      send(Socket,AckMsg,5,0);
+}
+/**********************************************************************/
+/* The frame is decoded where it sits in the ring, then released */
+void ReadFromShm(struct ShmLinkType *Shm, long EchoEnabled)
+{
+      const char *Frame;
+      uint32_t Hdr[3];
+      long Len;
+
+      Frame = ShmRecv(Shm,&Len);
+      if (Frame == NULL) return; /* Bail out if no message */
+      if (Len < 12) IpcTruncated();
+      memcpy(Hdr,Frame,12);
+      IpcCheckHdr(Hdr);
+      UnpackBinFrame(Frame,Len,EchoEnabled);
+      ShmRelease(Shm);
+}
@@ -0,0 +1,1193 @@
+/* Note:  This file was autogenerated by Database/JsonToIPC.py */
+/*        See Database/Readme.txt for details. */
+/*        If you are hand-modifying this file, keep in mind that */
+/*        your work will be lost if you run JsonToIPC.py again. */
+
+#include "42.h"
+#include <stdint.h>
+
+#define IPC_NFIELD 350
+#define IPC_MAGIC 0x34324950
+#define IPC_SCHEMA 0x8a7e4f07
+
+struct IpcFieldType {
+   const char *Name; /* As in the text protocol */
+   long Nidx;
+   long Nval;
+};
+static const struct IpcFieldType IpcField[IPC_NFIELD] = {
+   {"TIME",0,5},
+   {"SC[%ld].PosR",1,3},
+   {"SC[%ld].VelR",1,3},
+   {"SC[%ld].svb",1,3},
+   {"SC[%ld].bvb",1,3},
+   {"SC[%ld].Hvb",1,3},
+   {"SC[%ld].AC.ID",1,1},
+   {"SC[%ld].AC.EchoEnabled",1,1},
+   {"SC[%ld].AC.ParmLoadEnabled",1,1},
+   {"SC[%ld].AC.ParmDumpEnabled",1,1},
+   {"SC[%ld].AC.Nb",1,1},
+   {"SC[%ld].AC.Ng",1,1},
+   {"SC[%ld].AC.Nwhl",1,1},
+   {"SC[%ld].AC.Nmtb",1,1},
+   {"SC[%ld].AC.Nthr",1,1},
+   {"SC[%ld].AC.Ncmg",1,1},
+   {"SC[%ld].AC.Ngyro",1,1},
+   {"SC[%ld].AC.Nmag",1,1},
+   {"SC[%ld].AC.Ncss",1,1},
+   {"SC[%ld].AC.Nfss",1,1},
+   {"SC[%ld].AC.Nst",1,1},
+   {"SC[%ld].AC.Ngps",1,1},
+   {"SC[%ld].AC.Nacc",1,1},
+   {"SC[%ld].AC.Pi",1,1},
+   {"SC[%ld].AC.TwoPi",1,1},
+   {"SC[%ld].AC.DT",1,1},
+   {"SC[%ld].AC.mass",1,1},
+   {"SC[%ld].AC.cm",1,3},
+   {"SC[%ld].AC.MOI",1,9},
+   {"SC[%ld].AC.svb",1,3},
+   {"SC[%ld].AC.bvb",1,3},
+   {"SC[%ld].AC.Hvb",1,3},
+   {"SC[%ld].AC.B[%ld].mass",2,1},
+   {"SC[%ld].AC.B[%ld].cm",2,3},
+   {"SC[%ld].AC.B[%ld].MOI",2,9},
+   {"SC[%ld].AC.G[%ld].IsSpherical",2,1},
+   {"SC[%ld].AC.G[%ld].RotDOF",2,1},
+   {"SC[%ld].AC.G[%ld].TrnDOF",2,1},
+   {"SC[%ld].AC.G[%ld].RotSeq",2,1},
+   {"SC[%ld].AC.G[%ld].TrnSeq",2,1},
+   {"SC[%ld].AC.G[%ld].CGiBi",2,9},
+   {"SC[%ld].AC.G[%ld].CBoGo",2,9},
+   {"SC[%ld].AC.G[%ld].AngGain",2,3},
+   {"SC[%ld].AC.G[%ld].AngRateGain",2,3},
+   {"SC[%ld].AC.G[%ld].PosGain",2,3},
+   {"SC[%ld].AC.G[%ld].PosRateGain",2,3},
+   {"SC[%ld].AC.G[%ld].MaxAngRate",2,3},
+   {"SC[%ld].AC.G[%ld].MaxPosRate",2,3},
+   {"SC[%ld].AC.G[%ld].MaxTrq",2,3},
+   {"SC[%ld].AC.G[%ld].MaxFrc",2,3},
+   {"SC[%ld].AC.G[%ld].Ang",2,3},
+   {"SC[%ld].AC.G[%ld].Cmd.AngRate",2,3},
+   {"SC[%ld].AC.G[%ld].Cmd.Ang",2,3},
+   {"SC[%ld].AC.Gyro[%ld].Axis",2,3},
+   {"SC[%ld].AC.Gyro[%ld].Rate",2,1},
+   {"SC[%ld].AC.MAG[%ld].Axis",2,3},
+   {"SC[%ld].AC.MAG[%ld].Field",2,1},
+   {"SC[%ld].AC.CSS[%ld].Body",2,1},
+   {"SC[%ld].AC.CSS[%ld].Axis",2,3},
+   {"SC[%ld].AC.CSS[%ld].Scale",2,1},
+   {"SC[%ld].AC.CSS[%ld].Valid",2,1},
+   {"SC[%ld].AC.CSS[%ld].Illum",2,1},
+   {"SC[%ld].AC.FSS[%ld].qb",2,4},
+   {"SC[%ld].AC.FSS[%ld].CB",2,9},
+   {"SC[%ld].AC.FSS[%ld].Valid",2,1},
+   {"SC[%ld].AC.FSS[%ld].SunAng",2,2},
+   {"SC[%ld].AC.ST[%ld].qb",2,4},
+   {"SC[%ld].AC.ST[%ld].CB",2,9},
+   {"SC[%ld].AC.ST[%ld].Valid",2,1},
+   {"SC[%ld].AC.ST[%ld].qn",2,4},
+   {"SC[%ld].AC.GPS[%ld].Valid",2,1},
+   {"SC[%ld].AC.GPS[%ld].Rollover",2,1},
+   {"SC[%ld].AC.GPS[%ld].Week",2,1},
+   {"SC[%ld].AC.GPS[%ld].Sec",2,1},
+   {"SC[%ld].AC.GPS[%ld].PosN",2,3},
+   {"SC[%ld].AC.GPS[%ld].VelN",2,3},
+   {"SC[%ld].AC.GPS[%ld].PosW",2,3},
+   {"SC[%ld].AC.GPS[%ld].VelW",2,3},
+   {"SC[%ld].AC.GPS[%ld].Lng",2,1},
+   {"SC[%ld].AC.GPS[%ld].Lat",2,1},
+   {"SC[%ld].AC.GPS[%ld].Alt",2,1},
+   {"SC[%ld].AC.GPS[%ld].WgsLng",2,1},
+   {"SC[%ld].AC.GPS[%ld].WgsLat",2,1},
+   {"SC[%ld].AC.GPS[%ld].WgsAlt",2,1},
+   {"SC[%ld].AC.Accel[%ld].PosB",2,3},
+   {"SC[%ld].AC.Accel[%ld].Axis",2,3},
+   {"SC[%ld].AC.Accel[%ld].Acc",2,1},
+   {"SC[%ld].AC.Whl[%ld].Body",2,1},
+   {"SC[%ld].AC.Whl[%ld].Axis",2,3},
+   {"SC[%ld].AC.Whl[%ld].DistVec",2,3},
+   {"SC[%ld].AC.Whl[%ld].J",2,1},
+   {"SC[%ld].AC.Whl[%ld].Tmax",2,1},
+   {"SC[%ld].AC.Whl[%ld].Hmax",2,1},
+   {"SC[%ld].AC.Whl[%ld].H",2,1},
+   {"SC[%ld].AC.Whl[%ld].Tcmd",2,1},
+   {"SC[%ld].AC.MTB[%ld].Axis",2,3},
+   {"SC[%ld].AC.MTB[%ld].DistVec",2,3},
+   {"SC[%ld].AC.MTB[%ld].Mmax",2,1},
+   {"SC[%ld].AC.MTB[%ld].Mcmd",2,1},
+   {"SC[%ld].AC.Thr[%ld].Body",2,1},
+   {"SC[%ld].AC.Thr[%ld].PosB",2,3},
+   {"SC[%ld].AC.Thr[%ld].Axis",2,3},
+   {"SC[%ld].AC.Thr[%ld].rxA",2,3},
+   {"SC[%ld].AC.Thr[%ld].Fmax",2,1},
+   {"SC[%ld].AC.Thr[%ld].PulseWidthCmd",2,1},
+   {"SC[%ld].AC.Thr[%ld].ThrustLevelCmd",2,1},
+   {"SC[%ld].AC.PrototypeCtrl.wc",1,1},
+   {"SC[%ld].AC.PrototypeCtrl.amax",1,1},
+   {"SC[%ld].AC.PrototypeCtrl.vmax",1,1},
+   {"SC[%ld].AC.PrototypeCtrl.Kprec",1,1},
+   {"SC[%ld].AC.PrototypeCtrl.Knute",1,1},
+   {"SC[%ld].AC.AdHocCtrl.Kr",1,3},
+   {"SC[%ld].AC.AdHocCtrl.Kp",1,3},
+   {"SC[%ld].AC.SpinnerCtrl.Ispin",1,1},
+   {"SC[%ld].AC.SpinnerCtrl.Itrans",1,1},
+   {"SC[%ld].AC.SpinnerCtrl.SpinRate",1,1},
+   {"SC[%ld].AC.SpinnerCtrl.Knute",1,1},
+   {"SC[%ld].AC.SpinnerCtrl.Kprec",1,1},
+   {"SC[%ld].AC.ThreeAxisCtrl.Kr",1,3},
+   {"SC[%ld].AC.ThreeAxisCtrl.Kp",1,3},
+   {"SC[%ld].AC.ThreeAxisCtrl.Kunl",1,1},
+   {"SC[%ld].AC.IssCtrl.Kr",1,3},
+   {"SC[%ld].AC.IssCtrl.Kp",1,3},
+   {"SC[%ld].AC.IssCtrl.Tmax",1,1},
+   {"SC[%ld].AC.CmgCtrl.Kr",1,3},
+   {"SC[%ld].AC.CmgCtrl.Kp",1,3},
+   {"SC[%ld].AC.ThrCtrl.Kw",1,3},
+   {"SC[%ld].AC.ThrCtrl.Kth",1,3},
+   {"SC[%ld].AC.ThrCtrl.Kv",1,1},
+   {"SC[%ld].AC.ThrCtrl.Kp",1,1},
+   {"SC[%ld].AC.CfsCtrl.Kr",1,3},
+   {"SC[%ld].AC.CfsCtrl.Kp",1,3},
+   {"SC[%ld].AC.CfsCtrl.Kunl",1,1},
+   {"SC[%ld].AC.ThrSteerCtrl.Kr",1,3},
+   {"SC[%ld].AC.ThrSteerCtrl.Kp",1,3},
+   {"SC[%ld].AC.Cmd.AngRate",1,3},
+   {"SC[%ld].AC.Cmd.Ang",1,3},
+   {"SC[%ld].B[%ld].wn",2,3},
+   {"SC[%ld].B[%ld].qn",2,4},
+   {"SC[%ld].G[%ld].Pos",2,3},
+   {"SC[%ld].G[%ld].PosRate",2,3},
+   {"SC[%ld].G[%ld].Ang",2,3},
+   {"SC[%ld].G[%ld].AngRate",2,3},
+   {"SC[%ld].GN.Pos",1,3},
+   {"SC[%ld].GN.PosRate",1,3},
+   {"SC[%ld].GN.Ang",1,3},
+   {"SC[%ld].GN.AngRate",1,3},
+   {"SC[%ld].Whl[%ld].H",2,1},
+   {"SC[%ld].Gyro[%ld].SampleTime",2,1},
+   {"SC[%ld].Gyro[%ld].MaxCounter",2,1},
+   {"SC[%ld].Gyro[%ld].Axis",2,3},
+   {"SC[%ld].Gyro[%ld].MaxRate",2,1},
+   {"SC[%ld].Gyro[%ld].Scale",2,1},
+   {"SC[%ld].Gyro[%ld].Quant",2,1},
+   {"SC[%ld].Gyro[%ld].SigV",2,1},
+   {"SC[%ld].Gyro[%ld].SigU",2,1},
+   {"SC[%ld].Gyro[%ld].SigE",2,1},
+   {"SC[%ld].Gyro[%ld].Node",2,1},
+   {"SC[%ld].Gyro[%ld].BiasStabCoef",2,1},
+   {"SC[%ld].Gyro[%ld].ARWCoef",2,1},
+   {"SC[%ld].Gyro[%ld].AngNoiseCoef",2,1},
+   {"SC[%ld].Gyro[%ld].CorrCoef",2,1},
+   {"SC[%ld].Gyro[%ld].TrueRate",2,1},
+   {"SC[%ld].MAG[%ld].SampleTime",2,1},
+   {"SC[%ld].MAG[%ld].MaxCounter",2,1},
+   {"SC[%ld].MAG[%ld].Axis",2,3},
+   {"SC[%ld].MAG[%ld].Saturation",2,1},
+   {"SC[%ld].MAG[%ld].Scale",2,1},
+   {"SC[%ld].MAG[%ld].Quant",2,1},
+   {"SC[%ld].MAG[%ld].Noise",2,1},
+   {"SC[%ld].MAG[%ld].Node",2,1},
+   {"SC[%ld].CSS[%ld].SampleTime",2,1},
+   {"SC[%ld].CSS[%ld].MaxCounter",2,1},
+   {"SC[%ld].CSS[%ld].Body",2,1},
+   {"SC[%ld].CSS[%ld].Axis",2,3},
+   {"SC[%ld].CSS[%ld].FovHalfAng",2,1},
+   {"SC[%ld].CSS[%ld].CosFov",2,1},
+   {"SC[%ld].CSS[%ld].Scale",2,1},
+   {"SC[%ld].CSS[%ld].Quant",2,1},
+   {"SC[%ld].CSS[%ld].Node",2,1},
+   {"SC[%ld].FSS[%ld].SampleTime",2,1},
+   {"SC[%ld].FSS[%ld].MaxCounter",2,1},
+   {"SC[%ld].FSS[%ld].qb",2,4},
+   {"SC[%ld].FSS[%ld].CB",2,9},
+   {"SC[%ld].FSS[%ld].FovHalfAng",2,2},
+   {"SC[%ld].FSS[%ld].NEA",2,1},
+   {"SC[%ld].FSS[%ld].Quant",2,1},
+   {"SC[%ld].FSS[%ld].Node",2,1},
+   {"SC[%ld].FSS[%ld].BoreAxis",2,1},
+   {"SC[%ld].FSS[%ld].H_Axis",2,1},
+   {"SC[%ld].FSS[%ld].V_Axis",2,1},
+   {"SC[%ld].ST[%ld].SampleTime",2,1},
+   {"SC[%ld].ST[%ld].MaxCounter",2,1},
+   {"SC[%ld].ST[%ld].qb",2,4},
+   {"SC[%ld].ST[%ld].CB",2,9},
+   {"SC[%ld].ST[%ld].FovHalfAng",2,2},
+   {"SC[%ld].ST[%ld].CosFov",2,2},
+   {"SC[%ld].ST[%ld].SunExclAng",2,1},
+   {"SC[%ld].ST[%ld].CosSunExclAng",2,1},
+   {"SC[%ld].ST[%ld].EarthExclAng",2,1},
+   {"SC[%ld].ST[%ld].CosEarthExclAng",2,1},
+   {"SC[%ld].ST[%ld].MoonExclAng",2,1},
+   {"SC[%ld].ST[%ld].CosMoonExclAng",2,1},
+   {"SC[%ld].ST[%ld].NEA",2,3},
+   {"SC[%ld].ST[%ld].Node",2,1},
+   {"SC[%ld].ST[%ld].BoreAxis",2,1},
+   {"SC[%ld].ST[%ld].H_Axis",2,1},
+   {"SC[%ld].ST[%ld].V_Axis",2,1},
+   {"SC[%ld].GPS[%ld].SampleTime",2,1},
+   {"SC[%ld].GPS[%ld].MaxCounter",2,1},
+   {"SC[%ld].GPS[%ld].PosNoise",2,1},
+   {"SC[%ld].GPS[%ld].VelNoise",2,1},
+   {"SC[%ld].GPS[%ld].TimeNoise",2,1},
+   {"SC[%ld].GPS[%ld].Node",2,1},
+   {"SC[%ld].Accel[%ld].SampleTime",2,1},
+   {"SC[%ld].Accel[%ld].SampleCounter",2,1},
+   {"SC[%ld].Accel[%ld].MaxCounter",2,1},
+   {"SC[%ld].Accel[%ld].Node",2,1},
+   {"SC[%ld].Accel[%ld].Axis",2,3},
+   {"SC[%ld].Accel[%ld].Quant",2,1},
+   {"SC[%ld].Accel[%ld].Scale",2,1},
+   {"SC[%ld].Accel[%ld].SigV",2,1},
+   {"SC[%ld].Accel[%ld].SigU",2,1},
+   {"SC[%ld].Accel[%ld].SigE",2,1},
+   {"SC[%ld].Shaker[%ld].Body",2,1},
+   {"SC[%ld].Shaker[%ld].Node",2,1},
+   {"SC[%ld].Shaker[%ld].FrcTrq",2,1},
+   {"SC[%ld].Shaker[%ld].Axis",2,3},
+   {"SC[%ld].Shaker[%ld].Ntone",2,1},
+   {"SC[%ld].Shaker[%ld].RandomActive",2,1},
+   {"SC[%ld].Shaker[%ld].ToneAmp",2,1},
+   {"SC[%ld].Shaker[%ld].ToneFreq",2,1},
+   {"SC[%ld].Shaker[%ld].TonePhase",2,1},
+   {"SC[%ld].Shaker[%ld].LowBandLimit",2,1},
+   {"SC[%ld].Shaker[%ld].HighBandLimit",2,1},
+   {"SC[%ld].Shaker[%ld].RandStd",2,1},
+   {"Orb[%ld].Tag",1,1},
+   {"Orb[%ld].Exists",1,1},
+   {"Orb[%ld].Epoch",1,1},
+   {"Orb[%ld].Regime",1,1},
+   {"Orb[%ld].PolyhedronGravityEnabled",1,1},
+   {"Orb[%ld].World",1,1},
+   {"Orb[%ld].Region",1,1},
+   {"Orb[%ld].Sys",1,1},
+   {"Orb[%ld].LP",1,1},
+   {"Orb[%ld].Body1",1,1},
+   {"Orb[%ld].Body2",1,1},
+   {"Orb[%ld].mu1",1,1},
+   {"Orb[%ld].mu2",1,1},
+   {"Orb[%ld].LagDOF",1,1},
+   {"Orb[%ld].Ax",1,1},
+   {"Orb[%ld].Bx",1,1},
+   {"Orb[%ld].Cx",1,1},
+   {"Orb[%ld].Dx",1,1},
+   {"Orb[%ld].Ay",1,1},
+   {"Orb[%ld].By",1,1},
+   {"Orb[%ld].Cy",1,1},
+   {"Orb[%ld].Dy",1,1},
+   {"Orb[%ld].Az",1,1},
+   {"Orb[%ld].Bz",1,1},
+   {"Orb[%ld].mu",1,1},
+   {"Orb[%ld].SMA",1,1},
+   {"Orb[%ld].ecc",1,1},
+   {"Orb[%ld].inc",1,1},
+   {"Orb[%ld].RAAN",1,1},
+   {"Orb[%ld].ArgP",1,1},
+   {"Orb[%ld].tp",1,1},
+   {"Orb[%ld].alpha",1,1},
+   {"Orb[%ld].SLR",1,1},
+   {"Orb[%ld].rmin",1,1},
+   {"Orb[%ld].Period",1,1},
+   {"Orb[%ld].MeanMotion",1,1},
+   {"Orb[%ld].J2DriftEnabled",1,1},
+   {"Orb[%ld].MeanSMA",1,1},
+   {"Orb[%ld].RAAN0",1,1},
+   {"Orb[%ld].ArgP0",1,1},
+   {"Orb[%ld].MeanAnom0",1,1},
+   {"Orb[%ld].RAANdot",1,1},
+   {"Orb[%ld].ArgPdot",1,1},
+   {"Orb[%ld].J2Rw2bya",1,1},
+   {"Orb[%ld].PosN",1,3},
+   {"Orb[%ld].VelN",1,3},
+   {"World[%ld].Exists",1,1},
+   {"World[%ld].Type",1,1},
+   {"World[%ld].Parent",1,1},
+   {"World[%ld].Nsat",1,1},
+   {"World[%ld].Sat",1,1},
+   {"World[%ld].mu",1,1},
+   {"World[%ld].J2",1,1},
+   {"World[%ld].rad",1,1},
+   {"World[%ld].w",1,1},
+   {"World[%ld].PriMerAngJ2000",1,1},
+   {"World[%ld].RadOfInfluence",1,1},
+   {"World[%ld].DipoleMoment",1,1},
+   {"World[%ld].DipoleAxis",1,3},
+   {"World[%ld].DipoleOffset",1,3},
+   {"World[%ld].RingInner,",1,1},
+   {"World[%ld].Density",1,1},
+   {"World[%ld].HasRing",1,1},
+   {"World[%ld].GeomTag",1,1},
+   {"World[%ld].NearExtent,FarExtent",1,1},
+   {"World[%ld].CNH",1,9},
+   {"World[%ld].qnh",1,4},
+   {"World[%ld].PosH",1,3},
+   {"World[%ld].eph.Tag",1,1},
+   {"World[%ld].eph.Exists",1,1},
+   {"World[%ld].eph.Epoch",1,1},
+   {"World[%ld].eph.Regime",1,1},
+   {"World[%ld].eph.PolyhedronGravityEnabled",1,1},
+   {"World[%ld].eph.World",1,1},
+   {"World[%ld].eph.Region",1,1},
+   {"World[%ld].eph.Sys",1,1},
+   {"World[%ld].eph.LP",1,1},
+   {"World[%ld].eph.Body1",1,1},
+   {"World[%ld].eph.Body2",1,1},
+   {"World[%ld].eph.mu1",1,1},
+   {"World[%ld].eph.mu2",1,1},
+   {"World[%ld].eph.LagDOF",1,1},
+   {"World[%ld].eph.Ax",1,1},
+   {"World[%ld].eph.Bx",1,1},
+   {"World[%ld].eph.Cx",1,1},
+   {"World[%ld].eph.Dx",1,1},
+   {"World[%ld].eph.Ay",1,1},
+   {"World[%ld].eph.By",1,1},
+   {"World[%ld].eph.Cy",1,1},
+   {"World[%ld].eph.Dy",1,1},
+   {"World[%ld].eph.Az",1,1},
+   {"World[%ld].eph.Bz",1,1},
+   {"World[%ld].eph.mu",1,1},
+   {"World[%ld].eph.SMA",1,1},
+   {"World[%ld].eph.ecc",1,1},
+   {"World[%ld].eph.inc",1,1},
+   {"World[%ld].eph.RAAN",1,1},
+   {"World[%ld].eph.ArgP",1,1},
+   {"World[%ld].eph.tp",1,1},
+   {"World[%ld].eph.alpha",1,1},
+   {"World[%ld].eph.SLR",1,1},
+   {"World[%ld].eph.rmin",1,1},
+   {"World[%ld].eph.Period",1,1},
+   {"World[%ld].eph.MeanMotion",1,1},
+   {"World[%ld].eph.J2DriftEnabled",1,1},
+   {"World[%ld].eph.MeanSMA",1,1},
+   {"World[%ld].eph.RAAN0",1,1},
+   {"World[%ld].eph.ArgP0",1,1},
+   {"World[%ld].eph.MeanAnom0",1,1},
+   {"World[%ld].eph.RAANdot",1,1},
+   {"World[%ld].eph.ArgPdot",1,1},
+   {"World[%ld].eph.J2Rw2bya",1,1},
+   {"World[%ld].eph.PosN",1,3},
+   {"World[%ld].eph.VelN",1,3},
+};
+
+static SIMLOCAL char *IpcBuf = NULL;
+static SIMLOCAL long IpcBufSize = 0;
+static SIMLOCAL long IpcLen = 0;
+
+/**********************************************************************/
+static void IpcReserve(long N)
+{
+      if (IpcLen+N > IpcBufSize) {
+         IpcBufSize = 2*(IpcLen+N);
+         IpcBuf = (char *) realloc(IpcBuf,IpcBufSize);
+         if (IpcBuf == NULL) {
+            fprintf(stderr,"IPC buffer realloc failed.  Bailing out!\n");
+            exit(EXIT_FAILURE);
+         }
+      }
+}
+/**********************************************************************/
+static void IpcPutHdr(long Id, long I0, long I1, long I2)
+{
+      uint16_t Id16 = (uint16_t) Id;
+      int32_t Idx[3];
+      long Nidx = IpcField[Id].Nidx;
+
+      Idx[0] = (int32_t) I0;
+      Idx[1] = (int32_t) I1;
+      Idx[2] = (int32_t) I2;
+      IpcReserve(2+4*Nidx+8*IpcField[Id].Nval);
+      memcpy(&IpcBuf[IpcLen],&Id16,2);
+      memcpy(&IpcBuf[IpcLen+2],Idx,4*Nidx);
+      IpcLen += 2+4*Nidx;
+}
+/**********************************************************************/
+static void IpcPutDbl(const double *Val, long N)
+{
+      memcpy(&IpcBuf[IpcLen],Val,8*N);
+      IpcLen += 8*N;
+}
+/**********************************************************************/
+static void IpcPutLong(const long *Val, long N)
+{
+      int64_t Val64;
+      long k;
+
+      for(k=0;k<N;k++) {
+         Val64 = (int64_t) Val[k];
+         memcpy(&IpcBuf[IpcLen],&Val64,8);
+         IpcLen += 8;
+      }
+}
+/**********************************************************************/
+/* Would Pfx match the text protocol line for field Id, as strncmp */
+/* does in WriteToSocket?  1 = yes, 0 = no, and with Idx NULL,     */
+/* 2 = depends on the indices.                                     */
+static long IpcPrefixMatch(const char *Pfx, const char *Name, const long *Idx)
+{
+      char Digits[24];
+      long Ip = 0, In = 0, Ix = 0, Nd, k;
+
+      while(Pfx[Ip] != '\0') {
+         if (!strncmp(&Name[In],"%ld",3)) {
+            if (Idx == NULL) return(2);
+            Nd = sprintf(Digits,"%ld",Idx[Ix++]);
+            for(k=0;k<Nd && Pfx[Ip] != '\0';k++,Ip++) {
+               if (Pfx[Ip] != Digits[k]) return(0);
+            }
+            In += 3;
+         }
+         else if (Name[In] == '\0' || Pfx[Ip] != Name[In]) return(0);
+         else {
+            Ip++;
+            In++;
+         }
+      }
+      return(1);
+}
+/**********************************************************************/
+/* Per field, a summary (0 = never sent, 1 = always sent, 2 = check */
+/* indices) and the IpcPrefixMatch result for each prefix           */
+static void IpcBuildFieldSel(struct IpcType *I)
+{
+      long *Sel;
+      long Id,Ipfx;
+
+      I->FieldSel = (long *) calloc(IPC_NFIELD*(I->Nprefix+1),sizeof(long));
+      if (I->FieldSel == NULL) {
+         fprintf(stderr,"IPC field selection calloc failed.  Bailing out!\n");
+         exit(EXIT_FAILURE);
+      }
+      for(Id=0;Id<IPC_NFIELD;Id++) {
+         Sel = &I->FieldSel[Id*(I->Nprefix+1)];
+         for(Ipfx=0;Ipfx<I->Nprefix;Ipfx++) {
+            Sel[1+Ipfx] = IpcPrefixMatch(I->Prefix[Ipfx],IpcField[Id].Name,NULL);
+            if (Sel[1+Ipfx] == 1) Sel[0] = 1;
+            else if (Sel[1+Ipfx] == 2 && Sel[0] == 0) Sel[0] = 2;
+         }
+      }
+}
+/**********************************************************************/
+static long IpcSelected(struct IpcType *I, long Id, long I0, long I1, long I2)
+{
+      long *Sel = &I->FieldSel[Id*(I->Nprefix+1)];
+      long Idx[3];
+      long Ipfx;
+
+      if (Sel[0] != 2) return(Sel[0]);
+      Idx[0] = I0;
+      Idx[1] = I1;
+      Idx[2] = I2;
+      for(Ipfx=0;Ipfx<I->Nprefix;Ipfx++) {
+         if (Sel[1+Ipfx] == 2 &&
+             IpcPrefixMatch(I->Prefix[Ipfx],IpcField[Id].Name,Idx)) return(1);
+      }
+      return(0);
+}
+/**********************************************************************/
+/* Builds one frame in IpcBuf, for whichever transport sends it */
+static void PackBinFrame(struct IpcType *I)
+{
+
+      long Isc,Iorb,Iw,i;
+      uint32_t Hdr[3];
+      double TimeVal[5];
+
+      IpcLen = 0;
+      IpcReserve(12);
+      IpcLen = 12;
+
+      if (I->FieldSel == NULL) IpcBuildFieldSel(I);
+
+      TimeVal[0] = UTC.Year;
+      TimeVal[1] = UTC.doy;
+      TimeVal[2] = UTC.Hour;
+      TimeVal[3] = UTC.Minute;
+      TimeVal[4] = UTC.Second;
+      IpcPutHdr(0,0,0,0);
+      IpcPutDbl(TimeVal,5);
+
+         for(Isc=0;Isc<Nsc;Isc++) {
+            if (SC[Isc].Exists) {
+               if (IpcSelected(I,1,Isc,0,0)) {
+                  IpcPutHdr(1,Isc,0,0);
+                  IpcPutDbl(SC[Isc].PosR,3);
+               }
+               if (IpcSelected(I,2,Isc,0,0)) {
+                  IpcPutHdr(2,Isc,0,0);
+                  IpcPutDbl(SC[Isc].VelR,3);
+               }
+               if (IpcSelected(I,3,Isc,0,0)) {
+                  IpcPutHdr(3,Isc,0,0);
+                  IpcPutDbl(SC[Isc].svb,3);
+               }
+               if (IpcSelected(I,4,Isc,0,0)) {
+                  IpcPutHdr(4,Isc,0,0);
+                  IpcPutDbl(SC[Isc].bvb,3);
+               }
+               if (IpcSelected(I,5,Isc,0,0)) {
+                  IpcPutHdr(5,Isc,0,0);
+                  IpcPutDbl(SC[Isc].Hvb,3);
+               }
+               if (IpcSelected(I,8,Isc,0,0)) {
+                  IpcPutHdr(8,Isc,0,0);
+                  IpcPutLong(&SC[Isc].AC.ParmLoadEnabled,1);
+               }
+               if (IpcSelected(I,9,Isc,0,0)) {
+                  IpcPutHdr(9,Isc,0,0);
+                  IpcPutLong(&SC[Isc].AC.ParmDumpEnabled,1);
+               }
+               for(i=0;i<SC[Isc].AC.Ng;i++) {
+                  if (IpcSelected(I,50,Isc,i,0)) {
+                     IpcPutHdr(50,Isc,i,0);
+                     IpcPutDbl(SC[Isc].AC.G[i].Ang,3);
+                  }
+               }
+
+               for(i=0;i<SC[Isc].AC.Ngyro;i++) {
+                  if (IpcSelected(I,54,Isc,i,0)) {
+                     IpcPutHdr(54,Isc,i,0);
+                     IpcPutDbl(&SC[Isc].AC.Gyro[i].Rate,1);
+                  }
+               }
+
+               for(i=0;i<SC[Isc].AC.Nmag;i++) {
+                  if (IpcSelected(I,56,Isc,i,0)) {
+                     IpcPutHdr(56,Isc,i,0);
+                     IpcPutDbl(&SC[Isc].AC.MAG[i].Field,1);
+                  }
+               }
+
+               for(i=0;i<SC[Isc].AC.Ncss;i++) {
+                  if (IpcSelected(I,60,Isc,i,0)) {
+                     IpcPutHdr(60,Isc,i,0);
+                     IpcPutLong(&SC[Isc].AC.CSS[i].Valid,1);
+                  }
+                  if (IpcSelected(I,61,Isc,i,0)) {
+                     IpcPutHdr(61,Isc,i,0);
+                     IpcPutDbl(&SC[Isc].AC.CSS[i].Illum,1);
+                  }
+               }
+
+               for(i=0;i<SC[Isc].AC.Nfss;i++) {
+                  if (IpcSelected(I,64,Isc,i,0)) {
+                     IpcPutHdr(64,Isc,i,0);
+                     IpcPutLong(&SC[Isc].AC.FSS[i].Valid,1);
+                  }
+                  if (IpcSelected(I,65,Isc,i,0)) {
+                     IpcPutHdr(65,Isc,i,0);
+                     IpcPutDbl(SC[Isc].AC.FSS[i].SunAng,2);
+                  }
+               }
+
+               for(i=0;i<SC[Isc].AC.Nst;i++) {
+                  if (IpcSelected(I,68,Isc,i,0)) {
+                     IpcPutHdr(68,Isc,i,0);
+                     IpcPutLong(&SC[Isc].AC.ST[i].Valid,1);
+                  }
+                  if (IpcSelected(I,69,Isc,i,0)) {
+                     IpcPutHdr(69,Isc,i,0);
+                     IpcPutDbl(SC[Isc].AC.ST[i].qn,4);
+                  }
+               }
+
+               for(i=0;i<SC[Isc].AC.Ngps;i++) {
+                  if (IpcSelected(I,70,Isc,i,0)) {
+                     IpcPutHdr(70,Isc,i,0);
+                     IpcPutLong(&SC[Isc].AC.GPS[i].Valid,1);
+                  }
+                  if (IpcSelected(I,71,Isc,i,0)) {
+                     IpcPutHdr(71,Isc,i,0);
+                     IpcPutLong(&SC[Isc].AC.GPS[i].Rollover,1);
+                  }
+                  if (IpcSelected(I,72,Isc,i,0)) {
+                     IpcPutHdr(72,Isc,i,0);
+                     IpcPutLong(&SC[Isc].AC.GPS[i].Week,1);
+                  }
+                  if (IpcSelected(I,73,Isc,i,0)) {
+                     IpcPutHdr(73,Isc,i,0);
+                     IpcPutDbl(&SC[Isc].AC.GPS[i].Sec,1);
+                  }
+                  if (IpcSelected(I,74,Isc,i,0)) {
+                     IpcPutHdr(74,Isc,i,0);
+                     IpcPutDbl(SC[Isc].AC.GPS[i].PosN,3);
+                  }
+                  if (IpcSelected(I,75,Isc,i,0)) {
+                     IpcPutHdr(75,Isc,i,0);
+                     IpcPutDbl(SC[Isc].AC.GPS[i].VelN,3);
+                  }
+                  if (IpcSelected(I,76,Isc,i,0)) {
+                     IpcPutHdr(76,Isc,i,0);
+                     IpcPutDbl(SC[Isc].AC.GPS[i].PosW,3);
+                  }
+                  if (IpcSelected(I,77,Isc,i,0)) {
+                     IpcPutHdr(77,Isc,i,0);
+                     IpcPutDbl(SC[Isc].AC.GPS[i].VelW,3);
+                  }
+                  if (IpcSelected(I,78,Isc,i,0)) {
+                     IpcPutHdr(78,Isc,i,0);
+                     IpcPutDbl(&SC[Isc].AC.GPS[i].Lng,1);
+                  }
+                  if (IpcSelected(I,79,Isc,i,0)) {
+                     IpcPutHdr(79,Isc,i,0);
+                     IpcPutDbl(&SC[Isc].AC.GPS[i].Lat,1);
+                  }
+                  if (IpcSelected(I,80,Isc,i,0)) {
+                     IpcPutHdr(80,Isc,i,0);
+                     IpcPutDbl(&SC[Isc].AC.GPS[i].Alt,1);
+                  }
+                  if (IpcSelected(I,81,Isc,i,0)) {
+                     IpcPutHdr(81,Isc,i,0);
+                     IpcPutDbl(&SC[Isc].AC.GPS[i].WgsLng,1);
+                  }
+                  if (IpcSelected(I,82,Isc,i,0)) {
+                     IpcPutHdr(82,Isc,i,0);
+                     IpcPutDbl(&SC[Isc].AC.GPS[i].WgsLat,1);
+                  }
+                  if (IpcSelected(I,83,Isc,i,0)) {
+                     IpcPutHdr(83,Isc,i,0);
+                     IpcPutDbl(&SC[Isc].AC.GPS[i].WgsAlt,1);
+                  }
+               }
+
+               for(i=0;i<SC[Isc].AC.Nacc;i++) {
+                  if (IpcSelected(I,86,Isc,i,0)) {
+                     IpcPutHdr(86,Isc,i,0);
+                     IpcPutDbl(&SC[Isc].AC.Accel[i].Acc,1);
+                  }
+               }
+
+               for(i=0;i<SC[Isc].AC.Nwhl;i++) {
+                  if (IpcSelected(I,93,Isc,i,0)) {
+                     IpcPutHdr(93,Isc,i,0);
+                     IpcPutDbl(&SC[Isc].AC.Whl[i].H,1);
+                  }
+               }
+
+               for(i=0;i<SC[Isc].Nb;i++) {
+                  if (IpcSelected(I,137,Isc,i,0)) {
+                     IpcPutHdr(137,Isc,i,0);
+                     IpcPutDbl(SC[Isc].B[i].wn,3);
+                  }
+                  if (IpcSelected(I,138,Isc,i,0)) {
+                     IpcPutHdr(138,Isc,i,0);
+                     IpcPutDbl(SC[Isc].B[i].qn,4);
+                  }
+               }
+
+               for(i=0;i<SC[Isc].Ng;i++) {
+                  if (IpcSelected(I,139,Isc,i,0)) {
+                     IpcPutHdr(139,Isc,i,0);
+                     IpcPutDbl(SC[Isc].G[i].Pos,3);
+                  }
+                  if (IpcSelected(I,140,Isc,i,0)) {
+                     IpcPutHdr(140,Isc,i,0);
+                     IpcPutDbl(SC[Isc].G[i].PosRate,3);
+                  }
+                  if (IpcSelected(I,141,Isc,i,0)) {
+                     IpcPutHdr(141,Isc,i,0);
+                     IpcPutDbl(SC[Isc].G[i].Ang,3);
+                  }
+                  if (IpcSelected(I,142,Isc,i,0)) {
+                     IpcPutHdr(142,Isc,i,0);
+                     IpcPutDbl(SC[Isc].G[i].AngRate,3);
+                  }
+               }
+
+               if (IpcSelected(I,143,Isc,0,0)) {
+                  IpcPutHdr(143,Isc,0,0);
+                  IpcPutDbl(SC[Isc].GN.Pos,3);
+               }
+               if (IpcSelected(I,144,Isc,0,0)) {
+                  IpcPutHdr(144,Isc,0,0);
+                  IpcPutDbl(SC[Isc].GN.PosRate,3);
+               }
+               if (IpcSelected(I,145,Isc,0,0)) {
+                  IpcPutHdr(145,Isc,0,0);
+                  IpcPutDbl(SC[Isc].GN.Ang,3);
+               }
+               if (IpcSelected(I,146,Isc,0,0)) {
+                  IpcPutHdr(146,Isc,0,0);
+                  IpcPutDbl(SC[Isc].GN.AngRate,3);
+               }
+               for(i=0;i<SC[Isc].Nw;i++) {
+                  if (IpcSelected(I,147,Isc,i,0)) {
+                     IpcPutHdr(147,Isc,i,0);
+                     IpcPutDbl(&SC[Isc].Whl[i].H,1);
+                  }
+               }
+
+               for(i=0;i<SC[Isc].Ngyro;i++) {
+                  if (IpcSelected(I,162,Isc,i,0)) {
+                     IpcPutHdr(162,Isc,i,0);
+                     IpcPutDbl(&SC[Isc].Gyro[i].TrueRate,1);
+                  }
+               }
+
+            }
+         }
+
+         for(Iw=1;Iw<NWORLD;Iw++) {
+            if (World[Iw].Exists) {
+               if (IpcSelected(I,303,Iw,0,0)) {
+                  IpcPutHdr(303,Iw,0,0);
+                  IpcPutDbl(World[Iw].PosH,3);
+               }
+               if (IpcSelected(I,348,Iw,0,0)) {
+                  IpcPutHdr(348,Iw,0,0);
+                  IpcPutDbl(World[Iw].eph.PosN,3);
+               }
+               if (IpcSelected(I,349,Iw,0,0)) {
+                  IpcPutHdr(349,Iw,0,0);
+                  IpcPutDbl(World[Iw].eph.VelN,3);
+               }
+            }
+         }
+
+         for(Iorb=0;Iorb<Norb;Iorb++) {
+            if (Orb[Iorb].Exists) {
+               if (IpcSelected(I,280,Iorb,0,0)) {
+                  IpcPutHdr(280,Iorb,0,0);
+                  IpcPutDbl(Orb[Iorb].PosN,3);
+               }
+               if (IpcSelected(I,281,Iorb,0,0)) {
+                  IpcPutHdr(281,Iorb,0,0);
+                  IpcPutDbl(Orb[Iorb].VelN,3);
+               }
+            }
+         }
+
+         for(Isc=0;Isc<Nsc;Isc++) {
+            if (SC[Isc].Exists) {
+               if (SC[Isc].AC.ParmLoadEnabled) {
+                  if (IpcSelected(I,6,Isc,0,0)) {
+                     IpcPutHdr(6,Isc,0,0);
+                     IpcPutLong(&SC[Isc].AC.ID,1);
+                  }
+                  if (IpcSelected(I,7,Isc,0,0)) {
+                     IpcPutHdr(7,Isc,0,0);
+                     IpcPutLong(&SC[Isc].AC.EchoEnabled,1);
+                  }
+                  if (IpcSelected(I,10,Isc,0,0)) {
+                     IpcPutHdr(10,Isc,0,0);
+                     IpcPutLong(&SC[Isc].AC.Nb,1);
+                  }
+                  if (IpcSelected(I,11,Isc,0,0)) {
+                     IpcPutHdr(11,Isc,0,0);
+                     IpcPutLong(&SC[Isc].AC.Ng,1);
+                  }
+                  if (IpcSelected(I,12,Isc,0,0)) {
+                     IpcPutHdr(12,Isc,0,0);
+                     IpcPutLong(&SC[Isc].AC.Nwhl,1);
+                  }
+                  if (IpcSelected(I,13,Isc,0,0)) {
+                     IpcPutHdr(13,Isc,0,0);
+                     IpcPutLong(&SC[Isc].AC.Nmtb,1);
+                  }
+                  if (IpcSelected(I,14,Isc,0,0)) {
+                     IpcPutHdr(14,Isc,0,0);
+                     IpcPutLong(&SC[Isc].AC.Nthr,1);
+                  }
+                  if (IpcSelected(I,15,Isc,0,0)) {
+                     IpcPutHdr(15,Isc,0,0);
+                     IpcPutLong(&SC[Isc].AC.Ncmg,1);
+                  }
+                  if (IpcSelected(I,16,Isc,0,0)) {
+                     IpcPutHdr(16,Isc,0,0);
+                     IpcPutLong(&SC[Isc].AC.Ngyro,1);
+                  }
+                  if (IpcSelected(I,17,Isc,0,0)) {
+                     IpcPutHdr(17,Isc,0,0);
+                     IpcPutLong(&SC[Isc].AC.Nmag,1);
+                  }
+                  if (IpcSelected(I,18,Isc,0,0)) {
+                     IpcPutHdr(18,Isc,0,0);
+                     IpcPutLong(&SC[Isc].AC.Ncss,1);
+                  }
+                  if (IpcSelected(I,19,Isc,0,0)) {
+                     IpcPutHdr(19,Isc,0,0);
+                     IpcPutLong(&SC[Isc].AC.Nfss,1);
+                  }
+                  if (IpcSelected(I,20,Isc,0,0)) {
+                     IpcPutHdr(20,Isc,0,0);
+                     IpcPutLong(&SC[Isc].AC.Nst,1);
+                  }
+                  if (IpcSelected(I,21,Isc,0,0)) {
+                     IpcPutHdr(21,Isc,0,0);
+                     IpcPutLong(&SC[Isc].AC.Ngps,1);
+                  }
+                  if (IpcSelected(I,22,Isc,0,0)) {
+                     IpcPutHdr(22,Isc,0,0);
+                     IpcPutLong(&SC[Isc].AC.Nacc,1);
+                  }
+                  if (IpcSelected(I,23,Isc,0,0)) {
+                     IpcPutHdr(23,Isc,0,0);
+                     IpcPutDbl(&SC[Isc].AC.Pi,1);
+                  }
+                  if (IpcSelected(I,24,Isc,0,0)) {
+                     IpcPutHdr(24,Isc,0,0);
+                     IpcPutDbl(&SC[Isc].AC.TwoPi,1);
+                  }
+                  if (IpcSelected(I,25,Isc,0,0)) {
+                     IpcPutHdr(25,Isc,0,0);
+                     IpcPutDbl(&SC[Isc].AC.DT,1);
+                  }
+                  if (IpcSelected(I,26,Isc,0,0)) {
+                     IpcPutHdr(26,Isc,0,0);
+                     IpcPutDbl(&SC[Isc].AC.mass,1);
+                  }
+                  if (IpcSelected(I,27,Isc,0,0)) {
+                     IpcPutHdr(27,Isc,0,0);
+                     IpcPutDbl(SC[Isc].AC.cm,3);
+                  }
+                  if (IpcSelected(I,28,Isc,0,0)) {
+                     IpcPutHdr(28,Isc,0,0);
+                     IpcPutDbl(&SC[Isc].AC.MOI[0][0],9);
+                  }
+                  for(i=0;i<SC[Isc].AC.Nb;i++) {
+                     if (IpcSelected(I,32,Isc,i,0)) {
+                        IpcPutHdr(32,Isc,i,0);
+                        IpcPutDbl(&SC[Isc].AC.B[i].mass,1);
+                     }
+                     if (IpcSelected(I,33,Isc,i,0)) {
+                        IpcPutHdr(33,Isc,i,0);
+                        IpcPutDbl(SC[Isc].AC.B[i].cm,3);
+                     }
+                     if (IpcSelected(I,34,Isc,i,0)) {
+                        IpcPutHdr(34,Isc,i,0);
+                        IpcPutDbl(&SC[Isc].AC.B[i].MOI[0][0],9);
+                     }
+                  }
+
+                  for(i=0;i<SC[Isc].AC.Ng;i++) {
+                     if (IpcSelected(I,35,Isc,i,0)) {
+                        IpcPutHdr(35,Isc,i,0);
+                        IpcPutLong(&SC[Isc].AC.G[i].IsSpherical,1);
+                     }
+                     if (IpcSelected(I,36,Isc,i,0)) {
+                        IpcPutHdr(36,Isc,i,0);
+                        IpcPutLong(&SC[Isc].AC.G[i].RotDOF,1);
+                     }
+                     if (IpcSelected(I,37,Isc,i,0)) {
+                        IpcPutHdr(37,Isc,i,0);
+                        IpcPutLong(&SC[Isc].AC.G[i].TrnDOF,1);
+                     }
+                     if (IpcSelected(I,38,Isc,i,0)) {
+                        IpcPutHdr(38,Isc,i,0);
+                        IpcPutLong(&SC[Isc].AC.G[i].RotSeq,1);
+                     }
+                     if (IpcSelected(I,39,Isc,i,0)) {
+                        IpcPutHdr(39,Isc,i,0);
+                        IpcPutLong(&SC[Isc].AC.G[i].TrnSeq,1);
+                     }
+                     if (IpcSelected(I,40,Isc,i,0)) {
+                        IpcPutHdr(40,Isc,i,0);
+                        IpcPutDbl(&SC[Isc].AC.G[i].CGiBi[0][0],9);
+                     }
+                     if (IpcSelected(I,41,Isc,i,0)) {
+                        IpcPutHdr(41,Isc,i,0);
+                        IpcPutDbl(&SC[Isc].AC.G[i].CBoGo[0][0],9);
+                     }
+                     if (IpcSelected(I,42,Isc,i,0)) {
+                        IpcPutHdr(42,Isc,i,0);
+                        IpcPutDbl(SC[Isc].AC.G[i].AngGain,3);
+                     }
+                     if (IpcSelected(I,43,Isc,i,0)) {
+                        IpcPutHdr(43,Isc,i,0);
+                        IpcPutDbl(SC[Isc].AC.G[i].AngRateGain,3);
+                     }
+                     if (IpcSelected(I,44,Isc,i,0)) {
+                        IpcPutHdr(44,Isc,i,0);
+                        IpcPutDbl(SC[Isc].AC.G[i].PosGain,3);
+                     }
+                     if (IpcSelected(I,45,Isc,i,0)) {
+                        IpcPutHdr(45,Isc,i,0);
+                        IpcPutDbl(SC[Isc].AC.G[i].PosRateGain,3);
+                     }
+                     if (IpcSelected(I,46,Isc,i,0)) {
+                        IpcPutHdr(46,Isc,i,0);
+                        IpcPutDbl(SC[Isc].AC.G[i].MaxAngRate,3);
+                     }
+                     if (IpcSelected(I,47,Isc,i,0)) {
+                        IpcPutHdr(47,Isc,i,0);
+                        IpcPutDbl(SC[Isc].AC.G[i].MaxPosRate,3);
+                     }
+                     if (IpcSelected(I,48,Isc,i,0)) {
+                        IpcPutHdr(48,Isc,i,0);
+                        IpcPutDbl(SC[Isc].AC.G[i].MaxTrq,3);
+                     }
+                     if (IpcSelected(I,49,Isc,i,0)) {
+                        IpcPutHdr(49,Isc,i,0);
+                        IpcPutDbl(SC[Isc].AC.G[i].MaxFrc,3);
+                     }
+                  }
+
+                  for(i=0;i<SC[Isc].AC.Ngyro;i++) {
+                     if (IpcSelected(I,53,Isc,i,0)) {
+                        IpcPutHdr(53,Isc,i,0);
+                        IpcPutDbl(SC[Isc].AC.Gyro[i].Axis,3);
+                     }
+                  }
+
+                  for(i=0;i<SC[Isc].AC.Nmag;i++) {
+                     if (IpcSelected(I,55,Isc,i,0)) {
+                        IpcPutHdr(55,Isc,i,0);
+                        IpcPutDbl(SC[Isc].AC.MAG[i].Axis,3);
+                     }
+                  }
+
+                  for(i=0;i<SC[Isc].AC.Ncss;i++) {
+                     if (IpcSelected(I,57,Isc,i,0)) {
+                        IpcPutHdr(57,Isc,i,0);
+                        IpcPutLong(&SC[Isc].AC.CSS[i].Body,1);
+                     }
+                     if (IpcSelected(I,58,Isc,i,0)) {
+                        IpcPutHdr(58,Isc,i,0);
+                        IpcPutDbl(SC[Isc].AC.CSS[i].Axis,3);
+                     }
+                     if (IpcSelected(I,59,Isc,i,0)) {
+                        IpcPutHdr(59,Isc,i,0);
+                        IpcPutDbl(&SC[Isc].AC.CSS[i].Scale,1);
+                     }
+                  }
+
+                  for(i=0;i<SC[Isc].AC.Nfss;i++) {
+                     if (IpcSelected(I,62,Isc,i,0)) {
+                        IpcPutHdr(62,Isc,i,0);
+                        IpcPutDbl(SC[Isc].AC.FSS[i].qb,4);
+                     }
+                     if (IpcSelected(I,63,Isc,i,0)) {
+                        IpcPutHdr(63,Isc,i,0);
+                        IpcPutDbl(&SC[Isc].AC.FSS[i].CB[0][0],9);
+                     }
+                  }
+
+                  for(i=0;i<SC[Isc].AC.Nst;i++) {
+                     if (IpcSelected(I,66,Isc,i,0)) {
+                        IpcPutHdr(66,Isc,i,0);
+                        IpcPutDbl(SC[Isc].AC.ST[i].qb,4);
+                     }
+                     if (IpcSelected(I,67,Isc,i,0)) {
+                        IpcPutHdr(67,Isc,i,0);
+                        IpcPutDbl(&SC[Isc].AC.ST[i].CB[0][0],9);
+                     }
+                  }
+
+                  for(i=0;i<SC[Isc].AC.Nacc;i++) {
+                     if (IpcSelected(I,84,Isc,i,0)) {
+                        IpcPutHdr(84,Isc,i,0);
+                        IpcPutDbl(SC[Isc].AC.Accel[i].PosB,3);
+                     }
+                     if (IpcSelected(I,85,Isc,i,0)) {
+                        IpcPutHdr(85,Isc,i,0);
+                        IpcPutDbl(SC[Isc].AC.Accel[i].Axis,3);
+                     }
+                  }
+
+                  for(i=0;i<SC[Isc].AC.Nwhl;i++) {
+                     if (IpcSelected(I,87,Isc,i,0)) {
+                        IpcPutHdr(87,Isc,i,0);
+                        IpcPutLong(&SC[Isc].AC.Whl[i].Body,1);
+                     }
+                     if (IpcSelected(I,88,Isc,i,0)) {
+                        IpcPutHdr(88,Isc,i,0);
+                        IpcPutDbl(SC[Isc].AC.Whl[i].Axis,3);
+                     }
+                     if (IpcSelected(I,89,Isc,i,0)) {
+                        IpcPutHdr(89,Isc,i,0);
+                        IpcPutDbl(SC[Isc].AC.Whl[i].DistVec,3);
+                     }
+                     if (IpcSelected(I,90,Isc,i,0)) {
+                        IpcPutHdr(90,Isc,i,0);
+                        IpcPutDbl(&SC[Isc].AC.Whl[i].J,1);
+                     }
+                     if (IpcSelected(I,91,Isc,i,0)) {
+                        IpcPutHdr(91,Isc,i,0);
+                        IpcPutDbl(&SC[Isc].AC.Whl[i].Tmax,1);
+                     }
+                     if (IpcSelected(I,92,Isc,i,0)) {
+                        IpcPutHdr(92,Isc,i,0);
+                        IpcPutDbl(&SC[Isc].AC.Whl[i].Hmax,1);
+                     }
+                  }
+
+                  for(i=0;i<SC[Isc].AC.Nmtb;i++) {
+                     if (IpcSelected(I,95,Isc,i,0)) {
+                        IpcPutHdr(95,Isc,i,0);
+                        IpcPutDbl(SC[Isc].AC.MTB[i].Axis,3);
+                     }
+                     if (IpcSelected(I,96,Isc,i,0)) {
+                        IpcPutHdr(96,Isc,i,0);
+                        IpcPutDbl(SC[Isc].AC.MTB[i].DistVec,3);
+                     }
+                     if (IpcSelected(I,97,Isc,i,0)) {
+                        IpcPutHdr(97,Isc,i,0);
+                        IpcPutDbl(&SC[Isc].AC.MTB[i].Mmax,1);
+                     }
+                  }
+
+                  for(i=0;i<SC[Isc].AC.Nthr;i++) {
+                     if (IpcSelected(I,99,Isc,i,0)) {
+                        IpcPutHdr(99,Isc,i,0);
+                        IpcPutLong(&SC[Isc].AC.Thr[i].Body,1);
+                     }
+                     if (IpcSelected(I,100,Isc,i,0)) {
+                        IpcPutHdr(100,Isc,i,0);
+                        IpcPutDbl(SC[Isc].AC.Thr[i].PosB,3);
+                     }
+                     if (IpcSelected(I,101,Isc,i,0)) {
+                        IpcPutHdr(101,Isc,i,0);
+                        IpcPutDbl(SC[Isc].AC.Thr[i].Axis,3);
+                     }
+                     if (IpcSelected(I,102,Isc,i,0)) {
+                        IpcPutHdr(102,Isc,i,0);
+                        IpcPutDbl(SC[Isc].AC.Thr[i].rxA,3);
+                     }
+                     if (IpcSelected(I,103,Isc,i,0)) {
+                        IpcPutHdr(103,Isc,i,0);
+                        IpcPutDbl(&SC[Isc].AC.Thr[i].Fmax,1);
+                     }
+                  }
+
+                  if (IpcSelected(I,106,Isc,0,0)) {
+                     IpcPutHdr(106,Isc,0,0);
+                     IpcPutDbl(&SC[Isc].AC.PrototypeCtrl.wc,1);
+                  }
+                  if (IpcSelected(I,107,Isc,0,0)) {
+                     IpcPutHdr(107,Isc,0,0);
+                     IpcPutDbl(&SC[Isc].AC.PrototypeCtrl.amax,1);
+                  }
+                  if (IpcSelected(I,108,Isc,0,0)) {
+                     IpcPutHdr(108,Isc,0,0);
+                     IpcPutDbl(&SC[Isc].AC.PrototypeCtrl.vmax,1);
+                  }
+                  if (IpcSelected(I,109,Isc,0,0)) {
+                     IpcPutHdr(109,Isc,0,0);
+                     IpcPutDbl(&SC[Isc].AC.PrototypeCtrl.Kprec,1);
+                  }
+                  if (IpcSelected(I,110,Isc,0,0)) {
+                     IpcPutHdr(110,Isc,0,0);
+                     IpcPutDbl(&SC[Isc].AC.PrototypeCtrl.Knute,1);
+                  }
+                  if (IpcSelected(I,111,Isc,0,0)) {
+                     IpcPutHdr(111,Isc,0,0);
+                     IpcPutDbl(SC[Isc].AC.AdHocCtrl.Kr,3);
+                  }
+                  if (IpcSelected(I,112,Isc,0,0)) {
+                     IpcPutHdr(112,Isc,0,0);
+                     IpcPutDbl(SC[Isc].AC.AdHocCtrl.Kp,3);
+                  }
+                  if (IpcSelected(I,113,Isc,0,0)) {
+                     IpcPutHdr(113,Isc,0,0);
+                     IpcPutDbl(&SC[Isc].AC.SpinnerCtrl.Ispin,1);
+                  }
+                  if (IpcSelected(I,114,Isc,0,0)) {
+                     IpcPutHdr(114,Isc,0,0);
+                     IpcPutDbl(&SC[Isc].AC.SpinnerCtrl.Itrans,1);
+                  }
+                  if (IpcSelected(I,115,Isc,0,0)) {
+                     IpcPutHdr(115,Isc,0,0);
+                     IpcPutDbl(&SC[Isc].AC.SpinnerCtrl.SpinRate,1);
+                  }
+                  if (IpcSelected(I,116,Isc,0,0)) {
+                     IpcPutHdr(116,Isc,0,0);
+                     IpcPutDbl(&SC[Isc].AC.SpinnerCtrl.Knute,1);
+                  }
+                  if (IpcSelected(I,117,Isc,0,0)) {
+                     IpcPutHdr(117,Isc,0,0);
+                     IpcPutDbl(&SC[Isc].AC.SpinnerCtrl.Kprec,1);
+                  }
+                  if (IpcSelected(I,118,Isc,0,0)) {
+                     IpcPutHdr(118,Isc,0,0);
+                     IpcPutDbl(SC[Isc].AC.ThreeAxisCtrl.Kr,3);
+                  }
+                  if (IpcSelected(I,119,Isc,0,0)) {
+                     IpcPutHdr(119,Isc,0,0);
+                     IpcPutDbl(SC[Isc].AC.ThreeAxisCtrl.Kp,3);
+                  }
+                  if (IpcSelected(I,120,Isc,0,0)) {
+                     IpcPutHdr(120,Isc,0,0);
+                     IpcPutDbl(&SC[Isc].AC.ThreeAxisCtrl.Kunl,1);
+                  }
+                  if (IpcSelected(I,121,Isc,0,0)) {
+                     IpcPutHdr(121,Isc,0,0);
+                     IpcPutDbl(SC[Isc].AC.IssCtrl.Kr,3);
+                  }
+                  if (IpcSelected(I,122,Isc,0,0)) {
+                     IpcPutHdr(122,Isc,0,0);
+                     IpcPutDbl(SC[Isc].AC.IssCtrl.Kp,3);
+                  }
+                  if (IpcSelected(I,123,Isc,0,0)) {
+                     IpcPutHdr(123,Isc,0,0);
+                     IpcPutDbl(&SC[Isc].AC.IssCtrl.Tmax,1);
+                  }
+                  if (IpcSelected(I,124,Isc,0,0)) {
+                     IpcPutHdr(124,Isc,0,0);
+                     IpcPutDbl(SC[Isc].AC.CmgCtrl.Kr,3);
+                  }
+                  if (IpcSelected(I,125,Isc,0,0)) {
+                     IpcPutHdr(125,Isc,0,0);
+                     IpcPutDbl(SC[Isc].AC.CmgCtrl.Kp,3);
+                  }
+                  if (IpcSelected(I,126,Isc,0,0)) {
+                     IpcPutHdr(126,Isc,0,0);
+                     IpcPutDbl(SC[Isc].AC.ThrCtrl.Kw,3);
+                  }
+                  if (IpcSelected(I,127,Isc,0,0)) {
+                     IpcPutHdr(127,Isc,0,0);
+                     IpcPutDbl(SC[Isc].AC.ThrCtrl.Kth,3);
+                  }
+                  if (IpcSelected(I,128,Isc,0,0)) {
+                     IpcPutHdr(128,Isc,0,0);
+                     IpcPutDbl(&SC[Isc].AC.ThrCtrl.Kv,1);
+                  }
+                  if (IpcSelected(I,129,Isc,0,0)) {
+                     IpcPutHdr(129,Isc,0,0);
+                     IpcPutDbl(&SC[Isc].AC.ThrCtrl.Kp,1);
+                  }
+                  if (IpcSelected(I,130,Isc,0,0)) {
+                     IpcPutHdr(130,Isc,0,0);
+                     IpcPutDbl(SC[Isc].AC.CfsCtrl.Kr,3);
+                  }
+                  if (IpcSelected(I,131,Isc,0,0)) {
+                     IpcPutHdr(131,Isc,0,0);
+                     IpcPutDbl(SC[Isc].AC.CfsCtrl.Kp,3);
+                  }
+                  if (IpcSelected(I,132,Isc,0,0)) {
+                     IpcPutHdr(132,Isc,0,0);
+                     IpcPutDbl(&SC[Isc].AC.CfsCtrl.Kunl,1);
+                  }
+                  if (IpcSelected(I,133,Isc,0,0)) {
+                     IpcPutHdr(133,Isc,0,0);
+                     IpcPutDbl(SC[Isc].AC.ThrSteerCtrl.Kr,3);
+                  }
+                  if (IpcSelected(I,134,Isc,0,0)) {
+                     IpcPutHdr(134,Isc,0,0);
+                     IpcPutDbl(SC[Isc].AC.ThrSteerCtrl.Kp,3);
+                  }
+               }
+            }
+         }
+
+      Hdr[0] = IPC_MAGIC;
+      Hdr[1] = IPC_SCHEMA;
+      Hdr[2] = (uint32_t) (IpcLen-12);
+      memcpy(IpcBuf,Hdr,12);
+      if (I->EchoEnabled) printf("Binary IPC frame, %ld bytes\n",IpcLen);
+}
+/**********************************************************************/
+void WriteToBinSocket(struct IpcType *I)
+{
+      char AckMsg[5] = "Ack\n";
+
+      PackBinFrame(I);
+      send(I->Socket,IpcBuf,IpcLen,0);
+
+      /* Wait for Ack */
+      recv(I->Socket,AckMsg,5,0);
+}
+/**********************************************************************/
+/* No Ack: ShmSend waits whenever the ring is full */
+void WriteToShm(struct IpcType *I)
+{
+      PackBinFrame(I);
+      ShmSend(I->Shm,IpcBuf,IpcLen);
+}
@@ -209,6 +209,52 @@ long RunMathKit_Tests()
    cholDownDateTested = FALSE;
    success &=
        print_result(testSuccess, "Cholesky AAT Tests:", 20, 2, "", FALSE, TRUE);
+   testSuccess = TRUE;
+   print_hdr("LDL Solve Tests:", 17, 1);
+   for (int i = 0; i < NMATS; i++) {
+      if (n[i] == m[i] && isInv[i]) {
+         double **AAT = CreateMatrix(n[i], n[i]);
+         double **LU  = CreateMatrix(n[i], n[i]);
+         double x[n[i]], b[n[i]], d[n[i]], xLDL[n[i]], xLU[n[i]];
+         MxMTG(mats[i], mats[i], AAT, n[i], n[i], n[i]);
+         for (int j = 0; j < n[i]; j++) {
+            x[j] = 1.0 + j;
+            for (int k = 0; k < n[i]; k++)
+               LU[j][k] = AAT[j][k];
+         }
+         for (int j = 0; j < n[i]; j++) {
+            b[j] = 0.0;
+            for (int k = 0; k < n[i]; k++)
+               b[j] += AAT[j][k] * x[k];
+         }
+         {
+            char trialInfo[40] = {0};
+            snprintf(trialInfo, 39, "%i", i);
+            testSuccess &= print_result(LDLFactor(AAT, d, n[i]),
+                                        "LDLFactor Test", 15, 2, trialInfo,
+                                        FALSE, FALSE);
+            LDLSolve(AAT, d, xLDL, b, n[i]);
+            testSuccess &= print_result(TEST_VEC(n[i], xLDL, x, 1e-8),
+                                        "LDLSolve Test", 14, 2, trialInfo,
+                                        FALSE, FALSE);
+            LINSOLVE(LU, xLU, b, n[i]);
+            testSuccess &= print_result(TEST_VEC(n[i], xLU, x, 1e-8),
+                                        "LINSOLVE Test", 14, 2, trialInfo,
+                                        FALSE, FALSE);
+            for (int j = 0; j < n[i]; j++) {
+               for (int k = 0; k < n[i]; k++)
+                  LU[j][k] = -mats[6][j % 3][k % 3] * (j / 3 == k / 3);
+            }
+            testSuccess &= print_result(!LDLFactor(LU, d, n[i]),
+                                        "LDLFactor Indefinite Test", 26, 2,
+                                        trialInfo, FALSE, FALSE);
+         }
+         DestroyMatrix(AAT);
+         DestroyMatrix(LU);
+      }
+   }
+   success &=
+       print_result(testSuccess, "LDL Solve Tests:", 17, 2, "", FALSE, TRUE);
    for (int kk = 0; kk < 2; kk++) {
       testSuccess = TRUE;
       print_hdr(kk == 0 ? "hqrd Tests:" : "bhqrd Tests:", kk == 0 ? 12 : 13, 1);
@@ -327,6 +373,39 @@ long RunMathKit_Tests()
                 print_result(TEST_MAT(3, 3, RTests[i * 3 + j], R, 1e-12),
                              "expmso3 Test", 13, 2, trialInfo, FALSE, FALSE);
          }
+         {
+            /* The general expm must agree, from degree 3 up to scaled 13 */
+            double **Ax = CreateMatrix(3, 3), **Ex = CreateMatrix(3, 3);
+            double Wx[3][3], Rx[3][3], Rs[3][3], Ws[3], Scl = 1.0E-3;
+            char trialInfo[40] = {0};
+            snprintf(trialInfo, 39, "%i, %i", i, j);
+            V2CrossM(test3[i][j], Wx);
+            for (int k = 0; k < 3; k++)
+               for (int l = 0; l < 3; l++)
+                  Ax[k][l] = Wx[k][l];
+            expm(Ax, Ex, 3);
+            for (int k = 0; k < 3; k++)
+               for (int l = 0; l < 3; l++)
+                  Rx[k][l] = Ex[k][l];
+            testSuccess &=
+                print_result(TEST_MAT(3, 3, RTests[i * 3 + j], Rx, 1e-12),
+                             "expm Test", 10, 2, trialInfo, FALSE, FALSE);
+            for (int k = 0; k < 3; k++) {
+               Ws[k] = Scl * test3[i][j][k];
+               for (int l = 0; l < 3; l++)
+                  Ax[k][l] *= Scl;
+            }
+            expmso3(Ws, Rs);
+            expm(Ax, Ex, 3);
+            for (int k = 0; k < 3; k++)
+               for (int l = 0; l < 3; l++)
+                  Rx[k][l] = Ex[k][l];
+            testSuccess &= print_result(TEST_MAT(3, 3, Rs, Rx, 1e-15),
+                                        "expm Small Test", 16, 2, trialInfo,
+                                        FALSE, FALSE);
+            DestroyMatrix(Ax);
+            DestroyMatrix(Ex);
+         }
          logso3(R, theta);
          double unitTest[3] = {0.0};
          double magTest     = CopyUnitV(test3[i][j], unitTest);
@@ -723,6 +802,208 @@ long RunMathKit_Tests()
    }
    success &= print_result(testSuccess, "NewtonRaphson Tests:", 21, 2, "",
                            FALSE, TRUE);
+
+   testSuccess = TRUE;
+   print_hdr("Random Stream Tests:", 21, 1);
+   {
+      /* Known-answer tests from the Random123 distribution */
+      const uint32_t Ctr[3][4] = {{0, 0, 0, 0},
+                                  {0xffffffff, 0xffffffff, 0xffffffff,
+                                   0xffffffff},
+                                  {0x243f6a88, 0x85a308d3, 0x13198a2e,
+                                   0x03707344}};
+      const uint32_t Key[3][2] = {
+          {0, 0}, {0xffffffff, 0xffffffff}, {0xa4093822, 0x299f31d0}};
+      const uint32_t Ans[3][4] = {
+          {0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8},
+          {0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd},
+          {0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}};
+      uint32_t Out[4];
+      for (int i = 0; i < 3; i++) {
+         char trialInfo[40] = {0};
+         snprintf(trialInfo, 39, "%i", i);
+         Philox4x32(Ctr[i], Key[i], Out);
+         testSuccess &= print_result(
+             Out[0] == Ans[i][0] && Out[1] == Ans[i][1] &&
+                 Out[2] == Ans[i][2] && Out[3] == Ans[i][3],
+             "Philox4x32 Test", 16, 2, trialInfo, FALSE, FALSE);
+      }
+
+      /* Batched draws must match one-at-a-time draws bit for bit */
+      struct RandomStreamType RS1, RS2;
+      double Vec[21], Scalar[21];
+      InitRandomStream(&RS1, 42, 1, 2, 3, 0);
+      InitRandomStream(&RS2, 42, 1, 2, 3, 0);
+      GaussianStream(&RS1);
+      GaussianStreamVec(&RS1, Vec, 21);
+      GaussianStream(&RS2);
+      for (int i = 0; i < 21; i++)
+         Scalar[i] = GaussianStream(&RS2);
+      testSuccess &= print_result(TEST_VEC(21, Vec, Scalar, 0.0),
+                                  "GaussianStreamVec Test", 23, 2, "", FALSE,
+                                  FALSE);
+   }
+   success &= print_result(testSuccess, "Random Stream Tests:", 21, 2, "",
+                           FALSE, TRUE);
+
+   testSuccess = TRUE;
+   print_hdr("IGRF Batch Tests:", 18, 1);
+   {
+      /* IGRFMagFieldBatch against IGRFMagField one position at a time, */
+      /* with and without the coefficient cache.  The field must also   */
+      /* look like Earth's at LEO, so a missing coefficient file can't  */
+      /* pass as two matching zeroes.                                   */
+      struct DateType UTC = {0};
+      double **PosN       = CreateMatrix(4, 3);
+      double **BatchB     = CreateMatrix(4, 3);
+      double B[3];
+
+      UTC.Year   = 2025;
+      UTC.Month  = 3;
+      UTC.Day    = 1;
+      UTC.doy    = 60;
+      UTC.Hour   = 6;
+      UTC.Minute = 30;
+      UTC.Second = 12.5;
+      for (int i = 0; i < 4; i++) {
+         PosN[i][0] = 6.9E6 * cos(0.4 + 1.7 * i) * cos(0.3 * i - 0.5);
+         PosN[i][1] = 6.9E6 * sin(0.4 + 1.7 * i) * cos(0.3 * i - 0.5);
+         PosN[i][2] = 6.9E6 * sin(0.3 * i - 0.5);
+      }
+      for (int k = 0; k < 2; k++) {
+         const double EpochDT = (k == 0 ? 0.0 : 86400.0);
+         IGRFMagFieldBatch("./Model/", UTC, EpochDT, 10, 10, 4, PosN, 1.234,
+                           BatchB);
+         for (int i = 0; i < 4; i++) {
+            char trialInfo[40] = {0};
+            snprintf(trialInfo, 39, "%i, %i", k, i);
+            IGRFMagField("./Model/", UTC, EpochDT, 10, 10, PosN[i], 1.234, B);
+            testSuccess &= print_result(
+                TEST_VEC(3, BatchB[i], B, 1.0E-12 * MAGV(B)) &&
+                    MAGV(B) > 1.0E-5 && MAGV(B) < 1.0E-4,
+                "IGRFMagFieldBatch Test", 23, 2, trialInfo, FALSE, FALSE);
+         }
+      }
+      DestroyMatrix(PosN);
+      DestroyMatrix(BatchB);
+   }
+   success &= print_result(testSuccess, "IGRF Batch Tests:", 18, 2, "", FALSE,
+                           TRUE);
+
+   testSuccess = TRUE;
+   print_hdr("Spherical Harmonic Gravity Tests:", 34, 1);
+   {
+      /* SphereHarmGrav against the legacy SphericalHarmonics path at  */
+      /* degree and order 20, from 1 mrad off the north pole to 1 mrad */
+      /* off the south pole.  Closer in, the legacy path loses digits  */
+      /* (and zeroes the east component on the axis), so there the    */
+      /* new engine is checked for a smooth limit at the poles.        */
+      /* Coefficients are synthetic, fully normalized, and fall off as */
+      /* 1/deg^2 like a real field.                                      */
+#define SH_N 20
+      struct SphereHarmType SH = {0};
+      const double theta[5]    = {1.0E-3, 0.05, 0.7, 1.6, PI - 1.0E-3};
+      const double Re = 1.0, r = 1.05, K = 1.0;
+      double trigs[4], gradV[3], legacyGradV[3], poleGradV[3];
+      long deg, ord;
+
+      SH.N    = SH_N;
+      SH.M    = SH_N;
+      SH.C    = CreateMatrix(SH_N + 1, SH_N + 1);
+      SH.S    = CreateMatrix(SH_N + 1, SH_N + 1);
+      SH.Norm = CreateMatrix(SH_N + 1, SH_N + 1);
+      LegendreNorm(SH_N, SH_N, SH.Norm);
+      for (deg = 1; deg <= SH_N; deg++) {
+         for (ord = 0; ord <= deg; ord++) {
+            SH.C[deg][ord] = cos(3.0 * deg + 7.0 * ord) / (deg * deg);
+            SH.S[deg][ord] =
+                (ord == 0 ? 0.0 : sin(5.0 * deg + 2.0 * ord) / (deg * deg));
+         }
+      }
+      InitSphereHarmRecursion(&SH);
+
+      for (int i = 0; i < 5; i++) {
+         char trialInfo[40] = {0};
+         snprintf(trialInfo, 39, "%i", i);
+         trigs[0] = cos(theta[i]);
+         trigs[1] = sin(theta[i]);
+         trigs[2] = cos(0.3 + i);
+         trigs[3] = sin(0.3 + i);
+         SphereHarmGrav(&SH, SH_N, SH_N, r, trigs, Re, K, gradV, NULL);
+         SphericalHarmonics(SH_N, SH_N, r, trigs, Re, K, SH.C, SH.S, SH.Norm,
+                            legacyGradV);
+         testSuccess &= print_result(
+             TEST_VEC(3, gradV, legacyGradV, 1.0E-10 * MAGV(legacyGradV)),
+             "SphereHarmGrav Test", 20, 2, trialInfo, FALSE, FALSE);
+      }
+      for (int i = 0; i < 2; i++) {
+         char trialInfo[40] = {0};
+         snprintf(trialInfo, 39, "%i", i);
+         trigs[0] = (i == 0 ? 1.0 : -1.0);
+         trigs[1] = 0.0;
+         trigs[2] = cos(0.3);
+         trigs[3] = sin(0.3);
+         SphereHarmGrav(&SH, SH_N, SH_N, r, trigs, Re, K, poleGradV, NULL);
+         trigs[0] = cos(i == 0 ? 1.0E-9 : PI - 1.0E-9);
+         trigs[1] = sin(i == 0 ? 1.0E-9 : PI - 1.0E-9);
+         SphereHarmGrav(&SH, SH_N, SH_N, r, trigs, Re, K, gradV, NULL);
+         testSuccess &= print_result(
+             TEST_VEC(3, poleGradV, gradV, 1.0E-8 * MAGV(gradV)),
+             "SphereHarmGrav Pole Test", 25, 2, trialInfo, FALSE, FALSE);
+      }
+      /* Hessian against central differences of gradV.  In the raw    */
+      /* partials P = (dV/dr, dV/dtheta, dV/dphi), HV[i][j] is        */
+      /* s[i]*s[j]*dP[i]/dq[j], with q = (r, theta, phi) and          */
+      /* s = (1, 1/r, 1/(r*sin(theta))).                              */
+      for (int i = 1; i < 4; i++) {
+         char trialInfo[40] = {0};
+         const double h     = 1.0E-5;
+         double HV[3][3], FdHV[3][3], q[3], Pp[3], Pm[3], s[3];
+         snprintf(trialInfo, 39, "%i", i);
+         q[0]     = r;
+         q[1]     = theta[i];
+         q[2]     = 0.3 + i;
+         trigs[0] = cos(q[1]);
+         trigs[1] = sin(q[1]);
+         trigs[2] = cos(q[2]);
+         trigs[3] = sin(q[2]);
+         SphereHarmGrav(&SH, SH_N, SH_N, q[0], trigs, Re, K, gradV, HV);
+         s[0] = 1.0;
+         s[1] = 1.0 / q[0];
+         s[2] = 1.0 / (q[0] * sin(q[1]));
+         for (int j = 0; j < 3; j++) {
+            for (int k = -1; k <= 1; k += 2) {
+               double qk[3] = {q[0], q[1], q[2]};
+               double *P    = (k < 0 ? Pm : Pp);
+               qk[j]       += k * h;
+               trigs[0]     = cos(qk[1]);
+               trigs[1]     = sin(qk[1]);
+               trigs[2]     = cos(qk[2]);
+               trigs[3]     = sin(qk[2]);
+               SphereHarmGrav(&SH, SH_N, SH_N, qk[0], trigs, Re, K, gradV,
+                              NULL);
+               P[0] = gradV[0];
+               P[1] = gradV[1] * qk[0];
+               P[2] = gradV[2] * qk[0] * sin(qk[1]);
+            }
+            for (int k = 0; k < 3; k++)
+               FdHV[k][j] = s[k] * s[j] * (Pp[k] - Pm[k]) / (2.0 * h);
+         }
+         double Scale = 0.0;
+         for (int j = 0; j < 3; j++)
+            Scale = fmax(Scale, MAGV(HV[j]));
+         testSuccess &= print_result(
+             TEST_MAT(3, 3, HV, FdHV, 1.0E-6 * Scale),
+             "SphereHarmGrav Hessian Test", 28, 2, trialInfo, FALSE, FALSE);
+      }
+      DestroyMatrix(SH.C);
+      DestroyMatrix(SH.S);
+      DestroyMatrix(SH.Norm);
+      DestroySphereHarmRecursion(&SH);
+#undef SH_N
+   }
+   success &= print_result(testSuccess, "Spherical Harmonic Gravity Tests:",
+                           34, 2, "", FALSE, TRUE);
    return (success);
 }
 
@@ -14,7 +14,9 @@
 #ifndef __MATHKIT_TESTS_H__
 #define __MATHKIT_TESTS_H__
 
+#include "envkit.h"
 #include "mathkit.h"
+#include "sigkit.h"
 #include "test_lib.h"
 
 long RunMathKit_Tests();
@@ -14,6 +14,7 @@
 #ifndef __NAVKIT_TESTS_H__
 #define __NAVKIT_TESTS_H__
 
+#include "42.h"
 #include "42constants.h"
 #include "DSMTypes.h"
 #include "navkit.h"
@@ -23,5 +24,7 @@
 long RunNavKit_Tests();
 long DSMMeasType_Tests();
 long NavAux_Tests();
+long MeasUpdate_Tests();
+long StateTransitionMatrix_Tests();
 
 #endif
\ No newline at end of file
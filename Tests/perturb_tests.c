@@ -0,0 +1,206 @@
+/*    This file is distributed with 42,                               */
+/*    the (mostly harmless) spacecraft dynamics simulation            */
+/*    created by Eric Stoneking of NASA Goddard Space Flight Center   */
+
+/*    Copyright 2010 United States Government                         */
+/*    as represented by the Administrator                             */
+/*    of the National Aeronautics and Space Administration.           */
+
+/*    No copyright is claimed in the United States                    */
+/*    under Title 17, U.S. Code.                                      */
+
+/*    All Other Rights Reserved.                                      */
+
+#include "perturb_tests.h"
+
+#define GRAV_STAGE_NSC 4
+
+long RunPerturb_Tests()
+{
+   long successful = TRUE;
+   print_hdr("GravStage Tests:", 17, 1);
+   successful &= print_result(GravStage_Tests(), "GravStage Tests", 16, 2, "",
+                              FALSE, TRUE);
+
+   return (successful);
+}
+
+// Cowell spacecraft orbiting Earth, pulled on by the Sun, the planets, and
+// the Moon. Each World's ephemeris is one synthetic Chebyshev segment
+// spanning the test epoch, so no JPL file is needed.
+static void InitGravStageFixture(const double JD)
+{
+   long Iw, Isc, i;
+
+   EphemOption    = EPH_DE430;
+   GravPertActive = TRUE;
+   DTSIM          = 0.1;
+   TDB.JulDay     = JD;
+   qjh[0]         = 0.0;
+   qjh[1]         = 0.0;
+   qjh[2]         = 0.0;
+   qjh[3]         = 1.0;
+
+   for (Iw = SOL; Iw <= LUNA; Iw++) {
+      struct WorldType *W = &World[Iw];
+      struct Cheb3DType *Cheb;
+      const double Scale = (Iw == LUNA ? 3.8E5 : 1.0E7 * (Iw + 1));
+
+      W->Exists = (Iw <= PLUTO || Iw == LUNA);
+      W->mu     = 1.0E14 * (Iw + 1);
+      W->w      = 1.0E-5;
+      for (i = 0; i < 3; i++)
+         W->CNH[i][i] = 1.0;
+      W->eph.Ncheb = 1;
+      W->eph.Cheb  = calloc(1, sizeof(struct Cheb3DType));
+      Cheb         = &W->eph.Cheb[0];
+      Cheb->JD1    = JD - 16.0;
+      Cheb->JD2    = JD + 16.0;
+      Cheb->N      = 3;
+      for (i = 0; i < 3; i++) {
+         Cheb->Coef[i][0] = Scale * cos(Iw + 2.0 * i);
+         Cheb->Coef[i][1] = 0.01 * Scale * sin(Iw + i);
+         Cheb->Coef[i][2] = 0.001 * Scale;
+      }
+   }
+   World[EARTH].Nsat   = 1;
+   World[EARTH].Sat    = calloc(1, sizeof(long));
+   World[EARTH].Sat[0] = LUNA;
+
+   Norb          = 1;
+   Orb           = calloc(Norb, sizeof(struct OrbitType));
+   Orb[0].World  = EARTH;
+   Orb[0].Regime = ORB_N_BODY;
+
+   Nsc = GRAV_STAGE_NSC;
+   SC  = calloc(Nsc, sizeof(struct SCType));
+   for (Isc = 0; Isc < Nsc; Isc++) {
+      SC[Isc].Exists        = TRUE;
+      SC[Isc].RefOrb        = 0;
+      SC[Isc].OrbDOF        = ORBDOF_COWELL;
+      SC[Isc].OrbMaxCounter = 1;
+      SC[Isc].mass          = 100.0;
+   }
+}
+
+static void DestroyGravStageFixture(void)
+{
+   long Iw;
+
+   ShutdownGravPertStages();
+   for (Iw = SOL; Iw <= LUNA; Iw++) {
+      free(World[Iw].eph.Cheb);
+      memset(&World[Iw], 0, sizeof(struct WorldType));
+   }
+   free(Orb);
+   free(SC);
+   Orb            = NULL;
+   SC             = NULL;
+   Norb           = 0;
+   Nsc            = 0;
+   GravPertActive = FALSE;
+   EphemOption    = EPH_MEAN;
+}
+
+// The pull of the Sun, the planets and the Moon on an SC at PosN around
+// Earth, summed here from Rk4JplEphems without the stage table
+static void ThirdBodySum(const double RKFdt, double PosN[3], double mass,
+                         double FrcN[3])
+{
+   const double JD = TDB.JulDay + RKFdt / 86400.0;
+   double EarthPosN[3], EarthPosH[3], EarthCNH[3][3], PriMerAng;
+   double PosH[3], CNH[3][3], ph[3], p[3], s[3], Frc[3];
+   long Iw, j;
+
+   for (j = 0; j < 3; j++)
+      FrcN[j] = 0.0;
+   Rk4JplEphems(JD, EARTH, EarthPosN, EarthPosH, &PriMerAng, EarthCNH);
+   for (Iw = SOL; Iw <= LUNA; Iw++) {
+      if (!World[Iw].Exists || Iw == EARTH)
+         continue;
+      Rk4JplEphems(JD, Iw, p, PosH, &PriMerAng, CNH);
+      // Planets are placed from their heliocentric positions; the Moon's
+      // is already geocentric
+      if (Iw != LUNA) {
+         for (j = 0; j < 3; j++)
+            ph[j] = PosH[j] - EarthPosH[j];
+         MxV(EarthCNH, ph, p);
+      }
+      for (j = 0; j < 3; j++)
+         s[j] = p[j] - PosN[j];
+      ThirdBodyGravForce(p, s, World[Iw].mu, mass, Frc);
+      for (j = 0; j < 3; j++)
+         FrcN[j] += Frc[j];
+   }
+}
+
+// GravPertForceRK4 reads third-body positions from the stage table that
+// GravPertStages fills, and looks up any stage missing from it directly.
+// Both must give the same force, bit for bit, and agree with a sum taken
+// here without either path.
+long GravStage_Tests()
+{
+   const double Offset[4] = {0.0, 0.05, 0.05, 0.1}; // RK4 stage times
+   double u[6], Direct[3], Staged[3], Sum[3];
+   long success = TRUE;
+   long Isc, k, j;
+
+   InitGravStageFixture(2451545.0);
+   for (Isc = 0; Isc < GRAV_STAGE_NSC; Isc++) {
+      for (k = 0; k < 4; k++) {
+         char trialInfo[40] = {0};
+         snprintf(trialInfo, 39, "%li, %li", Isc, k);
+         for (j = 0; j < 3; j++) {
+            u[j]     = 7.0E6 * (1.0 + 0.1 * Isc) * (j == k % 3 ? 1.0 : 0.3);
+            u[j + 3] = 0.0;
+         }
+         for (j = 0; j < 3; j++) {
+            Direct[j] = 0.0;
+            Staged[j] = 0.0;
+         }
+
+         // An empty table sends every stage to the direct lookup
+         GravPertActive = FALSE;
+         GravPertStages();
+         GravPertActive = TRUE;
+
+         success &= print_result(!GravStageIsTabled(Offset[k], EARTH),
+                                 "GravStage Empty Table Test", 27, 2,
+                                 trialInfo, FALSE, FALSE);
+         GravPertForceRK4(&SC[Isc], u, Direct, Offset[k]);
+
+         GravPertStages();
+         success &= print_result(GravStageIsTabled(Offset[k], EARTH),
+                                 "GravStage Table Hit Test", 25, 2,
+                                 trialInfo, FALSE, FALSE);
+         GravPertForceRK4(&SC[Isc], u, Staged, Offset[k]);
+
+         ThirdBodySum(Offset[k], u, SC[Isc].mass, Sum);
+         success &= print_result(
+             TEST_VEC(3, Staged, Direct, 0.0) &&
+                 TEST_VEC(3, Staged, Sum, 1.0E-12 * MAGV(Sum)) &&
+                 MAGV(Sum) > 0.0,
+             "GravStage Force Test", 21, 2, trialInfo, FALSE, FALSE);
+      }
+   }
+
+   // A stage time the table wasn't filled for falls back too
+   for (j = 0; j < 3; j++) {
+      Direct[j] = 0.0;
+      Staged[j] = 0.0;
+   }
+   GravPertActive = FALSE;
+   GravPertStages();
+   GravPertActive = TRUE;
+   GravPertForceRK4(&SC[0], u, Direct, 0.02);
+   GravPertStages();
+   GravPertForceRK4(&SC[0], u, Staged, 0.02);
+   ThirdBodySum(0.02, u, SC[0].mass, Sum);
+   success &= print_result(!GravStageIsTabled(0.02, EARTH) &&
+                               TEST_VEC(3, Staged, Direct, 0.0) &&
+                               TEST_VEC(3, Staged, Sum, 1.0E-12 * MAGV(Sum)),
+                           "GravStage Fallback Test", 24, 2, "", FALSE, FALSE);
+
+   DestroyGravStageFixture();
+   return (success);
+}
@@ -0,0 +1,23 @@
+/*    This file is distributed with 42,                               */
+/*    the (mostly harmless) spacecraft dynamics simulation            */
+/*    created by Eric Stoneking of NASA Goddard Space Flight Center   */
+
+/*    Copyright 2010 United States Government                         */
+/*    as represented by the Administrator                             */
+/*    of the National Aeronautics and Space Administration.           */
+
+/*    No copyright is claimed in the United States                    */
+/*    under Title 17, U.S. Code.                                      */
+
+/*    All Other Rights Reserved.                                      */
+
+#ifndef __PERTURB_TESTS_H__
+#define __PERTURB_TESTS_H__
+
+#include "42.h"
+#include "test_lib.h"
+
+long RunPerturb_Tests();
+long GravStage_Tests();
+
+#endif